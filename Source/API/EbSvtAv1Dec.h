@@ -49,6 +49,26 @@ typedef struct EbAV1FrameInfo
     uint64_t    frame_presentation_time;
 } EbAV1FrameInfo;
 
+/* Random access properties of a temporal unit */
+typedef struct EbAV1TuInfo
+{
+    /* The temporal unit shows a key frame, decoding can start at it once
+     * a sequence header has been decoded */
+    EbBool      random_access_point;
+
+    /* Header of the first frame of the temporal unit. frame_type is
+     * KEY_FRAME (0), INTER_FRAME (1), INTRA_ONLY_FRAME (2) or S_FRAME (3),
+     * it is only read when show_existing_frame is 0 */
+    uint8_t     frame_type;
+    EbBool      show_existing_frame;
+    EbBool      show_frame;
+
+    /* Position of the sequence header OBU in the temporal unit.
+     * seq_header_size is 0 when the temporal unit has none */
+    uint32_t    seq_header_offset;
+    uint32_t    seq_header_size;
+} EbAV1TuInfo;
+
 typedef struct EbSvtAv1DecConfiguration
 {
     /* Bitstream operating point to decode.
@@ -117,7 +137,7 @@ typedef struct EbSvtAv1DecConfiguration
     * 0 = System default.
     * 1 = Single thread decoding.
     *
-    * Default is 0. */
+    * Default is 1. */
     uint32_t                 threads;
     // Application Specific parameters
 
@@ -272,6 +292,14 @@ typedef struct EbSvtAv1DecConfiguration
         EbComponentType     *svt_dec_component);
 
     /* Initialize callback functions.
+     *
+     * When set, the picture buffers of the decoder are allocated through
+     * allocate_buffer and handed back through release_buffer once no longer
+     * referenced. eb_svt_dec_get_picture then returns the picture buffer
+     * itself instead of a copy, with the strides of the picture buffer and
+     * the private_data of the frame buffer in p_app_private. The output stays
+     * valid until the next call to eb_svt_decode_frame. Must be called
+     * before the first decode call.
      *
      * Parameter:
      * @ *svt_dec_component     Decoder handle
@@ -285,6 +313,23 @@ typedef struct EbSvtAv1DecConfiguration
         eb_release_frame_buffer     release_buffer,
         void                        *priv_data);
 
+    /* Finds the random access properties of a temporal unit from its OBU
+     * headers and the first bits of its frame header. Nothing is entropy
+     * decoded and no decoder handle is needed, so the random access points
+     * of a stream can be indexed before decoding it.
+     *
+     * Parameter:
+     * @ *data                  Temporal unit, Section 5 low overhead format
+     * @ data_size              Data size in bytes
+     * @ *tu_info               Random access properties of the temporal unit
+     *
+     * Returns EB_Corrupt_Frame if the OBUs do not fit in the data or have
+     * no obu_size field. The length fields of Annex B are not parsed. */
+    EB_API EbErrorType eb_svt_dec_get_tu_info(
+        const uint8_t               *data,
+        size_t                      data_size,
+        EbAV1TuInfo                 *tu_info);
+
     /* Returns information about the bitstream and
      * the last decoded frame.
      *
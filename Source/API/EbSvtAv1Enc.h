@@ -27,6 +27,10 @@ extern "C" {
 #define EB_BUFFERFLAG_IS_ALT_REF    0x00000008  // signals that the packet contains an ALT_REF frame
 #define EB_BUFFERFLAG_ERROR_MASK    0xFFFFFFF0  // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
 
+// Run slots shared by the kernel threads of several encoder handles, see
+// eb_svt_create_thread_pool()
+typedef struct EbThreadPool EbSvtThreadPool;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration
@@ -359,6 +363,27 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is 1. */
     uint8_t                  unrestricted_motion_vector;
 
+    /* Encode the input pictures in place instead of copying them. The planes
+     * sent to eb_svt_enc_send_picture() must follow the layout given by
+     * eb_svt_enc_get_input_layout(), padding included, and are written to by
+     * the library (padding, temporal filtering). They are held until
+     * input_release_callback is called with the p_app_private of the sent
+     * buffer. 10 bit input is sent as 8 bit planes (luma, cb, cr) and 2 bit
+     * planes (luma_ext, cb_ext, cr_ext) holding the 2 LSBs in the top bits of
+     * each byte.
+     *
+     * Default is 0. */
+    EbBool                   zero_copy_input;
+
+    /* Called from a library thread when the planes of a zero copy input are
+     * no longer used, with the p_app_data given to eb_init_handle() and the
+     * p_app_private of the sent buffer. It must not call into the library.
+     * The pictures still held when the encoder is deinitialized are not
+     * released through it. */
+    void                   (*input_release_callback)(
+        void *p_app_data,
+        void *p_app_private);
+
     // Threads management
 
     /* The number of logical processor which encoder threads run on. If
@@ -376,8 +401,52 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is -1. */
     int32_t                 target_socket;
 
+    /* Number of kernel threads allowed to run at the same time. The picture
+     * analysis, motion estimation, source based operations, mode decision
+     * configuration, encdec, deblocking, cdef, restoration and entropy coding
+     * threads share this many run slots. A thread gives its slot away while it
+     * waits for an input or an output buffer.
+     *
+     * -1 = Sized to the CPU quota of the process cgroup, or to the number of
+     *      logical processors if there is no quota.
+     *  0 = Off, all the kernel threads may run at once.
+     *
+     * Default is 0. */
+    int32_t                 thread_pool_size;
+
+    /* Thread pool shared with other encoder handles, created with
+     * eb_svt_create_thread_pool(). The kernel threads of all the handles
+     * attached to the pool share its run slots, a freed slot going to the
+     * handle holding the fewest. The kernel processes of the handle are sized
+     * for its share of the pool, pool_size / active_channel_count cores.
+     * Overrides thread_pool_size.
+     *
+     * Default is NULL. */
+    EbSvtThreadPool        *thread_pool;
+
+    /* Memory budget of the encoder in MB. The picture buffer pools and the
+     * kernel processes are sized down, as for a lower number of cores, until
+     * their footprint fits in the budget. The footprint is measured on one
+     * object of each kind before the pools are allocated, and the encoder
+     * fails to initialize if even the single core sizing does not fit.
+     *
+     * 0 = No budget, the pools are sized for the number of cores.
+     *
+     * Default is 0. */
+    uint32_t                memory_budget_mb;
+
     // Debug tools
 
+    /* Number of pipeline trace events recorded. Every input a kernel thread
+     * takes from its fifo is recorded with its wait, processing and stall
+     * times and the depth of the fifo, see eb_svt_get_trace(). The events
+     * past this count are dropped.
+     *
+     * 0 = Tracing off.
+     *
+     * Default is 0. */
+    uint32_t                trace_event_count;
+
     /* Output reconstructed yuv used for debug purposes. The value is set through
      * ReconFile token (-o) and using the feature will affect the speed of encoder.
      *
@@ -432,6 +501,66 @@ typedef struct EbSvtAv1EncConfiguration
     EbBool                   enable_overlays;
 } EbSvtAv1EncConfiguration;
 
+/* Pipeline subsystems the encoder memory is accounted to. */
+typedef enum EbMemorySubsystem
+{
+    EB_MEM_SUBSYSTEM_OTHER = 0,     // Handle, sequence control sets and process result fifos
+    EB_MEM_SUBSYSTEM_PCS,           // Parent and child picture control set pools
+    EB_MEM_SUBSYSTEM_REFERENCE,     // Reference and PA reference picture pools
+    EB_MEM_SUBSYSTEM_IO_BUFFER,     // Input, overlay, output stream and recon buffer pools
+    EB_MEM_SUBSYSTEM_ANALYSIS,      // Picture analysis, picture decision, motion estimation and source based operations
+    EB_MEM_SUBSYSTEM_MODE_DECISION, // Mode decision configuration and encdec (MD) contexts
+    EB_MEM_SUBSYSTEM_LOOP_FILTER,   // Deblocking, cdef and restoration contexts
+    EB_MEM_SUBSYSTEM_ENTROPY,       // Rate control, entropy coding and packetization contexts
+    EB_MEM_SUBSYSTEM_COUNT
+} EbMemorySubsystem;
+
+/* Memory held by an encoder instance. Allocations made by the library
+ * threads while encoding are accounted to the subsystem of the kernel
+ * doing them. */
+typedef struct EbMemoryUsage
+{
+    uint64_t                 malloc_bytes;      // Bytes allocated with malloc
+    uint64_t                 calloc_bytes;      // Bytes allocated with calloc
+    uint64_t                 aligned_bytes;     // Bytes allocated aligned
+    uint64_t                 total_bytes;       // Sum of the above
+    uint64_t                 peak_bytes;        // Highest total_bytes since the handle was created
+    uint32_t                 mutex_count;
+    uint32_t                 semaphore_count;
+    uint32_t                 thread_count;
+    uint64_t                 subsystem_bytes[EB_MEM_SUBSYSTEM_COUNT];
+} EbMemoryUsage;
+
+/* Layout of the zero copy input planes. Each plane is a padded buffer, its
+ * first visible sample being origin_y rows and origin_x samples (halved for
+ * the chroma planes) from the start of the buffer. */
+typedef struct EbInputLayout
+{
+    uint32_t                 width;             // Luma width and height, the source size rounded up to a multiple of 8
+    uint32_t                 height;
+    uint32_t                 origin_x;          // Luma padding on the left
+    uint32_t                 origin_y;          // Luma padding on the top
+    uint32_t                 y_stride;          // In samples, also of the 2 bit planes
+    uint32_t                 cb_stride;
+    uint32_t                 cr_stride;
+    uint32_t                 luma_size;         // Samples of a luma plane, padding included
+    uint32_t                 chroma_size;       // Samples of a chroma plane, padding included
+} EbInputLayout;
+
+/* Input processed by a kernel thread of the encoder pipeline. The times are
+ * in microseconds from eb_init_encoder(). */
+typedef struct EbTraceEvent
+{
+    const char              *stage;             // Name of the kernel
+    uint32_t                 thread_index;      // Thread of the instance, in the order they took their first input
+    uint64_t                 picture_number;
+    uint64_t                 wait_start_us;     // The thread started waiting on its input fifo
+    uint64_t                 start_us;          // The thread took the input
+    uint64_t                 end_us;            // The thread went back to its input fifo
+    uint64_t                 stall_us;          // Time blocked on downstream fifos between start_us and end_us
+    uint32_t                 queue_depth;       // Inputs left in the fifo when the thread took the input
+} EbTraceEvent;
+
     /* STEP 1: Call the library to construct a Component Handle.
      *
      * Parameter:
@@ -486,7 +615,8 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbBufferHeaderType       **output_stream_ptr);
 
-    /* STEP 4: Send the picture.
+    /* STEP 4: Send the picture. The picture is copied, unless zero_copy_input
+     * is set.
      *
      * Parameter:
      * @ *svt_enc_component  Encoder handler.
@@ -495,6 +625,16 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Get the layout of the zero copy input planes. Can be called
+     * once eb_svt_enc_set_parameter() succeeded.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *layout             Layout filled by the library. */
+    EB_API EbErrorType eb_svt_enc_get_input_layout(
+        EbComponentType      *svt_enc_component,
+        EbInputLayout        *layout);
+
     /* STEP 5: Receive packet.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
@@ -522,6 +662,52 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Get the memory held by the encoder, per allocation kind and
+     * per pipeline subsystem. Can be called at any time between
+     * eb_init_handle() and eb_deinit_handle(), from any thread.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *usage              Memory usage filled by the library. */
+    EB_API EbErrorType eb_svt_get_memory_usage(
+        EbComponentType      *svt_enc_component,
+        EbMemoryUsage        *usage);
+
+    /* OPTIONAL: Get the pipeline trace events recorded so far when
+     * trace_event_count is set. The events stay valid until the next call or
+     * eb_deinit_handle(). The inputs still in process are not reported, call
+     * it once the last packet is received for a complete trace.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ **events            Set to the event array, NULL when tracing is off.
+     * @ *event_count        Number of events. */
+    EB_API EbErrorType eb_svt_get_trace(
+        EbComponentType      *svt_enc_component,
+        const EbTraceEvent  **events,
+        uint32_t             *event_count);
+
+    /* OPTIONAL: Create a thread pool to share between encoder handles, set as
+     * thread_pool of their configuration before eb_svt_enc_set_parameter().
+     *
+     * Parameter:
+     * @ **thread_pool       Pool created by the library.
+     * @ pool_size           Number of kernel threads of all the attached
+     *                       handles allowed to run at once, -1 for the CPU
+     *                       quota of the process or the number of logical
+     *                       processors. */
+    EB_API EbErrorType eb_svt_create_thread_pool(
+        EbSvtThreadPool     **thread_pool,
+        int32_t               pool_size);
+
+    /* OPTIONAL: Destroy a thread pool, once all the handles attached to it
+     * are deinitialized.
+     *
+     * Parameter:
+     * @ *thread_pool        Pool to destroy. */
+    EB_API EbErrorType eb_svt_destroy_thread_pool(
+        EbSvtThreadPool      *thread_pool);
+
     /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
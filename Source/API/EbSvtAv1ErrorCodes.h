@@ -88,6 +88,7 @@ extern "C" {
         EB_ENC_EC_ERROR27 = 0x0720,
         EB_ENC_EC_ERROR28 = 0x0721,
         EB_ENC_EC_ERROR29 = 0x0722,
+        EB_ENC_EC_ERROR30 = 0x0730, // Sent in the output buffer flags, the low 4 bits are kept clear
         //EB_ENC_INTER_PRED_ERRORS          = 0x0800,
         EB_ENC_INTER_PRED_ERROR0 = 0x0800,
         EB_ENC_INTER_PRED_ERROR1 = 0x0801,
@@ -145,6 +146,7 @@ extern "C" {
         EB_ENC_PACKETIZATION_ERROR3 = 0x1202,
         EB_ENC_PACKETIZATION_ERROR4 = 0x1203,
         EB_ENC_PACKETIZATION_ERROR5 = 0x1204,
+        EB_ENC_PACKETIZATION_ERROR6 = 0x1210, // Sent in the output buffer flags, the low 4 bits are kept clear
         //EB_ENC_PM_ERRORS                  = 0x1300,
         EB_ENC_PM_ERROR0 = 0x1300,
         EB_ENC_PM_ERROR1 = 0x1301,
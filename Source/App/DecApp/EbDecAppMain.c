@@ -8,6 +8,7 @@
  ***************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <inttypes.h>
 
@@ -57,23 +58,31 @@ int init_pic_buffer(EbSvtIOFormat *pic_buffer, CLInput *cli) {
     return 0;
 }
 
-int read_input_frame(DecInputContext *input, uint8_t **buffer, size_t *bytes_read,
-    size_t *buffer_size, int64_t *pts)
+/* Points data to the next temporal unit. A mapped input is read in place,
+   otherwise the temporal unit is read into buffer */
+int read_input_frame(DecInputContext *input, const uint8_t **data,
+    size_t *bytes_read, uint8_t **buffer, size_t *buffer_size, int64_t *pts)
 {
     CLInput *cli = input->cli_ctx;
+    if (input->mmap_ctx->data)
+        return input_mmap_read_temporal_unit(input, data, bytes_read, pts);
+    *data = NULL;
     switch (cli->inFileType)
     {
     case FILE_TYPE_IVF:
-        return read_ivf_frame(cli->inFile, buffer, bytes_read, buffer_size, pts);
+        if (!read_ivf_frame(cli->inFile, buffer, bytes_read, buffer_size, pts))
+            return 0;
         break;
     case FILE_TYPE_OBU:
-        return obudec_read_temporal_unit(input, buffer, bytes_read,
-            buffer_size);
+        if (!obudec_read_temporal_unit(input, buffer, bytes_read, buffer_size))
+            return 0;
         break;
     default:
         printf("Unsupported bitstream type. \n");
         return 0;
     }
+    *data = *buffer;
+    return 1;
 }
 
 void write_frame(EbBufferHeaderType *recon_buffer, CLInput *cli) {
@@ -121,6 +130,76 @@ void write_frame(EbBufferHeaderType *recon_buffer, CLInput *cli) {
     fflush(cli->outFile);
 }
 
+/* Frame buffers handed to the decoder with -ext-frame-buf. Released buffers
+   are kept in the pool and reused for the next allocations */
+typedef struct AppFrameBuf {
+    uint8_t     *data;
+    uint32_t    size;
+    int         in_use;
+} AppFrameBuf;
+
+typedef struct AppFrameBufPool {
+    AppFrameBuf *bufs;
+    uint32_t    num_bufs;
+} AppFrameBufPool;
+
+static int app_allocate_frame_buffer(EbExtFrameBuf *frame_buf,
+                                     uint32_t min_size, void *private_data)
+{
+    AppFrameBufPool *pool = (AppFrameBufPool *)private_data;
+    AppFrameBuf *fb = NULL;
+    uint32_t i;
+
+    for (i = 0; i < pool->num_bufs; i++) {
+        if (!pool->bufs[i].in_use) {
+            fb = &pool->bufs[i];
+            if (fb->size >= min_size) break;
+        }
+    }
+    if (fb == NULL) {
+        AppFrameBuf *bufs = (AppFrameBuf *)realloc(pool->bufs,
+            (pool->num_bufs + 1) * sizeof(AppFrameBuf));
+        if (bufs == NULL) return -1;
+        pool->bufs = bufs;
+        fb = &pool->bufs[pool->num_bufs++];
+        fb->data = NULL;
+        fb->size = 0;
+    }
+    if (fb->size < min_size) {
+        free(fb->data);
+        fb->data = (uint8_t *)malloc(min_size);
+        fb->size = fb->data ? min_size : 0;
+        if (fb->data == NULL) return -1;
+    }
+    fb->in_use = 1;
+
+    frame_buf->buffer = fb->data;
+    frame_buf->buffer_size = fb->size;
+    /* Index of the pool entry */
+    frame_buf->private_data = (void *)(uintptr_t)(fb - pool->bufs);
+    return 0;
+}
+
+static int app_release_frame_buffer(EbExtFrameBuf *frame_buf,
+                                    void *private_data)
+{
+    AppFrameBufPool *pool = (AppFrameBufPool *)private_data;
+    uintptr_t idx = (uintptr_t)frame_buf->private_data;
+
+    if (idx >= pool->num_bufs || !pool->bufs[idx].in_use) return -1;
+    pool->bufs[idx].in_use = 0;
+    return 0;
+}
+
+static void app_free_frame_buffers(AppFrameBufPool *pool) {
+    uint32_t i;
+    for (i = 0; i < pool->num_bufs; i++)
+        free(pool->bufs[i].data);
+    free(pool->bufs);
+    pool->bufs = NULL;
+    pool->num_bufs = 0;
+}
+
 static void show_progress(int in_frame, uint64_t dx_time) {
     printf("\n%d frames decoded in %" PRId64 " us (%.2f fps)\r",
         in_frame, dx_time,
@@ -146,14 +225,22 @@ int32_t main(int32_t argc, char* argv[])
     cli.enable_md5 = 0;
     cli.fps_frm = 0;
     cli.fps_summary = 0;
+    cli.ext_frame_buf = 0;
+    cli.input_mmap = 1;
+    cli.seek = 0;
+    cli.seek_frame = 0;
 
-    DecInputContext input = { NULL, NULL };
+    DecInputContext input = { NULL, NULL, NULL };
     ObuDecInputContext obu_ctx = { NULL, 0, 0, 0 };
+    DecInputMmap mmap_ctx;
+    memset(&mmap_ctx, 0, sizeof(mmap_ctx));
     input.cli_ctx = &cli;
     input.obu_ctx = &obu_ctx;
+    input.mmap_ctx = &mmap_ctx;
 
     uint64_t stop_after = 0;
     uint32_t in_frame = 0;
+    uint64_t drop_frames = 0;
 
     MD5Context md5_ctx;
     unsigned char md5_digest[16];
@@ -163,9 +250,12 @@ int32_t main(int32_t argc, char* argv[])
     int fps_frm = 0;
     int fps_summary = 0;
 
+    const uint8_t *data = NULL;
     uint8_t *buf = NULL;
     size_t bytes_in_buffer = 0, buffer_size = 0;
 
+    AppFrameBufPool frame_buf_pool = { NULL, 0 };
+
     // Print Decoder Info
     printf("-------------------------------------\n");
     printf("SVT-AV1 Decoder\n");
@@ -187,6 +277,17 @@ int32_t main(int32_t argc, char* argv[])
             goto fail;
         }
 
+        if (cli.ext_frame_buf) {
+            return_error = eb_dec_set_frame_buffer_callbacks(p_handle,
+                app_allocate_frame_buffer, app_release_frame_buffer,
+                &frame_buf_pool);
+            if (return_error != EB_ErrorNone) {
+                return_error |= eb_deinit_decoder(p_handle);
+                return_error |= eb_dec_deinit_handle(p_handle);
+                goto fail;
+            }
+        }
+
         assert(config_ptr->max_color_format <= EB_YUV444);
         assert(config_ptr->max_bit_depth <= EB_TWELVE_BIT);
 
@@ -203,9 +304,12 @@ int32_t main(int32_t argc, char* argv[])
                                 sizeof(uint8_t) : sizeof(uint16_t);
         size = size * cli.height * cli.width;
 
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->luma = (uint8_t*)malloc(size);
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->cb = (uint8_t*)malloc(size >> 2);
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->cr = (uint8_t*)malloc(size >> 2);
+        /* With external frame buffers the planes point to the decoder output */
+        if (!cli.ext_frame_buf) {
+            ((EbSvtIOFormat *)recon_buffer->p_buffer)->luma = (uint8_t*)malloc(size);
+            ((EbSvtIOFormat *)recon_buffer->p_buffer)->cb = (uint8_t*)malloc(size >> 2);
+            ((EbSvtIOFormat *)recon_buffer->p_buffer)->cr = (uint8_t*)malloc(size >> 2);
+        }
         if (!init_pic_buffer((EbSvtIOFormat*)recon_buffer->p_buffer, &cli)) {
             printf("Decoding \n");
             EbAV1StreamInfo *stream_info = (EbAV1StreamInfo*)malloc(sizeof(EbAV1StreamInfo));
@@ -214,24 +318,51 @@ int32_t main(int32_t argc, char* argv[])
             if (config_ptr->skip_frames)
                 fprintf(stderr, "Skipping first %" PRIu64 " frames.\n", config_ptr->skip_frames);
             uint64_t skip_frame = config_ptr->skip_frames;
-            while (skip_frame) {
-                if (!read_input_frame(&input, &buf, &bytes_in_buffer, &buffer_size, NULL)) break;
-                skip_frame--;
+            if (cli.input_mmap)
+                cli.input_mmap = input_mmap_open(&input);
+            if (cli.seek) {
+                // Decode from the random access point before the frame and
+                // drop the frames before it. Without an index, or for Annex B
+                // which eb_svt_dec_get_tu_info does not parse, decode from
+                // the start
+                uint64_t start_frame = 0;
+                if (obu_ctx.is_annexb)
+                    fprintf(stderr, "Seek is not supported for Annex B input, decoding from the first frame.\n");
+                else if (cli.input_mmap)
+                    start_frame = input_mmap_seek_random_access_point(&input, cli.seek_frame);
+                drop_frames = cli.seek_frame - start_frame;
+                fprintf(stderr, "Seeking to frame %" PRIu64 " from frame %" PRIu64 ".\n",
+                    cli.seek_frame, start_frame);
+            }
+            // The temporal units of a mapped input are indexed, seek to the first one decoded
+            else if (cli.input_mmap)
+                input_mmap_seek(&input, skip_frame);
+            else {
+                while (skip_frame) {
+                    if (!read_input_frame(&input, &data, &bytes_in_buffer, &buf, &buffer_size, NULL)) break;
+                    skip_frame--;
+                }
             }
             stop_after = config_ptr->frames_to_be_decoded;
             if (enable_md5)
                 md5_init(&md5_ctx);
             // Input Loop Thread
-            while (read_input_frame(&input, &buf, &bytes_in_buffer, &buffer_size, NULL)) {
+            while (read_input_frame(&input, &data, &bytes_in_buffer, &buf, &buffer_size, NULL)) {
                 if (!stop_after || in_frame < stop_after) {
 
                     dec_timer_start(&timer);
 
-                    return_error |= eb_svt_decode_frame(p_handle, buf, bytes_in_buffer);
+                    return_error |= eb_svt_decode_frame(p_handle, data, bytes_in_buffer);
 
                     dec_timer_mark(&timer);
                     dx_time += dec_timer_elapsed(&timer);
 
+                    // Only decoded as a reference of the frames that follow
+                    if (drop_frames) {
+                        drop_frames--;
+                        continue;
+                    }
+
                     in_frame++;
 
                     if (eb_svt_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) != EB_DecNoOutputPicture) {
@@ -257,13 +388,16 @@ int32_t main(int32_t argc, char* argv[])
             }
 
             return_error |= eb_deinit_decoder(p_handle);
+            input_mmap_close(&input);
 
             free(frame_info);
             free(stream_info);
         }
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cr);
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cb);
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->luma);
+        if (!cli.ext_frame_buf) {
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cr);
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cb);
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->luma);
+        }
         free(recon_buffer->p_buffer);
         free(recon_buffer);
         free(buf);
@@ -273,6 +407,7 @@ int32_t main(int32_t argc, char* argv[])
     return_error |= eb_dec_deinit_handle(p_handle);
 
 fail:
+    app_free_frame_buffers(&frame_buf_pool);
     if (cli.inFile) fclose(cli.inFile);
     if (cli.outFile) fclose(cli.outFile);
 
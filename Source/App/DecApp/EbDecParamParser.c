@@ -27,6 +27,7 @@ static void set_bit_depth(const char *value, EbSvtAv1DecConfiguration *cfg) { cf
 static void set_pic_width(const char *value, EbSvtAv1DecConfiguration *cfg) { cfg->max_picture_width = strtoul(value, NULL, 0); };
 static void set_pic_height(const char *value, EbSvtAv1DecConfiguration *cfg) { cfg->max_picture_height = strtoul(value, NULL, 0); };
 static void set_colour_space(const char *value, EbSvtAv1DecConfiguration *cfg) { cfg->max_color_format = parse_name(value, csp_names); };
+static void set_threads(const char *value, EbSvtAv1DecConfiguration *cfg) { cfg->threads = strtoul(value, NULL, 0); };
 
  /**********************************
   * Config Entry Array
@@ -35,6 +36,7 @@ ConfigEntry config_entry[] = {
     // Decoder settings
     { SKIP_FRAME_TOKEN, "SkipFrame", 1, set_skip_frame },
     { LIMIT_FRAME_TOKEN, "LimitFrame", 1, set_limit_frame },
+    { THREADS_TOKEN, "Threads", 1, set_threads },
     // Picture properties
     { BIT_DEPTH_TOKEN,"InputBitDepth", 1, set_bit_depth },
     { PIC_WIDTH_TOKEN, "PictureWidth", 1, set_pic_width},
@@ -52,15 +54,19 @@ static void showHelp()
     H0( " -i <arg>                  Input file name \n");
     H0( " -o <arg>                  Output file name \n");
     H0( " -skip <arg>               Skip the first n input frames \n");
+    H0( " -seek <arg>               Output from the nth frame, decoding from the key frame before it \n");
     H0( " -limit <arg>              Stop decoding after n frames \n");
+    H0( " -threads <arg>            Number of decoding threads. 0 = number of cores \n");
     H0( " -bit-depth <arg>          Input bitdepth. [8, 10] \n");
     H0( " -w <arg>                  Input picture width \n");
     H0( " -h <arg>                  Input picture height \n");
     H0( " -colour-space <arg>       Input picture colour space. [400, 420, 422, 444]\n");
     H0( " -md5                      MD5 support flag \n");
     H0( " -fps-frm                  Show fps after each frame decoded\n");
-    H0( " -fps-summary              Show fps summary");
-    H0( " -skip-film-grain          Disable Film Grain");
+    H0( " -fps-summary              Show fps summary\n");
+    H0( " -skip-film-grain          Disable Film Grain\n");
+    H0( " -ext-frame-buf            Decode into application allocated frame buffers\n");
+    H0( " -input-mmap <arg>         Map the input file instead of reading it. [0, 1], default 1\n");
 
 
     exit(1);
@@ -133,6 +139,19 @@ EbErrorType read_command_line(int32_t argc, char *const argv[],
                 cli->fps_summary = 1;
             else if (EB_STRCMP(cmd_copy[token_index], FILM_GRAIN_TOKEN) == 0)
                 cli->skip_film_grain = 1;
+            else if (EB_STRCMP(cmd_copy[token_index], EXT_FRAME_BUF_TOKEN) == 0)
+                cli->ext_frame_buf = 1;
+            else if (EB_STRCMP(cmd_copy[token_index], SEEK_FRAME_TOKEN) == 0) {
+                if (config_strings[token_index] == NULL) {
+                    printf("Invalid CLI option: %s \n", cmd_copy[token_index]);
+                    return EB_ErrorBadParameter;
+                }
+                cli->seek = 1;
+                cli->seek_frame = strtoull(config_strings[token_index], NULL, 0);
+            }
+            else if (EB_STRCMP(cmd_copy[token_index], INPUT_MMAP_TOKEN) == 0)
+                cli->input_mmap = config_strings[token_index] ?
+                    strtoul(config_strings[token_index], NULL, 0) : 1;
             else if (EB_STRCMP(cmd_copy[token_index], HELP_TOKEN) == 0)
                 showHelp();
             else {
@@ -41,6 +41,10 @@
 #define FPS_FRM_TOKEN                   "-fps-frm"
 #define FPS_SUMMARY_TOKEN               "-fps-summary"
 #define FILM_GRAIN_TOKEN                "-skip-film-grain"
+#define THREADS_TOKEN                   "-threads"
+#define EXT_FRAME_BUF_TOKEN             "-ext-frame-buf"
+#define INPUT_MMAP_TOKEN                "-input-mmap"
+#define SEEK_FRAME_TOKEN                "-seek"
 #define MAX_NUM_TOKENS 200
 
 #define EB_STRCMP(target,token) \
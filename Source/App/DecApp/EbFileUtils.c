@@ -8,6 +8,15 @@
 #include <string.h>
 #include <assert.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "EbFileUtils.h"
 
 const char *IVF_SIGNATURE = "DKIF";
@@ -707,3 +716,306 @@ int read_ivf_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read,
     }
     return 0;
 }
+
+/* Bytes the bit reader may read past the end of a temporal unit */
+#define MMAP_READ_AHEAD_SIZE 32
+
+static int add_temporal_unit(DecInputMmap *mmap_ctx, uint64_t *capacity,
+    uint64_t offset, size_t size, int64_t pts)
+{
+    if (mmap_ctx->num_tus == *capacity) {
+        const uint64_t new_capacity = *capacity ? 2 * *capacity : 1024;
+        TemporalUnitEntry *tu_index = (TemporalUnitEntry *)realloc(
+            mmap_ctx->tu_index, (size_t)new_capacity * sizeof(*tu_index));
+        if (!tu_index) {
+            fprintf(stderr, "Failed to allocate temporal unit index.\n");
+            return -1;
+        }
+        mmap_ctx->tu_index = tu_index;
+        *capacity = new_capacity;
+    }
+    mmap_ctx->tu_index[mmap_ctx->num_tus].offset = offset;
+    mmap_ctx->tu_index[mmap_ctx->num_tus].size = size;
+    mmap_ctx->tu_index[mmap_ctx->num_tus].pts = pts;
+    mmap_ctx->num_tus++;
+    return 0;
+}
+
+// Indexes the frames that follow the 32 byte IVF file header. Stops at the
+// first truncated frame, like read_ivf_frame.
+static void index_ivf_file(DecInputMmap *mmap_ctx) {
+    const uint8_t *data = mmap_ctx->data;
+    uint64_t capacity = 0;
+    uint64_t pos = 32;
+
+    while (pos + IVF_FRAME_HDR_SZ <= mmap_ctx->size) {
+        const size_t frame_size = mem_get_le32(data + pos);
+        const int64_t pts = mem_get_le32(data + pos + 4) +
+            ((int64_t)mem_get_le32(data + pos + 8) << 32);
+
+        pos += IVF_FRAME_HDR_SZ;
+        if (frame_size > 256 * 1024 * 1024 ||
+            pos + frame_size > mmap_ctx->size)
+            break;
+        if (add_temporal_unit(mmap_ctx, &capacity, pos, frame_size, pts))
+            break;
+        pos += frame_size;
+    }
+}
+
+// Indexes a Section 5 stream. A temporal unit starts at a temporal
+// delimiter and ends before the next one. Only the OBU headers and sizes
+// are parsed.
+static void index_obu_file(DecInputMmap *mmap_ctx) {
+    uint8_t *data = (uint8_t *)mmap_ctx->data;
+    uint64_t capacity = 0;
+    uint64_t pos = 0;
+    uint64_t tu_start = 0;
+
+    while (pos < mmap_ctx->size) {
+        ObuHeader obu_header;
+        size_t header_size = 0;
+        size_t length_size = 0;
+        uint64_t payload_length = 0;
+
+        memset(&obu_header, 0, sizeof(obu_header));
+        if (svt_read_obu_header(data + pos, (size_t)(mmap_ctx->size - pos),
+            &header_size, &obu_header, 0) != 0 ||
+            uleb_decode(data + pos + header_size,
+            (size_t)(mmap_ctx->size - pos - header_size), &payload_length,
+            &length_size) != 0 ||
+            pos + header_size + length_size + payload_length > mmap_ctx->size) {
+            fprintf(stderr, "obudec: Invalid OBU at offset %llu\n",
+                (unsigned long long)pos);
+            return;
+        }
+
+        if (obu_header.type == OBU_TEMPORAL_DELIMITER && pos > tu_start) {
+            if (add_temporal_unit(mmap_ctx, &capacity, tu_start,
+                (size_t)(pos - tu_start), 0))
+                return;
+            tu_start = pos;
+        }
+        pos += header_size + length_size + payload_length;
+    }
+    if (pos > tu_start)
+        add_temporal_unit(mmap_ctx, &capacity, tu_start,
+            (size_t)(pos - tu_start), 0);
+}
+
+// Indexes an Annex B stream. Each temporal unit starts with its size, the
+// size field is part of the data handed to the decoder.
+static void index_annexb_file(DecInputMmap *mmap_ctx) {
+    uint64_t capacity = 0;
+    uint64_t pos = 0;
+
+    while (pos < mmap_ctx->size) {
+        uint64_t tu_size = 0;
+        size_t length_size = 0;
+
+        if (uleb_decode(mmap_ctx->data + pos, (size_t)(mmap_ctx->size - pos),
+            &tu_size, &length_size) != 0 ||
+            pos + length_size + tu_size > mmap_ctx->size) {
+            fprintf(stderr, "obudec: Invalid temporal unit at offset %llu\n",
+                (unsigned long long)pos);
+            return;
+        }
+        if (add_temporal_unit(mmap_ctx, &capacity, pos,
+            (size_t)(length_size + tu_size), 0))
+            return;
+        pos += length_size + tu_size;
+    }
+}
+
+int input_mmap_open(DecInputContext *input) {
+    CLInput *cli = input->cli_ctx;
+    DecInputMmap *mmap_ctx = input->mmap_ctx;
+    uint64_t file_size;
+    uint8_t *map_ptr;
+
+    if (!mmap_ctx || !cli->inFile) return 0;
+    memset(mmap_ctx, 0, sizeof(*mmap_ctx));
+
+#ifdef _WIN32
+    {
+        const int fd = _fileno(cli->inFile);
+        HANDLE mapping_handle;
+        const __int64 length = _filelengthi64(fd);
+
+        if (length <= 0 || GetFileType((HANDLE)_get_osfhandle(fd)) != FILE_TYPE_DISK)
+            return 0;
+        file_size = (uint64_t)length;
+        if (file_size != (size_t)file_size) return 0;
+        mapping_handle = CreateFileMapping((HANDLE)_get_osfhandle(fd), NULL,
+            PAGE_READONLY, 0, 0, NULL);
+        if (!mapping_handle) return 0;
+        map_ptr = (uint8_t *)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        // The view keeps the mapping alive
+        CloseHandle(mapping_handle);
+        if (!map_ptr) return 0;
+    }
+#else
+    {
+        struct stat st;
+
+        if (fstat(fileno(cli->inFile), &st) || !S_ISREG(st.st_mode) ||
+            st.st_size <= 0)
+            return 0;
+        file_size = (uint64_t)st.st_size;
+        if (file_size != (size_t)file_size) return 0;
+        map_ptr = (uint8_t *)mmap(NULL, (size_t)file_size, PROT_READ,
+            MAP_SHARED, fileno(cli->inFile), 0);
+        if (map_ptr == (uint8_t *)MAP_FAILED) return 0;
+        // The temporal units are read in order, let the kernel read ahead
+        madvise(map_ptr, (size_t)file_size, MADV_SEQUENTIAL);
+    }
+#endif
+
+    mmap_ctx->data = map_ptr;
+    mmap_ctx->size = file_size;
+
+    if (cli->inFileType == FILE_TYPE_IVF)
+        index_ivf_file(mmap_ctx);
+    else if (input->obu_ctx->is_annexb)
+        index_annexb_file(mmap_ctx);
+    else
+        index_obu_file(mmap_ctx);
+
+    if (!mmap_ctx->num_tus) {
+        input_mmap_close(input);
+        return 0;
+    }
+    return 1;
+}
+
+void input_mmap_close(DecInputContext *input) {
+    DecInputMmap *mmap_ctx = input->mmap_ctx;
+
+    if (!mmap_ctx || !mmap_ctx->data) return;
+#ifdef _WIN32
+    UnmapViewOfFile((void *)mmap_ctx->data);
+#else
+    munmap((void *)mmap_ctx->data, (size_t)mmap_ctx->size);
+#endif
+    free(mmap_ctx->tu_index);
+    free(mmap_ctx->tail_buf);
+    memset(mmap_ctx, 0, sizeof(*mmap_ctx));
+}
+
+int input_mmap_read_temporal_unit(DecInputContext *input,
+    const uint8_t **data, size_t *data_size, int64_t *pts)
+{
+    DecInputMmap *mmap_ctx = input->mmap_ctx;
+    const TemporalUnitEntry *tu;
+    uint64_t map_end;
+
+    if (mmap_ctx->next_tu >= mmap_ctx->num_tus) return 0;
+    tu = &mmap_ctx->tu_index[mmap_ctx->next_tu++];
+
+#ifdef _WIN32
+    map_end = (mmap_ctx->size + 4095) & ~(uint64_t)4095;
+#else
+    {
+        const uint64_t page_mask = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+        map_end = (mmap_ctx->size + page_mask) & ~page_mask;
+    }
+#endif
+
+    if (mmap_ctx->seq_header ||
+        tu->offset + tu->size + MMAP_READ_AHEAD_SIZE > map_end) {
+        // Reading ahead would leave the mapped pages, or the TU follows a
+        // sequence header from an earlier TU
+        const size_t seq_header_size = mmap_ctx->seq_header_size;
+        free(mmap_ctx->tail_buf);
+        mmap_ctx->tail_buf = (uint8_t *)malloc(
+            seq_header_size + tu->size + MMAP_READ_AHEAD_SIZE);
+        if (!mmap_ctx->tail_buf) {
+            fprintf(stderr, "Failed to allocate compressed data buffer.\n");
+            return 0;
+        }
+        if (seq_header_size)
+            memcpy(mmap_ctx->tail_buf, mmap_ctx->seq_header, seq_header_size);
+        memcpy(mmap_ctx->tail_buf + seq_header_size,
+            mmap_ctx->data + tu->offset, tu->size);
+        memset(mmap_ctx->tail_buf + seq_header_size + tu->size, 0,
+            MMAP_READ_AHEAD_SIZE);
+        mmap_ctx->seq_header = NULL;
+        mmap_ctx->seq_header_size = 0;
+        *data = mmap_ctx->tail_buf;
+        *data_size = seq_header_size + tu->size;
+    }
+    else {
+#ifndef _WIN32
+        // Page in the next temporal unit while this one is decoded
+        if (mmap_ctx->next_tu < mmap_ctx->num_tus) {
+            const TemporalUnitEntry *next = tu + 1;
+            const uintptr_t page_mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+            const uintptr_t next_ptr = (uintptr_t)(mmap_ctx->data + next->offset);
+            madvise((void *)(next_ptr & ~page_mask),
+                next->size + (next_ptr & page_mask), MADV_WILLNEED);
+        }
+#endif
+        *data = mmap_ctx->data + tu->offset;
+        *data_size = tu->size;
+    }
+    if (pts && input->cli_ctx->inFileType == FILE_TYPE_IVF)
+        *pts = tu->pts;
+    return 1;
+}
+
+int input_mmap_seek(DecInputContext *input, uint64_t tu) {
+    DecInputMmap *mmap_ctx = input->mmap_ctx;
+
+    mmap_ctx->seq_header = NULL;
+    mmap_ctx->seq_header_size = 0;
+    if (tu >= mmap_ctx->num_tus) {
+        mmap_ctx->next_tu = mmap_ctx->num_tus;
+        return 0;
+    }
+    mmap_ctx->next_tu = tu;
+    return 1;
+}
+
+uint64_t input_mmap_seek_random_access_point(DecInputContext *input,
+    uint64_t tu)
+{
+    DecInputMmap *mmap_ctx = input->mmap_ctx;
+    uint64_t last_seq_header = UINT64_MAX;
+    uint64_t rap = 0;
+    uint64_t rap_seq_header = UINT64_MAX;
+    uint64_t i;
+
+    if (!mmap_ctx->num_tus)
+        return 0;
+    if (tu >= mmap_ctx->num_tus)
+        tu = mmap_ctx->num_tus - 1;
+
+    // Scan the TUs not scanned by an earlier seek
+    for (i = mmap_ctx->num_scanned_tus; i <= tu; i++) {
+        TemporalUnitEntry *entry = &mmap_ctx->tu_index[i];
+        if (eb_svt_dec_get_tu_info(mmap_ctx->data + entry->offset,
+            entry->size, &entry->info) != EB_ErrorNone)
+            memset(&entry->info, 0, sizeof(entry->info));
+    }
+    if (mmap_ctx->num_scanned_tus <= tu)
+        mmap_ctx->num_scanned_tus = tu + 1;
+
+    for (i = 0; i <= tu; i++) {
+        const EbAV1TuInfo *info = &mmap_ctx->tu_index[i].info;
+        if (info->seq_header_size)
+            last_seq_header = i;
+        if (info->random_access_point && last_seq_header != UINT64_MAX) {
+            rap = i;
+            rap_seq_header = last_seq_header;
+        }
+    }
+
+    input_mmap_seek(input, rap);
+    if (rap_seq_header != UINT64_MAX && rap_seq_header != rap) {
+        const TemporalUnitEntry *entry = &mmap_ctx->tu_index[rap_seq_header];
+        mmap_ctx->seq_header = mmap_ctx->data + entry->offset +
+            entry->info.seq_header_offset;
+        mmap_ctx->seq_header_size = entry->info.seq_header_size;
+    }
+    return rap;
+}
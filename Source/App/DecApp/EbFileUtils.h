@@ -70,6 +70,10 @@ typedef struct CLInput{
     uint32_t  fps_frm;
     uint32_t  fps_summary;
     uint32_t  skip_film_grain;
+    uint32_t  ext_frame_buf;
+    uint32_t  input_mmap;
+    uint32_t  seek;
+    uint64_t  seek_frame;
 }CLInput;
 
 typedef struct ObuDecInputContext {
@@ -79,9 +83,39 @@ typedef struct ObuDecInputContext {
     int is_annexb;
 }ObuDecInputContext;
 
+/* Temporal unit of a mapped input file */
+typedef struct TemporalUnitEntry {
+    uint64_t offset;
+    size_t size;
+    int64_t pts;
+    /* From eb_svt_dec_get_tu_info, once the TU has been scanned */
+    EbAV1TuInfo info;
+}TemporalUnitEntry;
+
+/* Input file mapped in memory. The temporal units are indexed when the
+   file is mapped and handed to the decoder in place */
+typedef struct DecInputMmap {
+    const uint8_t *data;
+    uint64_t size;
+    TemporalUnitEntry *tu_index;
+    uint64_t num_tus;
+    uint64_t next_tu;
+    /* TUs [0, num_scanned_tus) have their random access info */
+    uint64_t num_scanned_tus;
+    /* Sequence header sent before the next TU, after a seek to a random
+       access point without one */
+    const uint8_t *seq_header;
+    size_t seq_header_size;
+    /* Padded copy of a temporal unit too close to the end of the mapping
+       for the bit reader, which reads a few bytes ahead, or following a
+       sequence header */
+    uint8_t *tail_buf;
+}DecInputMmap;
+
 typedef struct DecInputContext {
     CLInput *cli_ctx;
     ObuDecInputContext *obu_ctx;
+    DecInputMmap *mmap_ctx;
 }DecInputContext;
 
 /*!\brief OBU types. */
@@ -118,4 +152,26 @@ int file_is_ivf(CLInput *cli);
 int read_ivf_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read,
     size_t *buffer_size, int64_t *pts);
 
+/* Maps the input file and indexes its temporal units. Returns 0 when the
+   input has to be read with fread (pipe, mapping failure, no complete
+   temporal unit) */
+int input_mmap_open(DecInputContext *input);
+void input_mmap_close(DecInputContext *input);
+
+/* Points data to the next temporal unit of the mapped file. Returns 0 at
+   the end of the file */
+int input_mmap_read_temporal_unit(DecInputContext *input,
+    const uint8_t **data, size_t *data_size, int64_t *pts);
+
+/* Makes tu the next temporal unit read. Returns 0 when the file has fewer
+   temporal units */
+int input_mmap_seek(DecInputContext *input, uint64_t tu);
+
+/* Makes the last random access point at or before tu the next temporal
+   unit read and returns its number, 0 when there is none. Only the TU
+   headers are scanned. The sequence header in force is sent with the
+   random access point when it has none */
+uint64_t input_mmap_seek_random_access_point(DecInputContext *input,
+    uint64_t tu);
+
 #endif
@@ -11,6 +11,7 @@
 #include "EbAppString.h"
 #include "EbAppConfig.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputMmap.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -31,10 +32,12 @@
 #define ERROR_FILE_TOKEN                "-errlog"
 #define QP_FILE_TOKEN                   "-qp-file"
 #define STAT_FILE_TOKEN                 "-stat-file"
+#define TRACE_FILE_TOKEN                "-trace"
 #define WIDTH_TOKEN                     "-w"
 #define HEIGHT_TOKEN                    "-h"
 #define NUMBER_OF_PICTURES_TOKEN        "-n"
 #define BUFFERED_INPUT_TOKEN            "-nb"
+#define INPUT_MMAP_TOKEN                "-input-mmap"
 #define BASE_LAYER_SWITCH_MODE_TOKEN    "-base-layer-switch-mode" // no Eval
 #define QP_TOKEN                        "-q"
 #define USE_QP_FILE_TOKEN               "-use-q-file"
@@ -105,6 +108,9 @@
 #define ASM_TYPE_TOKEN                  "-asm"
 #define THREAD_MGMNT                    "-lp"
 #define TARGET_SOCKET                   "-ss"
+#define THREAD_POOL_TOKEN               "-tp"
+#define SHARED_THREAD_POOL_TOKEN        "-stp"
+#define MEMORY_BUDGET_TOKEN             "-mem-budget"
 #define UNRESTRICTED_MOTION_VECTOR      "-umv"
 #define CONFIG_FILE_COMMENT_CHAR    '#'
 #define CONFIG_FILE_NEWLINE_CHAR    '\n'
@@ -183,6 +189,11 @@ static void SetCfgStatFile(const char *value, EbConfig *cfg)
     if (cfg->stat_file) { fclose(cfg->stat_file); }
     FOPEN(cfg->stat_file, value, "wb");
 };
+static void SetCfgTraceFile(const char *value, EbConfig *cfg)
+{
+    if (cfg->trace_file) { fclose(cfg->trace_file); }
+    FOPEN(cfg->trace_file, value, "w");
+};
 static void SetStatReport                       (const char *value, EbConfig *cfg) {cfg->stat_report = (uint8_t) strtoul(value, NULL, 0);};
 static void SetCfgSourceWidth                   (const char *value, EbConfig *cfg) {cfg->source_width = strtoul(value, NULL, 0);};
 static void SetInterlacedVideo                  (const char *value, EbConfig *cfg) {cfg->interlaced_video  = (EbBool) strtoul(value, NULL, 0);};
@@ -190,6 +201,7 @@ static void SetSeperateFields                   (const char *value, EbConfig *cf
 static void SetCfgSourceHeight                  (const char *value, EbConfig *cfg) {cfg->source_height = strtoul(value, NULL, 0) >> cfg->separate_fields;};
 static void SetCfgFramesToBeEncoded             (const char *value, EbConfig *cfg) {cfg->frames_to_be_encoded = strtol(value,  NULL, 0) << cfg->separate_fields;};
 static void SetBufferedInput                    (const char *value, EbConfig *cfg) {cfg->buffered_input = (strtol(value, NULL, 0) != -1 && cfg->separate_fields) ? strtol(value, NULL, 0) << cfg->separate_fields : strtol(value, NULL, 0);};
+static void SetInputMmap                        (const char *value, EbConfig *cfg) {cfg->input_mmap = (EbBool)strtoul(value, NULL, 0);};
 static void SetFrameRate                        (const char *value, EbConfig *cfg) {
     cfg->frame_rate = strtoul(value, NULL, 0);
     if (cfg->frame_rate > 1000 )
@@ -275,6 +287,9 @@ static void SetLatencyMode                      (const char *value, EbConfig *cf
 static void SetAsmType                          (const char *value, EbConfig *cfg)  {cfg->asm_type                   = (uint32_t)strtoul(value, NULL, 0);};
 static void SetLogicalProcessors                (const char *value, EbConfig *cfg)  {cfg->logical_processors         = (uint32_t)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig *cfg)  {cfg->target_socket              = (int32_t)strtol(value, NULL, 0);};
+static void SetThreadPoolSize                   (const char *value, EbConfig *cfg)  {cfg->thread_pool_size           = (int32_t)strtol(value, NULL, 0);};
+static void SetSharedThreadPoolSize             (const char *value, EbConfig *cfg)  {cfg->shared_thread_pool_size    = (int32_t)strtol(value, NULL, 0);};
+static void SetMemoryBudget                     (const char *value, EbConfig *cfg)  {cfg->memory_budget_mb           = (uint32_t)strtoul(value, NULL, 0);};
 static void SetUnrestrictedMotionVector         (const char *value, EbConfig *cfg)  {cfg->unrestricted_motion_vector = (EbBool)strtol(value, NULL, 0);};
 
 enum cfg_type{
@@ -303,6 +318,7 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", SetCfgReconFile },
     { SINGLE_INPUT, QP_FILE_TOKEN, "QpFile", SetCfgQpFile },
     { SINGLE_INPUT, STAT_FILE_TOKEN, "StatFile", SetCfgStatFile },
+    { SINGLE_INPUT, TRACE_FILE_TOKEN, "TraceFile", SetCfgTraceFile },
 
     // Interlaced Video
     { SINGLE_INPUT, INTERLACED_VIDEO_TOKEN , "InterlacedVideo" , SetInterlacedVideo },
@@ -313,6 +329,7 @@ config_entry_t config_entry[] = {
     // Prediction Structure
     { SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", SetCfgFramesToBeEncoded },
     { SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", SetBufferedInput },
+    { SINGLE_INPUT, INPUT_MMAP_TOKEN, "InputMmap", SetInputMmap },
     { SINGLE_INPUT, BASE_LAYER_SWITCH_MODE_TOKEN, "BaseLayerSwitchMode", SetBaseLayerSwitchMode },
     { SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", SetencMode},
     { SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", SetCfgIntraPeriod },
@@ -366,6 +383,9 @@ config_entry_t config_entry[] = {
     // Thread Management
     { SINGLE_INPUT, THREAD_MGMNT, "logicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, THREAD_POOL_TOKEN, "ThreadPoolSize", SetThreadPoolSize },
+    { SINGLE_INPUT, SHARED_THREAD_POOL_TOKEN, "SharedThreadPoolSize", SetSharedThreadPoolSize },
+    { SINGLE_INPUT, MEMORY_BUDGET_TOKEN, "MemoryBudget", SetMemoryBudget },
     // Optional Features
     { SINGLE_INPUT, UNRESTRICTED_MOTION_VECTOR, "UnrestrictedMotionVector", SetUnrestrictedMotionVector },
 
@@ -413,6 +433,7 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->error_log_file                         = stderr;
     config_ptr->qp_file                               = NULL;
     config_ptr->stat_file                             = NULL;
+    config_ptr->trace_file                            = NULL;
 
     config_ptr->frame_rate                            = 30 << 16;
     config_ptr->frame_rate_numerator                   = 0;
@@ -427,6 +448,8 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->frames_to_be_encoded                 = 0;
     config_ptr->buffered_input                        = -1;
     config_ptr->sequence_buffer                       = 0;
+    config_ptr->input_mmap                            = EB_TRUE;
+    config_ptr->input_mmap_ptr                        = NULL;
     config_ptr->latency_mode                          = 0;
 
     // Interlaced Video
@@ -535,6 +558,9 @@ void eb_config_ctor(EbConfig *config_ptr)
     config_ptr->stop_encoder                          = 0;
     config_ptr->logical_processors                    = 0;
     config_ptr->target_socket                         = -1;
+    config_ptr->thread_pool_size                      = 0;
+    config_ptr->shared_thread_pool_size               = 0;
+    config_ptr->memory_budget_mb                      = 0;
     config_ptr->processed_frame_count                  = 0;
     config_ptr->processed_byte_count                   = 0;
     config_ptr->tile_rows                            = 0;
@@ -566,6 +592,7 @@ void eb_config_dtor(EbConfig *config_ptr)
     }
 
     if (config_ptr->input_file) {
+        input_mmap_close(config_ptr);
         if (!config_ptr->input_file_is_fifo)
             fclose(config_ptr->input_file);
         config_ptr->input_file = (FILE *) NULL;
@@ -595,6 +622,11 @@ void eb_config_dtor(EbConfig *config_ptr)
         fclose(config_ptr->stat_file);
         config_ptr->stat_file = (FILE *) NULL;
     }
+
+    if (config_ptr->trace_file) {
+        fclose(config_ptr->trace_file);
+        config_ptr->trace_file = (FILE *) NULL;
+    }
     return;
 }
 
@@ -867,6 +899,18 @@ static EbErrorType VerifySettings(EbConfig *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    // thread_pool_size
+    if (config->thread_pool_size < -1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid thread pool size [-1, 0, N], your input: %d\n", channelNumber + 1, config->thread_pool_size);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // shared_thread_pool_size
+    if (config->shared_thread_pool_size < -1) {
+        fprintf(config->error_log_file, "Error instance %u: Invalid shared thread pool size [-1, 0, N], your input: %d\n", channelNumber + 1, config->shared_thread_pool_size);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // Local Warped Motion
     if (config->enable_warped_motion != 0 && config->enable_warped_motion != 1) {
         fprintf(config->error_log_file, "Error instance %u: Invalid warped motion flag [0 - 1], your input: %d\n", channelNumber + 1, config->target_socket);
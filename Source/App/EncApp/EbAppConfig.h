@@ -118,6 +118,7 @@ extern    uint32_t                   app_malloc_count;
     printf("Total App Memory: %.2lf KB\n\n",*total_app_memory/(double)1024);
 
 #define MAX_CHANNEL_NUMBER      6
+#define TRACE_EVENT_COUNT       (1 << 18)
 #define MAX_NUM_TOKENS          200
 
 #ifdef _WIN32
@@ -171,6 +172,7 @@ typedef struct EbConfig
     FILE                    *recon_file;
     FILE                    *error_log_file;
     FILE                    *stat_file;
+    FILE                    *trace_file;
     FILE                    *buffer_file;
 
     FILE                    *qp_file;
@@ -201,6 +203,16 @@ typedef struct EbConfig
     int32_t                  buffered_input;
     uint8_t                **sequence_buffer;
 
+    /****************************************
+     * Memory mapped input, the input buffers
+     * point to the frames of the file
+     ****************************************/
+    EbBool                   input_mmap;
+    uint8_t                 *input_mmap_ptr;
+    uint64_t                 input_mmap_size;
+    uint64_t                 input_mmap_data_offset;   // first frame
+    uint64_t                 input_mmap_offset;        // next frame
+
     uint8_t                  latency_mode;
 
     /****************************************
@@ -333,6 +345,10 @@ typedef struct EbConfig
     uint32_t                active_channel_count;
     uint32_t                logical_processors;
     int32_t                 target_socket;
+    int32_t                 thread_pool_size;
+    int32_t                 shared_thread_pool_size;
+    EbSvtThreadPool        *thread_pool;          // shared by all the channels, NULL if not pooled
+    uint32_t                memory_budget_mb;
     EbBool                  stop_encoder;         // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t                processed_frame_count;
@@ -11,6 +11,7 @@
 
 #include "EbAppContext.h"
 #include "EbAppConfig.h"
+#include "EbAppInputMmap.h"
 
 #define INPUT_SIZE_576p_TH                0x90000        // 0.58 Million
 #define INPUT_SIZE_1080i_TH                0xB71B0        // 0.75 Million
@@ -212,8 +213,12 @@ EbErrorType CopyConfigurationParameters(
     callback_data->eb_enc_parameters.asm_type = config->asm_type;
     callback_data->eb_enc_parameters.logical_processors = config->logical_processors;
     callback_data->eb_enc_parameters.target_socket = config->target_socket;
+    callback_data->eb_enc_parameters.thread_pool_size = config->thread_pool_size;
+    callback_data->eb_enc_parameters.thread_pool = config->thread_pool;
+    callback_data->eb_enc_parameters.memory_budget_mb = config->memory_budget_mb;
     callback_data->eb_enc_parameters.unrestricted_motion_vector = config->unrestricted_motion_vector;
     callback_data->eb_enc_parameters.recon_enabled = config->recon_file ? EB_TRUE : EB_FALSE;
+    callback_data->eb_enc_parameters.trace_event_count = config->trace_file ? TRACE_EVENT_COUNT : 0;
     // --- start: ALTREF_FILTERING_SUPPORT
     callback_data->eb_enc_parameters.enable_altrefs  = (EbBool)config->enable_altrefs;
     callback_data->eb_enc_parameters.altref_strength = config->altref_strength;
@@ -325,8 +330,8 @@ EbErrorType AllocateInputBuffers(EbConfig *config, EbAppContext *callback_data)
                   sizeof(EbSvtIOFormat), EB_N_PTR,
                   EB_ErrorInsufficientResources);
 
-    // Allocate frame buffer for the p_buffer
-    if (config->buffered_input == -1)
+    // Allocate frame buffer for the p_buffer, a mapped input points it to the file
+    if (config->buffered_input == -1 && !config->input_mmap_ptr)
         AllocateFrameBuffer(config, callback_data->input_buffer_pool->p_buffer);
 
     // Assign the variables
@@ -594,7 +599,9 @@ EbErrorType init_encoder(
 
     ///********************** APPLICATION INIT [START] ******************///
 
-    // STEP 6: Allocate input buffers carrying the yuv frames in
+    // STEP 6: Allocate input buffers carrying the yuv frames in, unless the
+    // input file can be mapped and its frames handed to the library directly
+    input_mmap_open(config);
     return_error = AllocateInputBuffers(config, callback_data);
 
     if (return_error != EB_ErrorNone)
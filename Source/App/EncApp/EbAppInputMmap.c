@@ -0,0 +1,140 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "EbAppInputMmap.h"
+
+#define Y4M_FRAME_DELIMITER      "FRAME\n"
+#define Y4M_FRAME_DELIMITER_SIZE 6
+
+/* size of a frame in the input file */
+static uint32_t input_mmap_frame_size(EbConfig *cfg)
+{
+    const uint32_t luma_size = cfg->input_padded_width * cfg->input_padded_height;
+    const uint32_t chroma_size = luma_size >> (3 - cfg->encoder_color_format);
+
+    if (cfg->encoder_bit_depth > 8 && cfg->compressed_ten_bit_format == 1)
+        return luma_size + 2 * chroma_size + ((luma_size + 2 * chroma_size) >> 2);
+    return (luma_size + 2 * chroma_size) << (cfg->encoder_bit_depth > 8);
+}
+
+EbBool input_mmap_open(EbConfig *cfg)
+{
+    uint64_t  file_size;
+    uint64_t  data_offset;
+    uint64_t  frame_stride;
+    uint8_t  *map_ptr;
+
+    cfg->input_mmap_ptr = NULL;
+    if (!cfg->input_mmap || !cfg->input_file || cfg->input_file_is_fifo ||
+        cfg->separate_fields || cfg->buffered_input != -1)
+        return EB_FALSE;
+
+    // The y4m header is already parsed, the frames start here
+    data_offset = ftello(cfg->input_file);
+    fseeko(cfg->input_file, 0L, SEEK_END);
+    file_size = ftello(cfg->input_file);
+    fseeko(cfg->input_file, data_offset, SEEK_SET);
+
+    frame_stride = input_mmap_frame_size(cfg) + (cfg->y4m_input ? Y4M_FRAME_DELIMITER_SIZE : 0);
+    if (file_size < data_offset + frame_stride || file_size != (size_t)file_size)
+        return EB_FALSE;
+
+#ifdef _WIN32
+    {
+        HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(cfg->input_file));
+        HANDLE mapping_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping_handle)
+            return EB_FALSE;
+        map_ptr = (uint8_t*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        // The view keeps the mapping alive
+        CloseHandle(mapping_handle);
+        if (!map_ptr)
+            return EB_FALSE;
+    }
+#else
+    map_ptr = (uint8_t*)mmap(NULL, (size_t)file_size, PROT_READ, MAP_SHARED, fileno(cfg->input_file), 0);
+    if (map_ptr == (uint8_t*)MAP_FAILED)
+        return EB_FALSE;
+    // The frames are read in order, let the kernel read ahead of the encoder
+    madvise(map_ptr, (size_t)file_size, MADV_SEQUENTIAL);
+#endif
+
+    cfg->input_mmap_ptr = map_ptr;
+    cfg->input_mmap_size = file_size;
+    cfg->input_mmap_data_offset = data_offset;
+    cfg->input_mmap_offset = data_offset;
+
+    return EB_TRUE;
+}
+
+void input_mmap_close(EbConfig *cfg)
+{
+    if (!cfg->input_mmap_ptr)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(cfg->input_mmap_ptr);
+#else
+    munmap(cfg->input_mmap_ptr, (size_t)cfg->input_mmap_size);
+#endif
+    cfg->input_mmap_ptr = NULL;
+}
+
+uint32_t input_mmap_read_frame(EbConfig *cfg, EbSvtIOFormat *input_ptr)
+{
+    const uint32_t frame_size = input_mmap_frame_size(cfg);
+    const uint64_t frame_stride = frame_size + (cfg->y4m_input ? Y4M_FRAME_DELIMITER_SIZE : 0);
+    const uint32_t luma_size = (cfg->input_padded_width * cfg->input_padded_height) <<
+        (cfg->encoder_bit_depth > 8 && cfg->compressed_ten_bit_format == 0);
+    const uint32_t chroma_size = luma_size >> (3 - cfg->encoder_color_format);
+    uint8_t *frame_ptr;
+
+    // If we reached the end of file, loop over again
+    if (cfg->input_mmap_offset + frame_stride > cfg->input_mmap_size)
+        cfg->input_mmap_offset = cfg->input_mmap_data_offset;
+    frame_ptr = cfg->input_mmap_ptr + cfg->input_mmap_offset;
+    cfg->input_mmap_offset += frame_stride;
+
+    if (cfg->y4m_input) {
+        if (memcmp(frame_ptr, Y4M_FRAME_DELIMITER, Y4M_FRAME_DELIMITER_SIZE) != 0)
+            fprintf(cfg->error_log_file, "Failed to read proper y4m frame delimeter. Read broken.\n");
+        frame_ptr += Y4M_FRAME_DELIMITER_SIZE;
+    }
+
+#ifndef _WIN32
+    // Page in the next frame while the library copies this one
+    if (cfg->input_mmap_offset + frame_stride <= cfg->input_mmap_size) {
+        const uintptr_t page_mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+        uintptr_t next_ptr = (uintptr_t)(cfg->input_mmap_ptr + cfg->input_mmap_offset);
+        madvise((void*)(next_ptr & ~page_mask), (size_t)(frame_stride + (next_ptr & page_mask)), MADV_WILLNEED);
+    }
+#endif
+
+    input_ptr->luma = frame_ptr;
+    input_ptr->cb = frame_ptr + luma_size;
+    input_ptr->cr = frame_ptr + luma_size + chroma_size;
+    if (cfg->encoder_bit_depth > 8 && cfg->compressed_ten_bit_format == 1) {
+        // 2 bit planes follow the 8 bit ones, 4 pixels per byte
+        input_ptr->luma_ext = frame_ptr + luma_size + 2 * chroma_size;
+        input_ptr->cb_ext = input_ptr->luma_ext + (luma_size >> 2);
+        input_ptr->cr_ext = input_ptr->cb_ext + (chroma_size >> 2);
+    } else {
+        input_ptr->luma_ext = NULL;
+        input_ptr->cb_ext = NULL;
+        input_ptr->cr_ext = NULL;
+    }
+
+    return frame_size;
+}
@@ -0,0 +1,21 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbAppInputMmap_h
+#define EbAppInputMmap_h
+
+#include "EbAppConfig.h"
+
+/* maps the input file in memory, returns EB_FALSE when the input has to be
+   read with fread (fifo, interlaced fields, preloaded frames, no full frame) */
+EbBool input_mmap_open(EbConfig *cfg);
+
+void input_mmap_close(EbConfig *cfg);
+
+/* points the input buffer to the next frame of the mapped file and returns
+   the frame size, looping to the first frame at the end of the file */
+uint32_t input_mmap_read_frame(EbConfig *cfg, EbSvtIOFormat *input_ptr);
+
+#endif // EbAppInputMmap_h
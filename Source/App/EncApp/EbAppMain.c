@@ -76,6 +76,108 @@ void AssignAppThreadGroup(uint8_t target_socket) {
 
 double get_psnr(double sse, double max);
 
+/***************************************
+ * write_trace
+ *   Writes the pipeline trace of a channel
+ *   in the Chrome trace event format, one
+ *   thread per kernel thread, and prints
+ *   the load of every stage
+ ***************************************/
+#define TRACE_MAX_STAGES 32
+static void write_trace(
+    EbConfig             *config,
+    EbAppContext         *appCallback,
+    uint32_t              channel)
+{
+    const EbTraceEvent *events;
+    uint32_t            event_count;
+    uint32_t            thread_count = 0;
+    uint64_t            trace_end_us = 0;
+    EbBool             *thread_named;
+    const char         *stage_names[TRACE_MAX_STAGES];
+    uint32_t            stage_count = 0;
+    uint32_t            stage_inputs[TRACE_MAX_STAGES] = { 0 };
+    uint64_t            stage_busy_us[TRACE_MAX_STAGES] = { 0 };
+    uint64_t            stage_wait_us[TRACE_MAX_STAGES] = { 0 };
+    uint64_t            stage_stall_us[TRACE_MAX_STAGES] = { 0 };
+    uint64_t            stage_depth[TRACE_MAX_STAGES] = { 0 };
+    uint32_t            stage_threads[TRACE_MAX_STAGES] = { 0 };
+    uint32_t            i, stage;
+
+    if (eb_svt_get_trace(appCallback->svt_encoder_handle, &events, &event_count) != EB_ErrorNone || !events)
+        return;
+
+    for (i = 0; i < event_count; i++) {
+        if (events[i].thread_index >= thread_count)
+            thread_count = events[i].thread_index + 1;
+        if (events[i].end_us > trace_end_us)
+            trace_end_us = events[i].end_us;
+    }
+    thread_named = (EbBool*)calloc(thread_count ? thread_count : 1, sizeof(EbBool));
+    if (!thread_named)
+        return;
+
+    fprintf(config->trace_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (i = 0; i < event_count; i++) {
+        const EbTraceEvent *event = &events[i];
+
+        for (stage = 0; stage < stage_count && stage_names[stage] != event->stage; stage++);
+        if (stage == stage_count && stage_count < TRACE_MAX_STAGES)
+            stage_names[stage_count++] = event->stage;
+
+        if (!thread_named[event->thread_index]) {
+            // The first input of a thread gives its stage
+            thread_named[event->thread_index] = EB_TRUE;
+            fprintf(config->trace_file,
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}},\n",
+                channel + 1, event->thread_index, event->stage, event->thread_index);
+            if (stage < stage_count)
+                stage_threads[stage]++;
+        }
+        if (event->start_us > event->wait_start_us)
+            fprintf(config->trace_file,
+                "{\"name\":\"wait\",\"cat\":\"wait\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%llu,\"dur\":%llu},\n",
+                channel + 1, event->thread_index,
+                (unsigned long long)event->wait_start_us,
+                (unsigned long long)(event->start_us - event->wait_start_us));
+        fprintf(config->trace_file,
+            "{\"name\":\"%s\",\"cat\":\"process\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%llu,\"dur\":%llu,"
+            "\"args\":{\"picture\":%llu,\"queue_depth\":%u,\"stall_us\":%llu}}%s\n",
+            event->stage, channel + 1, event->thread_index,
+            (unsigned long long)event->start_us,
+            (unsigned long long)(event->end_us - event->start_us),
+            (unsigned long long)event->picture_number,
+            event->queue_depth,
+            (unsigned long long)event->stall_us,
+            i + 1 < event_count ? "," : "");
+
+        if (stage < stage_count) {
+            stage_inputs[stage]++;
+            stage_busy_us[stage] += event->end_us - event->start_us - event->stall_us;
+            stage_wait_us[stage] += event->start_us - event->wait_start_us;
+            stage_stall_us[stage] += event->stall_us;
+            stage_depth[stage] += event->queue_depth;
+        }
+    }
+    fprintf(config->trace_file, "]}\n");
+    free(thread_named);
+
+    printf("\nTRACE ----------------------------------- Channel %u  --------------------------------\n", channel + 1);
+    printf("%-28s%8s%8s%12s%12s%12s%8s%8s\n", "Stage", "Threads", "Inputs", "Busy ms", "Wait ms", "Stall ms", "Depth", "Load");
+    for (stage = 0; stage < stage_count; stage++) {
+        printf("%-28s%8u%8u%12.1f%12.1f%12.1f%8.2f%7.0f%%\n",
+            stage_names[stage],
+            stage_threads[stage],
+            stage_inputs[stage],
+            stage_busy_us[stage] / 1000.0,
+            stage_wait_us[stage] / 1000.0,
+            stage_stall_us[stage] / 1000.0,
+            (double)stage_depth[stage] / stage_inputs[stage],
+            trace_end_us ? 100.0 * stage_busy_us[stage] / ((double)trace_end_us * stage_threads[stage]) : 0.0);
+    }
+    fflush(stdout);
+}
+
 /***************************************
  * Encoder App Main
  ***************************************/
@@ -102,6 +204,7 @@ int32_t main(int32_t argc, char* argv[])
     uint32_t                num_channels = 0;
     uint32_t                instanceCount=0;
     EbAppContext         *appCallbacks[MAX_CHANNEL_NUMBER];   // Instances App callback data
+    EbSvtThreadPool      *thread_pool = NULL;                 // Run slots shared by the channels
     signal(SIGINT, EventHandler);
     printf("-------------------------------------------\n");
     printf("SVT-AV1 Encoder\n");
@@ -150,11 +253,19 @@ int32_t main(int32_t argc, char* argv[])
             if (configs[0]->target_socket != -1)
                 AssignAppThreadGroup(configs[0]->target_socket);
 
+            // Share one thread pool between the channels, sized by the first one
+            if (configs[0]->shared_thread_pool_size != 0) {
+                return_error = eb_svt_create_thread_pool(&thread_pool, configs[0]->shared_thread_pool_size);
+                if (return_error != EB_ErrorNone)
+                    printf("Could not create the shared thread pool\n");
+            }
+
             // Init the Encoder
             for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
                 if (return_errors[instanceCount] == EB_ErrorNone) {
                     configs[instanceCount]->active_channel_count = num_channels;
                     configs[instanceCount]->channel_id = instanceCount;
+                    configs[instanceCount]->thread_pool = thread_pool;
 
                     StartTime((uint64_t*)&configs[instanceCount]->performance_context.lib_start_time[0], (uint64_t*)&configs[instanceCount]->performance_context.lib_start_time[1]);
 
@@ -333,11 +444,18 @@ int32_t main(int32_t argc, char* argv[])
                 else
                     printf("Error encoding at channel %u! Check error log file for more details ... \n", instanceCount + 1);
             }
+            // Write the pipeline traces
+            for (instanceCount = 0; instanceCount < num_channels; ++instanceCount) {
+                if (return_errors[instanceCount] == EB_ErrorNone && configs[instanceCount]->trace_file)
+                    write_trace(configs[instanceCount], appCallbacks[instanceCount], instanceCount);
+            }
             // DeInit Encoder
             for (instanceCount = num_channels; instanceCount > 0; --instanceCount) {
                 if (return_errors[instanceCount - 1] == EB_ErrorNone)
                     return_errors[instanceCount - 1] = de_init_encoder(appCallbacks[instanceCount - 1], instanceCount - 1);
             }
+            if (thread_pool)
+                eb_svt_destroy_thread_pool(thread_pool);
         }
         else {
             printf("Error in configuration, could not begin encoding! ... \n");
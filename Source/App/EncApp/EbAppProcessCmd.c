@@ -14,6 +14,7 @@
 #include "EbAppConfig.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputMmap.h"
 
 #include "EbTime.h"
 
@@ -224,6 +225,10 @@ void LogErrorOutput(
         fprintf(error_log_file, "Error: No more than 6 SAO types\n");
         break;
 
+    case EB_ENC_EC_ERROR30:
+        fprintf(error_log_file, "Error: EncodeSliceFinish: tile buffer could not be grown!\n");
+        break;
+
         // EB_ENC_FL_ERRORS:
     case EB_ENC_FL_ERROR1:
         fprintf(error_log_file, "Error: Uncovered area inside Cu!\n");
@@ -406,6 +411,9 @@ void LogErrorOutput(
     case EB_ENC_PACKETIZATION_ERROR5:
         fprintf(error_log_file, "Error: Stream Fifo is starving..deadlock, increase EB_outputStreamBufferFifoInitCount APP_ENCODERSTREAMBUFFERCOUNT \n");
         break;
+    case EB_ENC_PACKETIZATION_ERROR6:
+        fprintf(error_log_file, "Error: Output Stream Buffer could not be grown!\n");
+        break;
 
         // EB_ENC_PM_ERRORS:
     case EB_ENC_PM_ERROR0:
@@ -750,7 +758,10 @@ void ReadInputFrames(
     inputPtr->cr_stride = input_padded_width >> subsampling_x;
     inputPtr->cb_stride = input_padded_width >> subsampling_x;
 
-    if (config->buffered_input == -1) {
+    if (config->input_mmap_ptr) {
+        // Hand the frame of the mapped file to the library, no read and no copy here
+        headerPtr->n_filled_len = input_mmap_read_frame(config, inputPtr);
+    } else if (config->buffered_input == -1) {
         if (is16bit == 0 || (is16bit == 1 && config->compressed_ten_bit_format == 0)) {
             readSize = (uint64_t)SIZE_OF_ONE_FRAME_IN_BYTES(input_padded_width, input_padded_height, color_format, is16bit);
 
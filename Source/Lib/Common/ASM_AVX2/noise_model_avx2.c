@@ -0,0 +1,124 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "noise_model.h"
+#include "mathutils.h"
+#include "aom_dsp_rtcd.h"
+
+#define kLowPolyNumParams 3
+
+/* Converts 4 samples of a row to normalized doubles */
+static INLINE __m256d load_normalized_pd(const uint8_t *data, int32_t x,
+                                         int32_t use_highbd,
+                                         __m256d normalization)
+{
+    __m128i v;
+
+    if (use_highbd)
+        v = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)((const uint16_t *)data + x)));
+    else
+        v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)(data + x)));
+    return _mm256_div_pd(_mm256_cvtepi32_pd(v), normalization);
+}
+
+/* Same as eb_aom_flat_block_finder_extract_block_c(), the products keep
+   the order of the C matrix multiplications so the results are identical */
+void eb_aom_flat_block_finder_extract_block_avx2(
+    const aom_flat_block_finder_t *block_finder, const uint8_t *const data,
+    int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy,
+    double *plane, double *block)
+{
+    const int32_t block_size = block_finder->block_size;
+    const int32_t n = block_size * block_size;
+    const int32_t use_highbd = block_finder->use_highbd;
+    const double *A = block_finder->A;
+    const double *AtA_inv = block_finder->AtA_inv;
+    const __m256d normalization = _mm256_set1_pd(block_finder->normalization);
+    const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+    const __m128i stride3 = _mm_setr_epi32(0, 3, 6, 9);
+    DECLARE_ALIGNED(32, double, AtA_inv_b[4]);
+    double plane_coords[kLowPolyNumParams];
+    __m256d sum;
+    int32_t xi, yi, i;
+
+    for (yi = 0; yi < block_size; ++yi) {
+        const int32_t y = clamp(offsy + yi, 0, h - 1);
+        const uint8_t *row = data + (((intptr_t)y * stride) << use_highbd);
+        double *block_row = block + yi * block_size;
+
+        for (xi = 0; xi < block_size; ++xi) {
+            const int32_t x = offsx + xi;
+
+            if (x >= 0 && x + 4 <= w && xi + 4 <= block_size) {
+                _mm256_storeu_pd(block_row + xi,
+                    load_normalized_pd(row, x, use_highbd, normalization));
+                xi += 3;
+            }
+            else {
+                const int32_t xc = clamp(x, 0, w - 1);
+                block_row[xi] = (use_highbd ? ((const uint16_t *)row)[xc] :
+                    row[xc]) / block_finder->normalization;
+            }
+        }
+    }
+
+    /* block * A, the 3 columns in the lanes of one register */
+    sum = _mm256_setzero_pd();
+    for (i = 0; i < n; ++i) {
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_broadcast_sd(block + i),
+                                               _mm256_maskload_pd(A + 3 * i, mask)));
+    }
+    _mm256_store_pd(AtA_inv_b, sum);
+    multiply_mat(AtA_inv, AtA_inv_b, plane_coords, kLowPolyNumParams,
+                 kLowPolyNumParams, 1);
+
+    /* A * plane_coords, 4 rows of A at a time */
+    const __m256d c0 = _mm256_set1_pd(plane_coords[0]);
+    const __m256d c1 = _mm256_set1_pd(plane_coords[1]);
+    const __m256d c2 = _mm256_set1_pd(plane_coords[2]);
+    for (i = 0; i + 4 <= n; i += 4) {
+        const double *a = A + 3 * i;
+        __m256d p = _mm256_add_pd(_mm256_setzero_pd(),
+            _mm256_mul_pd(_mm256_i32gather_pd(a, stride3, 8), c0));
+        p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_i32gather_pd(a + 1, stride3, 8), c1));
+        p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_i32gather_pd(a + 2, stride3, 8), c2));
+        _mm256_storeu_pd(plane + i, p);
+        _mm256_storeu_pd(block + i, _mm256_sub_pd(_mm256_loadu_pd(block + i), p));
+    }
+    for (; i < n; ++i) {
+        double p = 0;
+        p += A[3 * i] * plane_coords[0];
+        p += A[3 * i + 1] * plane_coords[1];
+        p += A[3 * i + 2] * plane_coords[2];
+        plane[i] = p;
+        block[i] -= p;
+    }
+}
+
+void eb_aom_noise_model_add_observation_avx2(double *A, double *b,
+    const double *buffer, double val, int32_t n, double normalization)
+{
+    const double norm2 = normalization * normalization;
+    const __m256d norm2_pd = _mm256_set1_pd(norm2);
+
+    for (int32_t i = 0; i < n; ++i) {
+        const __m256d bi = _mm256_set1_pd(buffer[i]);
+        double *a_row = A + i * n;
+        int32_t j = 0;
+
+        for (; j + 4 <= n; j += 4) {
+            __m256d prod = _mm256_div_pd(
+                _mm256_mul_pd(bi, _mm256_loadu_pd(buffer + j)), norm2_pd);
+            _mm256_storeu_pd(a_row + j,
+                             _mm256_add_pd(_mm256_loadu_pd(a_row + j), prod));
+        }
+        for (; j < n; ++j)
+            a_row[j] += (buffer[i] * buffer[j]) / norm2;
+        b[i] += (buffer[i] * val) / norm2;
+    }
+}
@@ -0,0 +1,538 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <smmintrin.h>
+
+#include "EbDefinitions.h"
+#include "grainSynthesis.h"
+#include "aom_dsp_rtcd.h"
+
+/* Noise parameters of the block, broadcast */
+typedef struct NoiseParamsSse4 {
+    __m128i rounding_offset;
+    __m128i scaling_shift;
+    __m128i min_luma;
+    __m128i max_luma;
+    __m128i min_chroma;
+    __m128i max_chroma;
+    __m128i max_index;
+    __m128i cb_mult;
+    __m128i cb_luma_mult;
+    __m128i cb_offset;
+    __m128i cr_mult;
+    __m128i cr_luma_mult;
+    __m128i cr_offset;
+    /* Bit depth of the samples looked up in the scaling functions */
+    int32_t lut_bit_depth;
+} NoiseParamsSse4;
+
+static void init_noise_params(const FilmGrainCtxt *ctxt, int32_t hbd,
+                              NoiseParamsSse4 *np)
+{
+    int32_t bit_depth = ctxt->params->bit_depth;
+
+    np->rounding_offset = _mm_set1_epi32(ctxt->rounding_offset);
+    np->scaling_shift = _mm_cvtsi32_si128(ctxt->scaling_shift);
+    np->min_luma = _mm_set1_epi32(ctxt->min_luma);
+    np->max_luma = _mm_set1_epi32(ctxt->max_luma);
+    np->min_chroma = _mm_set1_epi32(ctxt->min_chroma);
+    np->max_chroma = _mm_set1_epi32(ctxt->max_chroma);
+    np->max_index = _mm_set1_epi32((256 << (bit_depth - 8)) - 1);
+    np->cb_mult = _mm_set1_epi32(ctxt->cb_mult);
+    np->cb_luma_mult = _mm_set1_epi32(ctxt->cb_luma_mult);
+    np->cb_offset = _mm_set1_epi32(ctxt->cb_offset);
+    np->cr_mult = _mm_set1_epi32(ctxt->cr_mult);
+    np->cr_luma_mult = _mm_set1_epi32(ctxt->cr_luma_mult);
+    np->cr_offset = _mm_set1_epi32(ctxt->cr_offset);
+    np->lut_bit_depth = hbd ? bit_depth : 8;
+}
+
+static INLINE __m128i load_samples_epi32(const uint8_t *src, int32_t hbd)
+{
+    if (hbd)
+        return _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)src));
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)src));
+}
+
+static INLINE void store_samples_epi32(uint8_t *dst, __m128i v, int32_t hbd)
+{
+    __m128i v16 = _mm_packus_epi32(v, v);
+    if (hbd)
+        _mm_storel_epi64((__m128i *)dst, v16);
+    else
+        *(int32_t *)dst = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+}
+
+/* Sums of 4 pairs of horizontal luma samples */
+static INLINE __m128i load_luma_pairs_epi32(const uint8_t *src, int32_t hbd)
+{
+    __m128i luma = hbd ? _mm_loadu_si128((const __m128i *)src) :
+        _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)src));
+    return _mm_madd_epi16(luma, _mm_set1_epi16(1));
+}
+
+/* scale_LUT() of 4 samples, the lookups are scalar */
+static INLINE __m128i scale_lut_sse4_1(const int32_t *scaling_lut,
+                                       __m128i index, int32_t bit_depth)
+{
+    int32_t idx[4];
+    int32_t res[4];
+    const int32_t shift = bit_depth - 8;
+
+    _mm_storeu_si128((__m128i *)idx, index);
+    for (int32_t k = 0; k < 4; k++) {
+        int32_t x = idx[k] >> shift;
+
+        if (!shift || x == 255)
+            res[k] = scaling_lut[x];
+        else {
+            res[k] = scaling_lut[x] + (((scaling_lut[x + 1] - scaling_lut[x]) *
+                (idx[k] & ((1 << shift) - 1)) + (1 << (shift - 1))) >> shift);
+        }
+    }
+    return _mm_loadu_si128((const __m128i *)res);
+}
+
+static INLINE __m128i add_noise_epi32(const NoiseParamsSse4 *np, __m128i orig,
+                                      __m128i scale, __m128i grain,
+                                      __m128i min, __m128i max)
+{
+    __m128i noise = _mm_sra_epi32(_mm_add_epi32(
+        _mm_mullo_epi32(scale, grain), np->rounding_offset),
+        np->scaling_shift);
+    return _mm_min_epi32(_mm_max_epi32(_mm_add_epi32(orig, noise), min), max);
+}
+
+static INLINE __m128i chroma_noise_epi32(const NoiseParamsSse4 *np,
+                                         const int32_t *scaling_lut,
+                                         __m128i average_luma, __m128i orig,
+                                         __m128i grain, __m128i luma_mult,
+                                         __m128i mult, __m128i offset)
+{
+    __m128i index = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(
+        _mm_mullo_epi32(average_luma, luma_mult),
+        _mm_mullo_epi32(mult, orig)), 6), offset);
+    index = _mm_min_epi32(_mm_max_epi32(index, _mm_setzero_si128()),
+                          np->max_index);
+
+    return add_noise_epi32(np, orig,
+        scale_lut_sse4_1(scaling_lut, index, np->lut_bit_depth), grain,
+        np->min_chroma, np->max_chroma);
+}
+
+static INLINE void add_noise_luma_4(const FilmGrainCtxt *ctxt,
+                                    const NoiseParamsSse4 *np,
+                                    const uint8_t *src, uint8_t *dst,
+                                    const int32_t *grain, int32_t hbd)
+{
+    __m128i orig = load_samples_epi32(src, hbd);
+    __m128i scale = scale_lut_sse4_1(ctxt->scaling_lut_y, orig,
+                                     np->lut_bit_depth);
+
+    store_samples_epi32(dst, add_noise_epi32(np, orig, scale,
+        _mm_loadu_si128((const __m128i *)grain), np->min_luma,
+        np->max_luma), hbd);
+}
+
+static void add_noise_luma_row(const FilmGrainCtxt *ctxt,
+                               const NoiseParamsSse4 *np, const uint8_t *src,
+                               uint8_t *dst, const int32_t *grain,
+                               int32_t width, int32_t hbd)
+{
+    int32_t j = 0;
+
+    for (; j + 4 <= width; j += 4) {
+        add_noise_luma_4(ctxt, np, src + (j << hbd), dst + (j << hbd),
+                         grain + j, hbd);
+    }
+
+    /* The last samples go through a copy, dst may be src */
+    if (j < width) {
+        uint16_t src_buf[4] = { 0 };
+        uint16_t dst_buf[4];
+        int32_t grain_buf[4] = { 0 };
+        int32_t n = width - j;
+
+        memcpy(src_buf, src + (j << hbd), n << hbd);
+        memcpy(grain_buf, grain + j, n * sizeof(*grain));
+        add_noise_luma_4(ctxt, np, (const uint8_t *)src_buf,
+                         (uint8_t *)dst_buf, grain_buf, hbd);
+        memcpy(dst + (j << hbd), dst_buf, n << hbd);
+    }
+}
+
+static INLINE void add_noise_chroma_4(const FilmGrainCtxt *ctxt,
+                                      const NoiseParamsSse4 *np,
+                                      const uint8_t *src_luma,
+                                      const uint8_t *src_cb,
+                                      const uint8_t *src_cr,
+                                      uint8_t *cb, uint8_t *cr,
+                                      const int32_t *cb_grain,
+                                      const int32_t *cr_grain, int32_t hbd)
+{
+    __m128i average_luma;
+
+    if (ctxt->chroma_subsamp_x) {
+        average_luma = _mm_srli_epi32(_mm_add_epi32(
+            load_luma_pairs_epi32(src_luma, hbd), _mm_set1_epi32(1)), 1);
+    }
+    else
+        average_luma = load_samples_epi32(src_luma, hbd);
+
+    if (ctxt->apply_cb) {
+        store_samples_epi32(cb, chroma_noise_epi32(np, ctxt->scaling_lut_cb,
+            average_luma, load_samples_epi32(src_cb, hbd),
+            _mm_loadu_si128((const __m128i *)cb_grain), np->cb_luma_mult,
+            np->cb_mult, np->cb_offset), hbd);
+    }
+    if (ctxt->apply_cr) {
+        store_samples_epi32(cr, chroma_noise_epi32(np, ctxt->scaling_lut_cr,
+            average_luma, load_samples_epi32(src_cr, hbd),
+            _mm_loadu_si128((const __m128i *)cr_grain), np->cr_luma_mult,
+            np->cr_mult, np->cr_offset), hbd);
+    }
+}
+
+static void add_noise_chroma_row(const FilmGrainCtxt *ctxt,
+                                 const NoiseParamsSse4 *np,
+                                 const uint8_t *src_luma,
+                                 const uint8_t *src_cb, const uint8_t *src_cr,
+                                 uint8_t *cb, uint8_t *cr,
+                                 const int32_t *cb_grain,
+                                 const int32_t *cr_grain, int32_t width,
+                                 int32_t hbd)
+{
+    int32_t sx = ctxt->chroma_subsamp_x;
+    int32_t j = 0;
+
+    for (; j + 4 <= width; j += 4) {
+        add_noise_chroma_4(ctxt, np, src_luma + ((j << sx) << hbd),
+                           src_cb + (j << hbd), src_cr + (j << hbd),
+                           cb + (j << hbd), cr + (j << hbd), cb_grain + j,
+                           cr_grain + j, hbd);
+    }
+
+    /* The last samples go through a copy, dst may be src */
+    if (j < width) {
+        uint16_t luma_buf[8] = { 0 };
+        uint16_t src_cb_buf[4] = { 0 };
+        uint16_t src_cr_buf[4] = { 0 };
+        uint16_t cb_buf[4];
+        uint16_t cr_buf[4];
+        int32_t cb_grain_buf[4] = { 0 };
+        int32_t cr_grain_buf[4] = { 0 };
+        int32_t n = width - j;
+
+        memcpy(luma_buf, src_luma + ((j << sx) << hbd), (n << sx) << hbd);
+        if (ctxt->apply_cb) {
+            memcpy(src_cb_buf, src_cb + (j << hbd), n << hbd);
+            memcpy(cb_grain_buf, cb_grain + j, n * sizeof(*cb_grain));
+        }
+        if (ctxt->apply_cr) {
+            memcpy(src_cr_buf, src_cr + (j << hbd), n << hbd);
+            memcpy(cr_grain_buf, cr_grain + j, n * sizeof(*cr_grain));
+        }
+        add_noise_chroma_4(ctxt, np, (const uint8_t *)luma_buf,
+                           (const uint8_t *)src_cb_buf,
+                           (const uint8_t *)src_cr_buf, (uint8_t *)cb_buf,
+                           (uint8_t *)cr_buf, cb_grain_buf, cr_grain_buf, hbd);
+        if (ctxt->apply_cb)
+            memcpy(cb + (j << hbd), cb_buf, n << hbd);
+        if (ctxt->apply_cr)
+            memcpy(cr + (j << hbd), cr_buf, n << hbd);
+    }
+}
+
+/* Same as eb_av1_add_noise_to_block_c(), 4 samples of a row at a time.
+   Pointers are to samples of 1 << hbd bytes */
+static void add_noise_to_block_sse4_1(const FilmGrainCtxt *ctxt,
+                                      const uint8_t *src_luma,
+                                      const uint8_t *src_cb,
+                                      const uint8_t *src_cr, uint8_t *luma,
+                                      uint8_t *cb, uint8_t *cr,
+                                      int32_t *luma_grain, int32_t *cb_grain,
+                                      int32_t *cr_grain,
+                                      int32_t luma_grain_stride,
+                                      int32_t chroma_grain_stride,
+                                      int32_t half_luma_height,
+                                      int32_t half_luma_width, int32_t hbd)
+{
+    int32_t sy = ctxt->chroma_subsamp_y;
+    int32_t sx = ctxt->chroma_subsamp_x;
+    NoiseParamsSse4 np;
+
+    init_noise_params(ctxt, hbd, &np);
+
+    if (ctxt->apply_cb || ctxt->apply_cr) {
+        int32_t chroma_height = half_luma_height << (1 - sy);
+        int32_t chroma_width = half_luma_width << (1 - sx);
+        intptr_t src_chroma_stride = (intptr_t)ctxt->src_chroma_stride << hbd;
+        intptr_t chroma_stride = (intptr_t)ctxt->chroma_stride << hbd;
+
+        for (int32_t i = 0; i < chroma_height; i++) {
+            add_noise_chroma_row(ctxt, &np,
+                src_luma + (((intptr_t)(i << sy) * ctxt->src_luma_stride) << hbd),
+                ctxt->apply_cb ? src_cb + i * src_chroma_stride : NULL,
+                ctxt->apply_cr ? src_cr + i * src_chroma_stride : NULL,
+                ctxt->apply_cb ? cb + i * chroma_stride : NULL,
+                ctxt->apply_cr ? cr + i * chroma_stride : NULL,
+                cb_grain + i * chroma_grain_stride,
+                cr_grain + i * chroma_grain_stride, chroma_width, hbd);
+        }
+    }
+
+    if (ctxt->apply_y) {
+        intptr_t src_luma_stride = (intptr_t)ctxt->src_luma_stride << hbd;
+        intptr_t luma_stride = (intptr_t)ctxt->luma_stride << hbd;
+
+        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
+            add_noise_luma_row(ctxt, &np, src_luma + i * src_luma_stride,
+                               luma + i * luma_stride,
+                               luma_grain + i * luma_grain_stride,
+                               half_luma_width << 1, hbd);
+        }
+    }
+}
+
+void eb_av1_add_noise_to_block_sse4_1(const FilmGrainCtxt *ctxt,
+                                      const uint8_t *src_luma,
+                                      const uint8_t *src_cb,
+                                      const uint8_t *src_cr, uint8_t *luma,
+                                      uint8_t *cb, uint8_t *cr,
+                                      int32_t *luma_grain, int32_t *cb_grain,
+                                      int32_t *cr_grain,
+                                      int32_t luma_grain_stride,
+                                      int32_t chroma_grain_stride,
+                                      int32_t half_luma_height,
+                                      int32_t half_luma_width)
+{
+    add_noise_to_block_sse4_1(ctxt, src_luma, src_cb, src_cr, luma, cb, cr,
+                              luma_grain, cb_grain, cr_grain,
+                              luma_grain_stride, chroma_grain_stride,
+                              half_luma_height, half_luma_width, 0);
+}
+
+void eb_av1_add_noise_to_block_hbd_sse4_1(const FilmGrainCtxt *ctxt,
+                                          const uint16_t *src_luma,
+                                          const uint16_t *src_cb,
+                                          const uint16_t *src_cr,
+                                          uint16_t *luma, uint16_t *cb,
+                                          uint16_t *cr, int32_t *luma_grain,
+                                          int32_t *cb_grain,
+                                          int32_t *cr_grain,
+                                          int32_t luma_grain_stride,
+                                          int32_t chroma_grain_stride,
+                                          int32_t half_luma_height,
+                                          int32_t half_luma_width)
+{
+    add_noise_to_block_sse4_1(ctxt, (const uint8_t *)src_luma,
+                              (const uint8_t *)src_cb,
+                              (const uint8_t *)src_cr, (uint8_t *)luma,
+                              (uint8_t *)cb, (uint8_t *)cr, luma_grain,
+                              cb_grain, cr_grain, luma_grain_stride,
+                              chroma_grain_stride, half_luma_height,
+                              half_luma_width, 1);
+}
+
+/* Taps of the auto-regressive filter. The rows above the current one are
+   final, their taps are applied 4 samples at a time. The taps of the
+   current row are applied sample by sample */
+typedef struct ArTaps {
+    int32_t num_above;
+    int32_t above_offset[24];
+    int32_t above_coeff[24];
+    int32_t num_left;
+    int32_t left_offset[3];
+    int32_t left_coeff[3];
+    /* Coefficient of the co-located luma grain, chroma only */
+    int32_t luma_coeff;
+} ArTaps;
+
+static void init_ar_taps(const int32_t *ar_coeffs, int32_t **pred_pos,
+                         int32_t num_pos, int32_t stride, ArTaps *taps)
+{
+    taps->num_above = 0;
+    taps->num_left = 0;
+    taps->luma_coeff = 0;
+    for (int32_t pos = 0; pos < num_pos; pos++) {
+        if (pred_pos[pos][2] == 1)
+            taps->luma_coeff = ar_coeffs[pos];
+        else if (pred_pos[pos][0] < 0) {
+            taps->above_offset[taps->num_above] =
+                pred_pos[pos][0] * stride + pred_pos[pos][1];
+            taps->above_coeff[taps->num_above++] = ar_coeffs[pos];
+        }
+        else {
+            taps->left_offset[taps->num_left] = pred_pos[pos][1];
+            taps->left_coeff[taps->num_left++] = ar_coeffs[pos];
+        }
+    }
+}
+
+/* Filters the samples [j_start, j_end) of a row of a grain template. wsum
+   is a scratch row, av_luma the average luma grain of the row or NULL */
+static void ar_filter_row(int32_t *row, const ArTaps *taps,
+                          const int32_t *av_luma, int32_t j_start,
+                          int32_t j_end, int32_t *wsum,
+                          int32_t rounding_offset, int32_t ar_coeff_shift,
+                          int32_t grain_min, int32_t grain_max)
+{
+    int32_t j = j_start;
+
+    for (; j + 4 <= j_end; j += 4) {
+        __m128i sum = _mm_setzero_si128();
+        for (int32_t k = 0; k < taps->num_above; k++) {
+            sum = _mm_add_epi32(sum, _mm_mullo_epi32(
+                _mm_set1_epi32(taps->above_coeff[k]),
+                _mm_loadu_si128((const __m128i *)(row + j +
+                                                  taps->above_offset[k]))));
+        }
+        if (av_luma) {
+            sum = _mm_add_epi32(sum, _mm_mullo_epi32(
+                _mm_set1_epi32(taps->luma_coeff),
+                _mm_loadu_si128((const __m128i *)(av_luma + j))));
+        }
+        _mm_storeu_si128((__m128i *)(wsum + j), sum);
+    }
+    for (; j < j_end; j++) {
+        int32_t sum = 0;
+        for (int32_t k = 0; k < taps->num_above; k++)
+            sum += taps->above_coeff[k] * row[j + taps->above_offset[k]];
+        if (av_luma)
+            sum += taps->luma_coeff * av_luma[j];
+        wsum[j] = sum;
+    }
+
+    for (j = j_start; j < j_end; j++) {
+        int32_t sum = wsum[j];
+        for (int32_t k = 0; k < taps->num_left; k++)
+            sum += taps->left_coeff[k] * row[j + taps->left_offset[k]];
+        row[j] = clamp(row[j] + ((sum + rounding_offset) >> ar_coeff_shift),
+                       grain_min, grain_max);
+    }
+}
+
+/* Average of the luma grain co-located with the chroma samples
+   [j_start, j_end) of a row */
+static void average_luma_row(const int32_t *luma_row,
+                             int32_t luma_grain_stride, int32_t left_pad,
+                             int32_t j_start, int32_t j_end,
+                             int32_t chroma_subsamp_y,
+                             int32_t chroma_subsamp_x, int32_t *av_luma)
+{
+    const int32_t sx = chroma_subsamp_x;
+    const int32_t sy = chroma_subsamp_y;
+    const int32_t *luma_row_1 = luma_row + luma_grain_stride;
+    const __m128i round = _mm_set1_epi32((1 << (sx + sy)) >> 1);
+    const __m128i shift = _mm_cvtsi32_si128(sx + sy);
+    int32_t j = j_start;
+
+    for (; j + 4 <= j_end; j += 4) {
+        int32_t l = ((j - left_pad) << sx) + left_pad;
+        __m128i sum;
+
+        if (sx) {
+            sum = _mm_hadd_epi32(
+                _mm_loadu_si128((const __m128i *)(luma_row + l)),
+                _mm_loadu_si128((const __m128i *)(luma_row + l + 4)));
+            if (sy) {
+                sum = _mm_add_epi32(sum, _mm_hadd_epi32(
+                    _mm_loadu_si128((const __m128i *)(luma_row_1 + l)),
+                    _mm_loadu_si128((const __m128i *)(luma_row_1 + l + 4))));
+            }
+        }
+        else {
+            sum = _mm_loadu_si128((const __m128i *)(luma_row + l));
+            if (sy) {
+                sum = _mm_add_epi32(sum,
+                    _mm_loadu_si128((const __m128i *)(luma_row_1 + l)));
+            }
+        }
+        _mm_storeu_si128((__m128i *)(av_luma + j),
+                         _mm_sra_epi32(_mm_add_epi32(sum, round), shift));
+    }
+    for (; j < j_end; j++) {
+        int32_t l = ((j - left_pad) << sx) + left_pad;
+        int32_t sum = 0;
+
+        for (int32_t k = 0; k <= sy; k++)
+            for (int32_t m = 0; m <= sx; m++)
+                sum += luma_row[k * luma_grain_stride + l + m];
+        av_luma[j] = (sum + ((1 << (sx + sy)) >> 1)) >> (sx + sy);
+    }
+}
+
+void eb_av1_luma_grain_ar_filter_sse4_1(const aom_film_grain_t *params,
+    int32_t **pred_pos_luma, int32_t *luma_grain_block,
+    int32_t luma_block_size_y, int32_t luma_block_size_x,
+    int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad,
+    int32_t right_pad, int32_t bottom_pad, int32_t grain_min,
+    int32_t grain_max)
+{
+    int32_t num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
+    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
+    int32_t *wsum = (int32_t *)malloc(sizeof(*wsum) * luma_block_size_x);
+    ArTaps taps;
+
+    init_ar_taps(params->ar_coeffs_y, pred_pos_luma, num_pos_luma,
+                 luma_grain_stride, &taps);
+
+    for (int32_t i = top_pad; i < luma_block_size_y - bottom_pad; i++) {
+        ar_filter_row(luma_grain_block + i * luma_grain_stride, &taps, NULL,
+                      left_pad, luma_block_size_x - right_pad, wsum,
+                      rounding_offset, params->ar_coeff_shift, grain_min,
+                      grain_max);
+    }
+    free(wsum);
+}
+
+void eb_av1_chroma_grain_ar_filter_sse4_1(const aom_film_grain_t *params,
+    int32_t **pred_pos_chroma, const int32_t *luma_grain_block,
+    int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride,
+    int32_t chroma_block_size_y, int32_t chroma_block_size_x,
+    int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
+    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max)
+{
+    int32_t num_pos_chroma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
+    if (params->num_y_points > 0) ++num_pos_chroma;
+    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
+    int32_t j_end = chroma_block_size_x - right_pad;
+    int32_t *wsum = (int32_t *)malloc(sizeof(*wsum) * chroma_block_size_x);
+    int32_t *av_luma = (int32_t *)malloc(sizeof(*av_luma) * chroma_block_size_x);
+    ArTaps cb_taps;
+    ArTaps cr_taps;
+
+    init_ar_taps(params->ar_coeffs_cb, pred_pos_chroma, num_pos_chroma,
+                 chroma_grain_stride, &cb_taps);
+    init_ar_taps(params->ar_coeffs_cr, pred_pos_chroma, num_pos_chroma,
+                 chroma_grain_stride, &cr_taps);
+
+    for (int32_t i = top_pad; i < chroma_block_size_y - bottom_pad; i++) {
+        int32_t luma_coord_y = ((i - top_pad) << chroma_subsamp_y) + top_pad;
+
+        if (cb_taps.luma_coeff || cr_taps.luma_coeff) {
+            average_luma_row(luma_grain_block + luma_coord_y * luma_grain_stride,
+                             luma_grain_stride, left_pad, left_pad, j_end,
+                             chroma_subsamp_y, chroma_subsamp_x, av_luma);
+        }
+        if (params->num_cb_points) {
+            ar_filter_row(cb_grain_block + i * chroma_grain_stride, &cb_taps,
+                          cb_taps.luma_coeff ? av_luma : NULL, left_pad, j_end,
+                          wsum, rounding_offset, params->ar_coeff_shift,
+                          grain_min, grain_max);
+        }
+        if (params->num_cr_points) {
+            ar_filter_row(cr_grain_block + i * chroma_grain_stride, &cr_taps,
+                          cr_taps.luma_coeff ? av_luma : NULL, left_pad, j_end,
+                          wsum, rounding_offset, params->ar_coeff_shift,
+                          grain_min, grain_max);
+        }
+    }
+    free(wsum);
+    free(av_luma);
+}
@@ -36,7 +36,7 @@ EbErrorType output_bitstream_unit_ctor(
     uint32_t                 buffer_size){
     bitstream_ptr->dctor = output_bitstream_unit_dctor;
     if (buffer_size) {
-        bitstream_ptr->size = buffer_size / sizeof(uint32_t);
+        bitstream_ptr->size = buffer_size;
         EB_MALLOC_ARRAY(bitstream_ptr->buffer_begin_av1, bitstream_ptr->size);
         bitstream_ptr->buffer_av1 = bitstream_ptr->buffer_begin_av1;
     }
@@ -65,6 +65,42 @@ EbErrorType output_bitstream_reset(
     return return_error;
 }
 
+/**********************************
+ * Reserve Bitstream
+ *   Grows the buffer so byte_count more bytes
+ *   can be written, the bytes already written
+ *   are kept. On failure the buffer is left
+ *   unchanged
+ **********************************/
+EbErrorType output_bitstream_reserve(
+    OutputBitstreamUnit *bitstream_ptr,
+    uint32_t             byte_count)
+{
+    uint32_t written_bytes_count = (uint32_t)(bitstream_ptr->buffer_av1 - bitstream_ptr->buffer_begin_av1);
+    uint32_t size;
+    uint8_t *buffer;
+
+    // The size is kept in 32 bits
+    if (byte_count > UINT32_MAX - written_bytes_count)
+        return EB_ErrorInsufficientResources;
+    if (written_bytes_count + byte_count <= bitstream_ptr->size)
+        return EB_ErrorNone;
+
+    size = MAX(bitstream_ptr->size << 1, written_bytes_count + byte_count);
+    EB_NO_THROW_MALLOC(buffer, size);
+    if (!buffer)
+        return EB_ErrorInsufficientResources;
+    if (written_bytes_count)
+        EB_MEMCPY(buffer, bitstream_ptr->buffer_begin_av1, written_bytes_count);
+    EB_FREE_ARRAY(bitstream_ptr->buffer_begin_av1);
+
+    bitstream_ptr->buffer_begin_av1 = buffer;
+    bitstream_ptr->buffer_av1 = buffer + written_bytes_count;
+    bitstream_ptr->size = size;
+
+    return EB_ErrorNone;
+}
+
 /**********************************
  * Output RBSP to payload
  *   Intended to be used in CABAC
@@ -31,7 +31,7 @@ extern "C" {
     typedef struct OutputBitstreamUnit
     {
         EbDctor   dctor;
-        uint32_t  size;                               // allocated buffer size
+        uint32_t  size;                               // allocated buffer size, in bytes
         uint32_t  written_bits_count;                   // count of written bits
         uint8_t  *buffer_begin_av1;                        // the byte buffer
         uint8_t  *buffer_av1;                             // the byte buffer
@@ -46,6 +46,10 @@ extern "C" {
 
     extern EbErrorType output_bitstream_reset(OutputBitstreamUnit *bitstream_ptr);
 
+    extern EbErrorType output_bitstream_reserve(
+        OutputBitstreamUnit *bitstream_ptr,
+        uint32_t             byte_count);
+
     extern EbErrorType output_bitstream_rbsp_to_payload(
         OutputBitstreamUnit *bitstream_ptr,
         EbByte                output_buffer,
@@ -43,14 +43,21 @@ void finish_cdef_search(
     PictureControlSet            *picture_control_set_ptr
     ,int32_t                         selected_strength_cnt[64]
    );
-void av1_cdef_frame16bit(
-    EncDecContext                *context_ptr,
+void eb_av1_cdef_save_fb_lines(
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs);
-void eb_av1_cdef_frame(
-    EncDecContext                *context_ptr,
+    PictureControlSet            *pCs,
+    int32_t                       fbr_start,
+    int32_t                       fbr_end,
+    int32_t                       fbc_start,
+    int32_t                       fbc_end);
+void av1_cdef_fb_row16bit(
     SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs);
+    PictureControlSet            *pCs,
+    int32_t                       fbr);
+void eb_av1_cdef_fb_row(
+    SequenceControlSet           *sequence_control_set_ptr,
+    PictureControlSet            *pCs,
+    int32_t                       fbr);
 void eb_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 
 /******************************************************
@@ -60,6 +67,7 @@ EbErrorType cdef_context_ctor(
     CdefContext_t           *context_ptr,
     EbFifo                *cdef_input_fifo_ptr,
     EbFifo                *cdef_output_fifo_ptr ,
+    EbFifo                *cdef_feedback_fifo_ptr,
     EbBool                  is16bit,
     uint32_t                max_input_luma_width,
     uint32_t                max_input_luma_height){
@@ -70,6 +78,7 @@ EbErrorType cdef_context_ctor(
     // Input/Output System Resource Manager FIFOs
     context_ptr->cdef_input_fifo_ptr = cdef_input_fifo_ptr;
     context_ptr->cdef_output_fifo_ptr = cdef_output_fifo_ptr;
+    context_ptr->cdef_feedback_fifo_ptr = cdef_feedback_fifo_ptr;
 
     return EB_ErrorNone;
 }
@@ -411,8 +420,158 @@ void cdef_seg_search16bit(
     }
 }
 
+/******************************************************
+ * Cdef Filter Needed
+ *   The filtered picture is only used by restoration,
+ *   as a reference or as the output recon
+ ******************************************************/
+static EbBool cdef_filter_needed(
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr)
+{
+    return (EbBool)(sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode &&
+        (sequence_control_set_ptr->seq_header.enable_restoration != 0 || picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag || sequence_control_set_ptr->static_config.recon_enabled));
+}
+
+/******************************************************
+ * Cdef Seg Save Lines
+ *   Saves the lines of the segment read by the
+ *   filtering of the rows above and below, which may
+ *   happen after these rows are filtered
+ ******************************************************/
+static void cdef_seg_save_lines(
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    uint32_t            segment_index)
+{
+    uint32_t x_seg_idx;
+    uint32_t y_seg_idx;
+    uint32_t picture_width_in_b64 = (sequence_control_set_ptr->seq_header.max_frame_width + 64 - 1) / 64;
+    uint32_t picture_height_in_b64 = (sequence_control_set_ptr->seq_header.max_frame_height + 64 - 1) / 64;
+    SEGMENT_CONVERT_IDX_TO_XY(segment_index, x_seg_idx, y_seg_idx, picture_control_set_ptr->cdef_segments_column_count);
+
+    eb_av1_cdef_save_fb_lines(
+        sequence_control_set_ptr,
+        picture_control_set_ptr,
+        SEGMENT_START_IDX(y_seg_idx, picture_height_in_b64, picture_control_set_ptr->cdef_segments_row_count),
+        SEGMENT_END_IDX(y_seg_idx, picture_height_in_b64, picture_control_set_ptr->cdef_segments_row_count),
+        SEGMENT_START_IDX(x_seg_idx, picture_width_in_b64, picture_control_set_ptr->cdef_segments_column_count),
+        SEGMENT_END_IDX(x_seg_idx, picture_width_in_b64, picture_control_set_ptr->cdef_segments_column_count));
+}
+
+/******************************************************
+ * Cdef Post Rest Segments
+ *   Prepares restoration once the picture is filtered
+ *   and posts its segments
+ ******************************************************/
+static void cdef_post_rest_segments(
+    CdefContext_t      *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr)
+{
+    EbBool           is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    Av1Common       *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    EbObjectWrapper *cdef_results_wrapper_ptr;
+    CdefResults     *cdef_results_ptr;
+    uint32_t         segment_index;
+
+    //restoration prep
+
+    if (sequence_control_set_ptr->seq_header.enable_restoration)
+    {
+        eb_av1_loop_restoration_save_boundary_lines(
+            cm->frame_to_show,
+            cm,
+            1);
+
+        //are these still needed here?/!!!
+        eb_extend_frame(cm->frame_to_show->buffers[0], cm->frame_to_show->crop_widths[0], cm->frame_to_show->crop_heights[0],
+            cm->frame_to_show->strides[0], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+        eb_extend_frame(cm->frame_to_show->buffers[1], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
+            cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+        eb_extend_frame(cm->frame_to_show->buffers[2], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
+            cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+    }
+
+    picture_control_set_ptr->rest_segments_column_count = sequence_control_set_ptr->rest_segment_column_count;
+    picture_control_set_ptr->rest_segments_row_count =   sequence_control_set_ptr->rest_segment_row_count;
+    picture_control_set_ptr->rest_segments_total_count = (uint16_t)(picture_control_set_ptr->rest_segments_column_count  * picture_control_set_ptr->rest_segments_row_count);
+    picture_control_set_ptr->tot_seg_searched_rest = 0;
+    for (segment_index = 0; segment_index < picture_control_set_ptr->rest_segments_total_count; ++segment_index)
+    {
+        // Get Empty Cdef Results to Rest
+        eb_get_empty_object(
+            context_ptr->cdef_output_fifo_ptr,
+            &cdef_results_wrapper_ptr);
+        cdef_results_ptr = (struct CdefResults*)cdef_results_wrapper_ptr->object_ptr;
+        cdef_results_ptr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
+        cdef_results_ptr->segment_index = segment_index;
+        cdef_results_ptr->input_type = REST_TASKS_CDEF_INPUT;
+        // Post Cdef Results
+        eb_post_full_object(cdef_results_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Cdef Filter Rows
+ *   Takes filter rows of the picture until none is
+ *   left. The thread completing the last row hands the
+ *   picture to restoration.
+ ******************************************************/
+static void cdef_filter_rows(
+    CdefContext_t      *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr)
+{
+    EbBool   is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbBool   row_taken = EB_FALSE;
+    EbBool   picture_done = EB_FALSE;
+    uint16_t fb_row = 0;
+
+    for (;;) {
+        eb_block_on_mutex(picture_control_set_ptr->cdef_search_mutex);
+
+        // Complete the row of the previous iteration
+        if (row_taken)
+            picture_done = ++picture_control_set_ptr->cdef_fb_done_row_count == picture_control_set_ptr->cdef_fb_row_count;
+
+        row_taken = picture_control_set_ptr->cdef_fb_row_index < picture_control_set_ptr->cdef_fb_row_count;
+        if (row_taken)
+            fb_row = picture_control_set_ptr->cdef_fb_row_index++;
+
+        eb_release_mutex(picture_control_set_ptr->cdef_search_mutex);
+
+        if (!row_taken)
+            break;
+
+        if (is16bit)
+            av1_cdef_fb_row16bit(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                fb_row);
+        else
+            eb_av1_cdef_fb_row(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                fb_row);
+    }
+
+    if (picture_done)
+        cdef_post_rest_segments(
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            picture_control_set_wrapper_ptr);
+}
+
 /******************************************************
  * CDEF Kernel
+ *   Each segment is searched as it comes from DLF. The
+ *   thread searching the last segment picks the
+ *   strengths, then posts continue tasks to the other
+ *   CDEF threads which share the filter rows.
  ******************************************************/
 void* cdef_kernel(void *input_ptr)
 {
@@ -427,9 +586,9 @@ void* cdef_kernel(void *input_ptr)
     EbObjectWrapper                       *dlf_results_wrapper_ptr;
     DlfResults                            *dlf_results_ptr;
 
-    //// Output
-    EbObjectWrapper                       *cdef_results_wrapper_ptr;
-    CdefResults                           *cdef_results_ptr;
+    //// Feedback
+    EbObjectWrapper                       *feedback_wrapper_ptr;
+    DlfResults                            *feedback_ptr;
 
     // SB Loop variables
 
@@ -442,98 +601,104 @@ void* cdef_kernel(void *input_ptr)
         dlf_results_ptr = (DlfResults*)dlf_results_wrapper_ptr->object_ptr;
         picture_control_set_ptr = (PictureControlSet*)dlf_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-
-        EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-        frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
-        int32_t selected_strength_cnt[64] = { 0 };
-
-        if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
-        {
-            if (is16bit)
-                cdef_seg_search16bit(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr,
-                    dlf_results_ptr->segment_index);
-            else
-                cdef_seg_search(
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_CDEF, picture_control_set_ptr->picture_number);
+
+        if (dlf_results_ptr->input_type == CDEF_TASKS_DLF_INPUT) {
+            EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+            EbBool  last_segment;
+            frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
+            int32_t selected_strength_cnt[64] = { 0 };
+
+            if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
+            {
+                if (is16bit)
+                    cdef_seg_search16bit(
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        dlf_results_ptr->segment_index);
+                else
+                    cdef_seg_search(
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        dlf_results_ptr->segment_index);
+            }
+            if (cdef_filter_needed(picture_control_set_ptr, sequence_control_set_ptr))
+                cdef_seg_save_lines(
                     picture_control_set_ptr,
                     sequence_control_set_ptr,
                     dlf_results_ptr->segment_index);
-        }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        eb_block_on_mutex(picture_control_set_ptr->cdef_search_mutex);
+            //all seg based search is done. update total processed segments. if all done, finish the search and start the application.
+            eb_block_on_mutex(picture_control_set_ptr->cdef_search_mutex);
+            picture_control_set_ptr->tot_seg_searched_cdef++;
+            last_segment = (EbBool)(picture_control_set_ptr->tot_seg_searched_cdef == picture_control_set_ptr->cdef_segments_total_count);
+            eb_release_mutex(picture_control_set_ptr->cdef_search_mutex);
+
+            if (last_segment) {
+                Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+                uint32_t   task_count;
+
+                if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode) {
+                    finish_cdef_search(
+                        0,
+                        sequence_control_set_ptr,
+                        picture_control_set_ptr,
+                        selected_strength_cnt);
+                }
+                else {
+                    frm_hdr->CDEF_params.cdef_bits = 0;
+                    frm_hdr->CDEF_params.cdef_y_strength[0] = 0;
+                    picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+                    frm_hdr->CDEF_params.cdef_uv_strength[0] = 0;
+                }
 
-        picture_control_set_ptr->tot_seg_searched_cdef++;
-        if (picture_control_set_ptr->tot_seg_searched_cdef == picture_control_set_ptr->cdef_segments_total_count)
-        {
-           // printf("    CDEF all seg here  %i\n", picture_control_set_ptr->picture_number);
-        if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode) {
-                finish_cdef_search(
-                    0,
-                    sequence_control_set_ptr,
-                    picture_control_set_ptr,
-                    selected_strength_cnt);
-
-                if (sequence_control_set_ptr->seq_header.enable_restoration != 0 || picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag || sequence_control_set_ptr->static_config.recon_enabled){
-                    if (is16bit)
-                        av1_cdef_frame16bit(
-                            0,
-                            sequence_control_set_ptr,
-                            picture_control_set_ptr);
-                    else
-                        eb_av1_cdef_frame(
-                            0,
-                            sequence_control_set_ptr,
-                            picture_control_set_ptr);
+                picture_control_set_ptr->cdef_fb_row_count = cdef_filter_needed(picture_control_set_ptr, sequence_control_set_ptr) ?
+                    (uint16_t)((cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64) : 0;
+                picture_control_set_ptr->cdef_fb_row_index = 0;
+                picture_control_set_ptr->cdef_fb_done_row_count = 0;
+
+                if (picture_control_set_ptr->cdef_fb_row_count == 0)
+                    cdef_post_rest_segments(
+                        context_ptr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        dlf_results_ptr->picture_control_set_wrapper_ptr);
+                else {
+                    // One continue task per other CDEF thread that can get a row. Each
+                    // task holds the picture until it is done with it
+                    task_count = MIN(sequence_control_set_ptr->cdef_process_init_count, picture_control_set_ptr->cdef_fb_row_count) - 1;
+                    if (task_count)
+                        eb_object_inc_live_count(
+                            dlf_results_ptr->picture_control_set_wrapper_ptr,
+                            task_count);
+                    while (task_count--) {
+                        eb_get_empty_object(
+                            context_ptr->cdef_feedback_fifo_ptr,
+                            &feedback_wrapper_ptr);
+                        feedback_ptr = (DlfResults*)feedback_wrapper_ptr->object_ptr;
+                        feedback_ptr->picture_control_set_wrapper_ptr = dlf_results_ptr->picture_control_set_wrapper_ptr;
+                        feedback_ptr->input_type = CDEF_TASKS_CONTINUE;
+                        feedback_ptr->segment_index = 0;
+                        eb_post_full_object(feedback_wrapper_ptr);
+                    }
+
+                    cdef_filter_rows(
+                        context_ptr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        dlf_results_ptr->picture_control_set_wrapper_ptr);
                 }
+            }
         }
         else {
-            frm_hdr->CDEF_params.cdef_bits = 0;
-            frm_hdr->CDEF_params.cdef_y_strength[0] = 0;
-            picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-            frm_hdr->CDEF_params.cdef_uv_strength[0] = 0;
-        }
-
-        //restoration prep
-
-        if (sequence_control_set_ptr->seq_header.enable_restoration)
-        {
-            eb_av1_loop_restoration_save_boundary_lines(
-                cm->frame_to_show,
-                cm,
-                1);
-
-            //are these still needed here?/!!!
-            eb_extend_frame(cm->frame_to_show->buffers[0], cm->frame_to_show->crop_widths[0], cm->frame_to_show->crop_heights[0],
-                cm->frame_to_show->strides[0], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
-            eb_extend_frame(cm->frame_to_show->buffers[1], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
-                cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
-            eb_extend_frame(cm->frame_to_show->buffers[2], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
-                cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+            cdef_filter_rows(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                dlf_results_ptr->picture_control_set_wrapper_ptr);
+            eb_release_object(dlf_results_ptr->picture_control_set_wrapper_ptr);
         }
 
-        picture_control_set_ptr->rest_segments_column_count = sequence_control_set_ptr->rest_segment_column_count;
-        picture_control_set_ptr->rest_segments_row_count =   sequence_control_set_ptr->rest_segment_row_count;
-        picture_control_set_ptr->rest_segments_total_count = (uint16_t)(picture_control_set_ptr->rest_segments_column_count  * picture_control_set_ptr->rest_segments_row_count);
-        picture_control_set_ptr->tot_seg_searched_rest = 0;
-        uint32_t segment_index;
-        for (segment_index = 0; segment_index < picture_control_set_ptr->rest_segments_total_count; ++segment_index)
-        {
-            // Get Empty Cdef Results to Rest
-            eb_get_empty_object(
-                context_ptr->cdef_output_fifo_ptr,
-                &cdef_results_wrapper_ptr);
-            cdef_results_ptr = (struct CdefResults*)cdef_results_wrapper_ptr->object_ptr;
-            cdef_results_ptr->picture_control_set_wrapper_ptr = dlf_results_ptr->picture_control_set_wrapper_ptr;
-            cdef_results_ptr->segment_index = segment_index;
-            // Post Cdef Results
-            eb_post_full_object(cdef_results_wrapper_ptr);
-        }
-        }
-        eb_release_mutex(picture_control_set_ptr->cdef_search_mutex);
-
         // Release Dlf Results
         eb_release_object(dlf_results_wrapper_ptr);
     }
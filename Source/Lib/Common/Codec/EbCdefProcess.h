@@ -23,6 +23,7 @@ typedef struct CdefContext_s
     EbDctor                       dctor;
     EbFifo                       *cdef_input_fifo_ptr;
     EbFifo                       *cdef_output_fifo_ptr;
+    EbFifo                       *cdef_feedback_fifo_ptr;
 } CdefContext_t;
 
 /**************************************
@@ -32,6 +33,7 @@ extern EbErrorType cdef_context_ctor(
     CdefContext_t           *context_ptr,
     EbFifo                       *cdef_input_fifo_ptr,
     EbFifo                       *cdef_output_fifo_ptr,
+    EbFifo                       *cdef_feedback_fifo_ptr,
     EbBool                  is16bit,
     uint32_t                max_input_luma_width,
     uint32_t                max_input_luma_height
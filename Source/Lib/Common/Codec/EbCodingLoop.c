@@ -2302,7 +2302,7 @@ EB_EXTERN void av1_encode_pass(
         CodingUnit  *cu_ptr = context_ptr->cu_ptr = &context_ptr->md_context->md_cu_arr_nsq[blk_it];
         PartitionType part = cu_ptr->part;
 
-        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_it);
+        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_it, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
         UNUSED(blk_geom);
         sb_ptr->cu_partition_array[blk_it] = context_ptr->md_context->md_cu_arr_nsq[blk_it].part;
         if (part != PARTITION_SPLIT && sequence_control_set_ptr->sb_geom[tbAddr].block_is_allowed[blk_it]) {
@@ -2311,7 +2311,7 @@ EB_EXTERN void av1_encode_pass(
 
            // for (int32_t d1_itr = blk_it; d1_itr < blk_it + num_d1_block; d1_itr++) {
             for (int32_t d1_itr = (int32_t)blk_it + offset_d1; d1_itr < (int32_t)blk_it + offset_d1 + num_d1_block; d1_itr++) {
-                const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(d1_itr);
+                const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(d1_itr, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
                 // PU Stack variables
                 PredictionUnit        *pu_ptr = (PredictionUnit *)EB_NULL; //  done
@@ -3725,7 +3725,7 @@ EB_EXTERN void no_enc_dec_pass(
     while (blk_it < sequence_control_set_ptr->max_block_cnt) {
         CodingUnit  *cu_ptr = context_ptr->cu_ptr = &context_ptr->md_context->md_cu_arr_nsq[blk_it];
         PartitionType part = cu_ptr->part;
-        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_it);
+        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_it, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
         sb_ptr->cu_partition_array[blk_it] = context_ptr->md_context->md_cu_arr_nsq[blk_it].part;
 
@@ -3734,7 +3734,7 @@ EB_EXTERN void no_enc_dec_pass(
             int32_t num_d1_block = ns_blk_num[(int32_t)part]; // context_ptr->blk_geom->totns; // TOCKECK
 
             for (int32_t d1_itr = blk_it + offset_d1; d1_itr < blk_it + offset_d1 + num_d1_block; d1_itr++) {
-                const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(d1_itr);
+                const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(d1_itr, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
                 CodingUnit            *cu_ptr = context_ptr->cu_ptr = &context_ptr->md_context->md_cu_arr_nsq[d1_itr];
 
                 cu_ptr->delta_qp = 0;
@@ -1366,6 +1366,68 @@ void eb_av1_loop_filter_frame(
         }
     }
 }
+
+/******************************************************
+ * eb_av1_loop_filter_sb_row
+ *   Filters the vertical or the horizontal edges of
+ *   one SB row. Edges filtered in one pass never
+ *   overlap, so the vertical pass of a row only
+ *   depends on the reconstruction and the horizontal
+ *   pass of row r on the vertical passes of rows r - 1
+ *   and r. Running the passes in that order gives the
+ *   output of eb_av1_loop_filter_frame.
+ *   eb_av1_loop_filter_frame_init() must be called
+ *   once for the frame before.
+ ******************************************************/
+void eb_av1_loop_filter_sb_row(
+    EbPictureBufferDesc *frame_buffer,
+    PictureControlSet *picture_control_set_ptr,
+    uint32_t sb_row,
+    EbBool horz_pass,
+    int32_t plane_start, int32_t plane_end) {
+    SequenceControlSet *scs_ptr = (SequenceControlSet*)picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    FrameHeader *frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
+    uint8_t sb_size_Log2 = (uint8_t)Log2f(scs_ptr->sb_size_pix);
+    uint32_t picture_width_in_sb = (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix;
+    int32_t mi_row = (int32_t)((sb_row << sb_size_Log2) >> MI_SIZE_LOG2);
+    struct MacroblockdPlane pd[3];
+    int32_t plane;
+
+    pd[0].subsampling_x = 0;
+    pd[0].subsampling_y = 0;
+    pd[0].plane_type = PLANE_TYPE_Y;
+    pd[0].is16Bit = frame_buffer->bit_depth > 8;
+    pd[1].subsampling_x = 1;
+    pd[1].subsampling_y = 1;
+    pd[1].plane_type = PLANE_TYPE_UV;
+    pd[1].is16Bit = frame_buffer->bit_depth > 8;
+    pd[2].subsampling_x = 1;
+    pd[2].subsampling_y = 1;
+    pd[2].plane_type = PLANE_TYPE_UV;
+    pd[2].is16Bit = frame_buffer->bit_depth > 8;
+
+    for (plane = plane_start; plane < plane_end; plane++) {
+        if (plane == 0 && !(frm_hdr->loop_filter_params.filter_level[0]) && !(frm_hdr->loop_filter_params.filter_level[1]))
+            break;
+        else if (plane == 1 && !(frm_hdr->loop_filter_params.filter_level_u))
+            continue;
+        else if (plane == 2 && !(frm_hdr->loop_filter_params.filter_level_v))
+            continue;
+
+        for (uint32_t x_lcu_index = 0; x_lcu_index < picture_width_in_sb; ++x_lcu_index) {
+            int32_t mi_col = (int32_t)((x_lcu_index << sb_size_Log2) >> MI_SIZE_LOG2);
+
+            eb_av1_setup_dst_planes(pd, scs_ptr->seq_header.sb_size, frame_buffer, mi_row,
+                mi_col, plane, plane + 1);
+            if (horz_pass)
+                eb_av1_filter_block_plane_horz(picture_control_set_ptr, NULL, plane, &pd[plane], mi_row,
+                    mi_col);
+            else
+                eb_av1_filter_block_plane_vert(picture_control_set_ptr, NULL, plane, &pd[plane], mi_row,
+                    mi_col);
+        }
+    }
+}
 extern int16_t eb_av1_ac_quant_Q3(int32_t qindex, int32_t delta, AomBitDepth bit_depth);
 
 void EbCopyBuffer(
@@ -105,6 +105,13 @@ extern "C" {
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
 
+    void eb_av1_loop_filter_sb_row(
+        EbPictureBufferDesc *frame_buffer,
+        PictureControlSet *pcs_ptr,
+        uint32_t sb_row,
+        EbBool horz_pass,
+        int32_t plane_start, int32_t plane_end);
+
     void eb_av1_pick_filter_level(
         DlfContext            *context_ptr,
         EbPictureBufferDesc   *srcBuffer, // source input
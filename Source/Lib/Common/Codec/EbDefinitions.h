@@ -2376,8 +2376,8 @@ extern    uint32_t                   app_malloc_count;
 #define EB_DESTROY_SEMAPHORE(pointer) \
     do { \
         if (pointer) { \
-            eb_destroy_semaphore(pointer); \
             EB_REMOVE_MEM_ENTRY(pointer, EB_SEMAPHORE); \
+            eb_destroy_semaphore(pointer); \
             pointer = NULL; \
         } \
     }while (0)
@@ -2391,8 +2391,8 @@ extern    uint32_t                   app_malloc_count;
 #define EB_DESTROY_MUTEX(pointer) \
     do { \
         if (pointer) { \
-            eb_destroy_mutex(pointer); \
             EB_REMOVE_MEM_ENTRY(pointer, EB_MUTEX); \
+            eb_destroy_mutex(pointer); \
             pointer = NULL; \
         } \
     } while (0)
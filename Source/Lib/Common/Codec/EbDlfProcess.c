@@ -22,6 +22,12 @@
 #include "EbReferenceObject.h"
 
 #include "EbDeblockingFilter.h"
+#include "EbCdef.h"
+
+// Progress of an SB row in dlf_row_status
+#define DLF_ROW_VERT_DONE       0x1
+#define DLF_ROW_HORZ_CLAIMED    0x2
+#define DLF_ROW_HORZ_DONE       0x4
 
 void eb_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 
@@ -38,6 +44,7 @@ EbErrorType dlf_context_ctor(
     DlfContext            *context_ptr,
     EbFifo                *dlf_input_fifo_ptr,
     EbFifo                *dlf_output_fifo_ptr ,
+    EbFifo                *dlf_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
@@ -50,6 +57,7 @@ EbErrorType dlf_context_ctor(
     // Input/Output System Resource Manager FIFOs
     context_ptr->dlf_input_fifo_ptr = dlf_input_fifo_ptr;
     context_ptr->dlf_output_fifo_ptr = dlf_output_fifo_ptr;
+    context_ptr->dlf_feedback_fifo_ptr = dlf_feedback_fifo_ptr;
 
     context_ptr->temp_lf_recon_picture16bit_ptr = (EbPictureBufferDesc *)EB_NULL;
     context_ptr->temp_lf_recon_picture_ptr = (EbPictureBufferDesc *)EB_NULL;
@@ -84,8 +92,274 @@ EbErrorType dlf_context_ctor(
     return return_error;
 }
 
+/******************************************************
+ * Get the recon picture the DLF filters in place
+ ******************************************************/
+static EbPictureBufferDesc *dlf_get_recon_picture(
+    PictureControlSet *picture_control_set_ptr,
+    EbBool             is16bit)
+{
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *reference_object = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        return is16bit ? reference_object->reference_picture16bit : reference_object->reference_picture;
+    }
+    return is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+}
+
+/******************************************************
+ * Dlf Picture Init
+ *   Picks the filter levels and prepares CDEF. Runs
+ *   once per picture, before the SB rows get filtered.
+ ******************************************************/
+static void dlf_picture_init(
+    DlfContext         *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr)
+{
+    EbBool is16bit       = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc  *recon_picture_ptr = dlf_get_recon_picture(picture_control_set_ptr, is16bit);
+
+    EbBool dlfEnableFlag = (EbBool) picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode;
+    if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+        eb_av1_loop_filter_init(picture_control_set_ptr);
+
+        if (picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+            eb_av1_pick_filter_level(
+                context_ptr,
+                (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                picture_control_set_ptr,
+                LPF_PICK_FROM_Q);
+        }
+
+        eb_av1_pick_filter_level(
+            context_ptr,
+            (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+            picture_control_set_ptr,
+            LPF_PICK_FROM_FULL_IMAGE);
+
+#if NO_ENCDEC
+        //NO DLF
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
+#endif
+        eb_av1_loop_filter_frame_init(picture_control_set_ptr, 0, 3);
+
+        picture_control_set_ptr->dlf_row_count = (uint16_t)((sequence_control_set_ptr->seq_header.max_frame_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix);
+    }
+    else
+        picture_control_set_ptr->dlf_row_count = 0;
+
+    picture_control_set_ptr->dlf_vert_row_index = 0;
+    picture_control_set_ptr->dlf_done_row_count = 0;
+    picture_control_set_ptr->dlf_cdef_segment_row_count = 0;
+    EB_MEMSET(picture_control_set_ptr->dlf_row_status, 0, picture_control_set_ptr->dlf_row_count);
+
+    //pre-cdef prep
+    {
+        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+
+        link_eb_to_aom_buffer_desc(
+            recon_picture_ptr,
+            cm->frame_to_show);
+
+        if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
+        {
+            if (is16bit)
+            {
+                picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
+                picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->buffer_cb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
+                picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->buffer_cr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
+
+                EbPictureBufferDesc *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
+                picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+                picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->buffer_cb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
+                picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->buffer_cr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
+            }
+            else
+            {
+                EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
+                EbByte  rec_ptr_cb = &((recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb]);
+                EbByte  rec_ptr_cr = &((recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr]);
+
+                EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+                EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+                EbByte  enh_ptr_cb = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
+                EbByte  enh_ptr_cr = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
+
+                picture_control_set_ptr->src[0] = (uint16_t*)rec_ptr;
+                picture_control_set_ptr->src[1] = (uint16_t*)rec_ptr_cb;
+                picture_control_set_ptr->src[2] = (uint16_t*)rec_ptr_cr;
+
+                picture_control_set_ptr->ref_coeff[0] = (uint16_t*)enh_ptr;
+                picture_control_set_ptr->ref_coeff[1] = (uint16_t*)enh_ptr_cb;
+                picture_control_set_ptr->ref_coeff[2] = (uint16_t*)enh_ptr_cr;
+            }
+        }
+    }
+
+    picture_control_set_ptr->cdef_segments_column_count =  sequence_control_set_ptr->cdef_segment_column_count;
+    picture_control_set_ptr->cdef_segments_row_count    = sequence_control_set_ptr->cdef_segment_row_count;
+    picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
+    picture_control_set_ptr->tot_seg_searched_cdef      = 0;
+}
+
+/******************************************************
+ * Dlf Cdef Ready Row Count
+ *   Number of CDEF segment rows whose 64x64 blocks and
+ *   borders are final once the first done_row_count SB
+ *   rows are deblocked. The horizontal pass of the next
+ *   SB row still changes the last lines of the done rows.
+ ******************************************************/
+static uint8_t dlf_cdef_ready_row_count(
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr)
+{
+    uint32_t picture_height_in_b64 = (sequence_control_set_ptr->seq_header.max_frame_height + 64 - 1) / 64;
+    uint32_t final_height = picture_control_set_ptr->dlf_done_row_count * sequence_control_set_ptr->sb_size_pix;
+    uint8_t  y_seg_idx;
+
+    if (picture_control_set_ptr->dlf_done_row_count == picture_control_set_ptr->dlf_row_count)
+        return picture_control_set_ptr->cdef_segments_row_count;
+    if (final_height < 8 + CDEF_VBORDER)
+        return 0;
+    final_height -= 8 + CDEF_VBORDER;
+
+    for (y_seg_idx = 0; y_seg_idx < picture_control_set_ptr->cdef_segments_row_count; ++y_seg_idx) {
+        uint32_t y_b64_end_idx = SEGMENT_END_IDX(y_seg_idx, picture_height_in_b64, picture_control_set_ptr->cdef_segments_row_count);
+        if ((y_b64_end_idx << 6) > final_height)
+            break;
+    }
+    return y_seg_idx;
+}
+
+/******************************************************
+ * Dlf Post Cdef Rows
+ *   Posts the CDEF segments of the segment rows
+ *   [row_start, row_end)
+ ******************************************************/
+static void dlf_post_cdef_rows(
+    DlfContext         *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr,
+    uint8_t             row_start,
+    uint8_t             row_end)
+{
+    EbObjectWrapper *dlf_results_wrapper_ptr;
+    DlfResults      *dlf_results_ptr;
+    uint32_t         segment_index;
+
+    // The boundary lines are saved once the whole picture is deblocked,
+    // before the last segments let CDEF filter the picture
+    if (row_end == picture_control_set_ptr->cdef_segments_row_count && row_end > row_start &&
+        sequence_control_set_ptr->seq_header.enable_restoration)
+        eb_av1_loop_restoration_save_boundary_lines(picture_control_set_ptr->parent_pcs_ptr->av1_cm->frame_to_show, picture_control_set_ptr->parent_pcs_ptr->av1_cm, 0);
+
+    for (segment_index = row_start * picture_control_set_ptr->cdef_segments_column_count; segment_index < (uint32_t)row_end * picture_control_set_ptr->cdef_segments_column_count; ++segment_index)
+    {
+        // Get Empty DLF Results to Cdef
+        eb_get_empty_object(
+            context_ptr->dlf_output_fifo_ptr,
+            &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults*)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
+        dlf_results_ptr->segment_index = segment_index;
+        dlf_results_ptr->input_type = CDEF_TASKS_DLF_INPUT;
+        // Post DLF Results
+        eb_post_full_object(dlf_results_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Dlf Filter Rows
+ *   Takes SB row passes of the picture until none is
+ *   ready. The horizontal pass of a row is taken first
+ *   once the vertical passes of the row and of the row
+ *   above are done, so CDEF can start on the top of
+ *   the picture while the bottom is still deblocked.
+ ******************************************************/
+static void dlf_filter_rows(
+    DlfContext         *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr)
+{
+    EbBool               is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc *recon_picture_ptr = NULL;
+    uint8_t             *row_status = picture_control_set_ptr->dlf_row_status;
+    uint32_t             sb_row = 0;
+    EbBool               horz_pass = EB_FALSE;
+    EbBool               row_taken = EB_FALSE;
+
+    for (;;) {
+        uint8_t cdef_row_start, cdef_row_end;
+
+        eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+
+        // Complete the pass of the previous iteration
+        if (row_taken) {
+            row_status[sb_row] |= horz_pass ? DLF_ROW_HORZ_DONE : DLF_ROW_VERT_DONE;
+            while (picture_control_set_ptr->dlf_done_row_count < picture_control_set_ptr->dlf_row_count &&
+                (row_status[picture_control_set_ptr->dlf_done_row_count] & DLF_ROW_HORZ_DONE))
+                picture_control_set_ptr->dlf_done_row_count++;
+        }
+        cdef_row_start = picture_control_set_ptr->dlf_cdef_segment_row_count;
+        cdef_row_end = dlf_cdef_ready_row_count(picture_control_set_ptr, sequence_control_set_ptr);
+        if (cdef_row_end > cdef_row_start)
+            picture_control_set_ptr->dlf_cdef_segment_row_count = cdef_row_end;
+
+        // Take the next pass
+        row_taken = EB_FALSE;
+        for (sb_row = picture_control_set_ptr->dlf_done_row_count; sb_row < picture_control_set_ptr->dlf_vert_row_index; ++sb_row) {
+            if (!(row_status[sb_row] & DLF_ROW_HORZ_CLAIMED) && (row_status[sb_row] & DLF_ROW_VERT_DONE) &&
+                (sb_row == 0 || (row_status[sb_row - 1] & DLF_ROW_VERT_DONE))) {
+                row_status[sb_row] |= DLF_ROW_HORZ_CLAIMED;
+                horz_pass = EB_TRUE;
+                row_taken = EB_TRUE;
+                break;
+            }
+        }
+        if (!row_taken && picture_control_set_ptr->dlf_vert_row_index < picture_control_set_ptr->dlf_row_count) {
+            sb_row = picture_control_set_ptr->dlf_vert_row_index++;
+            horz_pass = EB_FALSE;
+            row_taken = EB_TRUE;
+        }
+
+        eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+        if (cdef_row_end > cdef_row_start)
+            dlf_post_cdef_rows(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_wrapper_ptr,
+                cdef_row_start,
+                cdef_row_end);
+
+        if (!row_taken)
+            break;
+
+        // Only looked up with a row taken, the parent of a picture done
+        // before a continue task starts may be gone
+        if (!recon_picture_ptr)
+            recon_picture_ptr = dlf_get_recon_picture(picture_control_set_ptr, is16bit);
+        eb_av1_loop_filter_sb_row(
+            recon_picture_ptr,
+            picture_control_set_ptr,
+            sb_row,
+            horz_pass,
+            0,
+            3);
+    }
+}
+
 /******************************************************
  * Dlf Kernel
+ *   The thread receiving the picture from EncDec picks
+ *   the filter levels, then posts continue tasks to the
+ *   other DLF threads which share the SB row passes.
  ******************************************************/
 void* dlf_kernel(void *input_ptr)
 {
@@ -98,9 +372,9 @@ void* dlf_kernel(void *input_ptr)
     EbObjectWrapper                       *enc_dec_results_wrapper_ptr;
     EncDecResults                         *enc_dec_results_ptr;
 
-    //// Output
-    EbObjectWrapper                       *dlf_results_wrapper_ptr;
-    struct DlfResults*                     dlf_results_ptr;
+    //// Feedback
+    EbObjectWrapper                       *feedback_wrapper_ptr;
+    EncDecResults                         *feedback_ptr;
 
     // SB Loop variables
     for (;;) {
@@ -112,133 +386,49 @@ void* dlf_kernel(void *input_ptr)
         enc_dec_results_ptr         = (EncDecResults*)enc_dec_results_wrapper_ptr->object_ptr;
         picture_control_set_ptr     = (PictureControlSet*)enc_dec_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr    = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_DLF, picture_control_set_ptr->picture_number);
 
-        EbBool is16bit       = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-
-        EbBool dlfEnableFlag = (EbBool) picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode;
-        if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
-            EbPictureBufferDesc  *recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                //get the 16bit form of the input LCU
-                if (is16bit)
-                    recon_buffer = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture16bit;
-                else
-                    recon_buffer = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture;
-            else  // non ref pictures
-                recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-
-            eb_av1_loop_filter_init(picture_control_set_ptr);
-
-            if (picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
-                eb_av1_pick_filter_level(
-                    context_ptr,
-                    (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    picture_control_set_ptr,
-                    LPF_PICK_FROM_Q);
-            }
+        if (enc_dec_results_ptr->input_type == DLF_TASKS_ENCDEC_INPUT) {
+            uint32_t task_count;
 
-            eb_av1_pick_filter_level(
+            dlf_picture_init(
                 context_ptr,
-                (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
                 picture_control_set_ptr,
-                LPF_PICK_FROM_FULL_IMAGE);
-
-#if NO_ENCDEC
-            //NO DLF
-            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
-            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
-            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
-            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
-#endif
-                eb_av1_loop_filter_frame(
-                    recon_buffer,
-                    picture_control_set_ptr,
-                    0,
-                    3);
-            }
-
-        //pre-cdef prep
-        {
-            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-            EbPictureBufferDesc  * recon_picture_ptr;
-            if (is16bit) {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture16bit;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-            }
-            else {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-            }
-
-            link_eb_to_aom_buffer_desc(
-                recon_picture_ptr,
-                cm->frame_to_show);
-
-            if (sequence_control_set_ptr->seq_header.enable_restoration)
-                eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            if (sequence_control_set_ptr->seq_header.enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
-            {
-                if (is16bit)
-                {
-                    picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
-                    picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->buffer_cb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
-                    picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->buffer_cr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
-
-                    EbPictureBufferDesc *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
-                    picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
-                    picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->buffer_cb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
-                    picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->buffer_cr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
-                }
-                else
-                {
-                    EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
-                    EbByte  rec_ptr_cb = &((recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb]);
-                    EbByte  rec_ptr_cr = &((recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr]);
-
-                    EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                    EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-                    EbByte  enh_ptr_cb = &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-                    EbByte  enh_ptr_cr = &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-
-                    picture_control_set_ptr->src[0] = (uint16_t*)rec_ptr;
-                    picture_control_set_ptr->src[1] = (uint16_t*)rec_ptr_cb;
-                    picture_control_set_ptr->src[2] = (uint16_t*)rec_ptr_cr;
-
-                    picture_control_set_ptr->ref_coeff[0] = (uint16_t*)enh_ptr;
-                    picture_control_set_ptr->ref_coeff[1] = (uint16_t*)enh_ptr_cb;
-                    picture_control_set_ptr->ref_coeff[2] = (uint16_t*)enh_ptr_cr;
-
-                }
+                sequence_control_set_ptr);
+
+            // One continue task per other DLF thread that can get a row. Each
+            // task holds the picture until it is done with it
+            task_count = picture_control_set_ptr->dlf_row_count ?
+                MIN(sequence_control_set_ptr->dlf_process_init_count, picture_control_set_ptr->dlf_row_count) - 1 : 0;
+            if (task_count)
+                eb_object_inc_live_count(
+                    enc_dec_results_ptr->picture_control_set_wrapper_ptr,
+                    task_count);
+            while (task_count--) {
+                eb_get_empty_object(
+                    context_ptr->dlf_feedback_fifo_ptr,
+                    &feedback_wrapper_ptr);
+                feedback_ptr = (EncDecResults*)feedback_wrapper_ptr->object_ptr;
+                feedback_ptr->picture_control_set_wrapper_ptr = enc_dec_results_ptr->picture_control_set_wrapper_ptr;
+                feedback_ptr->input_type = DLF_TASKS_CONTINUE;
+                feedback_ptr->completed_lcu_row_index_start = 0;
+                feedback_ptr->completed_lcu_row_count = picture_control_set_ptr->dlf_row_count;
+                eb_post_full_object(feedback_wrapper_ptr);
             }
         }
 
-        picture_control_set_ptr->cdef_segments_column_count =  sequence_control_set_ptr->cdef_segment_column_count;
-        picture_control_set_ptr->cdef_segments_row_count    = sequence_control_set_ptr->cdef_segment_row_count;
-        picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
-        picture_control_set_ptr->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
+        dlf_filter_rows(
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            enc_dec_results_ptr->picture_control_set_wrapper_ptr);
 
-        for (segment_index = 0; segment_index < picture_control_set_ptr->cdef_segments_total_count; ++segment_index)
-        {
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(
-                context_ptr->dlf_output_fifo_ptr,
-                &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults*)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->picture_control_set_wrapper_ptr = enc_dec_results_ptr->picture_control_set_wrapper_ptr;
-            dlf_results_ptr->segment_index = segment_index;
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
-        }
+        if (enc_dec_results_ptr->input_type == DLF_TASKS_CONTINUE)
+            eb_release_object(enc_dec_results_ptr->picture_control_set_wrapper_ptr);
 
-            // Release EncDec Results
-            eb_release_object(enc_dec_results_wrapper_ptr);
-        }
+        // Release EncDec Results
+        eb_release_object(enc_dec_results_wrapper_ptr);
+    }
 
     return EB_NULL;
 }
@@ -23,6 +23,7 @@ typedef struct DlfContext
     EbDctor              dctor;
     EbFifo              *dlf_input_fifo_ptr;
     EbFifo              *dlf_output_fifo_ptr;
+    EbFifo              *dlf_feedback_fifo_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture16bit_ptr;
 } DlfContext;
@@ -34,6 +35,7 @@ extern EbErrorType dlf_context_ctor(
     DlfContext                   *context_ptr,
     EbFifo                       *dlf_input_fifo_ptr,
     EbFifo                       *dlf_output_fifo_ptr,
+    EbFifo                       *dlf_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
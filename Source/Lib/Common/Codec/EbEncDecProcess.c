@@ -30,22 +30,11 @@ void eb_av1_cdef_search(
     PictureControlSet            *picture_control_set_ptr
 );
 
-void eb_av1_cdef_frame(
-    EncDecContext                *context_ptr,
-    SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs
-);
-
 void av1_cdef_search16bit(
     EncDecContext                *context_ptr,
     SequenceControlSet           *sequence_control_set_ptr,
     PictureControlSet            *picture_control_set_ptr
 );
-void av1_cdef_frame16bit(
-    uint8_t is16bit,
-    SequenceControlSet           *sequence_control_set_ptr,
-    PictureControlSet            *pCs
-);
 
 void eb_av1_add_film_grain(EbPictureBufferDesc *src,
     EbPictureBufferDesc *dst,
@@ -53,7 +42,6 @@ void eb_av1_add_film_grain(EbPictureBufferDesc *src,
 
 void eb_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 void eb_av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig * trial_frame_rst /*Av1Comp *cpi*/, Macroblock *x, Av1Common *const cm);
-void eb_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm, int32_t optimized_lr);
 
 const int16_t encMinDeltaQpWeightTab[MAX_TEMPORAL_LAYERS] = { 100, 100, 100, 100, 100, 100 };
 const int16_t encMaxDeltaQpWeightTab[MAX_TEMPORAL_LAYERS] = { 100, 100, 100, 100, 100, 100 };
@@ -85,6 +73,7 @@ static void enc_dec_context_dctor(EbPtr p)
     if (obj->is_md_rate_estimation_ptr_owner)
         EB_FREE(obj->md_rate_estimation_ptr);
     EB_FREE_ARRAY(obj->transform_inner_array_ptr);
+    EB_FREE_ARRAY(obj->intra_coded_area_sb);
 }
 
 /******************************************************
@@ -102,9 +91,6 @@ EbErrorType enc_dec_context_ctor(
     uint32_t                max_input_luma_width,
     uint32_t                max_input_luma_height)
 {
-    (void)max_input_luma_width;
-    (void)max_input_luma_height;
-
     context_ptr->dctor = enc_dec_context_dctor;
     context_ptr->is16bit = is16bit;
     context_ptr->color_format = color_format;
@@ -117,6 +103,10 @@ EbErrorType enc_dec_context_ctor(
 
     // Trasform Scratch Memory
     EB_MALLOC_ARRAY(context_ptr->transform_inner_array_ptr, 3152); //refer to EbInvTransform_SSE2.as. case 32x32
+    // Per SB intra coded area
+    EB_MALLOC_ARRAY(context_ptr->intra_coded_area_sb,
+        ((max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+        ((max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64));
     // MD rate Estimation tables
     EB_MALLOC(context_ptr->md_rate_estimation_ptr, sizeof(MdRateEstimationContext));
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
@@ -637,9 +627,21 @@ void ReconOutput(
     eb_release_mutex(encode_context_ptr->total_number_of_recon_frame_mutex);
 }
 
+/******************************************************
+ * PSNR Calculations
+ *   Adds the SSE of the luma rows [luma_row_start,
+ *   luma_row_end) and the chroma rows [chroma_row_start,
+ *   chroma_row_end) of the recon to sse, so the rows
+ *   of a picture can be measured in parallel
+ ******************************************************/
 void psnr_calculations(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr){
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              luma_row_start,
+    uint32_t              luma_row_end,
+    uint32_t              chroma_row_start,
+    uint32_t              chroma_row_end,
+    uint64_t              sse[3]){
     EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
     if (!is16bit) {
@@ -652,9 +654,8 @@ void psnr_calculations(
 
         EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
 
-        uint64_t sseTotal[3] = { 0 };
         uint32_t   columnIndex;
-        uint32_t   row_index = 0;
+        uint32_t   row_index = luma_row_start;
         uint64_t   residualDistortion = 0;
         EbByte  inputBuffer;
         EbByte  reconCoeffBuffer;
@@ -676,12 +677,12 @@ void psnr_calculations(
             buffer_cr = input_picture_ptr->buffer_cr;
         }
 
-        reconCoeffBuffer = &((recon_ptr->buffer_y)[recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y]);
-        inputBuffer = &(buffer_y[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+        reconCoeffBuffer = &((recon_ptr->buffer_y)[recon_ptr->origin_x + (recon_ptr->origin_y + luma_row_start) * recon_ptr->stride_y]);
+        inputBuffer = &(buffer_y[input_picture_ptr->origin_x + (input_picture_ptr->origin_y + luma_row_start) * input_picture_ptr->stride_y]);
 
         residualDistortion = 0;
 
-        while (row_index < sequence_control_set_ptr->seq_header.max_frame_height) {
+        while (row_index < luma_row_end) {
             columnIndex = 0;
             while (columnIndex < sequence_control_set_ptr->seq_header.max_frame_width) {
                 residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
@@ -693,14 +694,14 @@ void psnr_calculations(
             ++row_index;
         }
 
-        sseTotal[0] = residualDistortion;
+        sse[0] += residualDistortion;
 
-        reconCoeffBuffer = &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cb]);
-        inputBuffer = &(buffer_cb[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
+        reconCoeffBuffer = &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cb]);
+        inputBuffer = &(buffer_cb[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cb]);
 
         residualDistortion = 0;
-        row_index = 0;
-        while (row_index < sequence_control_set_ptr->chroma_height) {
+        row_index = chroma_row_start;
+        while (row_index < chroma_row_end) {
             columnIndex = 0;
             while (columnIndex < sequence_control_set_ptr->chroma_width) {
                 residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
@@ -712,14 +713,14 @@ void psnr_calculations(
             ++row_index;
         }
 
-        sseTotal[1] = residualDistortion;
+        sse[1] += residualDistortion;
 
-        reconCoeffBuffer = &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 + recon_ptr->origin_y / 2 * recon_ptr->stride_cr]);
-        inputBuffer = &(buffer_cr[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
+        reconCoeffBuffer = &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 + (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cr]);
+        inputBuffer = &(buffer_cr[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cr]);
         residualDistortion = 0;
-        row_index = 0;
+        row_index = chroma_row_start;
 
-        while (row_index < sequence_control_set_ptr->chroma_height) {
+        while (row_index < chroma_row_end) {
             columnIndex = 0;
             while (columnIndex < sequence_control_set_ptr->chroma_width) {
                 residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
@@ -731,16 +732,7 @@ void psnr_calculations(
             ++row_index;
         }
 
-        sseTotal[2] = residualDistortion;
-        picture_control_set_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sseTotal[0];
-        picture_control_set_ptr->parent_pcs_ptr->cb_sse = (uint32_t)sseTotal[1];
-        picture_control_set_ptr->parent_pcs_ptr->cr_sse = (uint32_t)sseTotal[2];
-
-        if(picture_control_set_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-            EB_FREE_ARRAY(buffer_y);
-            EB_FREE_ARRAY(buffer_cb);
-            EB_FREE_ARRAY(buffer_cr);
-        }
+        sse[2] += residualDistortion;
     }
     else {
         EbPictureBufferDesc *recon_ptr;
@@ -751,9 +743,8 @@ void psnr_calculations(
             recon_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
         EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
 
-        uint64_t sseTotal[3] = { 0 };
         uint32_t   columnIndex;
-        uint32_t   row_index = 0;
+        uint32_t   row_index = luma_row_start;
         uint64_t   residualDistortion = 0;
         EbByte  inputBuffer;
         EbByte  inputBufferBitInc;
@@ -791,6 +782,9 @@ void psnr_calculations(
                     uint32_t tbOriginY = lcuNumberInHeight * 64;
                     uint32_t sb_width = (luma_width - tbOriginX) < 64 ? (luma_width - tbOriginX) : 64;
                     uint32_t sb_height = (luma_height - tbOriginY) < 64 ? (luma_height - tbOriginY) : 64;
+                    // Rows of the block in the measured rows
+                    uint32_t row_begin = luma_row_start > tbOriginY ? luma_row_start - tbOriginY : 0;
+                    uint32_t row_stop = luma_row_end > tbOriginY ? MIN(luma_row_end - tbOriginY, sb_height) : 0;
 
                     inputBuffer = inputBufferOrg + tbOriginY * input_picture_ptr->stride_y + tbOriginX;
                     inputBufferBitInc = input_picture_ptr->buffer_bit_inc_y + tbOriginY * luma2BitWidth + (tbOriginX / 4)*sb_height;
@@ -802,7 +796,7 @@ void psnr_calculations(
                     uint8_t   four2bitPels;
                     uint32_t     inn_stride = sb_width / 4;
 
-                    for (j = 0; j < sb_height; j++)
+                    for (j = row_begin; j < row_stop; j++)
                     {
                         for (k = 0; k < sb_width / 4; k++)
                         {
@@ -836,6 +830,8 @@ void psnr_calculations(
                     tbOriginY = lcuNumberInHeight * 32;
                     sb_width = (chroma_width - tbOriginX) < 32 ? (chroma_width - tbOriginX) : 32;
                     sb_height = (chroma_height - tbOriginY) < 32 ? (chroma_height - tbOriginY) : 32;
+                    row_begin = chroma_row_start > tbOriginY ? chroma_row_start - tbOriginY : 0;
+                    row_stop = chroma_row_end > tbOriginY ? MIN(chroma_row_end - tbOriginY, sb_height) : 0;
 
                     inn_stride = sb_width / 4;
 
@@ -845,7 +841,7 @@ void psnr_calculations(
 
                     reconCoeffBuffer = reconBufferOrgU + tbOriginY * recon_ptr->stride_cb + tbOriginX;
 
-                    for (j = 0; j < sb_height; j++)
+                    for (j = row_begin; j < row_stop; j++)
                     {
                         for (k = 0; k < sb_width / 4; k++)
                         {
@@ -877,7 +873,7 @@ void psnr_calculations(
                     inputBufferBitInc = input_picture_ptr->buffer_bit_inc_cr + tbOriginY * chroma2BitWidth + (tbOriginX / 4)*sb_height;
                     reconCoeffBuffer = reconBufferOrgV + tbOriginY * recon_ptr->stride_cr + tbOriginX;
 
-                    for (j = 0; j < sb_height; j++)
+                    for (j = row_begin; j < row_stop; j++)
                     {
                         for (k = 0; k < sb_width / 4; k++)
                         {
@@ -907,12 +903,12 @@ void psnr_calculations(
                 }
             }
 
-            sseTotal[0] = residualDistortion;
-            sseTotal[1] = residualDistortionU;
-            sseTotal[2] = residualDistortionV;
+            sse[0] += residualDistortion;
+            sse[1] += residualDistortionU;
+            sse[2] += residualDistortionV;
         }
         else {
-            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_y)[(recon_ptr->origin_x << is16bit) + (recon_ptr->origin_y << is16bit) * recon_ptr->stride_y]));
+            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_y)[(recon_ptr->origin_x << is16bit) + ((recon_ptr->origin_y + luma_row_start) << is16bit) * recon_ptr->stride_y]));
 
             // if current source picture was temporally filtered, use an alternative buffer which stores
             // the original source picture
@@ -936,12 +932,12 @@ void psnr_calculations(
                 buffer_bit_inc_cr = input_picture_ptr->buffer_bit_inc_cr;
             }
 
-            inputBuffer = &((buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-            inputBufferBitInc = &((buffer_bit_inc_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_bit_inc_y]);
+            inputBuffer = &((buffer_y)[input_picture_ptr->origin_x + (input_picture_ptr->origin_y + luma_row_start) * input_picture_ptr->stride_y]);
+            inputBufferBitInc = &((buffer_bit_inc_y)[input_picture_ptr->origin_x + (input_picture_ptr->origin_y + luma_row_start) * input_picture_ptr->stride_bit_inc_y]);
 
             residualDistortion = 0;
 
-            while (row_index < sequence_control_set_ptr->seq_header.max_frame_height) {
+            while (row_index < luma_row_end) {
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->seq_header.max_frame_width) {
                     residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
@@ -955,15 +951,15 @@ void psnr_calculations(
                 ++row_index;
             }
 
-            sseTotal[0] = residualDistortion;
+            sse[0] += residualDistortion;
 
-            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_cb)[(recon_ptr->origin_x << is16bit) / 2 + (recon_ptr->origin_y << is16bit) / 2 * recon_ptr->stride_cb]));
-            inputBuffer = &((buffer_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-            inputBufferBitInc = &((buffer_bit_inc_cb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_bit_inc_cb]);
+            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_cb)[(recon_ptr->origin_x << is16bit) / 2 + ((recon_ptr->origin_y << is16bit) / 2 + (chroma_row_start << is16bit)) * recon_ptr->stride_cb]));
+            inputBuffer = &((buffer_cb)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cb]);
+            inputBufferBitInc = &((buffer_bit_inc_cb)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_bit_inc_cb]);
 
             residualDistortion = 0;
-            row_index = 0;
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            row_index = chroma_row_start;
+            while (row_index < chroma_row_end) {
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
@@ -976,16 +972,16 @@ void psnr_calculations(
                 ++row_index;
             }
 
-            sseTotal[1] = residualDistortion;
+            sse[1] += residualDistortion;
 
-            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_cr)[(recon_ptr->origin_x << is16bit) / 2 + (recon_ptr->origin_y << is16bit) / 2 * recon_ptr->stride_cr]));
-            inputBuffer = &((buffer_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-            inputBufferBitInc = &((buffer_bit_inc_cr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_bit_inc_cr]);
+            reconCoeffBuffer = (uint16_t*)(&((recon_ptr->buffer_cr)[(recon_ptr->origin_x << is16bit) / 2 + ((recon_ptr->origin_y << is16bit) / 2 + (chroma_row_start << is16bit)) * recon_ptr->stride_cr]));
+            inputBuffer = &((buffer_cr)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_cr]);
+            inputBufferBitInc = &((buffer_bit_inc_cr)[input_picture_ptr->origin_x / 2 + (input_picture_ptr->origin_y / 2 + chroma_row_start) * input_picture_ptr->stride_bit_inc_cr]);
 
             residualDistortion = 0;
-            row_index = 0;
+            row_index = chroma_row_start;
 
-            while (row_index < sequence_control_set_ptr->chroma_height) {
+            while (row_index < chroma_row_end) {
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
@@ -998,28 +994,54 @@ void psnr_calculations(
                 ++row_index;
             }
 
-            sseTotal[2] = residualDistortion;
-
-            if(picture_control_set_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-                EB_FREE_ARRAY(buffer_y);
-                EB_FREE_ARRAY(buffer_cb);
-                EB_FREE_ARRAY(buffer_cr);
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
+            sse[2] += residualDistortion;
         }
+    }
+}
 
-        picture_control_set_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sseTotal[0];
-        picture_control_set_ptr->parent_pcs_ptr->cb_sse = (uint32_t)sseTotal[1];
-        picture_control_set_ptr->parent_pcs_ptr->cr_sse = (uint32_t)sseTotal[2];
+/******************************************************
+ * PSNR Finish Calculations
+ *   Stores the SSE of the picture once all its rows
+ *   are measured
+ ******************************************************/
+void psnr_finish_calculations(
+    PictureControlSet    *picture_control_set_ptr,
+    SequenceControlSet   *sequence_control_set_ptr,
+    const uint64_t        sse[3]){
+    EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    picture_control_set_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sse[0];
+    picture_control_set_ptr->parent_pcs_ptr->cb_sse = (uint32_t)sse[1];
+    picture_control_set_ptr->parent_pcs_ptr->cr_sse = (uint32_t)sse[2];
+
+    // The original source picture is not needed anymore
+    if (picture_control_set_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE &&
+        !(is16bit && sequence_control_set_ptr->static_config.ten_bit_format == 1)) {
+        EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0]);
+        EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1]);
+        EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2]);
+        if (is16bit) {
+            EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[0]);
+            EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[1]);
+            EB_FREE_ARRAY(picture_control_set_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[2]);
+        }
     }
 }
 
-void PadRefAndSetFlags(
+/******************************************************
+ * Pad Reference Rows
+ *   Pads the luma rows [luma_row_start, luma_row_end)
+ *   and the chroma rows [chroma_row_start,
+ *   chroma_row_end) of the reference picture, so the
+ *   rows of a picture can be padded in parallel
+ ******************************************************/
+void pad_ref_rows(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr
-)
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              luma_row_start,
+    uint32_t              luma_row_end,
+    uint32_t              chroma_row_start,
+    uint32_t              chroma_row_end)
 {
     EbReferenceObject   *referenceObject = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
     EbPictureBufferDesc *refPicPtr = (EbPictureBufferDesc*)referenceObject->reference_picture;
@@ -1028,96 +1050,123 @@ void PadRefAndSetFlags(
 
     if (!is16bit) {
         // Y samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_y,
             refPicPtr->stride_y,
             refPicPtr->width,
             refPicPtr->height,
             refPicPtr->origin_x,
-            refPicPtr->origin_y);
+            refPicPtr->origin_y,
+            luma_row_start,
+            luma_row_end);
 
         // Cb samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_cb,
             refPicPtr->stride_cb,
             refPicPtr->width >> 1,
             refPicPtr->height >> 1,
             refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
+            refPicPtr->origin_y >> 1,
+            chroma_row_start,
+            chroma_row_end);
 
         // Cr samples
-        generate_padding(
+        generate_padding_rows(
             refPicPtr->buffer_cr,
             refPicPtr->stride_cr,
             refPicPtr->width >> 1,
             refPicPtr->height >> 1,
             refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
+            refPicPtr->origin_y >> 1,
+            chroma_row_start,
+            chroma_row_end);
     }
 
     //We need this for MCP
     if (is16bit) {
         // Y samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_y,
             refPic16BitPtr->stride_y << 1,
             refPic16BitPtr->width << 1,
             refPic16BitPtr->height,
             refPic16BitPtr->origin_x << 1,
-            refPic16BitPtr->origin_y);
+            refPic16BitPtr->origin_y,
+            luma_row_start,
+            luma_row_end);
 
         // Cb samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_cb,
             refPic16BitPtr->stride_cb << 1,
             refPic16BitPtr->width,
             refPic16BitPtr->height >> 1,
             refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
+            refPic16BitPtr->origin_y >> 1,
+            chroma_row_start,
+            chroma_row_end);
 
         // Cr samples
-        generate_padding16_bit(
+        generate_padding16_bit_rows(
             refPic16BitPtr->buffer_cr,
             refPic16BitPtr->stride_cr << 1,
             refPic16BitPtr->width,
             refPic16BitPtr->height >> 1,
             refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
+            refPic16BitPtr->origin_y >> 1,
+            chroma_row_start,
+            chroma_row_end);
+
+        // Padded rows to unpack, with the padding above and below the picture
+        uint32_t luma_pad_start = luma_row_start ? luma_row_start + refPicPtr->origin_y : 0;
+        uint32_t luma_pad_end = luma_row_end == refPic16BitPtr->height ?
+            (uint32_t)(refPic16BitPtr->height + (refPicPtr->origin_y << 1)) : luma_row_end + refPicPtr->origin_y;
+        uint32_t chroma_pad_start = chroma_row_start ? chroma_row_start + (refPicPtr->origin_y >> 1) : 0;
+        uint32_t chroma_pad_end = chroma_row_end == (uint32_t)(refPic16BitPtr->height >> 1) ?
+            (uint32_t)((refPic16BitPtr->height + (refPicPtr->origin_y << 1)) >> 1) : chroma_row_end + (refPicPtr->origin_y >> 1);
 
         // Hsan: unpack ref samples (to be used @ MD)
         un_pack2d(
-            (uint16_t*) refPic16BitPtr->buffer_y,
+            (uint16_t*)refPic16BitPtr->buffer_y + luma_pad_start * refPic16BitPtr->stride_y,
             refPic16BitPtr->stride_y,
-            refPicPtr->buffer_y,
+            refPicPtr->buffer_y + luma_pad_start * refPicPtr->stride_y,
             refPicPtr->stride_y,
-            refPicPtr->buffer_bit_inc_y,
+            refPicPtr->buffer_bit_inc_y + luma_pad_start * refPicPtr->stride_bit_inc_y,
             refPicPtr->stride_bit_inc_y,
             refPic16BitPtr->width  + (refPicPtr->origin_x << 1),
-            refPic16BitPtr->height + (refPicPtr->origin_y << 1),
+            luma_pad_end - luma_pad_start,
             sequence_control_set_ptr->static_config.asm_type);
 
         un_pack2d(
-            (uint16_t*)refPic16BitPtr->buffer_cb,
+            (uint16_t*)refPic16BitPtr->buffer_cb + chroma_pad_start * refPic16BitPtr->stride_cb,
             refPic16BitPtr->stride_cb,
-            refPicPtr->buffer_cb,
+            refPicPtr->buffer_cb + chroma_pad_start * refPicPtr->stride_cb,
             refPicPtr->stride_cb,
-            refPicPtr->buffer_bit_inc_cb,
+            refPicPtr->buffer_bit_inc_cb + chroma_pad_start * refPicPtr->stride_bit_inc_cb,
             refPicPtr->stride_bit_inc_cb,
             (refPic16BitPtr->width + (refPicPtr->origin_x << 1)) >> 1,
-            (refPic16BitPtr->height + (refPicPtr->origin_y << 1)) >> 1,
+            chroma_pad_end - chroma_pad_start,
             sequence_control_set_ptr->static_config.asm_type);
 
         un_pack2d(
-            (uint16_t*)refPic16BitPtr->buffer_cr,
+            (uint16_t*)refPic16BitPtr->buffer_cr + chroma_pad_start * refPic16BitPtr->stride_cr,
             refPic16BitPtr->stride_cr,
-            refPicPtr->buffer_cr,
+            refPicPtr->buffer_cr + chroma_pad_start * refPicPtr->stride_cr,
             refPicPtr->stride_cr,
-            refPicPtr->buffer_bit_inc_cr,
+            refPicPtr->buffer_bit_inc_cr + chroma_pad_start * refPicPtr->stride_bit_inc_cr,
             refPicPtr->stride_bit_inc_cr,
             (refPic16BitPtr->width + (refPicPtr->origin_x << 1)) >> 1,
-            (refPic16BitPtr->height + (refPicPtr->origin_y << 1)) >> 1,
+            chroma_pad_end - chroma_pad_start,
             sequence_control_set_ptr->static_config.asm_type);
     }
+}
+
+void set_ref_flags(
+    PictureControlSet    *picture_control_set_ptr)
+{
+    EbReferenceObject   *referenceObject = (EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+
     // set up the ref POC
     referenceObject->ref_poc = picture_control_set_ptr->parent_pcs_ptr->picture_number;
 
@@ -1565,6 +1614,7 @@ void* enc_dec_kernel(void *input_ptr)
         encDecTasksPtr = (EncDecTasks*)encDecTasksWrapperPtr->object_ptr;
         picture_control_set_ptr = (PictureControlSet*)encDecTasksPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_ENC_DEC, picture_control_set_ptr->picture_number);
         segments_ptr = picture_control_set_ptr->enc_dec_segment_ctrl;
         lastLcuFlag = EB_FALSE;
         is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
@@ -1791,6 +1841,7 @@ void* enc_dec_kernel(void *input_ptr)
                 &encDecResultsWrapperPtr);
             encDecResultsPtr = (EncDecResults*)encDecResultsWrapperPtr->object_ptr;
             encDecResultsPtr->picture_control_set_wrapper_ptr = encDecTasksPtr->picture_control_set_wrapper_ptr;
+            encDecResultsPtr->input_type = DLF_TASKS_ENCDEC_INPUT;
             //CHKN these are not needed for DLF
             encDecResultsPtr->completed_lcu_row_index_start = 0;
             encDecResultsPtr->completed_lcu_row_count = ((sequence_control_set_ptr->seq_header.max_frame_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
@@ -88,7 +88,7 @@ extern "C" {
         EbBool                                 is16bit; //enable 10 bit encode in CL
         EbColorFormat                          color_format;
         uint64_t                               tot_intra_coded_area;
-        uint8_t                                intra_coded_area_sb[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
+        uint8_t                               *intra_coded_area_sb;//percentage of intra coded area 0-100%
         uint8_t                                pmp_masking_level_enc_dec;
         EbBool                                 skip_qpm_flag;
         int16_t                                min_delta_qp_weight;
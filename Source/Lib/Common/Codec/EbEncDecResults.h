@@ -12,6 +12,18 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define DLF_TASKS_ENCDEC_INPUT      0
+#define DLF_TASKS_CONTINUE          1
+
+#define CDEF_TASKS_DLF_INPUT        0
+#define CDEF_TASKS_CONTINUE         1
+
+#define REST_TASKS_CDEF_INPUT       0
+#define REST_TASKS_CONTINUE         1
+
+#define EC_TASKS_REST_INPUT         0
+#define EC_TASKS_CONTINUE           1
+
     /**************************************
      * Process Results
      **************************************/
@@ -21,6 +33,7 @@ extern "C" {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         completed_lcu_row_index_start;
         uint32_t         completed_lcu_row_count;
+        uint32_t         input_type;
     } EncDecResults;
 
     typedef struct DlfResults
@@ -28,6 +41,7 @@ extern "C" {
         EbDctor         dctor;
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         segment_index;
+        uint32_t         input_type;
     } DlfResults;
 
     typedef struct CdefResults
@@ -35,6 +49,7 @@ extern "C" {
         EbDctor         dctor;
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         segment_index;
+        uint32_t         input_type;
     } CdefResults;
 
     typedef struct RestResults
@@ -43,6 +58,7 @@ extern "C" {
         EbObjectWrapper *picture_control_set_wrapper_ptr;
         uint32_t         completed_lcu_row_index_start;
         uint32_t         completed_lcu_row_count;
+        uint32_t         input_type;
     } RestResults;
 
     typedef struct EncDecResultsInitData {
@@ -22,6 +22,7 @@
 #include "EbPredictionStructure.h"
 #include "EbRateControlTables.h"
 #include "EbObject.h"
+#include "EbTrace.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH                            128     // should be large enough to hold an entire prediction period
@@ -148,6 +149,9 @@ typedef struct EncodeContext
     EbHandle                                          shared_reference_mutex;
 
     uint64_t                                          picture_number_alt; // The picture number overlay includes all the overlay frames
+
+    // Pipeline trace, NULL when tracing is off
+    EbTrace                                          *trace_ptr;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -772,7 +772,7 @@ static EbErrorType av1_encode_tx_coef_y(
 {
     EbErrorType return_error = EB_ErrorNone;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, context_ptr->sb_sz == 128);
     int32_t cul_level_y = 0;
 
     uint8_t  tx_depth = cu_ptr->tx_depth;
@@ -858,7 +858,7 @@ static EbErrorType av1_encode_tx_coef_uv(
 {
     EbErrorType return_error = EB_ErrorNone;
 
-    const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, context_ptr->sb_sz == 128);
 
     if (!blk_geom->has_uv) return return_error;
 
@@ -1038,7 +1038,7 @@ static EbErrorType Av1EncodeCoeff1D(
             cb_dc_sign_level_coeff_neighbor_array);
     } else {
         // Transform partitioning free patch (except the 128x128 case)
-        const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+        const BlockGeom *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, context_ptr->sb_sz == 128);
         int32_t cul_level_y, cul_level_cb = 0, cul_level_cr = 0;
 
         uint16_t txb_count = blk_geom->txb_count[cu_ptr->tx_depth];
@@ -1704,10 +1704,23 @@ static int16_t Av1ModeContextAnalyzer(
     return comp_ctx;
 }
 
+#define EC_FLUSH_MAX_SIZE 8 // bytes a tile may take past its bit count once flushed
+#define OBU_HEADERS_MAX_SIZE 0x1000 // frame header and tile group OBU headers
+
 EbErrorType encode_slice_finish(
     EntropyCoder        *entropy_coder_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    OutputBitstreamUnit *ec_output_bitstream_ptr = (OutputBitstreamUnit*)entropy_coder_ptr->ec_output_bitstream_ptr;
+
+    // The coder grows its own buffer as the tile is coded, grow the tile
+    // buffer it is copied to when the tile is done
+    return_error = output_bitstream_reserve(
+        ec_output_bitstream_ptr,
+        ((eb_od_ec_enc_tell(&entropy_coder_ptr->ec_writer.ec) + 7) >> 3) + EC_FLUSH_MAX_SIZE);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    entropy_coder_ptr->ec_writer.buffer = ec_output_bitstream_ptr->buffer_av1;
 
     aom_stop_encode(&entropy_coder_ptr->ec_writer);
 
@@ -1827,10 +1840,11 @@ EbErrorType entropy_coder_ctor(
 
     entropy_coder_ptr->ec_output_bitstream_ptr = output_bitstream_ptr;
 
+    // Only reset, nothing is written to it
     EB_NEW(
         output_bitstream_ptr,
         output_bitstream_unit_ctor,
-        buffer_size);
+        0);
     ((CabacEncodeContext*)entropy_coder_ptr->cabac_encode_context_ptr)->bac_enc_context.m_pc_t_com_bit_if = output_bitstream_ptr;
     return return_error;
 }
@@ -4716,11 +4730,25 @@ EbErrorType write_frame_header_av1(
     EbErrorType                 return_error = EB_ErrorNone;
     OutputBitstreamUnit       *output_bitstream_ptr = (OutputBitstreamUnit*)bitstream_ptr->output_bitstream_ptr;
     PictureParentControlSet   *parent_pcs_ptr = pcs_ptr->parent_pcs_ptr;
-    uint8_t                     *data = output_bitstream_ptr->buffer_av1;
+    uint8_t                     *data;
     uint32_t obuHeaderSize = 0;
+    uint32_t frame_size = OBU_HEADERS_MAX_SIZE;
 
     int32_t currDataSize = 0;
 
+    // Grow the picture stream to take the headers and the tiles
+    if (!showExisting) {
+        const int tile_count = parent_pcs_ptr->av1_cm->tiles_info.tile_cols * parent_pcs_ptr->av1_cm->tiles_info.tile_rows;
+        for (int tile_idx = 0; tile_idx < tile_count; tile_idx++)
+            frame_size += (uint32_t)pcs_ptr->entropy_tile_info_ptr_array[tile_idx]->entropy_coder_ptr->ec_writer.pos + 4;
+    }
+    return_error = output_bitstream_reserve(
+        output_bitstream_ptr,
+        frame_size);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    data = output_bitstream_ptr->buffer_av1;
+
     const uint8_t obuExtensionHeader = 0;
 
     // A new tile group begins at this tile.  Write the obu header and
@@ -4741,12 +4769,21 @@ EbErrorType write_frame_header_av1(
 
     if (!showExisting) {
         // Add data from EC stream to Picture Stream.
-        int32_t frameSize = (int32_t)(parent_pcs_ptr->av1_cm->tiles_info.tile_cols*parent_pcs_ptr->av1_cm->tiles_info.tile_rows==1 ? pcs_ptr->entropy_coder_ptr->ec_writer.pos : pcs_ptr->entropy_coder_ptr->ec_frame_size);
-        OutputBitstreamUnit *ec_output_bitstream_ptr = (OutputBitstreamUnit*)pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr;
-        //****************************************************************//
-        // Copy from EC stream to frame stream
-        memcpy(data + currDataSize, ec_output_bitstream_ptr->buffer_begin_av1, frameSize);
-        currDataSize += (frameSize);
+        const int tile_count = parent_pcs_ptr->av1_cm->tiles_info.tile_cols * parent_pcs_ptr->av1_cm->tiles_info.tile_rows;
+        for (int tile_idx = 0; tile_idx < tile_count; tile_idx++) {
+            EntropyCoder *entropy_coder_ptr = pcs_ptr->entropy_tile_info_ptr_array[tile_idx]->entropy_coder_ptr;
+            int32_t tileSize = (int32_t)entropy_coder_ptr->ec_writer.pos;
+            OutputBitstreamUnit *ec_output_bitstream_ptr = (OutputBitstreamUnit*)entropy_coder_ptr->ec_output_bitstream_ptr;
+            // Every tile but the last one is preceded by its size
+            if (tile_idx != tile_count - 1) {
+                mem_put_le32(data + currDataSize, tileSize - AV1_MIN_TILE_SIZE_BYTES);
+                currDataSize += 4;
+            }
+            //****************************************************************//
+            // Copy from EC stream to frame stream
+            memcpy(data + currDataSize, ec_output_bitstream_ptr->buffer_begin_av1, tileSize);
+            currDataSize += (tileSize);
+        }
     }
     const uint32_t obuPayloadSize = currDataSize - obuHeaderSize;
     const size_t lengthFieldSize =
@@ -4850,6 +4887,7 @@ static void Av1writeDeltaQindex(
 static void write_cdef(
     SequenceControlSet     *seqCSetPtr,
     PictureControlSet     *p_pcs_ptr,
+    EntropyTileInfo       *tile_ptr,
     //Av1Common *cm,
     MacroBlockD *const xd,
     AomWriter *w,
@@ -4876,8 +4914,8 @@ static void write_cdef(
 // Initialise when at top left part of the superblock
     if (!(mi_row & (seqCSetPtr->seq_header.sb_mi_size - 1)) &&
         !(mi_col & (seqCSetPtr->seq_header.sb_mi_size - 1))) {  // Top left?
-        p_pcs_ptr->cdef_preset[0] = p_pcs_ptr->cdef_preset[1] = p_pcs_ptr->cdef_preset[2] =
-            p_pcs_ptr->cdef_preset[3] = -1;
+        tile_ptr->cdef_preset[0] = tile_ptr->cdef_preset[1] = tile_ptr->cdef_preset[2] =
+            tile_ptr->cdef_preset[3] = -1;
     }
 
     // Emit CDEF param at first non-skip coding block
@@ -4886,16 +4924,16 @@ static void write_cdef(
         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
         : 0;
 
-    if (p_pcs_ptr->cdef_preset[index] == -1 && !skip) {
+    if (tile_ptr->cdef_preset[index] == -1 && !skip) {
         aom_write_literal(w, mi->mbmi.cdef_strength, frm_hdr->CDEF_params.cdef_bits);
-        p_pcs_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
+        tile_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
     }
 }
 
-void eb_av1_reset_loop_restoration(PictureControlSet     *piCSetPtr) {
+void eb_av1_reset_loop_restoration(EntropyTileInfo *tile_ptr) {
     for (int32_t p = 0; p < 3; ++p) {
-        set_default_wiener(piCSetPtr->wiener_info + p);
-        set_default_sgrproj(piCSetPtr->sgrproj_info + p);
+        set_default_wiener(tile_ptr->wiener_info + p);
+        set_default_sgrproj(tile_ptr->sgrproj_info + p);
     }
 }
 static void write_wiener_filter(int32_t wiener_win, const WienerInfo *wiener_info,
@@ -4973,7 +5011,7 @@ static void write_sgrproj_filter(const SgrprojInfo *sgrproj_info,
 
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
-static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
+static void loop_restoration_write_sb_coeffs(EntropyTileInfo *tile_ptr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
     //MacroBlockD *xd,
     const RestorationUnitInfo *rui,
     AomWriter *const w, int32_t plane/*,
@@ -4987,8 +5025,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, F
 //    assert(!cm->all_lossless);
 
     const int32_t wiener_win = (plane > 0) ? WIENER_WIN_CHROMA : WIENER_WIN;
-    WienerInfo *wiener_info = piCSetPtr->wiener_info + plane;
-    SgrprojInfo *sgrproj_info = piCSetPtr->sgrproj_info + plane;
+    WienerInfo *wiener_info = tile_ptr->wiener_info + plane;
+    SgrprojInfo *sgrproj_info = tile_ptr->sgrproj_info + plane;
     RestorationType unit_rtype = rui->restoration_type;
 
     assert(unit_rtype < CDF_SIZE(RESTORE_SWITCHABLE_TYPES));
@@ -5041,8 +5079,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, F
 }
 
 EbErrorType ec_update_neighbors(
-    PictureControlSet     *picture_control_set_ptr,
     EntropyCodingContext  *context_ptr,
+    EntropyTileInfo       *tile_ptr,
     uint32_t                 blkOriginX,
     uint32_t                 blkOriginY,
     CodingUnit            *cu_ptr,
@@ -5051,17 +5089,17 @@ EbErrorType ec_update_neighbors(
 {
     UNUSED(coeff_ptr);
     EbErrorType return_error = EB_ErrorNone;
-    NeighborArrayUnit     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
-    NeighborArrayUnit     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
-    const BlockGeom         *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    NeighborArrayUnit     *mode_type_neighbor_array = tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit     *partition_context_neighbor_array = tile_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit     *skip_flag_neighbor_array = tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit     *skip_coeff_neighbor_array = tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *inter_pred_dir_neighbor_array = tile_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit     *ref_frame_type_neighbor_array = tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32   *interpolation_type_neighbor_array = tile_ptr->interpolation_type_neighbor_array;
+    const BlockGeom         *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, context_ptr->sb_sz == 128);
     EbBool                   skipCoeff = EB_FALSE;
     PartitionContext         partition;
 
@@ -5701,6 +5739,7 @@ static INLINE int get_segment_id(Av1Common *cm,
 }
 
 int get_spatial_seg_prediction(PictureControlSet *picture_control_set_ptr,
+                               MacroBlockD *xd,
                                uint32_t blkOriginX,
                                uint32_t blkOriginY,
                                int *cdf_index) {
@@ -5712,8 +5751,9 @@ int get_spatial_seg_prediction(PictureControlSet *picture_control_set_ptr,
     uint32_t mi_col = blkOriginX >> MI_SIZE_LOG2;
     uint32_t mi_row = blkOriginY >> MI_SIZE_LOG2;
 
-    EbBool left_available = mi_col > 0 ? EB_TRUE : EB_FALSE;
-    EbBool up_available = mi_row > 0 ? EB_TRUE : EB_FALSE;
+    // The neighbors of other tiles are not available, as in the decoder
+    EbBool left_available = xd->left_available ? EB_TRUE : EB_FALSE;
+    EbBool up_available = xd->up_available ? EB_TRUE : EB_FALSE;
     Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
     SegmentationNeighborMap *segmentation_map = picture_control_set_ptr->segmentation_neighbor_map;
 
@@ -5773,11 +5813,11 @@ int eb_av1_neg_interleave(int x, int ref, int max) {
 }
 
 
-int av1_get_pred_context_seg_id(PictureControlSet *picture_control_set_ptr,
+int av1_get_pred_context_seg_id(EntropyTileInfo *tile_ptr,
                                 CodingUnit *cu_ptr,
                                 uint32_t blkOriginX,
                                 uint32_t blkOriginY) {
-    NeighborArrayUnit *seg_id_pred_neighbor_array = picture_control_set_ptr->segmentation_id_pred_array;
+    NeighborArrayUnit *seg_id_pred_neighbor_array = tile_ptr->segmentation_id_pred_array;
     uint32_t top_idx = get_neighbor_array_unit_top_index(seg_id_pred_neighbor_array, blkOriginX);
     uint32_t left_idx = get_neighbor_array_unit_left_index(seg_id_pred_neighbor_array, blkOriginY);
 
@@ -5786,13 +5826,13 @@ int av1_get_pred_context_seg_id(PictureControlSet *picture_control_set_ptr,
     return above_pred + left_pred;
 }
 
-AomCdfProb *av1_get_pred_cdf_seg_id(PictureControlSet *picture_control_set_ptr,
+AomCdfProb *av1_get_pred_cdf_seg_id(EntropyTileInfo *tile_ptr,
                                       FRAME_CONTEXT *frameContext,
                                       CodingUnit *cu_ptr,
                                       uint32_t blkOriginX,
                                       uint32_t blkOriginY) {
     struct segmentation_probs *segp = &frameContext->seg;
-    return segp->spatial_pred_seg_cdf[av1_get_pred_context_seg_id(picture_control_set_ptr, cu_ptr, blkOriginX, blkOriginY)];
+    return segp->spatial_pred_seg_cdf[av1_get_pred_context_seg_id(tile_ptr, cu_ptr, blkOriginX, blkOriginY)];
 }
 
 static INLINE void update_segmentation_map(PictureControlSet *picture_control_set_ptr,
@@ -5831,7 +5871,7 @@ void write_segment_id(PictureControlSet *picture_control_set_ptr,
     if (!segmentationParams->segmentation_enabled)
         return;
     int cdf_num;
-    const int pred = get_spatial_seg_prediction(picture_control_set_ptr, blkOriginX, blkOriginY, &cdf_num);
+    const int pred = get_spatial_seg_prediction(picture_control_set_ptr, cu_ptr->av1xd, blkOriginX, blkOriginY, &cdf_num);
     if (skip_coeff) {
 //        SVT_LOG("BlockY = %d, BlockX = %d \n", blkOriginY>>2, blkOriginX>>2);
         update_segmentation_map(picture_control_set_ptr, bsize, blkOriginX, blkOriginY, pred);
@@ -5936,29 +5976,30 @@ int is_interintra_wedge_used(BlockSize sb_type);
 EbErrorType write_modes_b(
     PictureControlSet     *picture_control_set_ptr,
     EntropyCodingContext  *context_ptr,
-    EntropyCoder          *entropy_coder_ptr,
+    EntropyTileInfo       *tile_ptr,
     LargestCodingUnit     *tb_ptr,
     CodingUnit            *cu_ptr,
     EbPictureBufferDesc   *coeff_ptr)
 {
     UNUSED(tb_ptr);
     EbErrorType return_error = EB_ErrorNone;
+    EntropyCoder            *entropy_coder_ptr = tile_ptr->entropy_coder_ptr;
     FRAME_CONTEXT           *frameContext = entropy_coder_ptr->fc;
     AomWriter              *ec_writer = &entropy_coder_ptr->ec_writer;
     SequenceControlSet     *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
     FrameHeader *frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
 
-    NeighborArrayUnit     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit     *intra_luma_mode_neighbor_array = picture_control_set_ptr->intra_luma_mode_neighbor_array;
-    NeighborArrayUnit     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
-    NeighborArrayUnit     *txfm_context_array = picture_control_set_ptr->txfm_context_array;
-    const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    NeighborArrayUnit     *mode_type_neighbor_array = tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit     *intra_luma_mode_neighbor_array = tile_ptr->intra_luma_mode_neighbor_array;
+    NeighborArrayUnit     *skip_flag_neighbor_array = tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit     *skip_coeff_neighbor_array = tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit     *luma_dc_sign_level_coeff_neighbor_array = tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cr_dc_sign_level_coeff_neighbor_array = tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *cb_dc_sign_level_coeff_neighbor_array = tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit     *ref_frame_type_neighbor_array = tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32   *interpolation_type_neighbor_array = tile_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit     *txfm_context_array = tile_ptr->txfm_context_array;
+    const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, context_ptr->sb_sz == 128);
     uint32_t blkOriginX = context_ptr->sb_origin_x + blk_geom->origin_x;
     uint32_t blkOriginY = context_ptr->sb_origin_y + blk_geom->origin_y;
     BlockSize bsize = blk_geom->bsize;
@@ -6010,6 +6051,7 @@ assert(bsize < BlockSizeS_ALL);
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            tile_ptr,
             cu_ptr->av1xd,
             ec_writer,
             skipCoeff,
@@ -6023,7 +6065,7 @@ assert(bsize < BlockSizeS_ALL);
                 (((blkOriginX >> 2) & (sequence_control_set_ptr->seq_header.sb_mi_size - 1)) == 0);
             if ((bsize != sequence_control_set_ptr->seq_header.sb_size || skipCoeff == 0) && super_block_upper_left) {
                 assert(current_q_index > 0);
-                int32_t reduced_delta_qindex = (current_q_index - picture_control_set_ptr->parent_pcs_ptr->prev_qindex) / frm_hdr->delta_q_params.delta_q_res;
+                int32_t reduced_delta_qindex = (current_q_index - tile_ptr->prev_qindex) / frm_hdr->delta_q_params.delta_q_res;
 
                 //write_delta_qindex(xd, reduced_delta_qindex, w);
                 Av1writeDeltaQindex(
@@ -6037,7 +6079,7 @@ assert(bsize < BlockSizeS_ALL);
                 current_q_index,
                 picture_control_set_ptr->parent_pcs_ptr->prev_qindex);
                 }*/
-                picture_control_set_ptr->parent_pcs_ptr->prev_qindex = current_q_index;
+                tile_ptr->prev_qindex = current_q_index;
             }
         }
 #endif
@@ -6152,6 +6194,7 @@ assert(bsize < BlockSizeS_ALL);
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr, /*cm,*/
+            tile_ptr,
             cu_ptr->av1xd,
             ec_writer,
             cu_ptr->skip_flag ? 1 : skipCoeff,
@@ -6163,12 +6206,12 @@ assert(bsize < BlockSizeS_ALL);
             int32_t super_block_upper_left = (((blkOriginY >> 2) & (sequence_control_set_ptr->seq_header.sb_mi_size - 1)) == 0) && (((blkOriginX >> 2) & (sequence_control_set_ptr->seq_header.sb_mi_size - 1)) == 0);
             if ((bsize != sequence_control_set_ptr->seq_header.sb_size || skipCoeff == 0) && super_block_upper_left) {
                 assert(current_q_index > 0);
-                int32_t reduced_delta_qindex = (current_q_index - picture_control_set_ptr->parent_pcs_ptr->prev_qindex) / frm_hdr->delta_q_params.delta_q_res;
+                int32_t reduced_delta_qindex = (current_q_index - tile_ptr->prev_qindex) / frm_hdr->delta_q_params.delta_q_res;
                 Av1writeDeltaQindex(
                     frameContext,
                     reduced_delta_qindex,
                     ec_writer);
-                picture_control_set_ptr->parent_pcs_ptr->prev_qindex = current_q_index;
+                tile_ptr->prev_qindex = current_q_index;
             }
         }
 
@@ -6489,8 +6532,8 @@ assert(bsize < BlockSizeS_ALL);
     }
     // Update the neighbors
     ec_update_neighbors(
-        picture_control_set_ptr,
         context_ptr,
+        tile_ptr,
         blkOriginX,
         blkOriginY,
         cu_ptr,
@@ -6506,14 +6549,15 @@ EB_EXTERN EbErrorType write_sb(
     EntropyCodingContext  *context_ptr,
     LargestCodingUnit     *tb_ptr,
     PictureControlSet     *picture_control_set_ptr,
-    EntropyCoder          *entropy_coder_ptr,
+    EntropyTileInfo       *tile_ptr,
     EbPictureBufferDesc   *coeff_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EntropyCoder            *entropy_coder_ptr = tile_ptr->entropy_coder_ptr;
     FRAME_CONTEXT           *frameContext = entropy_coder_ptr->fc;
     AomWriter              *ec_writer = &entropy_coder_ptr->ec_writer;
     SequenceControlSet     *sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-    NeighborArrayUnit     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit     *partition_context_neighbor_array = tile_ptr->partition_context_neighbor_array;
 
     // CU Varaiables
     const BlockGeom          *blk_geom;
@@ -6537,7 +6581,7 @@ EB_EXTERN EbErrorType write_sb(
 
         cu_ptr = &tb_ptr->final_cu_arr[final_cu_index];
 
-        blk_geom = get_blk_geom_mds(cu_index); // AMIR to be replaced with /*cu_ptr->mds_idx*/
+        blk_geom = get_blk_geom_mds(cu_index, context_ptr->sb_sz == 128); // AMIR to be replaced with /*cu_ptr->mds_idx*/
 
         bsize = blk_geom->bsize;
         assert(bsize < BlockSizeS_ALL);
@@ -6545,7 +6589,7 @@ EB_EXTERN EbErrorType write_sb(
         cu_origin_y = context_ptr->sb_origin_y + blk_geom->origin_y;
         if (checkCuOutOfBound) {
             if (blk_geom->shape != PART_N)
-                blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                blk_geom = get_blk_geom_mds(blk_geom->sqi_mds, context_ptr->sb_sz == 128);
             codeCuCond = EB_FALSE;
             if (((cu_origin_x + blk_geom->bwidth / 2 < sequence_control_set_ptr->seq_header.max_frame_width) || (cu_origin_y + blk_geom->bheight / 2 < sequence_control_set_ptr->seq_header.max_frame_height)) &&
                 cu_origin_x < sequence_control_set_ptr->seq_header.max_frame_width && cu_origin_y < sequence_control_set_ptr->seq_header.max_frame_height)
@@ -6574,7 +6618,7 @@ EB_EXTERN EbErrorType write_sb(
                                 const int32_t runit_idx = tile_tl_idx + rcol + rrow * rstride;
                                 const RestorationUnitInfo *rui =
                                     &cm->rst_info[plane].unit_info[runit_idx];
-                                loop_restoration_write_sb_coeffs(picture_control_set_ptr, frameContext, cm, /*xd,*/ rui, ec_writer, plane);
+                                loop_restoration_write_sb_coeffs(tile_ptr, frameContext, cm, /*xd,*/ rui, ec_writer, plane);
                             }
                         }
                     }
@@ -6597,7 +6641,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6607,7 +6651,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6618,7 +6662,7 @@ EB_EXTERN EbErrorType write_sb(
                     write_modes_b(
                         picture_control_set_ptr,
                         context_ptr,
-                        entropy_coder_ptr,
+                        tile_ptr,
                         tb_ptr,
                         cu_ptr,
                         coeff_ptr);
@@ -6629,7 +6673,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6639,7 +6683,7 @@ EB_EXTERN EbErrorType write_sb(
                     write_modes_b(
                         picture_control_set_ptr,
                         context_ptr,
-                        entropy_coder_ptr,
+                        tile_ptr,
                         tb_ptr,
                         cu_ptr,
                         coeff_ptr);
@@ -6651,7 +6695,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6661,7 +6705,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6671,7 +6715,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6681,7 +6725,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6691,7 +6735,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6701,7 +6745,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6711,7 +6755,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6721,7 +6765,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6731,7 +6775,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6741,7 +6785,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6751,7 +6795,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6761,7 +6805,7 @@ EB_EXTERN EbErrorType write_sb(
                 write_modes_b(
                     picture_control_set_ptr,
                     context_ptr,
-                    entropy_coder_ptr,
+                    tile_ptr,
                     tb_ptr,
                     cu_ptr,
                     coeff_ptr);
@@ -6779,7 +6823,7 @@ EB_EXTERN EbErrorType write_sb(
                     write_modes_b(
                         picture_control_set_ptr,
                         context_ptr,
-                        entropy_coder_ptr,
+                        tile_ptr,
                         tb_ptr,
                         cu_ptr,
                         coeff_ptr);
@@ -6796,7 +6840,7 @@ EB_EXTERN EbErrorType write_sb(
                     write_modes_b(
                         picture_control_set_ptr,
                         context_ptr,
-                        entropy_coder_ptr,
+                        tile_ptr,
                         tb_ptr,
                         cu_ptr,
                         coeff_ptr);
@@ -21,8 +21,7 @@
 #include "EbEntropyCodingResults.h"
 #include "EbRateControlTasks.h"
 #include "EbCabacContextModel.h"
-#define  AV1_MIN_TILE_SIZE_BYTES 1
-void eb_av1_reset_loop_restoration(PictureControlSet     *piCSetPtr);
+void eb_av1_reset_loop_restoration(EntropyTileInfo *tile_ptr);
 void eb_av1_tile_set_col(TileInfo *tile, PictureParentControlSet * pcs_ptr, int col);
 void eb_av1_tile_set_row(TileInfo *tile, PictureParentControlSet * pcs_ptr, int row);
 
@@ -32,6 +31,7 @@ void eb_av1_tile_set_row(TileInfo *tile, PictureParentControlSet * pcs_ptr, int
 EbErrorType entropy_coding_context_ctor(
     EntropyCodingContext  *context_ptr,
     EbFifo                *enc_dec_input_fifo_ptr,
+    EbFifo                *entropy_coding_feedback_fifo_ptr,
     EbFifo                *packetization_output_fifo_ptr,
     EbFifo                *rate_control_output_fifo_ptr,
     EbBool                  is16bit)
@@ -40,6 +40,7 @@ EbErrorType entropy_coding_context_ctor(
 
     // Input/Output System Resource Manager FIFOs
     context_ptr->enc_dec_input_fifo_ptr = enc_dec_input_fifo_ptr;
+    context_ptr->entropy_coding_feedback_fifo_ptr = entropy_coding_feedback_fifo_ptr;
     context_ptr->entropy_coding_output_fifo_ptr = packetization_output_fifo_ptr;
     context_ptr->rate_control_output_fifo_ptr = rate_control_output_fifo_ptr;
 
@@ -49,25 +50,25 @@ EbErrorType entropy_coding_context_ctor(
 /***********************************************
  * Entropy Coding Reset Neighbor Arrays
  ***********************************************/
-static void EntropyCodingResetNeighborArrays(PictureControlSet *picture_control_set_ptr)
+static void EntropyCodingResetNeighborArrays(EntropyTileInfo *tile_ptr)
 {
-    neighbor_array_unit_reset(picture_control_set_ptr->mode_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->mode_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->partition_context_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->partition_context_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_flag_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->skip_flag_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->inter_pred_dir_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->ref_frame_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->skip_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->luma_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->cb_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->cr_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->inter_pred_dir_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->ref_frame_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->intra_luma_mode_neighbor_array);
-    neighbor_array_unit_reset32(picture_control_set_ptr->interpolation_type_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->txfm_context_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->segmentation_id_pred_array);
+    neighbor_array_unit_reset(tile_ptr->intra_luma_mode_neighbor_array);
+    neighbor_array_unit_reset32(tile_ptr->interpolation_type_neighbor_array);
+    neighbor_array_unit_reset(tile_ptr->txfm_context_array);
+    neighbor_array_unit_reset(tile_ptr->segmentation_id_pred_array);
     return;
 }
 
@@ -159,16 +160,22 @@ void eb_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2],
 }
 
 /**************************************************
- * Reset Entropy Coding Picture
+ * Reset Entropy Coding Tile
+ *   Each tile is coded in the bitstream buffer of
+ *   its own entropy coder, the tile size fields are
+ *   written when the tiles are copied to the frame
  **************************************************/
-static void ResetEntropyCodingPicture(
+static void reset_ec_tile(
+    EntropyTileInfo       *tile_ptr,
     EntropyCodingContext  *context_ptr,
     PictureControlSet     *picture_control_set_ptr,
     SequenceControlSet    *sequence_control_set_ptr)
 {
-    reset_bitstream(entropy_coder_get_bitstream_ptr(picture_control_set_ptr->entropy_coder_ptr));
+    EntropyCoder *entropy_coder_ptr = tile_ptr->entropy_coder_ptr;
+
+    reset_bitstream(entropy_coder_get_bitstream_ptr(entropy_coder_ptr));
 
-    uint32_t                       entropyCodingQp;
+    uint32_t                       entropy_coding_qp;
 
     context_ptr->is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
     FrameHeader *frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
@@ -178,103 +185,177 @@ static void ResetEntropyCodingPicture(
     context_ptr->qp = picture_control_set_ptr->picture_qp;
 #endif
     // Asuming cb and cr offset to be the same for chroma QP in both slice and pps for lambda computation
-    entropyCodingQp = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-
+    entropy_coding_qp = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
 #if ADD_DELTA_QP_SUPPORT
-    picture_control_set_ptr->parent_pcs_ptr->prev_qindex = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
+    tile_ptr->prev_qindex = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
     if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc)
         assert(picture_control_set_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present == 0);
     if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present) {
-        picture_control_set_ptr->parent_pcs_ptr->prev_delta_lf_from_base = 0;
+        tile_ptr->prev_delta_lf_from_base = 0;
         const int32_t frame_lf_count =
             picture_control_set_ptr->parent_pcs_ptr->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
         for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id)
-            picture_control_set_ptr->parent_pcs_ptr->prev_delta_lf[lf_id] = 0;
+            tile_ptr->prev_delta_lf[lf_id] = 0;
     }
 #endif
 
     // pass the ent
-    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(picture_control_set_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(entropy_coder_ptr->ec_output_bitstream_ptr);
     //****************************************************************//
 
     uint8_t *data = output_bitstream_ptr->buffer_av1;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ec_writer, data);
+    entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
+    entropy_coder_ptr->ec_writer.allow_update_cdf =
+        entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
+    aom_start_encode(&entropy_coder_ptr->ec_writer, data);
 
     // ADD Reset here
     if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-        memcpy(picture_control_set_ptr->entropy_coder_ptr->fc, &picture_control_set_ptr->ref_frame_context[picture_control_set_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame], sizeof(FRAME_CONTEXT));
+        memcpy(entropy_coder_ptr->fc, &picture_control_set_ptr->ref_frame_context[picture_control_set_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame], sizeof(FRAME_CONTEXT));
     else
+        //reset probabilities
         reset_entropy_coder(
             sequence_control_set_ptr->encode_context_ptr,
-            picture_control_set_ptr->entropy_coder_ptr,
-            entropyCodingQp,
+            entropy_coder_ptr,
+            entropy_coding_qp,
             picture_control_set_ptr->slice_type);
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    EntropyCodingResetNeighborArrays(tile_ptr);
 
     return;
 }
 
-static void reset_ec_tile(
-    uint32_t  total_size,
-    uint32_t  is_last_tile_in_tg,
+/**************************************************
+ * Entropy Coding Picture Done
+ *   Releases the reference pictures and sends the
+ *   picture to packetization
+ **************************************************/
+static void entropy_coding_picture_done(
     EntropyCodingContext  *context_ptr,
     PictureControlSet     *picture_control_set_ptr,
-    SequenceControlSet    *sequence_control_set_ptr)
+    EbObjectWrapper       *picture_control_set_wrapper_ptr)
 {
-    reset_bitstream(entropy_coder_get_bitstream_ptr(picture_control_set_ptr->entropy_coder_ptr));
-
-    uint32_t                       entropy_coding_qp;
-
-    context_ptr->is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-    FrameHeader *frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
-    // QP
-#if ADD_DELTA_QP_SUPPORT
-#else
-    context_ptr->qp = picture_control_set_ptr->picture_qp;
-#endif
-    entropy_coding_qp = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-#if ADD_DELTA_QP_SUPPORT
-    picture_control_set_ptr->parent_pcs_ptr->prev_qindex = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-    if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc)
-        assert(picture_control_set_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present == 0);
-    if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present) {
-        picture_control_set_ptr->parent_pcs_ptr->prev_delta_lf_from_base = 0;
-        const int32_t frame_lf_count =
-            picture_control_set_ptr->parent_pcs_ptr->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
-        for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id)
-            picture_control_set_ptr->parent_pcs_ptr->prev_delta_lf[lf_id] = 0;
+    EbObjectWrapper       *entropyCodingResultsWrapperPtr;
+    EntropyCodingResults  *entropyCodingResultsPtr;
+    uint32_t               ref_idx;
+
+    // Release the List 0 Reference Pictures
+    for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
+        if (picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL)
+            eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx]);
     }
-#endif
 
-    // pass the ent
-    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(picture_control_set_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
-    //****************************************************************//
+    // Release the List 1 Reference Pictures
+    for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
+        if (picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
+            eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx]);
+    }
 
-    uint8_t *data = output_bitstream_ptr->buffer_av1 + total_size;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
-    picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        picture_control_set_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
+    // Get Empty Entropy Coding Results
+    eb_get_empty_object(
+        context_ptr->entropy_coding_output_fifo_ptr,
+        &entropyCodingResultsWrapperPtr);
+    entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
+    entropyCodingResultsPtr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
 
-    //if not last tile, advance buffer by 4B to leave space for tile Size
-    if (is_last_tile_in_tg == 0)
-        data += 4;
+    // Post EntropyCoding Results
+    eb_post_full_object(entropyCodingResultsWrapperPtr);
+}
 
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ec_writer, data);
-    if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-        memcpy(picture_control_set_ptr->entropy_coder_ptr->fc, &picture_control_set_ptr->ref_frame_context[picture_control_set_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame], sizeof(FRAME_CONTEXT));
-    else
-        //reset probabilities
-        reset_entropy_coder(
-            sequence_control_set_ptr->encode_context_ptr,
-            picture_control_set_ptr->entropy_coder_ptr,
-            entropy_coding_qp,
-            picture_control_set_ptr->slice_type);
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+/******************************************************
+ * Entropy Coding Tiles
+ *   Codes the tiles of the picture that are still
+ *   free, the tiles are independent so any number of
+ *   EC threads can work on the same picture. The
+ *   thread coding the last tile sends the picture
+ *   to packetization. A tile whose buffer can not be
+ *   grown flags the picture with the error.
+ ******************************************************/
+static void entropy_coding_tiles(
+    EntropyCodingContext  *context_ptr,
+    PictureControlSet     *picture_control_set_ptr,
+    SequenceControlSet    *sequence_control_set_ptr,
+    EbObjectWrapper       *picture_control_set_wrapper_ptr)
+{
+    for (;;) {
+        uint16_t tile_idx;
+        EbBool   tile_available;
+        EbBool   picture_done;
+
+        eb_block_on_mutex(picture_control_set_ptr->entropy_coding_mutex);
+        tile_idx = picture_control_set_ptr->entropy_coding_tile_index;
+        tile_available = (EbBool)(tile_idx < picture_control_set_ptr->entropy_coding_tile_count);
+        if (tile_available)
+            picture_control_set_ptr->entropy_coding_tile_index++;
+        eb_release_mutex(picture_control_set_ptr->entropy_coding_mutex);
+
+        if (!tile_available)
+            break;
+
+        PictureParentControlSet *ppcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
+        Av1Common *const cm = ppcs_ptr->av1_cm;
+        EntropyTileInfo *tile_ptr = picture_control_set_ptr->entropy_tile_info_ptr_array[tile_idx];
+        const int tile_row = tile_idx / cm->tiles_info.tile_cols;
+        const int tile_col = tile_idx % cm->tiles_info.tile_cols;
+        const uint8_t lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
+        const uint32_t picture_width_in_sb = (sequence_control_set_ptr->seq_header.max_frame_width + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2;
+        uint64_t tile_total_bits = 0;
+        EbErrorType return_error;
+        uint32_t x_lcu_index;
+        uint32_t y_lcu_index;
+        TileInfo tile_info;
+
+        context_ptr->sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
+        reset_ec_tile(
+            tile_ptr,
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+
+        eb_av1_tile_set_row(&tile_info, ppcs_ptr, tile_row);
+        eb_av1_tile_set_col(&tile_info, ppcs_ptr, tile_col);
+
+        eb_av1_reset_loop_restoration(tile_ptr);
+
+        for (y_lcu_index = cm->tiles_info.tile_row_start_sb[tile_row]; y_lcu_index < (uint32_t)cm->tiles_info.tile_row_start_sb[tile_row + 1]; ++y_lcu_index)
+        {
+            for (x_lcu_index = cm->tiles_info.tile_col_start_sb[tile_col]; x_lcu_index < (uint32_t)cm->tiles_info.tile_col_start_sb[tile_col + 1]; ++x_lcu_index)
+            {
+                uint16_t sb_index = (uint16_t)(x_lcu_index + y_lcu_index * picture_width_in_sb);
+                LargestCodingUnit *sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
+                context_ptr->sb_origin_x = x_lcu_index << lcuSizeLog2;
+                context_ptr->sb_origin_y = y_lcu_index << lcuSizeLog2;
+                sb_ptr->total_bits = 0;
+                uint32_t prev_pos = tile_ptr->entropy_coder_ptr->ec_writer.ec.offs;//residual_bc.pos
+                EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
+                write_sb(
+                    context_ptr,
+                    sb_ptr,
+                    picture_control_set_ptr,
+                    tile_ptr,
+                    coeff_picture_ptr);
+                sb_ptr->total_bits = (tile_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
+                tile_total_bits += sb_ptr->total_bits;
+            }
+        }
 
-    return;
+        return_error = encode_slice_finish(tile_ptr->entropy_coder_ptr);
+        assert(return_error != EB_ErrorNone ||
+            tile_ptr->entropy_coder_ptr->ec_writer.pos >= AV1_MIN_TILE_SIZE_BYTES);
+
+        eb_block_on_mutex(picture_control_set_ptr->entropy_coding_mutex);
+        if (return_error != EB_ErrorNone)
+            picture_control_set_ptr->entropy_coding_error = return_error;
+        ppcs_ptr->quantized_coeff_num_bits += tile_total_bits;
+        picture_done = (EbBool)(++picture_control_set_ptr->entropy_coding_tile_done_count == picture_control_set_ptr->entropy_coding_tile_count);
+        eb_release_mutex(picture_control_set_ptr->entropy_coding_mutex);
+
+        //the picture is complete, terminate the slice
+        if (picture_done)
+            entropy_coding_picture_done(
+                context_ptr,
+                picture_control_set_ptr,
+                picture_control_set_wrapper_ptr);
+    }
 }
 
 /******************************************************
@@ -374,12 +455,12 @@ void* entropy_coding_kernel(void *input_ptr)
     SequenceControlSet                    *sequence_control_set_ptr;
 
     // Input
-    EbObjectWrapper                       *encDecResultsWrapperPtr;
-    EncDecResults                         *encDecResultsPtr;
+    EbObjectWrapper                       *rest_results_wrapper_ptr;
+    RestResults                           *rest_results_ptr;
 
-    // Output
-    EbObjectWrapper                       *entropyCodingResultsWrapperPtr;
-    EntropyCodingResults                  *entropyCodingResultsPtr;
+    // Feedback
+    EbObjectWrapper                       *feedback_wrapper_ptr;
+    RestResults                           *feedback_ptr;
 
     // SB Loop variables
     LargestCodingUnit                     *sb_ptr;
@@ -394,33 +475,46 @@ void* entropy_coding_kernel(void *input_ptr)
     // Variables
     EbBool                                  initialProcessCall;
     for (;;) {
-        // Get Mode Decision Results
+        // Get Rest Results
         eb_get_full_object(
             context_ptr->enc_dec_input_fifo_ptr,
-            &encDecResultsWrapperPtr);
-        encDecResultsPtr = (EncDecResults*)encDecResultsWrapperPtr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet*)encDecResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
+            &rest_results_wrapper_ptr);
+        rest_results_ptr = (RestResults*)rest_results_wrapper_ptr->object_ptr;
+        picture_control_set_ptr = (PictureControlSet*)rest_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-        // SB Constants
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_ENTROPY_CODING, picture_control_set_ptr->picture_number);
+
+        if (rest_results_ptr->input_type == EC_TASKS_CONTINUE) {
+            // The picture may be done already, its tiles are only read under the mutex
+            entropy_coding_tiles(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                rest_results_ptr->picture_control_set_wrapper_ptr);
+            eb_release_object(rest_results_ptr->picture_control_set_wrapper_ptr);
+        }
+        else if (picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows == 1)
+        {
+            EntropyTileInfo *tile_ptr = picture_control_set_ptr->entropy_tile_info_ptr_array[0];
 
-        sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
+            // SB Constants
+            sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
 
-        lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
-        context_ptr->sb_sz = sb_sz;
-        picture_width_in_sb = (sequence_control_set_ptr->seq_header.max_frame_width + sb_sz - 1) >> lcuSizeLog2;
-        if(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows == 1)
+            lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
+            context_ptr->sb_sz = sb_sz;
+            picture_width_in_sb = (sequence_control_set_ptr->seq_header.max_frame_width + sb_sz - 1) >> lcuSizeLog2;
 
-        {
             initialProcessCall = EB_TRUE;
-            y_lcu_index = encDecResultsPtr->completed_lcu_row_index_start;
+            y_lcu_index = rest_results_ptr->completed_lcu_row_index_start;
 
             // LCU-loops
-            while (UpdateEntropyCodingRows(picture_control_set_ptr, &y_lcu_index, encDecResultsPtr->completed_lcu_row_count, &initialProcessCall) == EB_TRUE)
+            while (UpdateEntropyCodingRows(picture_control_set_ptr, &y_lcu_index, rest_results_ptr->completed_lcu_row_count, &initialProcessCall) == EB_TRUE)
             {
                 uint32_t rowTotalBits = 0;
 
                 if (y_lcu_index == 0) {
-                    ResetEntropyCodingPicture(
+                    reset_ec_tile(
+                        tile_ptr,
                         context_ptr,
                         picture_control_set_ptr,
                         sequence_control_set_ptr);
@@ -437,17 +531,17 @@ void* entropy_coding_kernel(void *input_ptr)
                     context_ptr->sb_origin_x = sb_origin_x;
                     context_ptr->sb_origin_y = sb_origin_y;
                     if (sb_index == 0)
-                        eb_av1_reset_loop_restoration(picture_control_set_ptr);
+                        eb_av1_reset_loop_restoration(tile_ptr);
                     sb_ptr->total_bits = 0;
-                    uint32_t prev_pos = sb_index ? picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs : 0;//residual_bc.pos
+                    uint32_t prev_pos = sb_index ? tile_ptr->entropy_coder_ptr->ec_writer.ec.offs : 0;//residual_bc.pos
                     EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
                     write_sb(
                         context_ptr,
                         sb_ptr,
                         picture_control_set_ptr,
-                        picture_control_set_ptr->entropy_coder_ptr,
+                        tile_ptr,
                         coeff_picture_ptr);
-                    sb_ptr->total_bits = (picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
+                    sb_ptr->total_bits = (tile_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
                     picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
                     rowTotalBits += sb_ptr->total_bits;
                 }
@@ -479,35 +573,15 @@ void* entropy_coding_kernel(void *input_ptr)
                     // If the picture is complete, terminate the slice
                     if (picture_control_set_ptr->entropy_coding_current_row == picture_control_set_ptr->entropy_coding_row_count)
                     {
-                        uint32_t ref_idx;
-
                         picture_control_set_ptr->entropy_coding_pic_done = EB_TRUE;
 
-                        encode_slice_finish(picture_control_set_ptr->entropy_coder_ptr);
-
-                        // Release the List 0 Reference Pictures
-                        for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL) {
-
-                                eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx]);
-                            }
-                        }
-
-                        // Release the List 1 Reference Pictures
-                        for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
-                                eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx]);
-                        }
+                        picture_control_set_ptr->entropy_coding_error =
+                            encode_slice_finish(tile_ptr->entropy_coder_ptr);
 
-                        // Get Empty Entropy Coding Results
-                        eb_get_empty_object(
-                            context_ptr->entropy_coding_output_fifo_ptr,
-                            &entropyCodingResultsWrapperPtr);
-                        entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
-                        entropyCodingResultsPtr->picture_control_set_wrapper_ptr = encDecResultsPtr->picture_control_set_wrapper_ptr;
-
-                        // Post EntropyCoding Results
-                        eb_post_full_object(entropyCodingResultsWrapperPtr);
+                        entropy_coding_picture_done(
+                            context_ptr,
+                            picture_control_set_ptr,
+                            rest_results_ptr->picture_control_set_wrapper_ptr);
                     } // End if(PictureCompleteFlag)
                 }
                 eb_release_mutex(picture_control_set_ptr->entropy_coding_mutex);
@@ -515,112 +589,43 @@ void* entropy_coding_kernel(void *input_ptr)
         }
         else
         {
-             struct PictureParentControlSet     *ppcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
-             Av1Common *const cm = ppcs_ptr->av1_cm;
-             uint32_t total_size = 0;
-             int tile_row, tile_col;
-             const int tile_cols = ppcs_ptr->av1_cm->tiles_info.tile_cols;
-             const int tile_rows = ppcs_ptr->av1_cm->tiles_info.tile_rows;
-
-             //Entropy Tile Loop
-             for (tile_row = 0; tile_row < tile_rows; tile_row++)
-             {
-                 TileInfo tile_info;
-                 eb_av1_tile_set_row(&tile_info, ppcs_ptr, tile_row);
-
-                 for (tile_col = 0; tile_col < tile_cols; tile_col++)
-                 {
-                     const int tile_idx = tile_row * tile_cols + tile_col;
-                     uint32_t is_last_tile_in_tg = 0;
-
-                     if ( tile_idx == (tile_cols * tile_rows - 1))
-                         is_last_tile_in_tg = 1;
-                     else
-                         is_last_tile_in_tg = 0;
-                     reset_ec_tile(
-                         total_size,
-                         is_last_tile_in_tg,
-                         context_ptr,
-                         picture_control_set_ptr,
-                         sequence_control_set_ptr);
-
-                     eb_av1_tile_set_col(&tile_info, ppcs_ptr, tile_col);
-
-                     eb_av1_reset_loop_restoration(picture_control_set_ptr);
-
-                     for (y_lcu_index = cm->tiles_info.tile_row_start_sb[tile_row]; y_lcu_index < (uint32_t)cm->tiles_info.tile_row_start_sb[tile_row + 1]; ++y_lcu_index)
-                     {
-                         for (x_lcu_index = cm->tiles_info.tile_col_start_sb[tile_col]; x_lcu_index < (uint32_t)cm->tiles_info.tile_col_start_sb[tile_col + 1]; ++x_lcu_index)
-                         {
-                             int sb_index = (uint16_t)(x_lcu_index + y_lcu_index * picture_width_in_sb);
-                             sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
-                             sb_origin_x = x_lcu_index << lcuSizeLog2;
-                             sb_origin_y = y_lcu_index << lcuSizeLog2;
-                             context_ptr->sb_origin_x = sb_origin_x;
-                             context_ptr->sb_origin_y = sb_origin_y;
-                             sb_ptr->total_bits = 0;
-                             uint32_t prev_pos = sb_index ? picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs : 0;//residual_bc.pos
-                             EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
-                             write_sb(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr,
-                                 picture_control_set_ptr->entropy_coder_ptr,
-                                 coeff_picture_ptr);
-                             sb_ptr->total_bits = (picture_control_set_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
-                             picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
-                         }
-                     }
-
-                     encode_slice_finish(picture_control_set_ptr->entropy_coder_ptr);
-
-                     int tile_size = picture_control_set_ptr->entropy_coder_ptr->ec_writer.pos;
-                     assert(tile_size >= AV1_MIN_TILE_SIZE_BYTES);
-
-                     if (!is_last_tile_in_tg) {
-                         OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)(picture_control_set_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
-                         uint8_t *buf_data = output_bitstream_ptr->buffer_av1 + total_size;
-                         mem_put_le32(buf_data, tile_size - AV1_MIN_TILE_SIZE_BYTES);
-                     }
-
-                     if (is_last_tile_in_tg==0)
-                         total_size += 4;
-
-                     total_size += tile_size;
-                 }
-             }
-
-             //the picture is complete, terminate the slice
-             {
-                 uint32_t ref_idx;
-                 picture_control_set_ptr->entropy_coder_ptr->ec_frame_size = total_size;
-
-                 // Release the List 0 Reference Pictures
-                 for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
-                     if (picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL)
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0][ref_idx]);
-                 }
-
-                 // Release the List 1 Reference Pictures
-                 for (ref_idx = 0; ref_idx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
-                     if (picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1][ref_idx]);
-                 }
-
-                 // Get Empty Entropy Coding Results
-                 eb_get_empty_object(
-                     context_ptr->entropy_coding_output_fifo_ptr,
-                     &entropyCodingResultsWrapperPtr);
-                 entropyCodingResultsPtr = (EntropyCodingResults*)entropyCodingResultsWrapperPtr->object_ptr;
-                 entropyCodingResultsPtr->picture_control_set_wrapper_ptr = encDecResultsPtr->picture_control_set_wrapper_ptr;
-
-                 // Post EntropyCoding Results
-                 eb_post_full_object(entropyCodingResultsWrapperPtr);
-             }
+            const uint16_t tile_count = (uint16_t)(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows);
+            uint32_t task_count;
+
+            assert(tile_count <= picture_control_set_ptr->entropy_tile_info_count);
+            picture_control_set_ptr->entropy_coding_tile_count = tile_count;
+            picture_control_set_ptr->entropy_coding_tile_index = 0;
+            picture_control_set_ptr->entropy_coding_tile_done_count = 0;
+
+            // One continue task per other EC thread that can get a tile. Each
+            // task holds the picture until it is done with it
+            task_count = MIN(sequence_control_set_ptr->entropy_coding_process_init_count, tile_count) - 1;
+            if (task_count)
+                eb_object_inc_live_count(
+                    rest_results_ptr->picture_control_set_wrapper_ptr,
+                    task_count);
+            while (task_count--) {
+                eb_get_empty_object(
+                    context_ptr->entropy_coding_feedback_fifo_ptr,
+                    &feedback_wrapper_ptr);
+                feedback_ptr = (RestResults*)feedback_wrapper_ptr->object_ptr;
+                feedback_ptr->picture_control_set_wrapper_ptr = rest_results_ptr->picture_control_set_wrapper_ptr;
+                feedback_ptr->input_type = EC_TASKS_CONTINUE;
+                feedback_ptr->completed_lcu_row_index_start = 0;
+                feedback_ptr->completed_lcu_row_count = rest_results_ptr->completed_lcu_row_count;
+                eb_post_full_object(feedback_wrapper_ptr);
+            }
+
+            entropy_coding_tiles(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                rest_results_ptr->picture_control_set_wrapper_ptr);
         }
 
-        // Release Mode Decision Results
-        eb_release_object(encDecResultsWrapperPtr);
+        // Release Rest Results
+        eb_release_object(rest_results_wrapper_ptr);
     }
 
     return EB_NULL;
@@ -27,6 +27,7 @@ typedef struct EntropyCodingContext
 {
     EbDctor                      dctor;
     EbFifo                       *enc_dec_input_fifo_ptr;
+    EbFifo                       *entropy_coding_feedback_fifo_ptr; // tile tasks to the EC threads
     EbFifo                       *entropy_coding_output_fifo_ptr;  // to packetization
     EbFifo                       *rate_control_output_fifo_ptr; // feedback to rate control
 
@@ -79,6 +80,7 @@ typedef struct EntropyCodingContext
 extern EbErrorType entropy_coding_context_ctor(
     EntropyCodingContext  *context_ptr,
     EbFifo                *enc_dec_input_fifo_ptr,
+    EbFifo                *entropy_coding_feedback_fifo_ptr,
     EbFifo                *packetization_output_fifo_ptr,
     EbFifo                *rate_control_output_fifo_ptr,
     EbBool                   is16bit);
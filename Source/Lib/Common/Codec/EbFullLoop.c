@@ -1842,6 +1842,8 @@ int32_t av1_quantize_inv_quantize(
 #else
     uint32_t qIndex = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx + segmentation_qp_offset ;
 #endif
+    // Clamp the segment offset the way the decoder does
+    qIndex = (uint32_t)clamp((int32_t)qIndex, MINQ, MAXQ);
     if (bit_increment == 0) {
         if (component_type == COMPONENT_LUMA) {
             candidate_plane.quant_QTX = picture_control_set_ptr->parent_pcs_ptr->quantsMd.y_quant[qIndex];
@@ -3710,7 +3712,7 @@ uint32_t d2_inter_depth_block_decision(
     d1_idx_mds = blk_mds;
     d2_idx_mds = blk_mds;
     lastCuIndex = blk_mds;
-    blk_geom = get_blk_geom_mds(blk_mds);
+    blk_geom = get_blk_geom_mds(blk_mds, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
     uint32_t    parent_depth_idx_mds = blk_mds;
     uint32_t    current_depth_idx_mds = blk_mds;
 
@@ -3735,7 +3737,7 @@ uint32_t d2_inter_depth_block_decision(
             }
 
             //setup next parent inter depth
-            blk_geom = get_blk_geom_mds(parent_depth_idx_mds);
+            blk_geom = get_blk_geom_mds(parent_depth_idx_mds, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
             current_depth_idx_mds = parent_depth_idx_mds;
         }
     }
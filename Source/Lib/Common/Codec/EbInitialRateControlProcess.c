@@ -1202,6 +1202,8 @@ void* initial_rate_control_kernel(void *input_ptr)
 
         inputResultsPtr = (MotionEstimationResults*)inputResultsWrapperPtr->object_ptr;
         picture_control_set_ptr = (PictureParentControlSet*)inputResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
+        EB_TRACE_PICTURE(((SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr)->encode_context_ptr->trace_ptr,
+            EB_TRACE_INITIAL_RATE_CONTROL, picture_control_set_ptr->picture_number);
 
         segment_index = inputResultsPtr->segment_index;
 
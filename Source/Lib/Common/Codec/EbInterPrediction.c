@@ -2969,7 +2969,9 @@ EbErrorType av1_inter_prediction(
 
     InterpFilterParams filter_params_x, filter_params_y;
 
-    const BlockGeom * blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    // The temporal filter predicts without a picture, from the 64x64 geometry
+    const BlockGeom * blk_geom = get_blk_geom_mds(cu_ptr->mds_idx,
+        picture_control_set_ptr && picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
     //special treatment for chroma in 4XN/NX4 blocks
     //if one of the neighbour blocks of the parent square is intra the chroma prediction will follow the normal path using the luma MV of the current nsq block which is the latest sub8x8.
@@ -3615,7 +3617,9 @@ EbErrorType av1_inter_prediction_hbd(
     ConvolveParams conv_params;
     InterpFilterParams filter_params_x, filter_params_y;
 
-    const BlockGeom * blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    // The temporal filter predicts without a picture, from the 64x64 geometry
+    const BlockGeom * blk_geom = get_blk_geom_mds(cu_ptr->mds_idx,
+        picture_control_set_ptr && picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
     //special treatment for chroma in 4XN/NX4 blocks
    //if one of the neighbour blocks of the parent square is intra the chroma prediction will follow the normal path using the luma MV of the current nsq block which is the latest sub8x8.
@@ -5152,6 +5156,7 @@ EbErrorType inter_pu_prediction_av1(
                 asm_type);
         } else {
             ref_pic_list0 = ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->reference_picture16bit;
+            md_context_ptr->cu_ptr->interp_filters = candidate_buffer_ptr->candidate_ptr->interp_filters;
             av1_inter_prediction_hbd(
                 picture_control_set_ptr,
                 candidate_buffer_ptr->candidate_ptr->ref_frame_type,
@@ -5295,6 +5300,9 @@ EbErrorType inter_pu_prediction_av1(
             md_context_ptr->chroma_level <= CHROMA_MODE_1 && md_context_ptr->md_staging_skip_inter_chroma_pred == EB_FALSE,
             asm_type);
     } else {
+        // The high bit depth prediction takes the filters of the block, set
+        // them to the ones of the candidate
+        md_context_ptr->cu_ptr->interp_filters = candidate_buffer_ptr->candidate_ptr->interp_filters;
         av1_inter_prediction_hbd(
             picture_control_set_ptr,
             candidate_buffer_ptr->candidate_ptr->ref_frame_type,
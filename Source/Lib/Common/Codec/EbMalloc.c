@@ -9,8 +9,6 @@
 #include "EbMalloc.h"
 #include "EbThreads.h"
 
-#ifdef DEBUG_MEMORY_USAGE
-
 static EbHandle g_malloc_mutex;
 
 #ifdef _WIN32
@@ -52,6 +50,238 @@ static EbHandle get_malloc_mutex()
 }
 #endif // _WIN32
 
+// Bytes allocated by the thread, never decremented
+static EB_THREAD_LOCAL uint64_t g_thread_mem;
+
+// Account and subsystem charged with the allocations of the thread
+static EB_THREAD_LOCAL EbMemAccount *g_mem_account;
+static EB_THREAD_LOCAL EbMemorySubsystem g_mem_subsystem;
+
+struct EbMemAccount {
+    uint64_t amount[EB_PTR_TYPE_TOTAL];
+    uint64_t subsystem_amount[EB_MEM_SUBSYSTEM_COUNT];
+    uint64_t total;
+    uint64_t peak;
+};
+
+typedef struct MemUsageEntry {
+    void *ptr;
+    size_t count;
+    EbMemAccount *account;
+    uint8_t type;
+    uint8_t subsystem;
+} MemUsageEntry;
+
+/* Open addressing table of the accounted allocations, linear probing,
+   protected by the malloc mutex. The table grows to keep the load
+   under 1/2 */
+#define MEM_USAGE_MIN_SIZE 4096
+static MemUsageEntry *g_mem_usage_table;
+static size_t g_mem_usage_size;
+static size_t g_mem_usage_count;
+// Accounts alive, nothing is looked up on release when 0
+static volatile int32_t g_mem_account_count;
+
+static size_t hash_ptr(void *p, size_t size)
+{
+    uint64_t v = (uint64_t)(uintptr_t)p >> 4;
+    v *= 0x9E3779B97F4A7C15ull;
+    return (size_t)(v >> 32) & (size - 1);
+}
+
+static void charge_mem(MemUsageEntry *e, EbBool add)
+{
+    EbMemAccount *account = e->account;
+    if (!account)
+        return;
+    if (add) {
+        account->amount[e->type] += e->count;
+        if (e->type <= EB_A_PTR) {
+            account->subsystem_amount[e->subsystem] += e->count;
+            account->total += e->count;
+            if (account->total > account->peak)
+                account->peak = account->total;
+        }
+    } else {
+        account->amount[e->type] -= e->count;
+        if (e->type <= EB_A_PTR) {
+            account->subsystem_amount[e->subsystem] -= e->count;
+            account->total -= e->count;
+        }
+    }
+}
+
+static MemUsageEntry *find_mem_usage(void *ptr)
+{
+    size_t i;
+    if (!g_mem_usage_table)
+        return NULL;
+    for (i = hash_ptr(ptr, g_mem_usage_size); g_mem_usage_table[i].ptr; i = (i + 1) & (g_mem_usage_size - 1)) {
+        if (g_mem_usage_table[i].ptr == ptr)
+            return &g_mem_usage_table[i];
+    }
+    return &g_mem_usage_table[i];
+}
+
+static EbBool grow_mem_usage_table(void)
+{
+    MemUsageEntry *old_table = g_mem_usage_table;
+    size_t old_size = g_mem_usage_size;
+    size_t size = old_size ? old_size << 1 : MEM_USAGE_MIN_SIZE;
+    MemUsageEntry *table = (MemUsageEntry*)calloc(size, sizeof(MemUsageEntry));
+    if (!table)
+        return EB_FALSE;
+    g_mem_usage_table = table;
+    g_mem_usage_size = size;
+    for (size_t i = 0; i < old_size; i++) {
+        if (old_table[i].ptr)
+            *find_mem_usage(old_table[i].ptr) = old_table[i];
+    }
+    free(old_table);
+    return EB_TRUE;
+}
+
+// Backward shift deletion, keeps the probe sequences without tombstones
+static void delete_mem_usage(MemUsageEntry *e)
+{
+    size_t mask = g_mem_usage_size - 1;
+    size_t i = (size_t)(e - g_mem_usage_table);
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!g_mem_usage_table[j].ptr)
+            break;
+        size_t k = hash_ptr(g_mem_usage_table[j].ptr, g_mem_usage_size);
+        // Move j to the hole at i unless its home k lies cyclically in (i, j]
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        g_mem_usage_table[i] = g_mem_usage_table[j];
+        i = j;
+    }
+    g_mem_usage_table[i].ptr = NULL;
+    g_mem_usage_count--;
+}
+
+EbMemAccount *eb_create_mem_account(void)
+{
+    EbMemAccount *account = (EbMemAccount*)calloc(1, sizeof(EbMemAccount));
+    if (account) {
+        EbHandle m = get_malloc_mutex();
+        eb_block_on_mutex(m);
+        g_mem_account_count++;
+        eb_release_mutex(m);
+    }
+    return account;
+}
+
+void eb_release_mem_account(EbMemAccount *account)
+{
+    EbHandle m;
+    if (!account)
+        return;
+    m = get_malloc_mutex();
+    eb_block_on_mutex(m);
+    for (size_t i = 0; i < g_mem_usage_size; i++) {
+        if (g_mem_usage_table[i].ptr && g_mem_usage_table[i].account == account)
+            g_mem_usage_table[i].account = NULL;
+    }
+    g_mem_account_count--;
+    eb_release_mutex(m);
+    free(account);
+}
+
+EbMemAccount *eb_set_mem_account(EbMemAccount *account)
+{
+    EbMemAccount *prev = g_mem_account;
+    g_mem_account = account;
+    return prev;
+}
+
+EbMemorySubsystem eb_set_mem_subsystem(EbMemorySubsystem subsystem)
+{
+    EbMemorySubsystem prev = g_mem_subsystem;
+    g_mem_subsystem = subsystem;
+    return prev;
+}
+
+EbMemAccount *eb_get_mem_account(void)
+{
+    return g_mem_account;
+}
+
+EbMemorySubsystem eb_get_mem_subsystem(void)
+{
+    return g_mem_subsystem;
+}
+
+void eb_get_mem_account_usage(EbMemAccount *account, EbMemoryUsage *usage)
+{
+    EbHandle m = get_malloc_mutex();
+    eb_block_on_mutex(m);
+    usage->malloc_bytes = account->amount[EB_N_PTR];
+    usage->calloc_bytes = account->amount[EB_C_PTR];
+    usage->aligned_bytes = account->amount[EB_A_PTR];
+    usage->total_bytes = account->total;
+    usage->peak_bytes = account->peak;
+    usage->mutex_count = (uint32_t)account->amount[EB_MUTEX];
+    usage->semaphore_count = (uint32_t)account->amount[EB_SEMAPHORE];
+    usage->thread_count = (uint32_t)account->amount[EB_THREAD];
+    for (int i = 0; i < EB_MEM_SUBSYSTEM_COUNT; i++)
+        usage->subsystem_bytes[i] = account->subsystem_amount[i];
+    eb_release_mutex(m);
+}
+
+void eb_add_mem_usage(void *ptr, EbPtrType type, size_t count)
+{
+    EbHandle m;
+    MemUsageEntry *e;
+    if (type <= EB_A_PTR)
+        g_thread_mem += count;
+    if (!g_mem_account)
+        return;
+    m = get_malloc_mutex();
+    eb_block_on_mutex(m);
+    if ((g_mem_usage_count + 1) * 2 > g_mem_usage_size && !grow_mem_usage_table()) {
+        eb_release_mutex(m);
+        return;
+    }
+    e = find_mem_usage(ptr);
+    if (e->ptr)
+        charge_mem(e, EB_FALSE); // stale entry of an address released unaccounted
+    else
+        g_mem_usage_count++;
+    e->ptr = ptr;
+    e->count = count;
+    e->account = g_mem_account;
+    e->type = (uint8_t)type;
+    e->subsystem = (uint8_t)g_mem_subsystem;
+    charge_mem(e, EB_TRUE);
+    eb_release_mutex(m);
+}
+
+void eb_remove_mem_usage(void *ptr)
+{
+    EbHandle m;
+    MemUsageEntry *e;
+    if (!ptr || !g_mem_account_count)
+        return;
+    m = get_malloc_mutex();
+    eb_block_on_mutex(m);
+    e = find_mem_usage(ptr);
+    if (e && e->ptr) {
+        charge_mem(e, EB_FALSE);
+        delete_mem_usage(e);
+    }
+    eb_release_mutex(m);
+}
+
+uint64_t eb_get_thread_mem(void)
+{
+    return g_thread_mem;
+}
+
+#ifdef DEBUG_MEMORY_USAGE
+
 //hash function to speedup etnry search
 uint32_t hash(void* p)
 {
@@ -22,21 +22,53 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
     eb_add_mem_entry(p, type, count, __FILE__, __LINE__)
 
 #define EB_REMOVE_MEM_ENTRY(p, type) \
-    eb_remove_mem_entry(p, type);
+    do { \
+        eb_remove_mem_entry(p, type); \
+        eb_remove_mem_usage(p); \
+    } while (0)
 
 #else
 
 #define EB_ADD_MEM_ENTRY(p, type, count)
-#define EB_REMOVE_MEM_ENTRY(p, type)
+#define EB_REMOVE_MEM_ENTRY(p, type) \
+    eb_remove_mem_usage(p)
 
 #endif //DEBUG_MEMORY_USAGE
 
+/* Memory accounting, available in every build. An account holds the memory
+ * of an encoder instance per EbPtrType and per EbMemorySubsystem. Allocations
+ * are charged to the account and the subsystem set on the calling thread,
+ * threads created with eb_create_thread() inherit both from their creator.
+ * Nothing is recorded while the calling thread has no account. */
+typedef struct EbMemAccount EbMemAccount;
+
+EbMemAccount *eb_create_mem_account(void);
+
+// The memory still held by the account is no longer accounted
+void eb_release_mem_account(EbMemAccount *account);
+
+// Both return the previous value of the calling thread
+EbMemAccount *eb_set_mem_account(EbMemAccount *account);
+EbMemorySubsystem eb_set_mem_subsystem(EbMemorySubsystem subsystem);
+
+EbMemAccount *eb_get_mem_account(void);
+EbMemorySubsystem eb_get_mem_subsystem(void);
+
+void eb_get_mem_account_usage(EbMemAccount *account, EbMemoryUsage *usage);
+
+void eb_add_mem_usage(void *ptr, EbPtrType type, size_t count);
+void eb_remove_mem_usage(void *ptr);
+
+// Returns the bytes allocated so far by the calling thread
+uint64_t eb_get_thread_mem(void);
+
 #define EB_NO_THROW_ADD_MEM(p, size, type) \
     do { \
         if (!p) { \
             fprintf(stderr,"allocate memory failed, at %s, L%d\n", __FILE__, __LINE__); \
         } else { \
             EB_ADD_MEM_ENTRY(p, type, size); \
+            eb_add_mem_usage(p, type, size); \
         } \
     } while (0)
 
@@ -81,8 +113,8 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE(pointer) \
     do {\
-        free(pointer); \
         EB_REMOVE_MEM_ENTRY(pointer, EB_N_PTR); \
+        free(pointer); \
         pointer = NULL; \
     } while (0)
 
@@ -156,8 +188,8 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED(pointer) \
     do { \
-        _aligned_free(pointer); \
         EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
+        _aligned_free(pointer); \
         pointer = NULL; \
     } while (0)
 #else
@@ -170,8 +202,8 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED(pointer) \
     do { \
-        free(pointer); \
         EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
+        free(pointer); \
         pointer = NULL; \
     } while (0)
 #endif
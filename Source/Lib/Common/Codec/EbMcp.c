@@ -32,13 +32,39 @@ void generate_padding(
     uint32_t   padding_width,              //input paramter, the padding width.
     uint32_t   padding_height)             //input paramter, the padding height.
 {
-    uint32_t   verticalIdx = original_src_height;
+    generate_padding_rows(
+        src_pic,
+        src_stride,
+        original_src_width,
+        original_src_height,
+        padding_width,
+        padding_height,
+        0,
+        original_src_height);
+}
+
+/** generate_padding_rows()
+        is used to pad the rows [row_start, row_end) of the target picture, so the rows of a picture
+        can be padded in parallel. The padding above and below the picture is done with the first
+        and last rows.
+ */
+void generate_padding_rows(
+    EbByte  src_pic,                    //output paramter, pointer to the source picture to be padded.
+    uint32_t   src_stride,                 //input paramter, the stride of the source picture to be padded.
+    uint32_t   original_src_width,          //input paramter, the width of the source picture which excludes the padding.
+    uint32_t   original_src_height,         //input paramter, the height of the source picture which excludes the padding.
+    uint32_t   padding_width,              //input paramter, the padding width.
+    uint32_t   padding_height,             //input paramter, the padding height.
+    uint32_t   row_start,                  //input paramter, the first row to pad.
+    uint32_t   row_end)                    //input paramter, the row after the last row to pad.
+{
+    uint32_t   verticalIdx = row_end - row_start;
     EbByte  tempSrcPic0;
     EbByte  tempSrcPic1;
     EbByte  tempSrcPic2;
     EbByte  tempSrcPic3;
 
-    tempSrcPic0 = src_pic + padding_width + padding_height * src_stride;
+    tempSrcPic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
     while (verticalIdx)
     {
         // horizontal padding
@@ -49,25 +75,35 @@ void generate_padding(
         --verticalIdx;
     }
 
-    // vertical padding
-    verticalIdx = padding_height;
-    tempSrcPic0 = src_pic + padding_height * src_stride;
-    tempSrcPic1 = src_pic + (padding_height + original_src_height - 1)*src_stride;
-    tempSrcPic2 = tempSrcPic0;
-    tempSrcPic3 = tempSrcPic1;
-    while (verticalIdx)
-    {
-        // top part data copy
-        tempSrcPic2 -= src_stride;
-        EB_MEMCPY(tempSrcPic2, tempSrcPic0, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
-        // bottom part data copy
-        tempSrcPic3 += src_stride;
-        EB_MEMCPY(tempSrcPic3, tempSrcPic1, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
-        --verticalIdx;
+    // vertical padding, with the first and last rows of the picture
+    if (row_start == 0) {
+        verticalIdx = padding_height;
+        tempSrcPic0 = src_pic + padding_height * src_stride;
+        tempSrcPic2 = tempSrcPic0;
+        while (verticalIdx)
+        {
+            // top part data copy
+            tempSrcPic2 -= src_stride;
+            EB_MEMCPY(tempSrcPic2, tempSrcPic0, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
+            --verticalIdx;
+        }
+    }
+    if (row_end == original_src_height) {
+        verticalIdx = padding_height;
+        tempSrcPic1 = src_pic + (padding_height + original_src_height - 1)*src_stride;
+        tempSrcPic3 = tempSrcPic1;
+        while (verticalIdx)
+        {
+            // bottom part data copy
+            tempSrcPic3 += src_stride;
+            EB_MEMCPY(tempSrcPic3, tempSrcPic1, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
+            --verticalIdx;
+        }
     }
 
     return;
 }
+
 /** generate_padding16_bit()
 is used to pad the target picture. The horizontal padding happens first and then the vertical padding.
 */
@@ -79,13 +115,37 @@ void generate_padding16_bit(
     uint32_t   padding_width,              //input paramter, the padding width.
     uint32_t   padding_height)             //input paramter, the padding height.
 {
-    uint32_t   verticalIdx = original_src_height;
+    generate_padding16_bit_rows(
+        src_pic,
+        src_stride,
+        original_src_width,
+        original_src_height,
+        padding_width,
+        padding_height,
+        0,
+        original_src_height);
+}
+
+/** generate_padding16_bit_rows()
+is used to pad the rows [row_start, row_end) of the target picture, see generate_padding_rows().
+*/
+void generate_padding16_bit_rows(
+    EbByte  src_pic,                    //output paramter, pointer to the source picture to be padded.
+    uint32_t   src_stride,                 //input paramter, the stride of the source picture to be padded.
+    uint32_t   original_src_width,          //input paramter, the width of the source picture which excludes the padding.
+    uint32_t   original_src_height,         //input paramter, the height of the source picture which excludes the padding.
+    uint32_t   padding_width,              //input paramter, the padding width.
+    uint32_t   padding_height,             //input paramter, the padding height.
+    uint32_t   row_start,                  //input paramter, the first row to pad.
+    uint32_t   row_end)                    //input paramter, the row after the last row to pad.
+{
+    uint32_t   verticalIdx = row_end - row_start;
     EbByte  tempSrcPic0;
     EbByte  tempSrcPic1;
     EbByte  tempSrcPic2;
     EbByte  tempSrcPic3;
 
-    tempSrcPic0 = src_pic + padding_width + padding_height * src_stride;
+    tempSrcPic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
     while (verticalIdx)
     {
         // horizontal padding
@@ -97,21 +157,30 @@ void generate_padding16_bit(
         --verticalIdx;
     }
 
-    // vertical padding
-    verticalIdx = padding_height;
-    tempSrcPic0 = src_pic + padding_height * src_stride;
-    tempSrcPic1 = src_pic + (padding_height + original_src_height - 1)*src_stride;
-    tempSrcPic2 = tempSrcPic0;
-    tempSrcPic3 = tempSrcPic1;
-    while (verticalIdx)
-    {
-        // top part data copy
-        tempSrcPic2 -= src_stride;
-        EB_MEMCPY(tempSrcPic2, tempSrcPic0, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
-        // bottom part data copy
-        tempSrcPic3 += src_stride;
-        EB_MEMCPY(tempSrcPic3, tempSrcPic1, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
-        --verticalIdx;
+    // vertical padding, with the first and last rows of the picture
+    if (row_start == 0) {
+        verticalIdx = padding_height;
+        tempSrcPic0 = src_pic + padding_height * src_stride;
+        tempSrcPic2 = tempSrcPic0;
+        while (verticalIdx)
+        {
+            // top part data copy
+            tempSrcPic2 -= src_stride;
+            EB_MEMCPY(tempSrcPic2, tempSrcPic0, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
+            --verticalIdx;
+        }
+    }
+    if (row_end == original_src_height) {
+        verticalIdx = padding_height;
+        tempSrcPic1 = src_pic + (padding_height + original_src_height - 1)*src_stride;
+        tempSrcPic3 = tempSrcPic1;
+        while (verticalIdx)
+        {
+            // bottom part data copy
+            tempSrcPic3 += src_stride;
+            EB_MEMCPY(tempSrcPic3, tempSrcPic1, sizeof(uint8_t)*src_stride);        // uint8_t to be modified
+            --verticalIdx;
+        }
     }
 
     return;
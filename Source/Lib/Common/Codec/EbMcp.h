@@ -77,6 +77,26 @@ extern "C" {
         uint32_t            padding_width,
         uint32_t            padding_height);
 
+    extern void generate_padding_rows(
+        EbByte              src_pic,
+        uint32_t            src_stride,
+        uint32_t            original_src_width,
+        uint32_t            original_src_height,
+        uint32_t            padding_width,
+        uint32_t            padding_height,
+        uint32_t            row_start,
+        uint32_t            row_end);
+
+    extern void generate_padding16_bit_rows(
+        EbByte              src_pic,
+        uint32_t            src_stride,
+        uint32_t            original_src_width,
+        uint32_t            original_src_height,
+        uint32_t            padding_width,
+        uint32_t            padding_height,
+        uint32_t            row_start,
+        uint32_t            row_end);
+
     extern void pad_input_picture(
         EbByte              src_pic,
         uint32_t            src_stride,
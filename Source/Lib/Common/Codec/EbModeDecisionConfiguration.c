@@ -677,7 +677,7 @@ void PredictionPartitionLoop(
                     context_ptr->mdc_candidate_ptr->motion_vector_pred_y[REF_LIST_0] = 0;
                     // Initialize the ref mv
                     memset(context_ptr->mdc_ref_mv_stack,0,sizeof(CandidateMv));
-                    context_ptr->blk_geom = get_blk_geom_mds(pa_to_ep_block_index[cu_index]);
+                    context_ptr->blk_geom = get_blk_geom_mds(pa_to_ep_block_index[cu_index], sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
                     // Initialize mdc cu (only av1 rate estimation inputs)
                     context_ptr->mdc_cu_ptr->is_inter_ctx = 0;
                     context_ptr->mdc_cu_ptr->skip_flag_context = 0;
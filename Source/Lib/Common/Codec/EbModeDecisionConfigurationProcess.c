@@ -882,7 +882,7 @@ void forward_all_blocks_to_md(
         {
             split_flag = EB_TRUE;
 
-            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
             //if the parentSq is inside inject this block
             uint8_t is_blk_allowed = picture_control_set_ptr->slice_type != I_SLICE ? 1 : (blk_geom->sq_size < 128) ? 1 : 0;
@@ -935,7 +935,7 @@ void forward_sq_blocks_to_md(
         {
             split_flag = EB_TRUE;
 
-            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
             //if the parentSq is inside inject this block
             if (sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[blk_index])
@@ -982,7 +982,7 @@ void sb_forward_sq_blocks_to_md(
     {
         split_flag = EB_TRUE;
 
-        const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+        const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
         if (sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[blk_index])
         {
@@ -1576,7 +1576,7 @@ void forward_sq_non4_blocks_to_md(
         {
             split_flag = EB_TRUE;
 
-            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
             //if the parentSq is inside inject this block
             if (sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[blk_index])
@@ -1623,7 +1623,7 @@ void sb_forward_sq_non4_blocks_to_md(
     while (blk_index < sequence_control_set_ptr->max_block_cnt)
     {
         split_flag = EB_TRUE;
-        const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+        const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
         if (sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[blk_index])
         {
             resultsPtr->leaf_data_array[resultsPtr->leaf_count].tot_d1_blocks = 1;
@@ -1659,7 +1659,7 @@ void forward_all_c_blocks_to_md(
         while (blk_index < sequence_control_set_ptr->max_block_cnt)
         {
             tot_d1_blocks = 0;
-            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index);
+            const BlockGeom * blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
             //if the parentSq is inside inject this block
             uint8_t is_blk_allowed = picture_control_set_ptr->slice_type != I_SLICE ? 1 : (blk_geom->sq_size < 128) ? 1 : 0;
@@ -1673,7 +1673,7 @@ void forward_all_c_blocks_to_md(
                     blk_geom->sq_size == 8 ? 1 : 1;
 
                 for (uint32_t idx = 0; idx < tot_d1_blocks; ++idx) {
-                    blk_geom = get_blk_geom_mds(blk_index);
+                    blk_geom = get_blk_geom_mds(blk_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
                     //if the parentSq is inside inject this block
                     if (sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[blk_index]){
@@ -1934,6 +1934,7 @@ void* mode_decision_configuration_kernel(void *input_ptr)
         rateControlResultsPtr = (RateControlResults*)rateControlResultsWrapperPtr->object_ptr;
         picture_control_set_ptr = (PictureControlSet*)rateControlResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_MODE_DECISION_CONFIGURATION, picture_control_set_ptr->picture_number);
         if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.use_ref_frame_mvs)
             av1_setup_motion_field(picture_control_set_ptr->parent_pcs_ptr->av1_cm, picture_control_set_ptr);
 
@@ -166,8 +166,6 @@ EbErrorType mode_decision_context_ctor(
     for (codedLeafIndex = 0; codedLeafIndex < BLOCK_MAX_COUNT_SB_128; ++codedLeafIndex) {
         for (tu_index = 0; tu_index < TRANSFORM_UNIT_MAX_COUNT; ++tu_index)
             context_ptr->md_cu_arr_nsq[codedLeafIndex].transform_unit_array[tu_index].tu_index = tu_index;
-        const BlockGeom * blk_geom = get_blk_geom_mds(codedLeafIndex);
-        UNUSED(blk_geom);
         context_ptr->md_cu_arr_nsq[codedLeafIndex].av1xd = context_ptr->md_cu_arr_nsq[0].av1xd + codedLeafIndex;
         if (context_ptr->hbd_mode_decision) {
              for (int i = 0; i < 3; i++) {
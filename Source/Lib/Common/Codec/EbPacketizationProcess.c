@@ -16,6 +16,7 @@
 #include "EbTime.h"
 #include "EbModeDecisionProcess.h"
 #include "EbPictureDemuxResults.h"
+#include "EbSvtAv1ErrorCodes.h"
 #define DETAILED_FRAME_OUTPUT 0
 
 static EbBool IsPassthroughData(EbLinkedListNode* dataNode)
@@ -58,6 +59,33 @@ EbErrorType packetization_context_ctor(
 #define OBU_FRAME_HEADER_SIZE       3
 #define TILES_GROUP_SIZE            1
 
+// Grow the stream buffer so the bitstream and the TDs fit, the pooled buffer
+// keeps its size for the next pictures
+static EbErrorType output_stream_reserve(
+    EbBufferHeaderType  *out_str_ptr,
+    Bitstream           *bitstream_ptr){
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit*)bitstream_ptr->output_bitstream_ptr;
+    uint32_t  byte_count = (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
+    uint32_t  size = out_str_ptr->n_filled_len + byte_count + 2 * TD_SIZE + 1;
+    uint8_t  *buffer;
+
+    if (size <= out_str_ptr->n_alloc_len)
+        return EB_ErrorNone;
+
+    size = MAX(out_str_ptr->n_alloc_len << 1, size);
+    EB_NO_THROW_MALLOC(buffer, size);
+    if (!buffer)
+        return EB_ErrorInsufficientResources;
+    if (out_str_ptr->n_filled_len)
+        EB_MEMCPY(buffer, out_str_ptr->p_buffer, out_str_ptr->n_filled_len);
+    EB_FREE(out_str_ptr->p_buffer);
+
+    out_str_ptr->p_buffer = buffer;
+    out_str_ptr->n_alloc_len = size;
+
+    return EB_ErrorNone;
+}
+
 // Write TD after offsetting the stream buffer
 static void write_td (
     EbBufferHeaderType  *out_str_ptr,
@@ -273,6 +301,7 @@ void* packetization_kernel(void *input_ptr)
         picture_control_set_ptr = (PictureControlSet*)entropyCodingResultsPtr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
         encode_context_ptr = (EncodeContext*)sequence_control_set_ptr->encode_context_ptr;
+        EB_TRACE_PICTURE(encode_context_ptr->trace_ptr, EB_TRACE_PACKETIZATION, picture_control_set_ptr->picture_number);
         frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
         //****************************************************
         // Input Entropy Results into Reordering Queue
@@ -283,6 +312,9 @@ void* packetization_kernel(void *input_ptr)
         queueEntryPtr->start_time_seconds = picture_control_set_ptr->parent_pcs_ptr->start_time_seconds;
         queueEntryPtr->start_time_u_seconds = picture_control_set_ptr->parent_pcs_ptr->start_time_u_seconds;
         queueEntryPtr->is_alt_ref = picture_control_set_ptr->parent_pcs_ptr->is_alt_ref;
+        // A tile that could not be coded fails the output
+        queueEntryPtr->error_code = (picture_control_set_ptr->entropy_coding_error != EB_ErrorNone) ?
+            (uint32_t)EB_ENC_EC_ERROR30 : 0;
 
         //TODO: The output buffer should be big enough to avoid a deadlock here. Add an assert that make the warning
         // Get  Output Bitstream buffer
@@ -320,9 +352,13 @@ void* packetization_kernel(void *input_ptr)
             picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
             picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
 
-            eb_av1_reset_cdf_symbol_counters(picture_control_set_ptr->entropy_coder_ptr->fc);
+            // The context is updated from the last tile, see write_tile_info()
+            EntropyCoder *entropy_coder_ptr = picture_control_set_ptr->entropy_tile_info_ptr_array[
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows - 1]->entropy_coder_ptr;
+            eb_av1_reset_cdf_symbol_counters(entropy_coder_ptr->fc);
             ((EbReferenceObject*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->frame_context
-                = (*picture_control_set_ptr->entropy_coder_ptr->fc);
+                = (*entropy_coder_ptr->fc);
 
             // Get Empty Results Object
             eb_get_empty_object(
@@ -356,13 +392,19 @@ void* packetization_kernel(void *input_ptr)
             picture_control_set_ptr,
             0);
 
-        // Copy Slice Header to the Output Bitstream
-        copy_rbsp_bitstream_to_payload(
-            picture_control_set_ptr->bitstream_ptr,
-            output_stream_ptr->p_buffer,
-            (uint32_t*) &(output_stream_ptr->n_filled_len),
-            (uint32_t*) &(output_stream_ptr->n_alloc_len),
-            encode_context_ptr);
+        // Copy Slice Header to the Output Bitstream, the output fails
+        // instead when the buffer can not be grown
+        if (output_stream_reserve(
+                output_stream_ptr,
+                picture_control_set_ptr->bitstream_ptr) == EB_ErrorNone)
+            copy_rbsp_bitstream_to_payload(
+                picture_control_set_ptr->bitstream_ptr,
+                output_stream_ptr->p_buffer,
+                (uint32_t*) &(output_stream_ptr->n_filled_len),
+                (uint32_t*) &(output_stream_ptr->n_alloc_len),
+                encode_context_ptr);
+        else
+            queueEntryPtr->error_code = (uint32_t)EB_ENC_PACKETIZATION_ERROR6;
         if (picture_control_set_ptr->parent_pcs_ptr->has_show_existing) {
             // Reset the bitstream before writing to it
             reset_bitstream(
@@ -373,13 +415,19 @@ void* packetization_kernel(void *input_ptr)
                 picture_control_set_ptr,
                 1);
 
-            // Copy Slice Header to the Output Bitstream
-            copy_rbsp_bitstream_to_payload(
-                picture_control_set_ptr->bitstream_ptr,
-                output_stream_ptr->p_buffer,
-                (uint32_t*)&(output_stream_ptr->n_filled_len),
-                (uint32_t*)&(output_stream_ptr->n_alloc_len),
-                encode_context_ptr);
+            // Copy Slice Header to the Output Bitstream, the output fails
+            // instead when the buffer can not be grown
+            if (output_stream_reserve(
+                    output_stream_ptr,
+                    picture_control_set_ptr->bitstream_ptr) == EB_ErrorNone)
+                copy_rbsp_bitstream_to_payload(
+                    picture_control_set_ptr->bitstream_ptr,
+                    output_stream_ptr->p_buffer,
+                    (uint32_t*)&(output_stream_ptr->n_filled_len),
+                    (uint32_t*)&(output_stream_ptr->n_alloc_len),
+                    encode_context_ptr);
+            else
+                queueEntryPtr->error_code = (uint32_t)EB_ENC_PACKETIZATION_ERROR6;
 
             output_stream_ptr->flags |= EB_BUFFERFLAG_SHOW_EXT;
         }
@@ -608,6 +656,9 @@ void* packetization_kernel(void *input_ptr)
             output_stream_ptr->p_app_private = queueEntryPtr->out_meta_data;
             if (queueEntryPtr->is_alt_ref)
                 output_stream_ptr->flags |= (uint32_t)EB_BUFFERFLAG_IS_ALT_REF;
+            // The error code replaces the flags, eb_svt_get_packet reports it
+            if (queueEntryPtr->error_code)
+                output_stream_ptr->flags = queueEntryPtr->error_code;
 
             eb_post_full_object(output_stream_wrapper_ptr);
             queueEntryPtr->out_meta_data = (EbLinkedListNode *)EB_NULL;
@@ -40,6 +40,8 @@ extern "C" {
         EbBool                               has_show_existing;
         uint8_t                              show_existing_frame;
         uint8_t                              is_alt_ref;
+        // Error code sent in place of the output buffer flags, 0 if none
+        uint32_t                             error_code;
     } PacketizationReorderEntry;
 
     extern EbErrorType packetization_reorder_entry_ctor(
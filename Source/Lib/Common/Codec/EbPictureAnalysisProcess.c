@@ -4841,6 +4841,7 @@ void* picture_analysis_kernel(void *input_ptr)
         if (!picture_control_set_ptr->is_overlay)
         {
             sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+            EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_PICTURE_ANALYSIS, picture_control_set_ptr->picture_number);
             input_picture_ptr = picture_control_set_ptr->enhanced_picture_ptr;
 
             paReferenceObject = (EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
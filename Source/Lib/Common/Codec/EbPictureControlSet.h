@@ -36,7 +36,7 @@
 extern "C" {
 #endif
 
-#define SEGMENT_ENTROPY_BUFFER_SIZE         40000000 // Entropy Bitstream Buffer Size
+#define SEGMENT_ENTROPY_BUFFER_SIZE         0x40000 // Initial Entropy Bitstream Buffer Size, grown with the tiles
 #define PACKETIZATION_PROCESS_BUFFER_SIZE SEGMENT_ENTROPY_BUFFER_SIZE
 #define PACKETIZATION_PROCESS_SPS_BUFFER_SIZE 2000
 #define HISTOGRAM_NUMBER_OF_BINS            256
@@ -13585,8 +13585,6 @@ extern "C" {
         // rst_end_stripe[i] is one more than the index of the bottom stripe
         // for tile row i.
         int32_t rst_end_stripe[MAX_TILE_ROWS];
-        // Output of loop restoration
-        Yv12BufferConfig rst_frame;
         // pointer to a scratch buffer used by self-guided restoration
         int32_t *rst_tmpbuf;
         Yv12BufferConfig *frame_to_show;
@@ -13679,6 +13677,44 @@ extern "C" {
         MeshPattern mesh_patterns[MAX_MESH_STEP];
     } SpeedFeatures;
 
+    /**************************************
+     * Entropy Tile Info
+     *   Entropy coding state of a tile. The tiles
+     *   of a picture are coded by the EC threads
+     *   at the same time, each one into the buffer
+     *   of its own entropy coder.
+     **************************************/
+    typedef struct EntropyTileInfo
+    {
+        EbDctor                             dctor;
+        EntropyCoder                       *entropy_coder_ptr;
+
+        // Entropy Coding Neighbor Arrays
+        NeighborArrayUnit                  *mode_type_neighbor_array;
+        NeighborArrayUnit                  *partition_context_neighbor_array;
+        NeighborArrayUnit                  *intra_luma_mode_neighbor_array;
+        NeighborArrayUnit                  *skip_flag_neighbor_array;
+        NeighborArrayUnit                  *skip_coeff_neighbor_array;
+        NeighborArrayUnit                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit                  *txfm_context_array;
+        NeighborArrayUnit                  *inter_pred_dir_neighbor_array;
+        NeighborArrayUnit                  *ref_frame_type_neighbor_array;
+        NeighborArrayUnit32                *interpolation_type_neighbor_array;
+        NeighborArrayUnit                  *segmentation_id_pred_array;
+
+        // Reference values of the coded syntax, reset at the start of the tile
+        int32_t                             cdef_preset[4];
+        WienerInfo                          wiener_info[MAX_MB_PLANE];
+        SgrprojInfo                         sgrproj_info[MAX_MB_PLANE];
+#if ADD_DELTA_QP_SUPPORT
+        int32_t                             prev_qindex;
+        int32_t                             prev_delta_lf_from_base;
+        int32_t                             prev_delta_lf[FRAME_LF_COUNT];
+#endif
+    } EntropyTileInfo;
+
     typedef struct PictureControlSet
     {
         EbDctor                            dctor;
@@ -13693,7 +13729,9 @@ extern "C" {
 
         struct PictureParentControlSet     *parent_pcs_ptr;  //The parent of this PCS.
         EbObjectWrapper                    *picture_parent_control_set_wrapper_ptr;
-        EntropyCoder                       *entropy_coder_ptr;
+        // Entropy coding state of each tile, a single tile picture uses the first one
+        EntropyTileInfo                   **entropy_tile_info_ptr_array;
+        uint16_t                            entropy_tile_info_count;
         // Packetization (used to encode SPS, PPS, etc)
         Bitstream                          *bitstream_ptr;
 
@@ -13720,10 +13758,30 @@ extern "C" {
         EbHandle                              entropy_coding_mutex;
         EbBool                                entropy_coding_in_progress;
         EbBool                                entropy_coding_pic_done;
+        // Entropy Process Tiles
+        uint16_t                              entropy_coding_tile_count;
+        uint16_t                              entropy_coding_tile_index;
+        uint16_t                              entropy_coding_tile_done_count;
+        EbErrorType                           entropy_coding_error; // a tile buffer could not be grown
         EbHandle                              intra_mutex;
         uint32_t                              intra_coded_area;
+        // DLF Process Rows
+        EbHandle                              dlf_mutex;
+        uint8_t                               dlf_row_status[MAX_LCU_ROWS];
+        uint16_t                              dlf_row_count;
+        uint16_t                              dlf_vert_row_index;
+        uint16_t                              dlf_done_row_count;
+        uint8_t                               dlf_cdef_segment_row_count;
         uint32_t                              tot_seg_searched_cdef;
         EbHandle                              cdef_search_mutex;
+        // CDEF Filter Rows, of 64x64 blocks
+        uint16_t                              cdef_fb_row_count;
+        uint16_t                              cdef_fb_row_index;
+        uint16_t                              cdef_fb_done_row_count;
+        // Deblocked lines at the top and bottom of each filter row,
+        // read by the filtering of the rows above and below
+        uint16_t                             *cdef_fb_lines[3];
+        uint32_t                              cdef_fb_line_stride;
 
         uint16_t                              cdef_segments_total_count;
         uint8_t                               cdef_segments_column_count;
@@ -13739,6 +13797,11 @@ extern "C" {
         uint16_t                              rest_segments_total_count;
         uint8_t                               rest_segments_column_count;
         uint8_t                               rest_segments_row_count;
+        // Restoration Stripe Rows, filtered, padded and measured in parallel
+        uint16_t                              rest_stripe_row_count;
+        uint16_t                              rest_stripe_row_index;
+        uint16_t                              rest_stripe_done_row_count;
+        uint64_t                              rest_sse[3];
 
         // Mode Decision Config
         MdcLcuData                         *mdc_sb_array;
@@ -13808,21 +13871,6 @@ extern "C" {
         NeighborArrayUnit                  *ep_luma_dc_sign_level_coeff_neighbor_array;
         NeighborArrayUnit                  *ep_cr_dc_sign_level_coeff_neighbor_array;
         NeighborArrayUnit                  *ep_cb_dc_sign_level_coeff_neighbor_array;
-        // Entropy Coding Neighbor Arrays
-        NeighborArrayUnit                  *mode_type_neighbor_array;
-        NeighborArrayUnit                  *partition_context_neighbor_array;
-        NeighborArrayUnit                  *intra_luma_mode_neighbor_array;
-        NeighborArrayUnit                  *skip_flag_neighbor_array;
-        NeighborArrayUnit                  *skip_coeff_neighbor_array;
-        NeighborArrayUnit                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit                  *txfm_context_array;
-        NeighborArrayUnit                  *inter_pred_dir_neighbor_array;
-        NeighborArrayUnit                  *ref_frame_type_neighbor_array;
-        NeighborArrayUnit32                *interpolation_type_neighbor_array;
-
-        NeighborArrayUnit                  *segmentation_id_pred_array;
         SegmentationNeighborMap              *segmentation_neighbor_map;
 
         ModeInfo                            **mi_grid_base; //2 SB Rows of mi Data are enough
@@ -13844,9 +13892,6 @@ extern "C" {
         EbEncMode                             enc_mode;
         EbBool                                intra_md_open_loop_flag;
         EbBool                                limit_intra;
-        int32_t                               cdef_preset[4];
-        WienerInfo                            wiener_info[MAX_MB_PLANE];
-        SgrprojInfo                           sgrproj_info[MAX_MB_PLANE];
         SpeedFeatures sf;
         SearchSiteConfig ss_cfg;//CHKN this might be a seq based
         HashTable hash_table;
@@ -14280,6 +14325,7 @@ extern "C" {
         uint8_t                            nsq_present;
         uint8_t                            over_boundary_block_mode;
         uint8_t                            mfmv;
+        uint16_t                           tile_count;    // upper bound of the tiles of a picture
     } PictureControlSetInitData;
 
     typedef struct Av1Comp
@@ -2888,6 +2888,7 @@ void* picture_decision_kernel(void *input_ptr)
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
         frm_hdr = &picture_control_set_ptr->frm_hdr;
         encode_context_ptr = (EncodeContext*)sequence_control_set_ptr->encode_context_ptr;
+        EB_TRACE_PICTURE(encode_context_ptr->trace_ptr, EB_TRACE_PICTURE_DECISION, picture_control_set_ptr->picture_number);
         loopCount++;
 
         // Input Picture Analysis Results into the Picture Decision Reordering Queue
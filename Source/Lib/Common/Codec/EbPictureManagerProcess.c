@@ -150,6 +150,7 @@ void* picture_manager_kernel(void *input_ptr)
             picture_control_set_ptr = (PictureParentControlSet*)inputPictureDemuxPtr->picture_control_set_wrapper_ptr->object_ptr;
             sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
             encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+            EB_TRACE_PICTURE(encode_context_ptr->trace_ptr, EB_TRACE_PICTURE_MANAGER, picture_control_set_ptr->picture_number);
 
             //printf("\nPicture Manager Process @ %d \n ", picture_control_set_ptr->picture_number);
 
@@ -442,6 +443,7 @@ void* picture_manager_kernel(void *input_ptr)
 
             sequence_control_set_ptr = (SequenceControlSet*)inputPictureDemuxPtr->sequence_control_set_wrapper_ptr->object_ptr;
             encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+            EB_TRACE_PICTURE(encode_context_ptr->trace_ptr, EB_TRACE_PICTURE_MANAGER, inputPictureDemuxPtr->picture_number);
 
             // Check if Reference Queue is full
             CHECK_REPORT_ERROR(
@@ -479,6 +481,7 @@ void* picture_manager_kernel(void *input_ptr)
         case EB_PIC_FEEDBACK:
             sequence_control_set_ptr = (SequenceControlSet*)inputPictureDemuxPtr->sequence_control_set_wrapper_ptr->object_ptr;
             encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+            EB_TRACE_PICTURE(encode_context_ptr->trace_ptr, EB_TRACE_PICTURE_MANAGER, inputPictureDemuxPtr->picture_number);
             referenceQueueIndex = encode_context_ptr->reference_picture_queue_head_index;
             // Find the Reference in the Reference Queue
             do {
@@ -681,6 +684,7 @@ void* picture_manager_kernel(void *input_ptr)
                             ChildPictureControlSetPtr->entropy_coding_current_available_row = 0;
                             ChildPictureControlSetPtr->entropy_coding_row_count = picture_height_in_sb;
                             ChildPictureControlSetPtr->entropy_coding_in_progress = EB_FALSE;
+                            ChildPictureControlSetPtr->entropy_coding_error = EB_ErrorNone;
 
                             for (row_index = 0; row_index < MAX_LCU_ROWS; ++row_index)
                                 ChildPictureControlSetPtr->entropy_coding_row_array[row_index] = EB_FALSE;
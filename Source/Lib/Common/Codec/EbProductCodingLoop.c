@@ -31,6 +31,7 @@
 #include "EbAvcStyleMcp.h"
 #include "aom_dsp_rtcd.h"
 #include "EbCodingLoop.h"
+#include "EbSegmentation.h"
 
 #define PREDICTIVE_ME_MAX_MVP_CANIDATES  4
 #define PREDICTIVE_ME_DEVIATION_TH      50
@@ -397,7 +398,7 @@ void copy_neighbour_arrays(
 {
     (void)*context_ptr;
 
-    const BlockGeom * blk_geom = get_blk_geom_mds(blk_mds);
+    const BlockGeom * blk_geom = get_blk_geom_mds(blk_mds, picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
     uint32_t                            blk_org_x = sb_org_x + blk_geom->origin_x;
     uint32_t                            blk_org_y = sb_org_y + blk_geom->origin_y;
@@ -637,7 +638,7 @@ void md_update_all_neighbour_arrays(
     uint32_t                            sb_origin_x,
     uint32_t                            sb_origin_y)
 {
-    context_ptr->blk_geom = get_blk_geom_mds(lastCuIndex_mds);
+    context_ptr->blk_geom = get_blk_geom_mds(lastCuIndex_mds, picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
     context_ptr->cu_origin_x = sb_origin_x + context_ptr->blk_geom->origin_x;
     context_ptr->cu_origin_y = sb_origin_y + context_ptr->blk_geom->origin_y;
     context_ptr->round_origin_x = ((context_ptr->cu_origin_x >> 3) << 3);
@@ -668,7 +669,7 @@ void md_update_all_neighbour_arrays_multiple(
     uint32_t                            blk_mds,
     uint32_t                            sb_origin_x,
     uint32_t                            sb_origin_y){
-    context_ptr->blk_geom = get_blk_geom_mds(blk_mds);
+    context_ptr->blk_geom = get_blk_geom_mds(blk_mds, picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
     uint32_t blk_it;
     for (blk_it = 0; blk_it < context_ptr->blk_geom->totns; blk_it++)
@@ -1031,7 +1032,7 @@ void init_sq_nsq_block(
     ModeDecisionContext   *context_ptr){
     uint32_t blk_idx = 0;
     do {
-        const BlockGeom * blk_geom = get_blk_geom_mds(blk_idx);
+        const BlockGeom * blk_geom = get_blk_geom_mds(blk_idx, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
         context_ptr->md_local_cu_unit[blk_idx].avail_blk_flag = EB_FALSE;
         if (blk_geom->shape == PART_N)
         {
@@ -7618,7 +7619,7 @@ EB_EXTERN EbErrorType mode_decision_sb(
         skip_sub_blocks = 0;
         blk_idx_mds = leaf_data_array[cuIdx].mds_idx;
 
-        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_idx_mds);
+        const BlockGeom * blk_geom = context_ptr->blk_geom = get_blk_geom_mds(blk_idx_mds, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
         CodingUnit *  cu_ptr = context_ptr->cu_ptr = &context_ptr->md_cu_arr_nsq[blk_idx_mds];
 
         context_ptr->cu_size_log2 = blk_geom->bwidth_log2;
@@ -7640,6 +7641,13 @@ EB_EXTERN EbErrorType mode_decision_sb(
 
         cu_ptr->split_flag = (uint16_t)leafDataPtr->split_flag; //mdc indicates smallest or non valid CUs with split flag=
         cu_ptr->qp = context_ptr->qp;
+        // The full loop quantizes with the offset of the segment of the block
+        if (picture_control_set_ptr->parent_pcs_ptr->frm_hdr.segmentation_params.segmentation_enabled)
+            apply_segmentation_based_quantization(
+                blk_geom,
+                picture_control_set_ptr,
+                sb_ptr,
+                cu_ptr);
         cu_ptr->best_d1_blk = blk_idx_mds;
 
             if (leafDataPtr->tot_d1_blocks != 1)
@@ -7843,7 +7851,7 @@ EB_EXTERN EbErrorType mode_decision_sb(
         if (skip_sub_blocks && leaf_data_array[cuIdx].split_flag) {
             cuIdx++;
             while (cuIdx < leaf_count) {
-                const BlockGeom * next_blk_geom = get_blk_geom_mds(leaf_data_array[cuIdx].mds_idx);
+                const BlockGeom * next_blk_geom = get_blk_geom_mds(leaf_data_array[cuIdx].mds_idx, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
                 if ((next_blk_geom->origin_x < blk_geom->origin_x + blk_geom->bwidth) && (next_blk_geom->origin_y < blk_geom->origin_y + blk_geom->bheight))
                     cuIdx++;
                 else
@@ -2561,7 +2561,7 @@ EbErrorType av1_split_flag_rate(
     (void)tb_max_depth;
     (void)leaf_index;
 
-    const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
+    const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
     EbErrorType return_error = EB_ErrorNone;
 
     uint32_t cu_origin_x = context_ptr->sb_origin_x + blk_geom->origin_x;
@@ -9,6 +9,13 @@
 #include "EbPictureBufferDesc.h"
 #include "EbReferenceObject.h"
 
+/* Number of 64x64 SBs covering a picture, the size of the per-SB arrays */
+static uint32_t reference_sb_total_count(EbPictureBufferDescInitData *init_data_ptr)
+{
+    return ((init_data_ptr->max_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+        ((init_data_ptr->max_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64);
+}
+
 void InitializeSamplesNeighboringReferencePicture16Bit(
     EbByte  reconSamplesBufferPtr,
     uint16_t   stride,
@@ -127,6 +134,8 @@ static void eb_reference_object_dctor(EbPtr p)
     EB_DELETE(obj->reference_picture16bit);
     EB_DELETE(obj->reference_picture);
     EB_FREE_ALIGNED_ARRAY(obj->mvs);
+    EB_FREE_ARRAY(obj->intra_coded_area_sb);
+    EB_FREE_ARRAY(obj->non_moving_index_array);
 }
 
 
@@ -187,6 +196,8 @@ EbErrorType eb_reference_object_ctor(
         const int mem_size = ((mi_rows + 1) >> 1) * ((mi_cols + 1) >> 1);
         EB_CALLOC_ALIGNED_ARRAY(referenceObject->mvs, mem_size);
     }
+    EB_CALLOC_ARRAY(referenceObject->intra_coded_area_sb, reference_sb_total_count(pictureBufferDescInitDataPtr));
+    EB_CALLOC_ARRAY(referenceObject->non_moving_index_array, reference_sb_total_count(pictureBufferDescInitDataPtr));
     memset(&referenceObject->film_grain_params, 0, sizeof(referenceObject->film_grain_params));
 
     return EB_ErrorNone;
@@ -213,6 +224,8 @@ static void eb_pa_reference_object_dctor(EbPtr p)
     EB_DELETE(obj->sixteenth_decimated_picture_ptr);
     EB_DELETE(obj->quarter_filtered_picture_ptr);
     EB_DELETE(obj->sixteenth_filtered_picture_ptr);
+    EB_FREE_ARRAY(obj->variance);
+    EB_FREE_ARRAY(obj->y_mean);
 }
 
 /*****************************************
@@ -257,6 +270,8 @@ EbErrorType eb_pa_reference_object_ctor(
             eb_picture_buffer_desc_ctor,
             (EbPtr)(pictureBufferDescInitDataPtr + 2));
     }
+    EB_CALLOC_ARRAY(paReferenceObject->variance, reference_sb_total_count(pictureBufferDescInitDataPtr));
+    EB_CALLOC_ARRAY(paReferenceObject->y_mean, reference_sb_total_count(pictureBufferDescInitDataPtr));
 
     return EB_ErrorNone;
 }
@@ -24,9 +24,8 @@ typedef struct EbReferenceObject
 #endif
     EB_SLICE                        slice_type;
     uint8_t                         intra_coded_area;//percentage of intra coded area 0-100%
-    uint8_t                         intra_coded_area_sb[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
-    uint32_t                        non_moving_index_array[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//array to hold non-moving blocks in reference frames
-    uint32_t                        picSampleValue[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];// [Y U V];
+    uint8_t                        *intra_coded_area_sb;//percentage of intra coded area 0-100%
+    uint32_t                       *non_moving_index_array;//array to hold non-moving blocks in reference frames
     uint8_t                         tmp_layer_idx;
     EbBool                          is_scene_change;
     uint16_t                        pic_avg_variance;
@@ -54,10 +53,11 @@ typedef struct EbPaReferenceObject
     EbPictureBufferDesc          *sixteenth_decimated_picture_ptr;
     EbPictureBufferDesc          *quarter_filtered_picture_ptr;
     EbPictureBufferDesc          *sixteenth_filtered_picture_ptr;
-    uint16_t                      variance[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
-    uint8_t                       y_mean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+    uint16_t                     *variance;
+    uint8_t                      *y_mean;
     EB_SLICE                      slice_type;
     uint32_t                      dependent_pictures_count; //number of pic using this reference frame
+    EbObjectWrapper              *input_picture_wrapper_ptr; //zero copy input whose planes input_padded_picture_ptr points to
 
 } EbPaReferenceObject;
 
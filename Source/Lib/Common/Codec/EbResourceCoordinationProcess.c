@@ -568,6 +568,7 @@ void* resource_coordination_kernel(void *input_ptr)
             &ebInputWrapperPtr);
         ebInputPtr = (EbBufferHeaderType*)ebInputWrapperPtr->object_ptr;
         sequence_control_set_ptr = context_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr;
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_RESOURCE_COORDINATION, context_ptr->picture_number_array[instance_index]);
 
         // If config changes occured since the last picture began encoding, then
         //   prepare a new sequence_control_set_ptr containing the new changes and update the state
@@ -837,6 +838,14 @@ void* resource_coordination_kernel(void *input_ptr)
                     picture_control_set_ptr->pa_reference_picture_wrapper_ptr,
                     2);
             ((EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->input_padded_picture_ptr->buffer_y = picture_control_set_ptr->enhanced_picture_ptr->buffer_y;
+            // The application planes of a zero copy input are also read through the reference,
+            // it holds the input until it is released
+            if (sequence_control_set_ptr->static_config.zero_copy_input && !picture_control_set_ptr->is_overlay) {
+                ((EbPaReferenceObject*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->input_picture_wrapper_ptr = picture_control_set_ptr->input_picture_wrapper_ptr;
+                eb_object_inc_live_count(
+                    picture_control_set_ptr->input_picture_wrapper_ptr,
+                    2);
+            }
 
             // Get Empty Output Results Object
             if (picture_control_set_ptr->picture_number > 0 && (prevPictureControlSetWrapperPtr != NULL))
@@ -26,24 +26,33 @@
 void ReconOutput(
     PictureControlSet    *picture_control_set_ptr,
     SequenceControlSet   *sequence_control_set_ptr);
-void eb_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
-    Av1Common *cm, int32_t optimized_lr);
+void eb_av1_loop_restoration_filter_stripe(Yv12BufferConfig *frame,
+    Yv12BufferConfig *src, Av1Common *cm, int32_t plane, int32_t stripe,
+    int32_t *tmpbuf);
 void CopyStatisticsToRefObject(
     PictureControlSet    *picture_control_set_ptr,
     SequenceControlSet   *sequence_control_set_ptr);
 void psnr_calculations(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr);
-void PadRefAndSetFlags(
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              luma_row_start,
+    uint32_t              luma_row_end,
+    uint32_t              chroma_row_start,
+    uint32_t              chroma_row_end,
+    uint64_t              sse[3]);
+void psnr_finish_calculations(
     PictureControlSet    *picture_control_set_ptr,
-    SequenceControlSet   *sequence_control_set_ptr);
-void generate_padding(
-    EbByte              src_pic,
-    uint32_t            src_stride,
-    uint32_t            original_src_width,
-    uint32_t            original_src_height,
-    uint32_t            padding_width,
-    uint32_t            padding_height);
+    SequenceControlSet   *sequence_control_set_ptr,
+    const uint64_t        sse[3]);
+void pad_ref_rows(
+    PictureControlSet    *picture_control_set_ptr,
+    SequenceControlSet   *sequence_control_set_ptr,
+    uint32_t              luma_row_start,
+    uint32_t              luma_row_end,
+    uint32_t              chroma_row_start,
+    uint32_t              chroma_row_end);
+void set_ref_flags(
+    PictureControlSet    *picture_control_set_ptr);
 void restoration_seg_search(
     RestContext          *context_ptr,
     Yv12BufferConfig       *org_fts,
@@ -71,6 +80,7 @@ EbErrorType rest_context_ctor(
     EbFifo                *rest_input_fifo_ptr,
     EbFifo                *rest_output_fifo_ptr ,
     EbFifo                *picture_demux_fifo_ptr,
+    EbFifo                *rest_feedback_fifo_ptr,
     EbBool                  is16bit,
     EbColorFormat           color_format,
     uint32_t                max_input_luma_width,
@@ -84,6 +94,7 @@ EbErrorType rest_context_ctor(
     context_ptr->rest_input_fifo_ptr = rest_input_fifo_ptr;
     context_ptr->rest_output_fifo_ptr = rest_output_fifo_ptr;
     context_ptr->picture_demux_fifo_ptr = picture_demux_fifo_ptr;
+    context_ptr->rest_feedback_fifo_ptr = rest_feedback_fifo_ptr;
 
     {
         EbPictureBufferDescInitData initData;
@@ -196,8 +207,221 @@ void   get_own_recon(
     }
 }
 
+/******************************************************
+ * Rest Row Range
+ *   Rows of a plane in the processing stripe, the last
+ *   stripe takes the rows down to the bottom
+ ******************************************************/
+static void rest_row_range(
+    uint32_t  stripe,
+    uint32_t  stripe_count,
+    uint32_t  ss_y,
+    uint32_t  height,
+    uint32_t *row_start,
+    uint32_t *row_end)
+{
+    const uint32_t full_stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+    const uint32_t stripe_offset = RESTORATION_UNIT_OFFSET >> ss_y;
+
+    *row_start = stripe ? MIN(stripe * full_stripe_height - stripe_offset, height) : 0;
+    *row_end = (stripe == stripe_count - 1) ? height : MIN((stripe + 1) * full_stripe_height - stripe_offset, height);
+}
+
+/******************************************************
+ * Rest Apply Needed
+ ******************************************************/
+static EbBool rest_apply_needed(
+    Av1Common *cm)
+{
+    return (EbBool)(cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+        cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+        cm->rst_info[2].frame_restoration_type != RESTORE_NONE);
+}
+
+/******************************************************
+ * Rest Filter Row
+ *   Filters one processing stripe of each plane, then
+ *   measures and pads its rows
+ ******************************************************/
+static void rest_filter_row(
+    RestContext        *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    uint32_t            stripe,
+    uint64_t            sse[3])
+{
+    Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    uint32_t   luma_row_start, luma_row_end;
+    uint32_t   chroma_row_start, chroma_row_end;
+
+    if (rest_apply_needed(cm)) {
+        // The stripe is filtered from a copy in the own recon of the thread
+        Yv12BufferConfig org_fts;
+        link_eb_to_aom_buffer_desc(
+            context_ptr->org_rec_frame,
+            &org_fts);
+
+        for (int32_t plane = 0; plane < 3; ++plane) {
+            if (cm->rst_info[plane].frame_restoration_type != RESTORE_NONE)
+                eb_av1_loop_restoration_filter_stripe(
+                    cm->frame_to_show,
+                    &org_fts,
+                    cm,
+                    plane,
+                    stripe,
+                    context_ptr->rst_tmpbuf);
+        }
+    }
+
+    rest_row_range(stripe, picture_control_set_ptr->rest_stripe_row_count, 0,
+        sequence_control_set_ptr->seq_header.max_frame_height, &luma_row_start, &luma_row_end);
+    rest_row_range(stripe, picture_control_set_ptr->rest_stripe_row_count, cm->subsampling_y,
+        sequence_control_set_ptr->chroma_height, &chroma_row_start, &chroma_row_end);
+
+    // PSNR Calculation
+    if (sequence_control_set_ptr->static_config.stat_report)
+        psnr_calculations(
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            luma_row_start,
+            luma_row_end,
+            chroma_row_start,
+            chroma_row_end,
+            sse);
+
+    // Pad the reference picture
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+        pad_ref_rows(
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            luma_row_start,
+            luma_row_end,
+            chroma_row_start,
+            chroma_row_end);
+}
+
+/******************************************************
+ * Rest Finish Picture
+ *   Outputs the picture once all its rows are done
+ ******************************************************/
+static void rest_finish_picture(
+    RestContext        *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr)
+{
+    uint8_t                lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
+    EbObjectWrapper       *rest_results_wrapper_ptr;
+    RestResults           *rest_results_ptr;
+    EbObjectWrapper       *picture_demux_results_wrapper_ptr;
+    PictureDemuxResults   *picture_demux_results_rtr;
+
+    if (sequence_control_set_ptr->static_config.stat_report)
+        psnr_finish_calculations(
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            picture_control_set_ptr->rest_sse);
+
+    // Set ref POC
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+        set_ref_flags(
+            picture_control_set_ptr);
+    if (sequence_control_set_ptr->static_config.recon_enabled) {
+        ReconOutput(
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+    }
+
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag)
+    {
+        // Get Empty PicMgr Results
+        eb_get_empty_object(
+            context_ptr->picture_demux_fifo_ptr,
+            &picture_demux_results_wrapper_ptr);
+
+        picture_demux_results_rtr = (PictureDemuxResults*)picture_demux_results_wrapper_ptr->object_ptr;
+        picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+        picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+        picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
+        picture_demux_results_rtr->picture_type = EB_PIC_REFERENCE;
+
+        // Post Reference Picture
+        eb_post_full_object(picture_demux_results_wrapper_ptr);
+    }
+
+    // Get Empty rest Results to EC
+    eb_get_empty_object(
+        context_ptr->rest_output_fifo_ptr,
+        &rest_results_wrapper_ptr);
+    rest_results_ptr = (struct RestResults*)rest_results_wrapper_ptr->object_ptr;
+    rest_results_ptr->picture_control_set_wrapper_ptr = picture_control_set_wrapper_ptr;
+    rest_results_ptr->completed_lcu_row_index_start = 0;
+    rest_results_ptr->completed_lcu_row_count = ((sequence_control_set_ptr->seq_header.max_frame_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+    rest_results_ptr->input_type = EC_TASKS_REST_INPUT;
+    // Post Rest Results
+    eb_post_full_object(rest_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Rest Filter Rows
+ *   Takes stripe rows of the picture until none is
+ *   left. The thread completing the last row outputs
+ *   the picture.
+ ******************************************************/
+static void rest_filter_rows(
+    RestContext        *context_ptr,
+    PictureControlSet  *picture_control_set_ptr,
+    SequenceControlSet *sequence_control_set_ptr,
+    EbObjectWrapper    *picture_control_set_wrapper_ptr)
+{
+    EbBool   row_taken = EB_FALSE;
+    EbBool   picture_done = EB_FALSE;
+    uint16_t stripe_row = 0;
+    uint64_t sse[3] = { 0 };
+
+    for (;;) {
+        eb_block_on_mutex(picture_control_set_ptr->rest_search_mutex);
+
+        // Complete the row of the previous iteration
+        if (row_taken) {
+            picture_control_set_ptr->rest_sse[0] += sse[0];
+            picture_control_set_ptr->rest_sse[1] += sse[1];
+            picture_control_set_ptr->rest_sse[2] += sse[2];
+            picture_done = ++picture_control_set_ptr->rest_stripe_done_row_count == picture_control_set_ptr->rest_stripe_row_count;
+        }
+
+        row_taken = picture_control_set_ptr->rest_stripe_row_index < picture_control_set_ptr->rest_stripe_row_count;
+        if (row_taken)
+            stripe_row = picture_control_set_ptr->rest_stripe_row_index++;
+
+        eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
+
+        if (!row_taken)
+            break;
+
+        sse[0] = sse[1] = sse[2] = 0;
+        rest_filter_row(
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            stripe_row,
+            sse);
+    }
+
+    if (picture_done)
+        rest_finish_picture(
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            picture_control_set_wrapper_ptr);
+}
+
 /******************************************************
  * Rest Kernel
+ *   Each segment is searched as it comes from CDEF. The
+ *   thread searching the last segment picks the filters,
+ *   then posts continue tasks to the other Rest threads
+ *   which share the stripe rows.
  ******************************************************/
 void* rest_kernel(void *input_ptr)
 {
@@ -211,11 +435,10 @@ void* rest_kernel(void *input_ptr)
     EbObjectWrapper                       *cdef_results_wrapper_ptr;
     CdefResults                         *cdef_results_ptr;
 
-    //// Output
-    EbObjectWrapper                       *rest_results_wrapper_ptr;
-    RestResults*                          rest_results_ptr;
-    EbObjectWrapper                       *picture_demux_results_wrapper_ptr;
-    PictureDemuxResults                   *picture_demux_results_rtr;
+    //// Feedback
+    EbObjectWrapper                       *feedback_wrapper_ptr;
+    CdefResults                           *feedback_ptr;
+
     // SB Loop variables
 
     for (;;) {
@@ -227,129 +450,143 @@ void* rest_kernel(void *input_ptr)
         cdef_results_ptr = (CdefResults*)cdef_results_wrapper_ptr->object_ptr;
         picture_control_set_ptr = (PictureControlSet*)cdef_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-        frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
-        uint8_t lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
-        EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-
-        if (sequence_control_set_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0)
-        {
-            get_own_recon(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, is16bit);
-
-            Yv12BufferConfig cpi_source;
-            link_eb_to_aom_buffer_desc(
-                is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                &cpi_source);
-
-            Yv12BufferConfig trial_frame_rst;
-            link_eb_to_aom_buffer_desc(
-                context_ptr->trial_frame_rst,
-                &trial_frame_rst);
-
-            Yv12BufferConfig org_fts;
-            link_eb_to_aom_buffer_desc(
-                context_ptr->org_rec_frame,
-                &org_fts);
-
-            restoration_seg_search(
-                context_ptr,
-                &org_fts,
-                &cpi_source,
-                &trial_frame_rst,
-                picture_control_set_ptr,
-                cdef_results_ptr->segment_index);
-        }
+        EB_TRACE_PICTURE(sequence_control_set_ptr->encode_context_ptr->trace_ptr, EB_TRACE_REST, picture_control_set_ptr->picture_number);
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        eb_block_on_mutex(picture_control_set_ptr->rest_search_mutex);
+        if (cdef_results_ptr->input_type == REST_TASKS_CDEF_INPUT) {
+            EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+            EbBool  last_segment;
+            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+            frm_hdr = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr;
 
-        picture_control_set_ptr->tot_seg_searched_rest++;
-        if (picture_control_set_ptr->tot_seg_searched_rest == picture_control_set_ptr->rest_segments_total_count)
-        {
-            if (sequence_control_set_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(
-                    picture_control_set_ptr->parent_pcs_ptr->av1x,
-                    picture_control_set_ptr->parent_pcs_ptr->av1_cm);
-
-                if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
-                {
-                    eb_av1_loop_restoration_filter_frame(
-                        cm->frame_to_show,
-                        cm,
-                        0);
-                }
-            }
-            else {
-                cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+            if (sequence_control_set_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0)
+            {
+                get_own_recon(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, is16bit);
+
+                Yv12BufferConfig cpi_source;
+                link_eb_to_aom_buffer_desc(
+                    is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    &cpi_source);
+
+                Yv12BufferConfig trial_frame_rst;
+                link_eb_to_aom_buffer_desc(
+                    context_ptr->trial_frame_rst,
+                    &trial_frame_rst);
+
+                Yv12BufferConfig org_fts;
+                link_eb_to_aom_buffer_desc(
+                    context_ptr->org_rec_frame,
+                    &org_fts);
+
+                restoration_seg_search(
+                    context_ptr,
+                    &org_fts,
+                    &cpi_source,
+                    &trial_frame_rst,
+                    picture_control_set_ptr,
+                    cdef_results_ptr->segment_index);
             }
 
-            uint8_t best_ep_cnt = 0;
-            uint8_t best_ep = 0;
-            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                    best_ep = i;
-                    best_ep_cnt = cm->sg_frame_ep_cnt[i];
+            //all seg based search is done. update total processed segments. if all done, finish the search and start the application.
+            eb_block_on_mutex(picture_control_set_ptr->rest_search_mutex);
+            picture_control_set_ptr->tot_seg_searched_rest++;
+            last_segment = (EbBool)(picture_control_set_ptr->tot_seg_searched_rest == picture_control_set_ptr->rest_segments_total_count);
+            eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
+
+            if (last_segment) {
+                uint32_t task_count;
+
+                if (sequence_control_set_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
+                    rest_finish_search(
+                        picture_control_set_ptr->parent_pcs_ptr->av1x,
+                        picture_control_set_ptr->parent_pcs_ptr->av1_cm);
+                }
+                else {
+                    cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
+                    cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
+                    cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
                 }
-            }
-            cm->sg_frame_ep = best_ep;
 
-            if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
+                uint8_t best_ep_cnt = 0;
+                uint8_t best_ep = 0;
+                for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+                    if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                        best_ep = i;
+                        best_ep_cnt = cm->sg_frame_ep_cnt[i];
+                    }
+                }
+                cm->sg_frame_ep = best_ep;
 
-            // PSNR Calculation
-            if (sequence_control_set_ptr->static_config.stat_report)
-                psnr_calculations(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+                if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+                    // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+                    CopyStatisticsToRefObject(
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr);
+                }
 
-            // Pad the reference picture and set ref POC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                PadRefAndSetFlags(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            if (sequence_control_set_ptr->static_config.recon_enabled) {
-                ReconOutput(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
+                if (rest_apply_needed(cm)) {
+                    for (int32_t plane = 0; plane < 3; ++plane) {
+                        RestorationInfo *rsi = &cm->rst_info[plane];
+                        const int32_t    is_uv = plane > 0;
+
+                        if (rsi->frame_restoration_type == RESTORE_NONE)
+                            continue;
+                        rsi->optimized_lr = 0;
+                        eb_extend_frame(cm->frame_to_show->buffers[plane], cm->frame_to_show->crop_widths[is_uv], cm->frame_to_show->crop_heights[is_uv],
+                            cm->frame_to_show->strides[is_uv], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+                    }
+                }
 
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag)
-            {
-                // Get Empty PicMgr Results
-                eb_get_empty_object(
-                    context_ptr->picture_demux_fifo_ptr,
-                    &picture_demux_results_wrapper_ptr);
-
-                picture_demux_results_rtr = (PictureDemuxResults*)picture_demux_results_wrapper_ptr->object_ptr;
-                picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
-                picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
-                picture_demux_results_rtr->picture_type = EB_PIC_REFERENCE;
-
-                // Post Reference Picture
-                eb_post_full_object(picture_demux_results_wrapper_ptr);
+                picture_control_set_ptr->rest_stripe_row_count = (rest_apply_needed(cm) ||
+                    sequence_control_set_ptr->static_config.stat_report ||
+                    picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) ?
+                    (uint16_t)((sequence_control_set_ptr->seq_header.max_frame_height + RESTORATION_UNIT_OFFSET + RESTORATION_PROC_UNIT_SIZE - 1) / RESTORATION_PROC_UNIT_SIZE) : 0;
+                picture_control_set_ptr->rest_stripe_row_index = 0;
+                picture_control_set_ptr->rest_stripe_done_row_count = 0;
+                picture_control_set_ptr->rest_sse[0] = 0;
+                picture_control_set_ptr->rest_sse[1] = 0;
+                picture_control_set_ptr->rest_sse[2] = 0;
+
+                if (picture_control_set_ptr->rest_stripe_row_count == 0)
+                    rest_finish_picture(
+                        context_ptr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        cdef_results_ptr->picture_control_set_wrapper_ptr);
+                else {
+                    // One continue task per other Rest thread that can get a row. Each
+                    // task holds the picture until it is done with it
+                    task_count = MIN(sequence_control_set_ptr->rest_process_init_count, picture_control_set_ptr->rest_stripe_row_count) - 1;
+                    if (task_count)
+                        eb_object_inc_live_count(
+                            cdef_results_ptr->picture_control_set_wrapper_ptr,
+                            task_count);
+                    while (task_count--) {
+                        eb_get_empty_object(
+                            context_ptr->rest_feedback_fifo_ptr,
+                            &feedback_wrapper_ptr);
+                        feedback_ptr = (CdefResults*)feedback_wrapper_ptr->object_ptr;
+                        feedback_ptr->picture_control_set_wrapper_ptr = cdef_results_ptr->picture_control_set_wrapper_ptr;
+                        feedback_ptr->input_type = REST_TASKS_CONTINUE;
+                        feedback_ptr->segment_index = 0;
+                        eb_post_full_object(feedback_wrapper_ptr);
+                    }
+
+                    rest_filter_rows(
+                        context_ptr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        cdef_results_ptr->picture_control_set_wrapper_ptr);
+                }
             }
-
-            // Get Empty rest Results to EC
-            eb_get_empty_object(
-                context_ptr->rest_output_fifo_ptr,
-                &rest_results_wrapper_ptr);
-            rest_results_ptr = (struct RestResults*)rest_results_wrapper_ptr->object_ptr;
-            rest_results_ptr->picture_control_set_wrapper_ptr = cdef_results_ptr->picture_control_set_wrapper_ptr;
-            rest_results_ptr->completed_lcu_row_index_start = 0;
-            rest_results_ptr->completed_lcu_row_count = ((sequence_control_set_ptr->seq_header.max_frame_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
-            // Post Rest Results
-            eb_post_full_object(rest_results_wrapper_ptr);
         }
-        eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
+        else {
+            rest_filter_rows(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                cdef_results_ptr->picture_control_set_wrapper_ptr);
+            eb_release_object(cdef_results_ptr->picture_control_set_wrapper_ptr);
+        }
 
         // Release input Results
         eb_release_object(cdef_results_wrapper_ptr);
@@ -21,16 +21,6 @@ void av1_foreach_rest_unit_in_frame(Av1Common *cm, int32_t plane,
     RestUnitVisitor on_rest_unit,
     void *priv);
 
-void eb_aom_yv12_copy_y_c(const Yv12BufferConfig *src_ybc, Yv12BufferConfig *dst_ybc);
-void eb_aom_yv12_copy_u_c(const Yv12BufferConfig *src_bc, Yv12BufferConfig *dst_bc);
-void eb_aom_yv12_copy_v_c(const Yv12BufferConfig *src_bc, Yv12BufferConfig *dst_bc);
-
-int32_t eb_aom_realloc_frame_buffer(Yv12BufferConfig *ybf, int32_t width, int32_t height,
-    int32_t ss_x, int32_t ss_y, int32_t use_highbitdepth,
-    int32_t border, int32_t byte_alignment,
-    AomCodecFrameBuffer *fb,
-    aom_get_frame_buffer_cb_fn_t cb, void *cb_priv);
-
 ///---filter.h
 #define MAX_FILTER_TAP 8
 
@@ -1220,93 +1210,65 @@ void eb_av1_loop_restoration_filter_unit(
     }
 }
 
-typedef struct {
-    const RestorationInfo *rsi;
-    RestorationLineBuffers *rlbs;
-    const Av1Common *cm;
-    int32_t tile_stripe0;
-    int32_t ss_x, ss_y;
-    int32_t highbd, bit_depth;
-    uint8_t *data8, *dst8;
-    int32_t data_stride, dst_stride;
-    int32_t *tmpbuf;
-} FilterFrameCtxt;
-
-static void filter_frame_on_tile(int32_t tile_row, int32_t tile_col, void *priv) {
-    (void)tile_col;
-    FilterFrameCtxt *ctxt = (FilterFrameCtxt *)priv;
-    ctxt->tile_stripe0 =
-        (tile_row == 0) ? 0 : ctxt->cm->rst_end_stripe[tile_row - 1];
-}
-
-static void filter_frame_on_unit(const RestorationTileLimits *limits,
-    const AV1PixelRect *tile_rect,
-    int32_t rest_unit_idx, void *priv) {
-    FilterFrameCtxt *ctxt = (FilterFrameCtxt *)priv;
-    const RestorationInfo *rsi = ctxt->rsi;
-
-    eb_av1_loop_restoration_filter_unit(
-        1,
-        limits, &rsi->unit_info[rest_unit_idx], &rsi->boundaries, ctxt->rlbs,
-        tile_rect, ctxt->tile_stripe0, ctxt->ss_x, ctxt->ss_y, ctxt->highbd,
-        ctxt->bit_depth, ctxt->data8, ctxt->data_stride, ctxt->dst8,
-        ctxt->dst_stride, ctxt->tmpbuf, rsi->optimized_lr);
-}
-
-void eb_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
-    Av1Common *cm, int32_t optimized_lr) {
-    // assert(!cm->all_lossless);
-    const int32_t num_planes = 3;// av1_num_planes(cm);
-    typedef void(*copy_fun)(const Yv12BufferConfig *src,
-        Yv12BufferConfig *dst);
-    static const copy_fun copy_funs[3] = { eb_aom_yv12_copy_y_c, eb_aom_yv12_copy_u_c, eb_aom_yv12_copy_v_c };//CHKN SSE
-
-    Yv12BufferConfig *dst = &cm->rst_frame;
-
-    const int32_t frame_width = frame->crop_widths[0];
-    const int32_t frame_height = frame->crop_heights[0];
-    if (eb_aom_realloc_frame_buffer(dst, frame_width, frame_height,
-        cm->subsampling_x, cm->subsampling_y,
-        cm->use_highbitdepth, AOM_BORDER_IN_PIXELS,
-        cm->byte_alignment, NULL, NULL, NULL) < 0)
-        printf("Failed to allocate restoration dst buffer\n");
-
-    RestorationLineBuffers rlbs;
-    const int32_t bit_depth = cm->bit_depth;
+// Filter the stripe of one plane of the frame. The stripe rows are copied into
+// src, where the stripe boundaries are set up, so the other stripes of the
+// frame can be filtered at the same time
+void eb_av1_loop_restoration_filter_stripe(Yv12BufferConfig *frame,
+    Yv12BufferConfig *src, Av1Common *cm, int32_t plane, int32_t stripe,
+    int32_t *tmpbuf) {
+    const RestorationInfo *rsi = &cm->rst_info[plane];
+    const int32_t is_uv = plane > 0;
+    const int32_t ss_x = is_uv && cm->subsampling_x;
+    const int32_t ss_y = is_uv && cm->subsampling_y;
     const int32_t highbd = cm->use_highbitdepth;
-
-    for (int32_t plane = 0; plane < num_planes; ++plane) {
-        RestorationInfo *rsi = &cm->rst_info[plane];
-        RestorationType rtype = rsi->frame_restoration_type;
-        rsi->optimized_lr = optimized_lr;
-
-        if (rtype == RESTORE_NONE)
-            continue;
-        const int32_t is_uv = plane > 0;
-        const int32_t plane_width = frame->crop_widths[is_uv];
-        const int32_t plane_height = frame->crop_heights[is_uv];
-
-        eb_extend_frame(frame->buffers[plane], plane_width, plane_height,
-            frame->strides[is_uv], RESTORATION_BORDER, RESTORATION_BORDER,
-            highbd);
-
-        FilterFrameCtxt ctxt;
-        ctxt.rsi = rsi;
-        ctxt.rlbs = &rlbs;
-        ctxt.cm = cm;
-        ctxt.ss_x = is_uv && cm->subsampling_x;
-        ctxt.ss_y = is_uv && cm->subsampling_y;
-        ctxt.highbd = highbd;
-        ctxt.bit_depth = bit_depth;
-        ctxt.data8 = frame->buffers[plane];
-        ctxt.dst8 = dst->buffers[plane];
-        ctxt.data_stride = frame->strides[is_uv];
-        ctxt.dst_stride = dst->strides[is_uv];
-        ctxt.tmpbuf = cm->rst_tmpbuf;
-
-        av1_foreach_rest_unit_in_frame(cm, plane, filter_frame_on_tile, filter_frame_on_unit, &ctxt);
-
-        copy_funs[plane](dst, frame);
+    const AV1PixelRect tile_rect = whole_frame_rect(cm, is_uv);
+    const int32_t tile_w = tile_rect.right - tile_rect.left;
+    const int32_t full_stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+    const int32_t runit_offset = RESTORATION_UNIT_OFFSET >> ss_y;
+    const int32_t unit_size = rsi->restoration_unit_size;
+    const int32_t ext_size = unit_size * 3 / 2;
+    // The last unit row takes the remaining stripes
+    const int32_t unit_row = AOMMIN(stripe * full_stripe_height / unit_size,
+        rsi->vert_units_per_tile - 1);
+    const int32_t data_stride = frame->strides[is_uv];
+    const int32_t src_stride = src->strides[is_uv];
+    RestorationLineBuffers rlbs;
+    RestorationTileLimits limits;
+
+    limits.v_start = AOMMAX(tile_rect.top,
+        tile_rect.top + stripe * full_stripe_height - runit_offset);
+    limits.v_end = AOMMIN(tile_rect.bottom,
+        tile_rect.top + (stripe + 1) * full_stripe_height - runit_offset);
+    if (limits.v_start >= limits.v_end) return;
+
+    // Only the frame extension is taken around the stripe, the lines
+    // above and below the other stripes come from rsi->boundaries
+    const int32_t copy_start = limits.v_start -
+        (limits.v_start == tile_rect.top ? RESTORATION_BORDER : 0);
+    const int32_t copy_end = limits.v_end +
+        (limits.v_end == tile_rect.bottom ? RESTORATION_BORDER : 0);
+    copy_tile(tile_w + 2 * RESTORATION_BORDER, copy_end - copy_start,
+        frame->buffers[plane] + copy_start * data_stride - RESTORATION_BORDER, data_stride,
+        src->buffers[plane] + copy_start * src_stride - RESTORATION_BORDER, src_stride,
+        highbd);
+
+    int32_t x0 = 0, j = 0;
+    while (x0 < tile_w) {
+        int32_t remaining_w = tile_w - x0;
+        int32_t w = (remaining_w < ext_size) ? remaining_w : unit_size;
+
+        limits.h_start = tile_rect.left + x0;
+        limits.h_end = tile_rect.left + x0 + w;
+
+        eb_av1_loop_restoration_filter_unit(
+            1,
+            &limits, &rsi->unit_info[unit_row * rsi->horz_units_per_tile + j],
+            &rsi->boundaries, &rlbs, &tile_rect, 0, ss_x, ss_y, highbd,
+            cm->bit_depth, src->buffers[plane], src_stride, frame->buffers[plane],
+            data_stride, tmpbuf, rsi->optimized_lr);
+
+        x0 += w;
+        ++j;
     }
 }
 
@@ -125,6 +125,8 @@ void apply_segmentation_based_quantization(
     uint16_t *variance_ptr = picture_control_set_ptr->parent_pcs_ptr->variance[sb_ptr->index];
     SegmentationParams *segmentation_params = &picture_control_set_ptr->parent_pcs_ptr->frm_hdr.segmentation_params;
     uint16_t variance = get_variance_for_cu(blk_geom, variance_ptr);
+    // Variances above the last bin edge go to the last segment
+    cu_ptr->segment_id = MAX_SEGMENTS - 1;
     for (int i = 0; i < MAX_SEGMENTS; i++) {
         if (variance <= segmentation_params->variance_bin_edge[i]) {
             cu_ptr->segment_id = i;
@@ -133,7 +135,7 @@ void apply_segmentation_based_quantization(
     }
     int32_t q_index = picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx +
                       picture_control_set_ptr->parent_pcs_ptr->frm_hdr.segmentation_params.feature_data[cu_ptr->segment_id][SEG_LVL_ALT_Q];
-    cu_ptr->qp = q_index_to_quantizer[q_index];
+    cu_ptr->qp = q_index_to_quantizer[clamp(q_index, MINQ, MAXQ)];
 
 }
 
@@ -243,6 +243,7 @@ EbErrorType copy_sequence_control_set(
     dst->film_grain_denoise_strength = src->film_grain_denoise_strength;          writeCount += sizeof(int32_t);
     dst->seq_header.film_grain_params_present = src->seq_header.film_grain_params_present;              writeCount += sizeof(int32_t);
     dst->seq_header.film_grain_params_present = src->seq_header.film_grain_params_present;              writeCount += sizeof(int32_t);
+    dst->core_count = src->core_count;                                                              writeCount += sizeof(int32_t);
     dst->picture_control_set_pool_init_count = src->picture_control_set_pool_init_count;            writeCount += sizeof(int32_t);
     dst->picture_control_set_pool_init_count_child = src->picture_control_set_pool_init_count_child; writeCount += sizeof(int32_t);
     dst->pa_reference_picture_buffer_init_count = src->pa_reference_picture_buffer_init_count; writeCount += sizeof(int32_t);
@@ -269,6 +270,9 @@ EbErrorType copy_sequence_control_set(
     dst->mode_decision_configuration_process_init_count = src->mode_decision_configuration_process_init_count; writeCount += sizeof(int32_t);
     dst->enc_dec_process_init_count = src->enc_dec_process_init_count; writeCount += sizeof(int32_t);
     dst->entropy_coding_process_init_count = src->entropy_coding_process_init_count; writeCount += sizeof(int32_t);
+    dst->dlf_process_init_count = src->dlf_process_init_count; writeCount += sizeof(int32_t);
+    dst->cdef_process_init_count = src->cdef_process_init_count; writeCount += sizeof(int32_t);
+    dst->rest_process_init_count = src->rest_process_init_count; writeCount += sizeof(int32_t);
     dst->total_process_init_count = src->total_process_init_count; writeCount += sizeof(int32_t);
     dst->left_padding = src->left_padding; writeCount += sizeof(int16_t);
     dst->right_padding = src->right_padding; writeCount += sizeof(int16_t);
@@ -477,7 +481,7 @@ EbErrorType sb_geom_init(SequenceControlSet * sequence_control_set_ptr)
         uint16_t max_block_count = sequence_control_set_ptr->max_block_cnt;
 
         for (md_scan_block_index = 0; md_scan_block_index < max_block_count ; md_scan_block_index++) {
-            const BlockGeom * blk_geom = get_blk_geom_mds(md_scan_block_index);
+            const BlockGeom * blk_geom = get_blk_geom_mds(md_scan_block_index, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
             if (sequence_control_set_ptr->over_boundary_block_mode == 1) {
                 sequence_control_set_ptr->sb_geom[sb_index].block_is_allowed[md_scan_block_index] =
                     ((sequence_control_set_ptr->sb_geom[sb_index].origin_x + blk_geom->origin_x + blk_geom->bwidth / 2 < sequence_control_set_ptr->seq_header.max_frame_width) &&
@@ -491,7 +495,7 @@ EbErrorType sb_geom_init(SequenceControlSet * sequence_control_set_ptr)
                     sequence_control_set_ptr->sb_geom[sb_index].block_is_allowed[md_scan_block_index] = EB_FALSE;
 
                 if (blk_geom->shape != PART_N)
-                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
                 sequence_control_set_ptr->sb_geom[sb_index].block_is_inside_md_scan[md_scan_block_index] =
                     ((sequence_control_set_ptr->sb_geom[sb_index].origin_x >= sequence_control_set_ptr->seq_header.max_frame_width) ||
                     (sequence_control_set_ptr->sb_geom[sb_index].origin_y >= sequence_control_set_ptr->seq_header.max_frame_height)) ?
@@ -500,7 +504,7 @@ EbErrorType sb_geom_init(SequenceControlSet * sequence_control_set_ptr)
             }
             else {
                 if (blk_geom->shape != PART_N)
-                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                    blk_geom = get_blk_geom_mds(blk_geom->sqi_mds, sequence_control_set_ptr->seq_header.sb_size == BLOCK_128X128);
 
                 sequence_control_set_ptr->sb_geom[sb_index].block_is_allowed[md_scan_block_index] =
                     ((sequence_control_set_ptr->sb_geom[sb_index].origin_x + blk_geom->origin_x + blk_geom->bwidth > sequence_control_set_ptr->seq_header.max_frame_width) ||
@@ -127,6 +127,8 @@ extern "C" {
         uint32_t                                tf_segment_row_count;
         EbBool                                  enable_altrefs;
         // Buffers
+        // core_count - Number of cores the buffers and the processes are sized for
+        uint32_t                                core_count;
         uint32_t                                picture_control_set_pool_init_count;
         uint32_t                                picture_control_set_pool_init_count_child;
         uint32_t                                pa_reference_picture_buffer_init_count;
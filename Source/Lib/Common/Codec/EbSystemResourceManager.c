@@ -4,9 +4,304 @@
 */
 
 #include <stdlib.h>
+#include <assert.h>
 
 #include "EbSystemResourceManager.h"
+#include "EbTrace.h"
 
+// Pooled thread of the calling thread, NULL if the thread is not pooled
+static EB_THREAD_LOCAL EbPoolThread *current_thread_ptr = NULL;
+
+static void eb_thread_pool_acquire(EbPoolThread *thread_ptr);
+static void eb_thread_pool_release(EbPoolThread *thread_ptr);
+
+/**************************************
+ * EbThreadPoolBlockOnSemaphore
+ *   Blocks on semaphore_handle. A pooled
+ *   thread gives its run slot away for
+ *   the time it is blocked
+ **************************************/
+static void EbThreadPoolBlockOnSemaphore(
+    EbHandle  semaphore_handle)
+{
+    EbPoolThread *thread_ptr = current_thread_ptr;
+
+    if (thread_ptr)
+        eb_thread_pool_release(thread_ptr);
+
+    eb_block_on_semaphore(semaphore_handle);
+
+    if (thread_ptr)
+        eb_thread_pool_acquire(thread_ptr);
+}
+
+#if EB_LOCKFREE_FIFO
+/**************************************
+ * Spin iterations before a waiting
+ * process blocks on the OS semaphore
+ **************************************/
+#define EB_FIFO_SPIN_COUNT 1024
+
+/**************************************
+ * EbSpinSemaphoreCtor
+ **************************************/
+static EbErrorType EbSpinSemaphoreCtor(
+    EbSpinSemaphore  *semaphore_ptr,
+    uint32_t          max_count)
+{
+    semaphore_ptr->count = 0;
+    EB_CREATE_SEMAPHORE(semaphore_ptr->os_semaphore, 0, max_count);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * EbSpinSemaphorePost
+ **************************************/
+static void EbSpinSemaphorePost(
+    EbSpinSemaphore  *semaphore_ptr)
+{
+    // Wake up a blocked process, if any
+    if (eb_atomic_add(&semaphore_ptr->count, 1) < 0)
+        eb_post_semaphore(semaphore_ptr->os_semaphore);
+}
+
+/**************************************
+ * EbSpinSemaphoreTryWait
+ **************************************/
+static EbBool EbSpinSemaphoreTryWait(
+    EbSpinSemaphore  *semaphore_ptr)
+{
+    int32_t count = eb_atomic_load(&semaphore_ptr->count);
+
+    while (count > 0) {
+        if (eb_atomic_cas(&semaphore_ptr->count, count, count - 1))
+            return EB_TRUE;
+        count = eb_atomic_load(&semaphore_ptr->count);
+    }
+    return EB_FALSE;
+}
+
+/**************************************
+ * EbSpinSemaphoreWait
+ **************************************/
+static void EbSpinSemaphoreWait(
+    EbSpinSemaphore  *semaphore_ptr)
+{
+    uint32_t spin;
+
+    for (spin = 0; spin < EB_FIFO_SPIN_COUNT; ++spin) {
+        if (EbSpinSemaphoreTryWait(semaphore_ptr))
+            return;
+        eb_cpu_pause();
+    }
+
+    // Block until a post, the count went negative
+    if (eb_atomic_add(&semaphore_ptr->count, -1) <= 0)
+        EbThreadPoolBlockOnSemaphore(semaphore_ptr->os_semaphore);
+}
+
+void EbRingDctor(EbPtr p)
+{
+    EbRing *obj = (EbRing*)p;
+    EB_FREE(obj->cell_array);
+}
+
+/**************************************
+ * EbRingCtor
+ **************************************/
+static EbErrorType EbRingCtor(
+    EbRing    *ring_ptr,
+    uint32_t   object_total_count)
+{
+    uint32_t cell_total_count = 1;
+    uint32_t cellIndex;
+
+    ring_ptr->dctor = EbRingDctor;
+
+    // Every object is in at most one ring, so the ring never fills up
+    while (cell_total_count < object_total_count)
+        cell_total_count <<= 1;
+    ring_ptr->mask = cell_total_count - 1;
+
+    EB_MALLOC(ring_ptr->cell_array, cell_total_count * sizeof(EbRingCell));
+    for (cellIndex = 0; cellIndex < cell_total_count; ++cellIndex) {
+        ring_ptr->cell_array[cellIndex].sequence = cellIndex;
+        ring_ptr->cell_array[cellIndex].wrapper_ptr = (EbObjectWrapper*)EB_NULL;
+    }
+    ring_ptr->enqueue_pos = 0;
+    ring_ptr->dequeue_pos = 0;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * Ring position atomics
+ *   The ring positions are unsigned so
+ *   that they wrap without overflow
+ **************************************/
+static INLINE uint32_t ring_pos_load(volatile uint32_t *ptr)
+{
+    return (uint32_t)eb_atomic_load((volatile int32_t *)ptr);
+}
+
+static INLINE void ring_pos_store(volatile uint32_t *ptr, uint32_t value)
+{
+    eb_atomic_store((volatile int32_t *)ptr, (int32_t)value);
+}
+
+static INLINE EbBool ring_pos_cas(volatile uint32_t *ptr, uint32_t expected,
+    uint32_t desired)
+{
+    return eb_atomic_cas((volatile int32_t *)ptr, (int32_t)expected,
+        (int32_t)desired);
+}
+
+/**************************************
+ * EbRingPushBack
+ **************************************/
+static void EbRingPushBack(
+    EbRing           *ring_ptr,
+    EbObjectWrapper  *wrapper_ptr)
+{
+    EbRingCell *cell_ptr;
+    uint32_t pos = ring_pos_load(&ring_ptr->enqueue_pos);
+
+    // Claim the cell at enqueue_pos once it is free for this lap
+    for (;;) {
+        cell_ptr = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        int32_t diff = (int32_t)(ring_pos_load(&cell_ptr->sequence) - pos);
+        assert(diff >= 0);
+        if (diff == 0 && ring_pos_cas(&ring_ptr->enqueue_pos, pos, pos + 1))
+            break;
+        pos = ring_pos_load(&ring_ptr->enqueue_pos);
+    }
+
+    // Publish the object to the consumers
+    cell_ptr->wrapper_ptr = wrapper_ptr;
+    ring_pos_store(&cell_ptr->sequence, pos + 1);
+}
+
+/**************************************
+ * EbRingPopFront
+ **************************************/
+static EbBool EbRingPopFront(
+    EbRing           *ring_ptr,
+    EbObjectWrapper **wrapper_ptr)
+{
+    EbRingCell *cell_ptr;
+    uint32_t pos = ring_pos_load(&ring_ptr->dequeue_pos);
+
+    // Claim the cell at dequeue_pos once its object is published
+    for (;;) {
+        cell_ptr = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        int32_t diff = (int32_t)(ring_pos_load(&cell_ptr->sequence) - (pos + 1));
+        if (diff < 0)
+            return EB_FALSE;
+        if (diff == 0 && ring_pos_cas(&ring_ptr->dequeue_pos, pos, pos + 1))
+            break;
+        pos = ring_pos_load(&ring_ptr->dequeue_pos);
+    }
+
+    // Free the cell for the next lap
+    *wrapper_ptr = cell_ptr->wrapper_ptr;
+    ring_pos_store(&cell_ptr->sequence, pos + ring_ptr->mask + 1);
+
+    return EB_TRUE;
+}
+
+/**************************************
+ * EbFifoCtor
+ **************************************/
+static EbErrorType EbFifoCtor(
+    EbFifo           *fifoPtr,
+    EbMuxingQueue    *queue_ptr)
+{
+    // Copy the Muxing Queue ptr this Fifo belongs to
+    fifoPtr->queue_ptr = queue_ptr;
+
+    return EB_ErrorNone;
+}
+
+void EbMuxingQueueDctor(EbPtr p)
+{
+    EbMuxingQueue* obj = (EbMuxingQueue*)p;
+    EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
+    EB_DELETE(obj->object_ring);
+    EB_DESTROY_SEMAPHORE(obj->object_semaphore.os_semaphore);
+}
+
+/**************************************
+ * EbMuxingQueueCtor
+ **************************************/
+static EbErrorType EbMuxingQueueCtor(
+    EbMuxingQueue        *queue_ptr,
+    uint32_t              object_total_count,
+    uint32_t              process_total_count,
+    EbFifo         ***processFifoPtrArrayPtr)
+{
+    uint32_t processIndex;
+    EbErrorType     return_error = EB_ErrorNone;
+
+    queue_ptr->dctor = EbMuxingQueueDctor;
+    queue_ptr->process_total_count = process_total_count;
+
+    // Construct Object Ring
+    EB_NEW(
+        queue_ptr->object_ring,
+        EbRingCtor,
+        object_total_count);
+    return_error = EbSpinSemaphoreCtor(
+        &queue_ptr->object_semaphore,
+        object_total_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Construct the Process Fifos
+    EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
+
+    for (processIndex = 0; processIndex < queue_ptr->process_total_count; ++processIndex) {
+        EB_NEW(
+            queue_ptr->process_fifo_ptr_array[processIndex],
+            EbFifoCtor,
+            queue_ptr);
+    }
+
+    *processFifoPtrArrayPtr = queue_ptr->process_fifo_ptr_array;
+
+    return return_error;
+}
+
+/**************************************
+ * EbMuxingQueueObjectPushBack
+ **************************************/
+static EbErrorType EbMuxingQueueObjectPushBack(
+    EbMuxingQueue    *queue_ptr,
+    EbObjectWrapper  *object_ptr)
+{
+    EbRingPushBack(
+        queue_ptr->object_ring,
+        object_ptr);
+
+    EbSpinSemaphorePost(&queue_ptr->object_semaphore);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * EbMuxingQueueObjectPopFront
+ *   Blocks until an object is available
+ **************************************/
+static void EbMuxingQueueObjectPopFront(
+    EbMuxingQueue    *queue_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbSpinSemaphoreWait(&queue_ptr->object_semaphore);
+
+    // The object is counted, its producer may still be publishing it
+    while (EbRingPopFront(queue_ptr->object_ring, wrapper_dbl_ptr) == EB_FALSE)
+        eb_cpu_pause();
+}
+#else
 void EbFifoDctor(EbPtr p)
 {
     EbFifo *obj = (EbFifo*)p;
@@ -314,6 +609,65 @@ static EbErrorType EbMuxingQueueObjectPushFront(
     return return_error;
 }
 
+#endif
+
+#if EB_LOCKFREE_FIFO
+/*********************************************************************
+ * eb_object_release_enable
+ *   Enables the release_enable member of EbObjectWrapper.  Used by
+ *   certain objects (e.g. SequenceControlSet) to control whether
+ *   EbObjectWrappers are allowed to be released or not.
+ *
+ *   wrapper_ptr
+ *      pointer to the EbObjectWrapper to be modified.
+ *********************************************************************/
+EbErrorType eb_object_release_enable(
+    EbObjectWrapper   *wrapper_ptr)
+{
+    eb_atomic_store((volatile int32_t *)&wrapper_ptr->release_enable, EB_TRUE);
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * eb_object_release_disable
+ *   Disables the release_enable member of EbObjectWrapper.  Used by
+ *   certain objects (e.g. SequenceControlSet) to control whether
+ *   EbObjectWrappers are allowed to be released or not.
+ *
+ *   wrapper_ptr
+ *      pointer to the EbObjectWrapper to be modified.
+ *********************************************************************/
+EbErrorType eb_object_release_disable(
+    EbObjectWrapper   *wrapper_ptr)
+{
+    eb_atomic_store((volatile int32_t *)&wrapper_ptr->release_enable, EB_FALSE);
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * eb_object_inc_live_count
+ *   Increments the live_count member of EbObjectWrapper.  Used by
+ *   certain objects (e.g. SequenceControlSet) to count the number of active
+ *   pointers of a EbObjectWrapper in pipeline at any point in time.
+ *
+ *   wrapper_ptr
+ *      pointer to the EbObjectWrapper to be modified.
+ *
+ *   increment_number
+ *      The number to increment the live count by.
+ *********************************************************************/
+EbErrorType eb_object_inc_live_count(
+    EbObjectWrapper   *wrapper_ptr,
+    uint32_t               increment_number)
+{
+    eb_atomic_add((volatile int32_t *)&wrapper_ptr->live_count,
+        (int32_t)increment_number);
+
+    return EB_ErrorNone;
+}
+#else
 /*********************************************************************
  * eb_object_release_enable
  *   Enables the release_enable member of EbObjectWrapper.  Used by
@@ -398,6 +752,7 @@ EbErrorType eb_object_inc_live_count(
 
     return return_error;
 }
+#endif
 
 //ugly hack
 typedef struct DctorAble
@@ -438,6 +793,22 @@ static EbErrorType eb_object_wrapper_ctor(EbObjectWrapper* wrapper,
     return EB_ErrorNone;
 }
 
+EbErrorType eb_object_memory_cost(
+    uint64_t           *cost_ptr,
+    EbCreator           object_creator,
+    EbPtr               object_init_data_ptr,
+    EbDctor             object_destroyer)
+{
+    EbObjectWrapper *wrapper_ptr;
+    uint64_t start_mem = eb_get_thread_mem();
+
+    EB_NEW(wrapper_ptr, eb_object_wrapper_ctor, NULL,
+        object_creator, object_init_data_ptr, object_destroyer);
+    *cost_ptr = eb_get_thread_mem() - start_mem;
+    EB_DELETE(wrapper_ptr);
+    return EB_ErrorNone;
+}
+
 static void eb_system_resource_dctor(EbPtr p)
 {
     EbSystemResource* obj = (EbSystemResource*)p;
@@ -536,6 +907,154 @@ EbErrorType eb_system_resource_ctor(
     return return_error;
 }
 
+#if EB_LOCKFREE_FIFO
+/*********************************************************************
+ * EbSystemResourcePostObject
+ *   Queues a full EbObjectWrapper to the SystemResource. This
+ *   function posts the SystemResource fullFifo object_semaphore.
+ *
+ *   wrapper_ptr
+ *      pointer to EbObjectWrapper to be posted.
+ *********************************************************************/
+EbErrorType eb_post_full_object(
+    EbObjectWrapper   *object_ptr)
+{
+    return EbMuxingQueueObjectPushBack(
+        object_ptr->system_resource_ptr->full_queue,
+        object_ptr);
+}
+
+/*********************************************************************
+ * EbSystemResourceReleaseObject
+ *   Queues an empty EbObjectWrapper to the SystemResource once its
+ *   live_count drops to zero. The live_count is updated with a compare
+ *   and swap, so that a single release queues the object.
+ *
+ *   object_ptr
+ *      pointer to EbObjectWrapper to be released.
+ *********************************************************************/
+EbErrorType eb_release_object(
+    EbObjectWrapper   *object_ptr)
+{
+    volatile int32_t *live_count_ptr = (volatile int32_t *)&object_ptr->live_count;
+    int32_t live_count;
+
+    // Decrement live_count
+    do {
+        live_count = eb_atomic_load(live_count_ptr);
+    } while (live_count != 0 &&
+        !eb_atomic_cas(live_count_ptr, live_count, live_count - 1));
+
+    // Set live_count to EB_ObjectWrapperReleasedValue
+    if (eb_atomic_load((volatile int32_t *)&object_ptr->release_enable) == EB_TRUE &&
+        eb_atomic_cas(live_count_ptr, 0, (int32_t)EB_ObjectWrapperReleasedValue)) {
+        if (object_ptr->system_resource_ptr->release_callback)
+            object_ptr->system_resource_ptr->release_callback(
+                object_ptr->object_ptr,
+                object_ptr->system_resource_ptr->release_callback_data);
+        EbMuxingQueueObjectPushBack(
+            object_ptr->system_resource_ptr->empty_queue,
+            object_ptr);
+    }
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * EbSystemResourceGetEmptyObject
+ *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
+ *   function blocks on the SystemResource emptyFifo object_semaphore.
+ *
+ *   wrapper_dbl_ptr
+ *      Double pointer used to pass the pointer to the empty
+ *      EbObjectWrapper pointer.
+ *********************************************************************/
+EbErrorType eb_get_empty_object(
+    EbFifo   *empty_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    uint64_t stall_begin = EB_TRACE_ACTIVE() ? eb_trace_stall_begin() : 0;
+
+    EbMuxingQueueObjectPopFront(
+        empty_fifo_ptr->queue_ptr,
+        wrapper_dbl_ptr);
+
+    if (stall_begin)
+        eb_trace_stall_end(stall_begin);
+
+    // Reset the wrapper's live_count
+    eb_atomic_store((volatile int32_t *)&(*wrapper_dbl_ptr)->live_count, 0);
+
+    // Object release enable
+    eb_atomic_store((volatile int32_t *)&(*wrapper_dbl_ptr)->release_enable, EB_TRUE);
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * EbSystemResourceGetFullObject
+ *   Dequeues an full EbObjectWrapper from the SystemResource. This
+ *   function blocks on the SystemResource fullFifo object_semaphore.
+ *
+ *   wrapper_dbl_ptr
+ *      Double pointer used to pass the pointer to the full
+ *      EbObjectWrapper pointer.
+ *********************************************************************/
+EbErrorType eb_get_full_object(
+    EbFifo   *full_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    const EbBool trace = EB_TRACE_ACTIVE();
+
+    if (trace)
+        eb_trace_wait_begin();
+
+    EbMuxingQueueObjectPopFront(
+        full_fifo_ptr->queue_ptr,
+        wrapper_dbl_ptr);
+
+    if (trace) {
+        int32_t depth = eb_atomic_load(&full_fifo_ptr->queue_ptr->object_semaphore.count);
+        eb_trace_wait_end(depth > 0 ? (uint32_t)depth : 0);
+    }
+
+    return EB_ErrorNone;
+}
+
+EbErrorType eb_get_full_object_non_blocking(
+    EbFifo   *full_fifo_ptr,
+    EbObjectWrapper **wrapper_dbl_ptr)
+{
+    EbMuxingQueue *queue_ptr = full_fifo_ptr->queue_ptr;
+
+    if (EbSpinSemaphoreTryWait(&queue_ptr->object_semaphore)) {
+        // The object is counted, its producer may still be publishing it
+        while (EbRingPopFront(queue_ptr->object_ring, wrapper_dbl_ptr) == EB_FALSE)
+            eb_cpu_pause();
+    }
+    else
+        *wrapper_dbl_ptr = (EbObjectWrapper*)EB_NULL;
+
+    return EB_ErrorNone;
+}
+#else
+/*********************************************************************
+ * EbFifoQueueDepth
+ *   Number of full objects left for the processes of a fifo, for the
+ *   pipeline trace. The muxing queue count is read without its lock.
+ *********************************************************************/
+static uint32_t EbFifoQueueDepth(
+    EbFifo   *fifoPtr)
+{
+    uint32_t depth = fifoPtr->queue_ptr->object_queue->current_count;
+    EbObjectWrapper *wrapper_ptr;
+
+    for (wrapper_ptr = fifoPtr->first_ptr; wrapper_ptr; wrapper_ptr = wrapper_ptr->next_ptr)
+        depth++;
+
+    return depth;
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -601,8 +1120,9 @@ EbErrorType eb_release_object(
     EbObjectWrapper   *object_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
 
-    eb_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    eb_block_on_mutex(resource_ptr->empty_queue->lockout_mutex);
 
     // Decrement live_count
     object_ptr->live_count = (object_ptr->live_count == 0) ? object_ptr->live_count : object_ptr->live_count - 1;
@@ -611,12 +1131,21 @@ EbErrorType eb_release_object(
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
+        // The callback may release other objects, it runs unlocked
+        if (resource_ptr->release_callback) {
+            eb_release_mutex(resource_ptr->empty_queue->lockout_mutex);
+            resource_ptr->release_callback(
+                object_ptr->object_ptr,
+                resource_ptr->release_callback_data);
+            eb_block_on_mutex(resource_ptr->empty_queue->lockout_mutex);
+        }
+
         EbMuxingQueueObjectPushFront(
-            object_ptr->system_resource_ptr->empty_queue,
+            resource_ptr->empty_queue,
             object_ptr);
     }
 
-    eb_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    eb_release_mutex(resource_ptr->empty_queue->lockout_mutex);
 
     return return_error;
 }
@@ -641,12 +1170,16 @@ EbErrorType eb_get_empty_object(
     EbObjectWrapper **wrapper_dbl_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    uint64_t    stall_begin = EB_TRACE_ACTIVE() ? eb_trace_stall_begin() : 0;
 
     // Queue the Fifo requesting the empty fifo
     EbReleaseProcess(empty_fifo_ptr);
 
     // Block on the counting Semaphore until an empty buffer is available
-    eb_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
+    EbThreadPoolBlockOnSemaphore(empty_fifo_ptr->counting_semaphore);
+
+    if (stall_begin)
+        eb_trace_stall_end(stall_begin);
 
     // Acquire lockout Mutex
     eb_block_on_mutex(empty_fifo_ptr->lockout_mutex);
@@ -687,13 +1220,18 @@ EbErrorType eb_get_full_object(
     EbFifo   *full_fifo_ptr,
     EbObjectWrapper **wrapper_dbl_ptr)
 {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType  return_error = EB_ErrorNone;
+    const EbBool trace = EB_TRACE_ACTIVE();
+    uint32_t     depth = 0;
+
+    if (trace)
+        eb_trace_wait_begin();
 
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(full_fifo_ptr);
 
     // Block on the counting Semaphore until an empty buffer is available
-    eb_block_on_semaphore(full_fifo_ptr->counting_semaphore);
+    EbThreadPoolBlockOnSemaphore(full_fifo_ptr->counting_semaphore);
 
     // Acquire lockout Mutex
     eb_block_on_mutex(full_fifo_ptr->lockout_mutex);
@@ -702,9 +1240,15 @@ EbErrorType eb_get_full_object(
         full_fifo_ptr,
         wrapper_dbl_ptr);
 
+    if (trace)
+        depth = EbFifoQueueDepth(full_fifo_ptr);
+
     // Release Mutex
     eb_release_mutex(full_fifo_ptr->lockout_mutex);
 
+    if (trace)
+        eb_trace_wait_end(depth);
+
     return return_error;
 }
 
@@ -748,3 +1292,194 @@ EbErrorType eb_get_full_object_non_blocking(
 
     return return_error;
 }
+#endif
+
+/**************************************
+ * ThreadPool
+ **************************************/
+static void eb_thread_pool_dctor(EbPtr p)
+{
+    EbThreadPool *obj = (EbThreadPool*)p;
+    assert(!obj->channel_list_ptr);
+    EB_DESTROY_MUTEX(obj->lockout_mutex);
+}
+
+EbErrorType eb_thread_pool_ctor(
+    EbThreadPool *pool_ptr,
+    uint32_t      pool_size)
+{
+    pool_ptr->dctor = eb_thread_pool_dctor;
+    pool_ptr->pool_size = pool_size;
+
+    EB_CREATE_MUTEX(pool_ptr->lockout_mutex);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_thread_pool_hand_over
+ *   Hands the free run slots to the waiting
+ *   threads, the channel holding the fewest
+ *   slots first. Called with the pool mutex
+ *   held
+ **************************************/
+static void eb_thread_pool_hand_over(
+    EbThreadPool *pool_ptr)
+{
+    while (pool_ptr->wait_count && pool_ptr->running_count < pool_ptr->pool_size) {
+        EbThreadPoolChannel *channel_ptr = pool_ptr->next_channel_ptr;
+        EbThreadPoolChannel *best_channel_ptr = NULL;
+        EbPoolThread        *thread_ptr;
+
+        // Starting from next_channel_ptr serves the tied channels in turn
+        do {
+            if (channel_ptr->wait_first_ptr &&
+                (!best_channel_ptr || channel_ptr->running_count < best_channel_ptr->running_count))
+                best_channel_ptr = channel_ptr;
+            channel_ptr = channel_ptr->next_ptr ? channel_ptr->next_ptr : pool_ptr->channel_list_ptr;
+        } while (channel_ptr != pool_ptr->next_channel_ptr);
+
+        thread_ptr = best_channel_ptr->wait_first_ptr;
+        best_channel_ptr->wait_first_ptr = thread_ptr->next_ptr;
+        if (!best_channel_ptr->wait_first_ptr)
+            best_channel_ptr->wait_last_ptr = NULL;
+        thread_ptr->next_ptr = NULL;
+
+        pool_ptr->wait_count--;
+        pool_ptr->running_count++;
+        best_channel_ptr->running_count++;
+        pool_ptr->next_channel_ptr = best_channel_ptr->next_ptr ? best_channel_ptr->next_ptr : pool_ptr->channel_list_ptr;
+
+        eb_post_semaphore(thread_ptr->wake_semaphore);
+    }
+}
+
+/**************************************
+ * eb_thread_pool_acquire
+ *   Takes a free run slot, or waits for one
+ *   behind the threads already waiting
+ **************************************/
+static void eb_thread_pool_acquire(
+    EbPoolThread *thread_ptr)
+{
+    EbThreadPoolChannel *channel_ptr = thread_ptr->channel_ptr;
+    EbThreadPool        *pool_ptr = channel_ptr->pool_ptr;
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    if (!pool_ptr->wait_count && pool_ptr->running_count < pool_ptr->pool_size) {
+        pool_ptr->running_count++;
+        channel_ptr->running_count++;
+        eb_release_mutex(pool_ptr->lockout_mutex);
+        return;
+    }
+
+    if (channel_ptr->wait_last_ptr)
+        channel_ptr->wait_last_ptr->next_ptr = thread_ptr;
+    else
+        channel_ptr->wait_first_ptr = thread_ptr;
+    channel_ptr->wait_last_ptr = thread_ptr;
+    pool_ptr->wait_count++;
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    // The slot is accounted to the channel by the thread that hands it over
+    eb_block_on_semaphore(thread_ptr->wake_semaphore);
+}
+
+static void eb_thread_pool_release(
+    EbPoolThread *thread_ptr)
+{
+    EbThreadPoolChannel *channel_ptr = thread_ptr->channel_ptr;
+    EbThreadPool        *pool_ptr = channel_ptr->pool_ptr;
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    pool_ptr->running_count--;
+    channel_ptr->running_count--;
+    eb_thread_pool_hand_over(pool_ptr);
+    eb_release_mutex(pool_ptr->lockout_mutex);
+}
+
+/**************************************
+ * ThreadPoolChannel
+ **************************************/
+static void eb_thread_pool_channel_dctor(EbPtr p)
+{
+    EbThreadPoolChannel  *obj = (EbThreadPoolChannel*)p;
+    EbThreadPool         *pool_ptr = obj->pool_ptr;
+    EbThreadPoolChannel **link_ptr;
+
+    // Detach, the slots and the waits of the destroyed threads go back to the pool
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    for (link_ptr = &pool_ptr->channel_list_ptr; *link_ptr; link_ptr = &(*link_ptr)->next_ptr) {
+        if (*link_ptr == obj) {
+            *link_ptr = obj->next_ptr;
+            break;
+        }
+    }
+    if (pool_ptr->next_channel_ptr == obj)
+        pool_ptr->next_channel_ptr = obj->next_ptr ? obj->next_ptr : pool_ptr->channel_list_ptr;
+    pool_ptr->running_count -= obj->running_count;
+    for (EbPoolThread *thread_ptr = obj->wait_first_ptr; thread_ptr; thread_ptr = thread_ptr->next_ptr)
+        pool_ptr->wait_count--;
+    eb_thread_pool_hand_over(pool_ptr);
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    if (obj->thread_array) {
+        for (uint32_t i = 0; i < obj->thread_total_count; i++)
+            EB_DESTROY_SEMAPHORE(obj->thread_array[i].wake_semaphore);
+    }
+    EB_FREE_ARRAY(obj->thread_array);
+}
+
+EbErrorType eb_thread_pool_channel_ctor(
+    EbThreadPoolChannel *channel_ptr,
+    EbThreadPool        *pool_ptr,
+    uint32_t             thread_total_count)
+{
+    channel_ptr->dctor = eb_thread_pool_channel_dctor;
+    channel_ptr->pool_ptr = pool_ptr;
+    channel_ptr->thread_total_count = thread_total_count;
+
+    EB_CALLOC_ARRAY(channel_ptr->thread_array, thread_total_count);
+    for (uint32_t i = 0; i < thread_total_count; i++)
+        EB_CREATE_SEMAPHORE(channel_ptr->thread_array[i].wake_semaphore, 0, 1);
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    channel_ptr->next_ptr = pool_ptr->channel_list_ptr;
+    pool_ptr->channel_list_ptr = channel_ptr;
+    if (!pool_ptr->next_channel_ptr)
+        pool_ptr->next_channel_ptr = channel_ptr;
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    return EB_ErrorNone;
+}
+
+EbPoolThread *eb_thread_pool_add_thread(
+    EbThreadPoolChannel *channel_ptr,
+    void                *thread_function(void *),
+    void                *thread_context)
+{
+    EbPoolThread *thread_ptr;
+
+    assert(channel_ptr->thread_count < channel_ptr->thread_total_count);
+    thread_ptr = &channel_ptr->thread_array[channel_ptr->thread_count++];
+    thread_ptr->channel_ptr = channel_ptr;
+    thread_ptr->thread_function = thread_function;
+    thread_ptr->thread_context = thread_context;
+
+    return thread_ptr;
+}
+
+/**************************************
+ * eb_thread_pool_kernel
+ *   Runs the kernel of a pooled thread
+ *   once it holds a run slot
+ **************************************/
+void *eb_thread_pool_kernel(void *input_ptr)
+{
+    EbPoolThread *thread_ptr = (EbPoolThread*)input_ptr;
+
+    current_thread_ptr = thread_ptr;
+    eb_thread_pool_acquire(thread_ptr);
+
+    return thread_ptr->thread_function(thread_ptr->thread_context);
+}
@@ -17,6 +17,12 @@ extern "C" {
      *********************************/
 #define EB_ObjectWrapperReleasedValue   ~0u
 
+// EB_LOCKFREE_FIFO - selects the lock-free EbFifo and EbMuxingQueue
+//   implementation. Set by the LOCKFREE_FIFO build option.
+#ifndef EB_LOCKFREE_FIFO
+#define EB_LOCKFREE_FIFO 0
+#endif
+
      /*********************************************************************
       * Object Wrapper
       *   Provides state information for each type of object in the
@@ -50,6 +56,80 @@ extern "C" {
         struct EbObjectWrapper *next_ptr;
     } EbObjectWrapper;
 
+#if EB_LOCKFREE_FIFO
+    /*********************************************************************
+     * SpinSemaphore
+     *   Counting semaphore that spins on an atomic count before blocking
+     *   on an OS semaphore. A negative count is the number of blocked
+     *   threads, only those go through the OS semaphore (a futex on
+     *   Linux).
+     *********************************************************************/
+    typedef struct EbSpinSemaphore
+    {
+        volatile int32_t count;
+        EbHandle         os_semaphore;
+    } EbSpinSemaphore;
+
+    /*********************************************************************
+     * Ring
+     *   Bounded lock-free multi producer, multi consumer ring of
+     *   EbObjectWrapper pointers. Every cell carries a sequence number
+     *   telling whether it is ready to be written or read for the
+     *   current lap, producers and consumers claim cells with a
+     *   compare and swap on enqueue_pos and dequeue_pos. The single
+     *   producer, single consumer case goes through the same code
+     *   without contention. Positions and sequences only increase and
+     *   wrap around, they are compared through their signed difference.
+     *********************************************************************/
+    typedef struct EbRingCell
+    {
+        volatile uint32_t sequence;
+        EbObjectWrapper  *wrapper_ptr;
+    } EbRingCell;
+
+    typedef struct EbRing
+    {
+        EbDctor          dctor;
+        EbRingCell      *cell_array;
+        uint32_t         mask;
+
+        // enqueue_pos and dequeue_pos - kept on separate cache lines as
+        //   they are written by producers and consumers respectively.
+        uint8_t          pad0[64];
+        volatile uint32_t enqueue_pos;
+        uint8_t          pad1[64];
+        volatile uint32_t dequeue_pos;
+        uint8_t          pad2[64];
+    } EbRing;
+
+    /*********************************************************************
+     * Fifo
+     *   The process fifos of a MuxingQueue share its ring, an object
+     *   goes to whichever process asks first.
+     *********************************************************************/
+    typedef struct EbFifo
+    {
+        EbDctor  dctor;
+
+        // queue_ptr - pointer to MuxingQueue that the EbFifo is
+        //   associated with.
+        struct EbMuxingQueue *queue_ptr;
+    } EbFifo;
+
+    /*********************************************************************
+     * MuxingQueue
+     *   object_ring holds the queued objects, object_semaphore counts
+     *   them and blocks the processes waiting for one.
+     *********************************************************************/
+    typedef struct EbMuxingQueue
+    {
+        EbDctor            dctor;
+        EbRing            *object_ring;
+        EbSpinSemaphore    object_semaphore;
+        uint32_t           process_total_count;
+        EbFifo           **process_fifo_ptr_array;
+    } EbMuxingQueue;
+#else
     /*********************************************************************
      * Fifo
      *   Defines a static (i.e. no dynamic memory allocation) single
@@ -106,6 +186,7 @@ extern "C" {
         uint32_t              process_total_count;
         EbFifo          **process_fifo_ptr_array;
     } EbMuxingQueue;
+#endif
 
     /*********************************************************************
      * SystemResource
@@ -132,8 +213,93 @@ extern "C" {
 
         // The full FIFO contains a queue of completed buffers
         EbMuxingQueue     *full_queue;
+
+        // release_callback - called with the object and release_callback_data
+        //   when its live_count drops to zero, before it is queued back in
+        //   the empty FIFO. Optional, set after the construction.
+        void             (*release_callback)(EbPtr object_ptr, EbPtr callback_data);
+        EbPtr              release_callback_data;
     } EbSystemResource;
 
+    /*********************************************************************
+     * ThreadPool
+     *   Caps the number of kernel threads that run at the same time. A
+     *   pooled thread holds one of the pool_size run slots while it
+     *   processes its inputs and hands it over to another pooled thread
+     *   whenever it blocks on a fifo. The kernels of all the pooled
+     *   stages thus share pool_size cores, whatever their thread counts.
+     *
+     *   Several encoder handles may share a pool, each one through its own
+     *   channel. A freed slot goes to the first waiting thread of the
+     *   channel holding the fewest slots, channels tied on their slot count
+     *   being served in turn, so that a busy handle can not starve the
+     *   others.
+     *********************************************************************/
+    struct EbThreadPool;
+    struct EbThreadPoolChannel;
+
+    typedef struct EbPoolThread
+    {
+        struct EbThreadPoolChannel  *channel_ptr;
+        void                      *(*thread_function)(void *);
+        void                        *thread_context;
+
+        // wake_semaphore - Posted when a run slot is handed to the waiting thread
+        EbHandle                     wake_semaphore;
+        struct EbPoolThread         *next_ptr;
+    } EbPoolThread;
+
+    typedef struct EbThreadPoolChannel
+    {
+        EbDctor                      dctor;
+        struct EbThreadPool         *pool_ptr;
+
+        // thread_array - Kernel and context of every pooled thread of the handle
+        EbPoolThread                *thread_array;
+        uint32_t                     thread_count;
+        uint32_t                     thread_total_count;
+
+        // running_count - Run slots held by the threads of the channel
+        uint32_t                     running_count;
+
+        // Threads waiting for a run slot, in arrival order
+        EbPoolThread                *wait_first_ptr;
+        EbPoolThread                *wait_last_ptr;
+
+        struct EbThreadPoolChannel  *next_ptr;
+    } EbThreadPoolChannel;
+
+    typedef struct EbThreadPool
+    {
+        EbDctor               dctor;
+        // pool_size - Number of pooled threads allowed to run at once
+        uint32_t              pool_size;
+        uint32_t              running_count;
+        uint32_t              wait_count;
+
+        // lockout_mutex - Protects the slot counts, the wait lists and the
+        //   channel list
+        EbHandle              lockout_mutex;
+
+        // channel_list_ptr - Attached channels, next_channel_ptr being the
+        //   first one considered on the next slot hand over
+        EbThreadPoolChannel  *channel_list_ptr;
+        EbThreadPoolChannel  *next_channel_ptr;
+    } EbThreadPool;
+
+// Creates the threads of a kernel array, in the pool channel if channel_ptr is set
+#define EB_CREATE_POOL_THREAD_ARRAY(pa, count, channel_ptr, thread_function, thread_contexts) \
+    do { \
+        if (channel_ptr) { \
+            EB_ALLOC_PTR_ARRAY(pa, count); \
+            for (uint32_t i = 0; i < count; i++) \
+                EB_CREATE_THREAD(pa[i], eb_thread_pool_kernel, \
+                    eb_thread_pool_add_thread(channel_ptr, thread_function, thread_contexts[i])); \
+        } \
+        else \
+            EB_CREATE_THREAD_ARRAY(pa, count, thread_function, thread_contexts); \
+    } while (0)
+
     /*********************************************************************
      * eb_object_release_enable
      *   Enables the release_enable member of EbObjectWrapper.  Used by
@@ -228,6 +394,22 @@ extern "C" {
         EbPtr               object_init_data_ptr,
         EbDctor             object_destroyer);
 
+    /*********************************************************************
+     * eb_object_memory_cost
+     *   Measures the memory one object of a SystemResource takes, its
+     *   EbObjectWrapper included, by constructing and deleting an object
+     *   with the object_ctor, object_init_data_ptr and object_destroyer
+     *   later passed to eb_system_resource_ctor.
+     *
+     *   cost_ptr
+     *     pointer that will contain the object size in bytes.
+     *********************************************************************/
+    extern EbErrorType eb_object_memory_cost(
+        uint64_t           *cost_ptr,
+        EbCreator           object_ctor,
+        EbPtr               object_init_data_ptr,
+        EbDctor             object_destroyer);
+
     /*********************************************************************
      * EbSystemResourceGetEmptyObject
      *   Dequeues an empty EbObjectWrapper from the SystemResource.  The
@@ -300,6 +482,37 @@ extern "C" {
      *********************************************************************/
     extern EbErrorType eb_release_object(
         EbObjectWrapper *object_ptr);
+
+    /*********************************************************************
+     * eb_thread_pool_ctor
+     *   Constructor of a ThreadPool with pool_size run slots.
+     *********************************************************************/
+    extern EbErrorType eb_thread_pool_ctor(
+        EbThreadPool *pool_ptr,
+        uint32_t      pool_size);
+
+    /*********************************************************************
+     * eb_thread_pool_channel_ctor
+     *   Attaches a channel for up to thread_total_count pooled threads to
+     *   pool_ptr. The destructor detaches it, the threads of the channel
+     *   must be destroyed before.
+     *********************************************************************/
+    extern EbErrorType eb_thread_pool_channel_ctor(
+        EbThreadPoolChannel *channel_ptr,
+        EbThreadPool        *pool_ptr,
+        uint32_t             thread_total_count);
+
+    /*********************************************************************
+     * eb_thread_pool_add_thread
+     *   Registers a pooled thread. Returns the context to create the
+     *   thread with, eb_thread_pool_kernel being its thread function.
+     *********************************************************************/
+    extern EbPoolThread *eb_thread_pool_add_thread(
+        EbThreadPoolChannel *channel_ptr,
+        void                *thread_function(void *),
+        void                *thread_context);
+
+    extern void *eb_thread_pool_kernel(void *input_ptr);
 #ifdef __cplusplus
 }
 #endif
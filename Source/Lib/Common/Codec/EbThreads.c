@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbMalloc.h"
  /****************************************
   * Win32 Includes
   ****************************************/
@@ -42,6 +43,26 @@ void printfTime(const char *fmt, ...)
 #endif
 #endif
 
+/****************************************
+ * Thread start, passes the memory account
+ * and subsystem of the creating thread on
+ ****************************************/
+typedef struct EbThreadStart {
+    void               *(*thread_function)(void *);
+    void               *thread_context;
+    EbMemAccount       *mem_account;
+    EbMemorySubsystem   mem_subsystem;
+} EbThreadStart;
+
+static void *eb_thread_start(void *input)
+{
+    EbThreadStart start = *(EbThreadStart*)input;
+    free(input);
+    eb_set_mem_account(start.mem_account);
+    eb_set_mem_subsystem(start.mem_subsystem);
+    return start.thread_function(start.thread_context);
+}
+
 /****************************************
  * eb_create_thread
  ****************************************/
@@ -50,6 +71,19 @@ EbHandle eb_create_thread(
     void *thread_context)
 {
     EbHandle thread_handle = NULL;
+    EbThreadStart *start = NULL;
+
+    if (eb_get_mem_account()) {
+        start = (EbThreadStart*)malloc(sizeof(EbThreadStart));
+        if (start == NULL)
+            return NULL;
+        start->thread_function = thread_function;
+        start->thread_context = thread_context;
+        start->mem_account = eb_get_mem_account();
+        start->mem_subsystem = eb_get_mem_subsystem();
+        thread_function = eb_thread_start;
+        thread_context = start;
+    }
 
 #ifdef _WIN32
 
@@ -60,6 +94,8 @@ EbHandle eb_create_thread(
         thread_context,                  // context to be tied to the new thread
         0,                              // thread active when created
         NULL);                          // new thread ID
+    if (thread_handle == NULL)
+        free(start);
 
 #else
 
@@ -97,6 +133,8 @@ EbHandle eb_create_thread(
             }
         }
     }
+    if (thread_handle == NULL)
+        free(start);
     pthread_attr_destroy(&attr);
 #endif // _WIN32
 
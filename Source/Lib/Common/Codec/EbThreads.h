@@ -70,6 +70,63 @@ extern "C" {
     extern EbErrorType eb_destroy_mutex(
         EbHandle mutex_handle);
 
+#ifdef _WIN32
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+    /**************************************
+     * Atomics
+     *   Sequentially consistent operations on
+     *   32 bit words, returning the previous value
+     **************************************/
+#ifdef _WIN32
+    static INLINE int32_t eb_atomic_load(volatile int32_t *ptr) {
+        return (int32_t)InterlockedOr((volatile LONG *)ptr, 0);
+    }
+
+    static INLINE void eb_atomic_store(volatile int32_t *ptr, int32_t value) {
+        InterlockedExchange((volatile LONG *)ptr, value);
+    }
+
+    static INLINE int32_t eb_atomic_add(volatile int32_t *ptr, int32_t value) {
+        return (int32_t)InterlockedExchangeAdd((volatile LONG *)ptr, value);
+    }
+
+    static INLINE EbBool eb_atomic_cas(volatile int32_t *ptr, int32_t expected,
+        int32_t desired) {
+        return InterlockedCompareExchange((volatile LONG *)ptr, desired,
+            expected) == expected ? EB_TRUE : EB_FALSE;
+    }
+
+#define eb_cpu_pause() YieldProcessor()
+#else
+    static INLINE int32_t eb_atomic_load(volatile int32_t *ptr) {
+        return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+    }
+
+    static INLINE void eb_atomic_store(volatile int32_t *ptr, int32_t value) {
+        __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+    }
+
+    static INLINE int32_t eb_atomic_add(volatile int32_t *ptr, int32_t value) {
+        return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+    }
+
+    static INLINE EbBool eb_atomic_cas(volatile int32_t *ptr, int32_t expected,
+        int32_t desired) {
+        return __atomic_compare_exchange_n(ptr, &expected, desired, 0,
+            __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? EB_TRUE : EB_FALSE;
+    }
+
+#if defined(__i386__) || defined(__x86_64__)
+#define eb_cpu_pause() __builtin_ia32_pause()
+#else
+#define eb_cpu_pause() do { } while (0)
+#endif
+#endif
+
     extern    EbMemoryMapEntry *memory_map;                // library Memory table
     extern    uint32_t         *memory_map_index;          // library memory index
     extern    uint64_t         *total_lib_memory;          // library Memory malloc'd
@@ -119,8 +176,8 @@ extern    cpu_set_t                   group_affinity;
 #define EB_DESTROY_THREAD(pointer) \
     do { \
         if (pointer) { \
-            eb_destroy_thread(pointer); \
             EB_REMOVE_MEM_ENTRY(pointer, EB_THREAD); \
+            eb_destroy_thread(pointer); \
             pointer = NULL; \
         } \
     } while (0);
@@ -0,0 +1,236 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef __USE_POSIX199309
+#define __USE_POSIX199309
+#endif
+
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "EbTrace.h"
+#include "EbThreads.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define TRACE_TSC 1
+#else
+#define TRACE_TSC 0
+#endif
+
+volatile int32_t eb_trace_active_count = 0;
+
+static const char *const trace_stage_names[EB_TRACE_STAGE_COUNT] = {
+    "resource_coordination",
+    "picture_analysis",
+    "picture_decision",
+    "motion_estimation",
+    "initial_rate_control",
+    "source_based_operations",
+    "picture_manager",
+    "rate_control",
+    "mode_decision_configuration",
+    "enc_dec",
+    "dlf",
+    "cdef",
+    "rest",
+    "entropy_coding",
+    "packetization"
+};
+
+/**************************************
+ * Trace state of the calling kernel thread,
+ * pending is set from the tag of an input
+ * until the event is recorded
+ **************************************/
+typedef struct TraceThread
+{
+    EbTrace     *trace_ptr;
+    uint16_t     thread_index;
+    uint8_t      stage;
+    EbBool       pending;
+    uint64_t     picture_number;
+    uint64_t     wait_ticks;
+    uint64_t     start_ticks;
+    uint64_t     stall_ticks;
+    uint32_t     queue_depth;
+} TraceThread;
+
+static EB_THREAD_LOCAL TraceThread trace_thread;
+
+/**************************************
+ * Monotonic clock in microseconds, used to
+ * scale the timestamp counter
+ **************************************/
+static uint64_t trace_clock_us(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+#endif
+}
+
+static INLINE uint64_t trace_ticks(void)
+{
+#if TRACE_TSC
+    return __rdtsc();
+#else
+    return trace_clock_us();
+#endif
+}
+
+static void eb_trace_dctor(EbPtr p)
+{
+    EbTrace *obj = (EbTrace*)p;
+    eb_atomic_add(&eb_trace_active_count, -1);
+    EB_FREE_ARRAY(obj->record_array);
+    EB_FREE_ARRAY(obj->event_array);
+}
+
+EbErrorType eb_trace_ctor(
+    EbTrace  *trace_ptr,
+    uint32_t  max_event_count)
+{
+    trace_ptr->dctor = eb_trace_dctor;
+    trace_ptr->max_event_count = max_event_count;
+    EB_MALLOC_ARRAY(trace_ptr->record_array, max_event_count);
+    EB_MALLOC_ARRAY(trace_ptr->event_array, max_event_count);
+    trace_ptr->start_us = trace_clock_us();
+    trace_ptr->start_ticks = trace_ticks();
+    eb_atomic_add(&eb_trace_active_count, 1);
+
+    return EB_ErrorNone;
+}
+
+static void trace_record(TraceThread *thread_ptr, uint64_t end_ticks)
+{
+    EbTrace       *trace_ptr = thread_ptr->trace_ptr;
+    EbTraceRecord *record_ptr;
+    int32_t        index;
+
+    if ((uint32_t)eb_atomic_load(&trace_ptr->event_count) >= trace_ptr->max_event_count)
+        return;
+    index = eb_atomic_add(&trace_ptr->event_count, 1);
+    if ((uint32_t)index >= trace_ptr->max_event_count)
+        return;
+
+    record_ptr = &trace_ptr->record_array[index];
+    record_ptr->picture_number = thread_ptr->picture_number;
+    record_ptr->wait_ticks = thread_ptr->wait_ticks;
+    record_ptr->start_ticks = thread_ptr->start_ticks;
+    record_ptr->end_ticks = end_ticks;
+    record_ptr->stall_ticks = thread_ptr->stall_ticks;
+    record_ptr->queue_depth = thread_ptr->queue_depth;
+    record_ptr->thread_index = thread_ptr->thread_index;
+    record_ptr->stage = thread_ptr->stage;
+}
+
+void eb_trace_picture(
+    EbTrace      *trace_ptr,
+    EbTraceStage  stage,
+    uint64_t      picture_number)
+{
+    TraceThread *thread_ptr = &trace_thread;
+
+    if (thread_ptr->trace_ptr != trace_ptr) {
+        // First input of the thread, its wait is unknown
+        thread_ptr->trace_ptr = trace_ptr;
+        thread_ptr->thread_index = (uint16_t)eb_atomic_add(&trace_ptr->thread_count, 1);
+        thread_ptr->start_ticks = trace_ticks();
+        thread_ptr->wait_ticks = thread_ptr->start_ticks;
+        thread_ptr->stall_ticks = 0;
+        thread_ptr->queue_depth = 0;
+    }
+    thread_ptr->stage = (uint8_t)stage;
+    thread_ptr->picture_number = picture_number;
+    thread_ptr->pending = EB_TRUE;
+}
+
+void eb_trace_wait_begin(void)
+{
+    TraceThread *thread_ptr = &trace_thread;
+    uint64_t     now;
+
+    if (!thread_ptr->trace_ptr)
+        return;
+    now = trace_ticks();
+    if (thread_ptr->pending) {
+        trace_record(thread_ptr, now);
+        thread_ptr->pending = EB_FALSE;
+    }
+    thread_ptr->wait_ticks = now;
+}
+
+void eb_trace_wait_end(
+    uint32_t queue_depth)
+{
+    TraceThread *thread_ptr = &trace_thread;
+
+    if (!thread_ptr->trace_ptr)
+        return;
+    thread_ptr->start_ticks = trace_ticks();
+    thread_ptr->stall_ticks = 0;
+    thread_ptr->queue_depth = queue_depth;
+}
+
+uint64_t eb_trace_stall_begin(void)
+{
+    return trace_thread.pending ? trace_ticks() : 0;
+}
+
+void eb_trace_stall_end(
+    uint64_t stall_begin)
+{
+    if (stall_begin)
+        trace_thread.stall_ticks += trace_ticks() - stall_begin;
+}
+
+/**************************************
+ * eb_trace_get_events
+ *   Converts the records to microseconds from
+ *   the creation of the trace. Inputs still in
+ *   process are not reported.
+ **************************************/
+uint32_t eb_trace_get_events(
+    EbTrace             *trace_ptr,
+    const EbTraceEvent **events)
+{
+    uint32_t event_count = (uint32_t)eb_atomic_load(&trace_ptr->event_count);
+    uint64_t elapsed_us = trace_clock_us() - trace_ptr->start_us;
+    uint64_t elapsed_ticks = trace_ticks() - trace_ptr->start_ticks;
+    double   us_per_tick = elapsed_ticks ? (double)elapsed_us / elapsed_ticks : 1.0;
+
+    if (event_count > trace_ptr->max_event_count)
+        event_count = trace_ptr->max_event_count;
+
+    for (uint32_t i = 0; i < event_count; i++) {
+        const EbTraceRecord *record_ptr = &trace_ptr->record_array[i];
+        EbTraceEvent        *event_ptr = &trace_ptr->event_array[i];
+
+        event_ptr->stage = trace_stage_names[record_ptr->stage];
+        event_ptr->thread_index = record_ptr->thread_index;
+        event_ptr->picture_number = record_ptr->picture_number;
+        event_ptr->wait_start_us = (uint64_t)((record_ptr->wait_ticks - trace_ptr->start_ticks) * us_per_tick);
+        event_ptr->start_us = (uint64_t)((record_ptr->start_ticks - trace_ptr->start_ticks) * us_per_tick);
+        event_ptr->end_us = (uint64_t)((record_ptr->end_ticks - trace_ptr->start_ticks) * us_per_tick);
+        event_ptr->stall_us = (uint64_t)(record_ptr->stall_ticks * us_per_tick);
+        event_ptr->queue_depth = record_ptr->queue_depth;
+    }
+    *events = trace_ptr->event_array;
+
+    return event_count;
+}
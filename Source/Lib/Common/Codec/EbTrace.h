@@ -0,0 +1,117 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbTrace_h
+#define EbTrace_h
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * Pipeline stages, one per kernel
+     **************************************/
+    typedef enum EbTraceStage
+    {
+        EB_TRACE_RESOURCE_COORDINATION,
+        EB_TRACE_PICTURE_ANALYSIS,
+        EB_TRACE_PICTURE_DECISION,
+        EB_TRACE_MOTION_ESTIMATION,
+        EB_TRACE_INITIAL_RATE_CONTROL,
+        EB_TRACE_SOURCE_BASED_OPERATIONS,
+        EB_TRACE_PICTURE_MANAGER,
+        EB_TRACE_RATE_CONTROL,
+        EB_TRACE_MODE_DECISION_CONFIGURATION,
+        EB_TRACE_ENC_DEC,
+        EB_TRACE_DLF,
+        EB_TRACE_CDEF,
+        EB_TRACE_REST,
+        EB_TRACE_ENTROPY_CODING,
+        EB_TRACE_PACKETIZATION,
+        EB_TRACE_STAGE_COUNT
+    } EbTraceStage;
+
+    /**************************************
+     * Trace Record
+     *   One input processed by a kernel thread,
+     *   in timestamp ticks
+     **************************************/
+    typedef struct EbTraceRecord
+    {
+        uint64_t                 picture_number;
+        uint64_t                 wait_ticks;
+        uint64_t                 start_ticks;
+        uint64_t                 end_ticks;
+        uint64_t                 stall_ticks;
+        uint32_t                 queue_depth;
+        uint16_t                 thread_index;
+        uint8_t                  stage;
+    } EbTraceRecord;
+
+    /**************************************
+     * Trace
+     *   Pipeline events of an encoder instance.
+     *   The kernel threads append to record_array
+     *   until max_event_count, later events are
+     *   dropped. event_array holds the records
+     *   converted to microseconds on read.
+     **************************************/
+    typedef struct EbTrace
+    {
+        EbDctor                  dctor;
+        EbTraceRecord           *record_array;
+        EbTraceEvent            *event_array;
+        uint32_t                 max_event_count;
+        volatile int32_t         event_count;
+        volatile int32_t         thread_count;
+        uint64_t                 start_ticks;
+        uint64_t                 start_us;
+    } EbTrace;
+
+    // Number of live traces, the fifos skip the timestamps when it is 0
+    extern volatile int32_t eb_trace_active_count;
+
+#define EB_TRACE_ACTIVE() (eb_trace_active_count != 0)
+
+// Tags the input a kernel thread just took with its stage and picture. The
+// event is recorded once the thread goes back to its input fifo.
+#define EB_TRACE_PICTURE(trace_ptr, stage, picture_number) \
+    do { \
+        if (trace_ptr) \
+            eb_trace_picture(trace_ptr, stage, picture_number); \
+    } while (0)
+
+    extern EbErrorType eb_trace_ctor(
+        EbTrace  *trace_ptr,
+        uint32_t  max_event_count);
+
+    extern void eb_trace_picture(
+        EbTrace      *trace_ptr,
+        EbTraceStage  stage,
+        uint64_t      picture_number);
+
+    /**************************************
+     * Fifo hooks, called by the calling thread
+     * around a blocking get of a full object
+     * (wait) or of an empty object (stall)
+     **************************************/
+    extern void eb_trace_wait_begin(void);
+    extern void eb_trace_wait_end(
+        uint32_t queue_depth);
+    extern uint64_t eb_trace_stall_begin(void);
+    extern void eb_trace_stall_end(
+        uint64_t stall_begin);
+
+    extern uint32_t eb_trace_get_events(
+        EbTrace             *trace_ptr,
+        const EbTraceEvent **events);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTrace_h
@@ -570,7 +570,8 @@ uint32_t  max_num_active_blocks;
 //     square blk1 in raster scan (followed by all its ns blcoks), etc
 //mds: top-down and Z scan.
 BlockGeom blk_geom_dps[MAX_NUM_BLOCKS_ALLOC];  //to access geom info of a particular block : use this table if you have the block index in depth scan
-BlockGeom blk_geom_mds[MAX_NUM_BLOCKS_ALLOC];  //to access geom info of a particular block : use this table if you have the block index in md    scan
+BlockGeom blk_geom_mds_sb[2][MAX_NUM_BLOCKS_ALLOC];  //md scan table of the 64x64 [0] and of the 128x128 [1] super blocks
+BlockGeom *blk_geom_mds;  //the md scan table being built by build_blk_geom
 
 uint32_t search_matching_from_dps(
     uint32_t depth,
@@ -1277,6 +1278,7 @@ void build_blk_geom(int32_t use_128x128)
 {
     max_sb = use_128x128 ? 128 : 64;
     max_depth = use_128x128 ? 6 : 5;
+    blk_geom_mds = blk_geom_mds_sb[use_128x128 ? 1 : 0];
     uint32_t  max_block_count = use_128x128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
 
     //(0)compute total number of blocks using the information provided
@@ -1302,9 +1304,9 @@ const BlockGeom * Get_blk_geom_dps(uint32_t bidx_dps)
 {
     return &blk_geom_dps[bidx_dps];
 }
-const BlockGeom * get_blk_geom_mds(uint32_t bidx_mds)
+const BlockGeom * get_blk_geom_mds(uint32_t bidx_mds, uint32_t use_128x128)
 {
-    return &blk_geom_mds[bidx_mds];
+    return &blk_geom_mds_sb[use_128x128 ? 1 : 0][bidx_mds];
 }
 
 uint32_t get_mds_idx(uint32_t orgx, uint32_t orgy, uint32_t size, uint32_t use_128x128)
@@ -1313,7 +1315,7 @@ uint32_t get_mds_idx(uint32_t orgx, uint32_t orgy, uint32_t size, uint32_t use_1
     uint32_t mds = 0;
 
     for (uint32_t blk_it = 0; blk_it < max_block_count; blk_it++){
-        BlockGeom * cur_geom = &blk_geom_mds[blk_it];
+        BlockGeom * cur_geom = &blk_geom_mds_sb[use_128x128 ? 1 : 0][blk_it];
 
         if ((uint32_t)cur_geom->sq_size == size && cur_geom->origin_x == orgx &&
             cur_geom->origin_y == orgy && cur_geom->shape == PART_N) {
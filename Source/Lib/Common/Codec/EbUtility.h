@@ -112,7 +112,8 @@ extern "C" {
         /*128x128*/{ 17 , 25,25,25, 5 ,1 }
     };
 
-    const BlockGeom * get_blk_geom_mds(uint32_t bidx_mds);
+    // The geometry of both super block sizes is built, use_128x128 selects the table
+    const BlockGeom * get_blk_geom_mds(uint32_t bidx_mds, uint32_t use_128x128);
 
     // CU Stats Helper Functions
     typedef struct CodedUnitStats
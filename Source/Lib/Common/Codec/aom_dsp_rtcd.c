@@ -0,0 +1,75 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define RTCD_C
+#include "aom_dsp_rtcd.h"
+
+void asmSetConvolveAsmTable(void);
+void asmSetConvolveHbdAsmTable(void);
+void init_intra_dc_predictors_c_internal(void);
+void init_intra_predictors_internal(void);
+void av1_init_wedge_masks(void);
+
+/**********************************
+* Process Wide Tables
+*   The RTCD function pointers and the tables built
+*   from them are shared by the encoder and the decoder
+*   handles of the process. The first handle to start
+*   builds them for its asm_type, they are never
+*   rewritten afterwards.
+**********************************/
+static EbAsm rtcd_tables_asm_type = ASM_TYPE_INVALID;
+
+static void build_rtcd_tables(EbAsm asm_type)
+{
+    setup_rtcd_internal(asm_type);
+    asmSetConvolveAsmTable();
+
+    init_intra_dc_predictors_c_internal();
+
+    asmSetConvolveHbdAsmTable();
+
+    init_intra_predictors_internal();
+
+    av1_init_wedge_masks();
+    rtcd_tables_asm_type = asm_type;
+}
+
+#ifdef _WIN32
+static INIT_ONCE rtcd_tables_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK build_rtcd_tables_once(
+    PINIT_ONCE InitOnce,
+    PVOID Parameter,
+    PVOID *lpContext)
+{
+    (void)InitOnce;
+    (void)lpContext;
+    build_rtcd_tables(*(const EbAsm *)Parameter);
+    return TRUE;
+}
+#else
+static pthread_mutex_t rtcd_tables_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+EbAsm init_rtcd_tables(EbAsm asm_type)
+{
+#ifdef _WIN32
+    InitOnceExecuteOnce(&rtcd_tables_once, build_rtcd_tables_once, &asm_type, NULL);
+#else
+    // pthread_once takes no argument, the first asm_type is kept under a static mutex
+    pthread_mutex_lock(&rtcd_tables_mutex);
+    if (rtcd_tables_asm_type == ASM_TYPE_INVALID)
+        build_rtcd_tables(asm_type);
+    pthread_mutex_unlock(&rtcd_tables_mutex);
+#endif
+    return rtcd_tables_asm_type;
+}
@@ -164,6 +164,37 @@ extern "C" {
     //to not include convolve.h, just forward declare what's needed.
     struct ConvolveParams;
     struct InterpFilterParams;
+    struct FilmGrainCtxt;
+    struct aom_film_grain;
+    struct aom_flat_block_finder;
+
+    void eb_av1_add_noise_to_block_c(const struct FilmGrainCtxt *ctxt, const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    void eb_av1_add_noise_to_block_sse4_1(const struct FilmGrainCtxt *ctxt, const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    void eb_av1_add_noise_to_block_avx2(const struct FilmGrainCtxt *ctxt, const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    RTCD_EXTERN void(*eb_av1_add_noise_to_block)(const struct FilmGrainCtxt *ctxt, const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+
+    void eb_av1_add_noise_to_block_hbd_c(const struct FilmGrainCtxt *ctxt, const uint16_t *src_luma, const uint16_t *src_cb, const uint16_t *src_cr, uint16_t *luma, uint16_t *cb, uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    void eb_av1_add_noise_to_block_hbd_sse4_1(const struct FilmGrainCtxt *ctxt, const uint16_t *src_luma, const uint16_t *src_cb, const uint16_t *src_cr, uint16_t *luma, uint16_t *cb, uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    void eb_av1_add_noise_to_block_hbd_avx2(const struct FilmGrainCtxt *ctxt, const uint16_t *src_luma, const uint16_t *src_cb, const uint16_t *src_cr, uint16_t *luma, uint16_t *cb, uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+    RTCD_EXTERN void(*eb_av1_add_noise_to_block_hbd)(const struct FilmGrainCtxt *ctxt, const uint16_t *src_luma, const uint16_t *src_cb, const uint16_t *src_cr, uint16_t *luma, uint16_t *cb, uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width);
+
+    void eb_av1_luma_grain_ar_filter_c(const struct aom_film_grain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block, int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t grain_min, int32_t grain_max);
+    void eb_av1_luma_grain_ar_filter_sse4_1(const struct aom_film_grain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block, int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t grain_min, int32_t grain_max);
+    void eb_av1_luma_grain_ar_filter_avx2(const struct aom_film_grain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block, int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t grain_min, int32_t grain_max);
+    RTCD_EXTERN void(*eb_av1_luma_grain_ar_filter)(const struct aom_film_grain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block, int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t grain_min, int32_t grain_max);
+
+    void eb_av1_chroma_grain_ar_filter_c(const struct aom_film_grain *params, int32_t **pred_pos_chroma, const int32_t *luma_grain_block, int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y, int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max);
+    void eb_av1_chroma_grain_ar_filter_sse4_1(const struct aom_film_grain *params, int32_t **pred_pos_chroma, const int32_t *luma_grain_block, int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y, int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max);
+    void eb_av1_chroma_grain_ar_filter_avx2(const struct aom_film_grain *params, int32_t **pred_pos_chroma, const int32_t *luma_grain_block, int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y, int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max);
+    RTCD_EXTERN void(*eb_av1_chroma_grain_ar_filter)(const struct aom_film_grain *params, int32_t **pred_pos_chroma, const int32_t *luma_grain_block, int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y, int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max);
+
+    void eb_aom_flat_block_finder_extract_block_c(const struct aom_flat_block_finder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    void eb_aom_flat_block_finder_extract_block_avx2(const struct aom_flat_block_finder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    RTCD_EXTERN void(*eb_aom_flat_block_finder_extract_block)(const struct aom_flat_block_finder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+
+    void eb_aom_noise_model_add_observation_c(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
+    void eb_aom_noise_model_add_observation_avx2(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
+    RTCD_EXTERN void(*eb_aom_noise_model_add_observation)(double *A, double *b, const double *buffer, double val, int32_t n, double normalization);
 
     void eb_apply_selfguided_restoration_c(const uint8_t *dat, int32_t width, int32_t height, int32_t stride, int32_t eps, const int32_t *xqd, uint8_t *dst, int32_t dst_stride, int32_t *tmpbuf, int32_t bit_depth, int32_t highbd);
     void eb_apply_selfguided_restoration_avx2(const uint8_t *dat, int32_t width, int32_t height, int32_t stride, int32_t eps, const int32_t *xqd, uint8_t *dst, int32_t dst_stride, int32_t *tmpbuf, int32_t bit_depth, int32_t highbd);
@@ -2659,6 +2690,10 @@ extern "C" {
 
     void eb_aom_dsp_rtcd(void);
 
+    // Builds the RTCD function pointers and their tables once for the process,
+    // returns the asm_type of the first caller they were built for
+    EbAsm init_rtcd_tables(EbAsm asm_type);
+
 #ifdef RTCD_C
 
     static void setup_rtcd_internal(EbAsm asm_type)
@@ -2672,6 +2707,23 @@ extern "C" {
 
         //to use C: flags=0
 
+        eb_av1_add_noise_to_block = eb_av1_add_noise_to_block_c;
+        if (flags & HAS_SSE4_1) eb_av1_add_noise_to_block = eb_av1_add_noise_to_block_sse4_1;
+        if (flags & HAS_AVX2) eb_av1_add_noise_to_block = eb_av1_add_noise_to_block_avx2;
+        eb_av1_add_noise_to_block_hbd = eb_av1_add_noise_to_block_hbd_c;
+        if (flags & HAS_SSE4_1) eb_av1_add_noise_to_block_hbd = eb_av1_add_noise_to_block_hbd_sse4_1;
+        if (flags & HAS_AVX2) eb_av1_add_noise_to_block_hbd = eb_av1_add_noise_to_block_hbd_avx2;
+        eb_av1_luma_grain_ar_filter = eb_av1_luma_grain_ar_filter_c;
+        if (flags & HAS_SSE4_1) eb_av1_luma_grain_ar_filter = eb_av1_luma_grain_ar_filter_sse4_1;
+        if (flags & HAS_AVX2) eb_av1_luma_grain_ar_filter = eb_av1_luma_grain_ar_filter_avx2;
+        eb_av1_chroma_grain_ar_filter = eb_av1_chroma_grain_ar_filter_c;
+        if (flags & HAS_SSE4_1) eb_av1_chroma_grain_ar_filter = eb_av1_chroma_grain_ar_filter_sse4_1;
+        if (flags & HAS_AVX2) eb_av1_chroma_grain_ar_filter = eb_av1_chroma_grain_ar_filter_avx2;
+        eb_aom_flat_block_finder_extract_block = eb_aom_flat_block_finder_extract_block_c;
+        if (flags & HAS_AVX2) eb_aom_flat_block_finder_extract_block = eb_aom_flat_block_finder_extract_block_avx2;
+        eb_aom_noise_model_add_observation = eb_aom_noise_model_add_observation_c;
+        if (flags & HAS_AVX2) eb_aom_noise_model_add_observation = eb_aom_noise_model_add_observation_avx2;
+
         eb_apply_selfguided_restoration = eb_apply_selfguided_restoration_c;
         if (flags & HAS_AVX2) eb_apply_selfguided_restoration = eb_apply_selfguided_restoration_avx2;
 
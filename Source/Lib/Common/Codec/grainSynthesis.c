@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "grainSynthesis.h"
+#include "aom_dsp_rtcd.h"
 
   // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
   // with zero mean and standard deviation of about 512.
@@ -215,27 +216,19 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
-
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
-
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
 
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
-
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
-
-static uint16_t random_register = 0;  // random number generator register
+// Padding of the grain templates, to offset for AR coefficients
+#define FGN_LEFT_PAD 3
+#define FGN_RIGHT_PAD 3
+#define FGN_TOP_PAD 3
+#define FGN_BOTTOM_PAD 0
+// maximum lag used for stabilization of AR coefficients
+#define FGN_AR_PADDING 3
 
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
@@ -300,18 +293,10 @@ void eb_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(aom_film_grain_t *params, int32_t luma_stride,
-    int32_t chroma_stride, int32_t ***pred_pos_luma_p,
+static void init_arrays(aom_film_grain_t *params, int32_t ***pred_pos_luma_p,
     int32_t ***pred_pos_chroma_p, int32_t **luma_grain_block,
     int32_t **cb_grain_block, int32_t **cr_grain_block,
-    int32_t **y_line_buf, int32_t **cb_line_buf, int32_t **cr_line_buf,
-    int32_t **y_col_buf, int32_t **cb_col_buf, int32_t **cr_col_buf,
-    int32_t luma_grain_samples, int32_t chroma_grain_samples,
-    int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
-
+    int32_t luma_grain_samples, int32_t chroma_grain_samples) {
     int32_t num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0) ++num_pos_chroma;
@@ -371,23 +356,6 @@ static void init_arrays(aom_film_grain_t *params, int32_t luma_stride,
     *pred_pos_luma_p = pred_pos_luma;
     *pred_pos_chroma_p = pred_pos_chroma;
 
-    *y_line_buf = (int32_t *)malloc(sizeof(**y_line_buf) * luma_stride * 2);
-    *cb_line_buf = (int32_t *)malloc(sizeof(**cb_line_buf) * chroma_stride *
-        (2 >> chroma_subsamp_y));
-    *cr_line_buf = (int32_t *)malloc(sizeof(**cr_line_buf) * chroma_stride *
-        (2 >> chroma_subsamp_y));
-
-    *y_col_buf =
-        (int32_t *)malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-    *cb_col_buf =
-        (int32_t *)malloc(sizeof(**cb_col_buf) *
-        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-            (2 >> chroma_subsamp_x));
-    *cr_col_buf =
-        (int32_t *)malloc(sizeof(**cr_col_buf) *
-        (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-            (2 >> chroma_subsamp_x));
-
     *luma_grain_block =
         (int32_t *)malloc(sizeof(**luma_grain_block) * luma_grain_samples);
     *cb_grain_block =
@@ -397,13 +365,10 @@ static void init_arrays(aom_film_grain_t *params, int32_t luma_stride,
 }
 
 static void dealloc_arrays(aom_film_grain_t *params, int32_t ***pred_pos_luma,
-    int32_t ***pred_pos_chroma, int32_t **luma_grain_block,
-    int32_t **cb_grain_block, int32_t **cr_grain_block,
-    int32_t **y_line_buf, int32_t **cb_line_buf,
-    int32_t **cr_line_buf, int32_t **y_col_buf, int32_t **cb_col_buf,
-    int32_t **cr_col_buf) {
+    int32_t ***pred_pos_chroma) {
     int32_t num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    int32_t num_pos_chroma = num_pos_luma + 1;
+    int32_t num_pos_chroma = num_pos_luma;
+    if (params->num_y_points > 0) ++num_pos_chroma;
 
     for (int32_t row = 0; row < num_pos_luma; row++)
         free((*pred_pos_luma)[row]);
@@ -412,70 +377,69 @@ static void dealloc_arrays(aom_film_grain_t *params, int32_t ***pred_pos_luma,
     for (int32_t row = 0; row < num_pos_chroma; row++)
         free((*pred_pos_chroma)[row]);
     free((*pred_pos_chroma));
-
-    free(*y_line_buf);
-
-    free(*cb_line_buf);
-
-    free(*cr_line_buf);
-
-    free(*y_col_buf);
-
-    free(*cb_col_buf);
-
-    free(*cr_col_buf);
-
-    free(*luma_grain_block);
-
-    free(*cb_grain_block);
-
-    free(*cr_grain_block);
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(uint16_t *random_register, int32_t bits) {
     uint16_t bit;
-    bit = ((random_register >> 0) ^ (random_register >> 1) ^
-        (random_register >> 3) ^ (random_register >> 12)) &
+    bit = ((*random_register >> 0) ^ (*random_register >> 1) ^
+        (*random_register >> 3) ^ (*random_register >> 12)) &
         1;
-    random_register = (random_register >> 1) | (bit << 15);
-    return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+    *random_register = (*random_register >> 1) | (bit << 15);
+    return (*random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+// returns the random number generator register for a luma line
+static uint16_t init_random_generator(int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    uint16_t random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
     random_register ^= ((luma_num * 37 + 178) & 255) << 8;
     random_register ^= ((luma_num * 173 + 105) & 255);
+    return random_register;
 }
 
 static void generate_luma_grain_block(
     aom_film_grain_t *params, int32_t **pred_pos_luma, int32_t *luma_grain_block,
     int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride,
-    int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad) {
+    int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad,
+    int32_t grain_min, int32_t grain_max) {
     if (params->num_y_points == 0) return;
 
+    uint16_t random_register = params->random_seed;
+
     int32_t bit_depth = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
-    int32_t num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
-
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
             luma_grain_block[i * luma_grain_stride + j] =
-            (gaussian_sequence[get_random_number(gauss_bits)] +
+            (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
             ((1 << gauss_sec_shift) >> 1)) >>
             gauss_sec_shift;
 
+    eb_av1_luma_grain_ar_filter(params, pred_pos_luma, luma_grain_block,
+        luma_block_size_y, luma_block_size_x, luma_grain_stride, left_pad,
+        top_pad, right_pad, bottom_pad, grain_min, grain_max);
+}
+
+// auto-regressive filtering of the luma grain template, in raster order
+void eb_av1_luma_grain_ar_filter_c(const aom_film_grain_t *params,
+    int32_t **pred_pos_luma, int32_t *luma_grain_block,
+    int32_t luma_block_size_y, int32_t luma_block_size_x,
+    int32_t luma_grain_stride, int32_t left_pad, int32_t top_pad,
+    int32_t right_pad, int32_t bottom_pad, int32_t grain_min,
+    int32_t grain_max) {
+    int32_t num_pos_luma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
+    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
+
     for (int32_t i = top_pad; i < luma_block_size_y - bottom_pad; i++)
         for (int32_t j = left_pad; j < luma_block_size_x - right_pad; j++) {
             int32_t wsum = 0;
@@ -498,35 +462,51 @@ static void generate_chroma_grain_blocks(
     int32_t **pred_pos_chroma, int32_t *luma_grain_block, int32_t *cb_grain_block,
     int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y,
     int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
-    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+    int32_t grain_min, int32_t grain_max) {
     int32_t bit_depth = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
-    int32_t num_pos_chroma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    if (params->num_y_points > 0) ++num_pos_chroma;
-    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
-
     if (params->num_cb_points) {
-        init_random_generator(7 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cb_grain_block[i * chroma_grain_stride + j] =
-                (gaussian_sequence[get_random_number(gauss_bits)] +
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                 ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
     }
     if (params->num_cr_points) {
-        init_random_generator(11 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cr_grain_block[i * chroma_grain_stride + j] =
-                (gaussian_sequence[get_random_number(gauss_bits)] +
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                 ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
     }
 
+    eb_av1_chroma_grain_ar_filter(params, pred_pos_chroma, luma_grain_block,
+        cb_grain_block, cr_grain_block, luma_grain_stride, chroma_block_size_y,
+        chroma_block_size_x, chroma_grain_stride, left_pad, top_pad, right_pad,
+        bottom_pad, chroma_subsamp_y, chroma_subsamp_x, grain_min, grain_max);
+}
+
+// auto-regressive filtering of the chroma grain templates, in raster order.
+// The last position predicts from the co-located luma grain
+void eb_av1_chroma_grain_ar_filter_c(const aom_film_grain_t *params,
+    int32_t **pred_pos_chroma, const int32_t *luma_grain_block,
+    int32_t *cb_grain_block, int32_t *cr_grain_block, int32_t luma_grain_stride,
+    int32_t chroma_block_size_y, int32_t chroma_block_size_x,
+    int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
+    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max) {
+    int32_t num_pos_chroma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
+    if (params->num_y_points > 0) ++num_pos_chroma;
+    int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
+
     for (int32_t i = top_pad; i < chroma_block_size_y - bottom_pad; i++)
         for (int32_t j = left_pad; j < chroma_block_size_x - right_pad; j++) {
             int32_t wsum_cb = 0;
@@ -605,7 +585,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a LUT (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_LUT(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static int32_t scale_LUT(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -617,217 +597,168 @@ static int32_t scale_LUT(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
             (bit_depth - 8));
 }
 
-static void add_noise_to_block(aom_film_grain_t *params, uint8_t *luma,
-    uint8_t *cb, uint8_t *cr, int32_t luma_stride,
-    int32_t chroma_stride, int32_t *luma_grain,
-    int32_t *cb_grain, int32_t *cr_grain,
-    int32_t luma_grain_stride, int32_t chroma_grain_stride,
-    int32_t half_luma_height, int32_t half_luma_width,
-    int32_t bit_depth, int32_t chroma_subsamp_y,
-    int32_t chroma_subsamp_x) {
-    int32_t cb_mult = params->cb_mult - 128;            // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
-    int32_t cb_offset = params->cb_offset - 256;
-
-    int32_t cr_mult = params->cr_mult - 128;            // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128;  // fixed scale
-    int32_t cr_offset = params->cr_offset - 256;
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
-    int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
-
-    if (params->chroma_scaling_from_luma) {
-        cb_mult = 0;        // fixed scale
-        cb_luma_mult = 64;  // fixed scale
-        cb_offset = 0;
-
-        cr_mult = 0;        // fixed scale
-        cr_luma_mult = 64;  // fixed scale
-        cr_offset = 0;
-    }
-
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
-    if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range;
-        max_luma = max_luma_legal_range;
-
-        min_chroma = min_chroma_legal_range;
-        max_chroma = max_chroma_legal_range;
-    }
-    else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = 255;
-    }
-
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x)] +
-                    luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x) + 1] +
-                    1) >>
-                    1;
-            }
-            else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cb,
-                        clamp(((average_luma * cb_luma_mult +
-                            cb_mult * cb[i * chroma_stride + j]) >>
-                            6) +
-                            cb_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        8) *
-                        cb_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
+// Adds the noise to a block of src and writes it to dst. The chroma noise
+// depends on the luma of src, which may be dst as well
+void eb_av1_add_noise_to_block_c(const FilmGrainCtxt *ctxt,
+    const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr,
+    uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t *luma_grain,
+    int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+    int32_t chroma_grain_stride, int32_t half_luma_height,
+    int32_t half_luma_width) {
+    const aom_film_grain_t *params = ctxt->params;
+    int32_t src_luma_stride = ctxt->src_luma_stride;
+    int32_t src_chroma_stride = ctxt->src_chroma_stride;
+    int32_t luma_stride = ctxt->luma_stride;
+    int32_t chroma_stride = ctxt->chroma_stride;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t bit_depth = params->bit_depth;
+    int32_t rounding_offset = ctxt->rounding_offset;
+
+    if (ctxt->apply_cb || ctxt->apply_cr) {
+        for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
+            for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
+                int32_t average_luma = 0;
+                if (chroma_subsamp_x) {
+                    average_luma = (src_luma[(i << chroma_subsamp_y) * src_luma_stride +
+                        (j << chroma_subsamp_x)] +
+                        src_luma[(i << chroma_subsamp_y) * src_luma_stride +
+                        (j << chroma_subsamp_x) + 1] +
+                        1) >>
+                        1;
+                }
+                else
+                    average_luma = src_luma[(i << chroma_subsamp_y) * src_luma_stride + j];
+                if (ctxt->apply_cb) {
+                    int32_t orig = src_cb[i * src_chroma_stride + j];
+                    cb[i * chroma_stride + j] = clamp(
+                        orig +
+                        ((scale_LUT(ctxt->scaling_lut_cb,
+                            clamp(((average_luma * ctxt->cb_luma_mult +
+                                ctxt->cb_mult * orig) >>
+                                6) +
+                                ctxt->cb_offset,
+                                0, (256 << (bit_depth - 8)) - 1),
+                            8) *
+                            cb_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                            ctxt->scaling_shift),
+                        ctxt->min_chroma, ctxt->max_chroma);
+                }
 
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cr,
-                        clamp(((average_luma * cr_luma_mult +
-                            cr_mult * cr[i * chroma_stride + j]) >>
-                            6) +
-                            cr_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        8) *
-                        cr_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
+                if (ctxt->apply_cr) {
+                    int32_t orig = src_cr[i * src_chroma_stride + j];
+                    cr[i * chroma_stride + j] = clamp(
+                        orig +
+                        ((scale_LUT(ctxt->scaling_lut_cr,
+                            clamp(((average_luma * ctxt->cr_luma_mult +
+                                ctxt->cr_mult * orig) >>
+                                6) +
+                                ctxt->cr_offset,
+                                0, (256 << (bit_depth - 8)) - 1),
+                            8) *
+                            cr_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                            ctxt->scaling_shift),
+                        ctxt->min_chroma, ctxt->max_chroma);
+                }
             }
         }
     }
 
-    if (apply_y) {
+    if (ctxt->apply_y) {
         for (int32_t i = 0; i < (half_luma_height << 1); i++) {
             for (int32_t j = 0; j < (half_luma_width << 1); j++) {
+                int32_t orig = src_luma[i * src_luma_stride + j];
                 luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                    ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j], 8) *
+                    clamp(orig +
+                    ((scale_LUT(ctxt->scaling_lut_y, orig, 8) *
                         luma_grain[i * luma_grain_stride + j] +
                         rounding_offset) >>
-                        params->scaling_shift),
-                        min_luma, max_luma);
+                        ctxt->scaling_shift),
+                        ctxt->min_luma, ctxt->max_luma);
             }
         }
     }
 }
 
-static void add_noise_to_block_hbd(
-    aom_film_grain_t *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-    int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain,
-    int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride,
-    int32_t half_luma_height, int32_t half_luma_width, int32_t bit_depth,
-    int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t cb_mult = params->cb_mult - 128;            // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
-    // offset value depends on the bit depth
-    int32_t cb_offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t cr_mult = params->cr_mult - 128;            // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128;  // fixed scale
-    // offset value depends on the bit depth
-    int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
-    int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
-
-    if (params->chroma_scaling_from_luma) {
-        cb_mult = 0;        // fixed scale
-        cb_luma_mult = 64;  // fixed scale
-        cb_offset = 0;
-
-        cr_mult = 0;        // fixed scale
-        cr_luma_mult = 64;  // fixed scale
-        cr_offset = 0;
-    }
-
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
-    if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range << (bit_depth - 8);
-        max_luma = max_luma_legal_range << (bit_depth - 8);
-
-        min_chroma = min_chroma_legal_range << (bit_depth - 8);
-        max_chroma = max_chroma_legal_range << (bit_depth - 8);
-    }
-    else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
-    }
-
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x)] +
-                    luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x) + 1] +
-                    1) >>
-                    1;
-            }
-            else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cb,
-                        clamp(((average_luma * cb_luma_mult +
-                            cb_mult * cb[i * chroma_stride + j]) >>
-                            6) +
-                            cb_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        bit_depth) *
-                        cb_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cr,
-                        clamp(((average_luma * cr_luma_mult +
-                            cr_mult * cr[i * chroma_stride + j]) >>
-                            6) +
-                            cr_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        bit_depth) *
-                        cr_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
+void eb_av1_add_noise_to_block_hbd_c(const FilmGrainCtxt *ctxt,
+    const uint16_t *src_luma, const uint16_t *src_cb, const uint16_t *src_cr,
+    uint16_t *luma, uint16_t *cb, uint16_t *cr, int32_t *luma_grain,
+    int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+    int32_t chroma_grain_stride, int32_t half_luma_height,
+    int32_t half_luma_width) {
+    const aom_film_grain_t *params = ctxt->params;
+    int32_t src_luma_stride = ctxt->src_luma_stride;
+    int32_t src_chroma_stride = ctxt->src_chroma_stride;
+    int32_t luma_stride = ctxt->luma_stride;
+    int32_t chroma_stride = ctxt->chroma_stride;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t bit_depth = params->bit_depth;
+    int32_t rounding_offset = ctxt->rounding_offset;
+
+    if (ctxt->apply_cb || ctxt->apply_cr) {
+        for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
+            for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
+                int32_t average_luma = 0;
+                if (chroma_subsamp_x) {
+                    average_luma = (src_luma[(i << chroma_subsamp_y) * src_luma_stride +
+                        (j << chroma_subsamp_x)] +
+                        src_luma[(i << chroma_subsamp_y) * src_luma_stride +
+                        (j << chroma_subsamp_x) + 1] +
+                        1) >>
+                        1;
+                }
+                else
+                    average_luma = src_luma[(i << chroma_subsamp_y) * src_luma_stride + j];
+                if (ctxt->apply_cb) {
+                    int32_t orig = src_cb[i * src_chroma_stride + j];
+                    cb[i * chroma_stride + j] = clamp(
+                        orig +
+                        ((scale_LUT(ctxt->scaling_lut_cb,
+                            clamp(((average_luma * ctxt->cb_luma_mult +
+                                ctxt->cb_mult * orig) >>
+                                6) +
+                                ctxt->cb_offset,
+                                0, (256 << (bit_depth - 8)) - 1),
+                            bit_depth) *
+                            cb_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                            ctxt->scaling_shift),
+                        ctxt->min_chroma, ctxt->max_chroma);
+                }
+                if (ctxt->apply_cr) {
+                    int32_t orig = src_cr[i * src_chroma_stride + j];
+                    cr[i * chroma_stride + j] = clamp(
+                        orig +
+                        ((scale_LUT(ctxt->scaling_lut_cr,
+                            clamp(((average_luma * ctxt->cr_luma_mult +
+                                ctxt->cr_mult * orig) >>
+                                6) +
+                                ctxt->cr_offset,
+                                0, (256 << (bit_depth - 8)) - 1),
+                            bit_depth) *
+                            cr_grain[i * chroma_grain_stride + j] +
+                            rounding_offset) >>
+                            ctxt->scaling_shift),
+                        ctxt->min_chroma, ctxt->max_chroma);
+                }
             }
         }
     }
 
-    if (apply_y) {
+    if (ctxt->apply_y) {
         for (int32_t i = 0; i < (half_luma_height << 1); i++) {
             for (int32_t j = 0; j < (half_luma_width << 1); j++) {
+                int32_t orig = src_luma[i * src_luma_stride + j];
                 luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                    ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j],
-                        bit_depth) *
+                    clamp(orig +
+                    ((scale_LUT(ctxt->scaling_lut_y, orig, bit_depth) *
                         luma_grain[i * luma_grain_stride + j] +
                         rounding_offset) >>
-                        params->scaling_shift),
-                        min_luma, max_luma);
+                        ctxt->scaling_shift),
+                        ctxt->min_luma, ctxt->max_luma);
             }
         }
     }
@@ -921,7 +852,7 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
 static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride,
     int32_t *right_block, int32_t right_stride,
     int32_t *dst_block, int32_t dst_stride, int32_t width,
-    int32_t height) {
+    int32_t height, int32_t grain_min, int32_t grain_max) {
     if (width == 1) {
         while (height) {
             *dst_block = clamp((*left_block * 23 + *right_block * 22 + 16) >> 5,
@@ -951,7 +882,7 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride,
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride,
     int32_t *bottom_block, int32_t bottom_stride,
     int32_t *dst_block, int32_t dst_stride, int32_t width,
-    int32_t height) {
+    int32_t height, int32_t grain_min, int32_t grain_max) {
     if (height == 1) {
         while (width) {
             *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5,
@@ -980,393 +911,609 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride,
     }
 }
 
-void eb_av1_add_film_grain_run(aom_film_grain_t *params, uint8_t *luma,
-    uint8_t *cb, uint8_t *cr, int32_t height, int32_t width,
-    int32_t luma_stride, int32_t chroma_stride,
-    int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
-    int32_t chroma_subsamp_x) {
+void eb_av1_film_grain_init(FilmGrainCtxt *ctxt, aom_film_grain_t *params,
+    const uint8_t *src_luma, const uint8_t *src_cb, const uint8_t *src_cr,
+    int32_t src_luma_stride, int32_t src_chroma_stride, uint8_t *luma,
+    uint8_t *cb, uint8_t *cr, int32_t luma_stride, int32_t chroma_stride,
+    int32_t height, int32_t width, int32_t use_high_bit_depth,
+    int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
     int32_t **pred_pos_luma;
     int32_t **pred_pos_chroma;
-    int32_t *luma_grain_block;
-    int32_t *cb_grain_block;
-    int32_t *cr_grain_block;
-
-    int32_t *y_line_buf;
-    int32_t *cb_line_buf;
-    int32_t *cr_line_buf;
-
-    int32_t *y_col_buf;
-    int32_t *cb_col_buf;
-    int32_t *cr_col_buf;
-
-    random_register = params->random_seed;
-
-    int32_t left_pad = 3;
-    int32_t right_pad = 3;  // padding to offset for AR coefficients
-    int32_t top_pad = 3;
-    int32_t bottom_pad = 0;
-
-    int32_t ar_padding = 3;  // maximum lag used for stabilization of AR coefficients
 
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
-
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+    ctxt->params = params;
+    ctxt->src_luma = src_luma;
+    ctxt->src_cb = src_cb;
+    ctxt->src_cr = src_cr;
+    ctxt->src_luma_stride = src_luma_stride;
+    ctxt->src_chroma_stride = src_chroma_stride;
+    ctxt->luma = luma;
+    ctxt->cb = cb;
+    ctxt->cr = cr;
+    ctxt->luma_stride = luma_stride;
+    ctxt->chroma_stride = chroma_stride;
+    ctxt->height = height;
+    ctxt->width = width;
+    ctxt->use_high_bit_depth = use_high_bit_depth;
+    ctxt->chroma_subsamp_y = chroma_subsamp_y;
+    ctxt->chroma_subsamp_x = chroma_subsamp_x;
+
+    ctxt->luma_subblock_size_y = 32;
+    ctxt->luma_subblock_size_x = 32;
+
+    ctxt->chroma_subblock_size_y = ctxt->luma_subblock_size_y >> chroma_subsamp_y;
+    ctxt->chroma_subblock_size_x = ctxt->luma_subblock_size_x >> chroma_subsamp_x;
+
+    // A band per row of blocks, at least one so that dst is always written
+    int32_t half_block_size_y = ctxt->luma_subblock_size_y >> 1;
+    ctxt->num_bands = AOMMAX((height / 2 + half_block_size_y - 1) / half_block_size_y, 1);
 
     // Initial padding is only needed for generation of
     // film grain templates (to stabilize the AR process)
     // Only a 64x64 luma and 32x32 chroma part of a template
     // is used later for adding grain, padding can be discarded
 
-    int32_t luma_block_size_y =
-        top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
-    int32_t luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 +
-        2 * ar_padding + right_pad;
+    int32_t luma_block_size_y = FGN_TOP_PAD + 2 * FGN_AR_PADDING +
+        ctxt->luma_subblock_size_y * 2 + FGN_BOTTOM_PAD;
+    int32_t luma_block_size_x = FGN_LEFT_PAD + 2 * FGN_AR_PADDING +
+        ctxt->luma_subblock_size_x * 2 + 2 * FGN_AR_PADDING + FGN_RIGHT_PAD;
 
-    int32_t chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-        chroma_subblock_size_y * 2 + bottom_pad;
-    int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-        chroma_subblock_size_x * 2 +
-        (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+    int32_t chroma_block_size_y = FGN_TOP_PAD + (2 >> chroma_subsamp_y) * FGN_AR_PADDING +
+        ctxt->chroma_subblock_size_y * 2 + FGN_BOTTOM_PAD;
+    int32_t chroma_block_size_x = FGN_LEFT_PAD + (2 >> chroma_subsamp_x) * FGN_AR_PADDING +
+        ctxt->chroma_subblock_size_x * 2 +
+        (2 >> chroma_subsamp_x) * FGN_AR_PADDING + FGN_RIGHT_PAD;
 
-    int32_t luma_grain_stride = luma_block_size_x;
-    int32_t chroma_grain_stride = chroma_block_size_x;
+    ctxt->luma_grain_stride = luma_block_size_x;
+    ctxt->chroma_grain_stride = chroma_block_size_x;
 
-    int32_t overlap = params->overlap_flag;
     int32_t bit_depth = params->bit_depth;
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min = 0 - grain_center;
-    grain_max = (256 << (bit_depth - 8)) - 1 - grain_center;
+    int32_t grain_center = 128 << (bit_depth - 8);
+    ctxt->grain_min = 0 - grain_center;
+    ctxt->grain_max = (256 << (bit_depth - 8)) - 1 - grain_center;
 
-    init_arrays(params, luma_stride, chroma_stride, &pred_pos_luma,
-        &pred_pos_chroma, &luma_grain_block, &cb_grain_block,
-        &cr_grain_block, &y_line_buf, &cb_line_buf, &cr_line_buf,
-        &y_col_buf, &cb_col_buf, &cr_col_buf,
+    init_arrays(params, &pred_pos_luma, &pred_pos_chroma,
+        &ctxt->luma_grain_block, &ctxt->cb_grain_block, &ctxt->cr_grain_block,
         luma_block_size_y * luma_block_size_x,
-        chroma_block_size_y * chroma_block_size_x, chroma_subsamp_y,
-        chroma_subsamp_x);
+        chroma_block_size_y * chroma_block_size_x);
 
-    generate_luma_grain_block(params, pred_pos_luma, luma_grain_block,
+    generate_luma_grain_block(params, pred_pos_luma, ctxt->luma_grain_block,
         luma_block_size_y, luma_block_size_x,
-        luma_grain_stride, left_pad, top_pad, right_pad,
-        bottom_pad);
+        ctxt->luma_grain_stride, FGN_LEFT_PAD, FGN_TOP_PAD, FGN_RIGHT_PAD,
+        FGN_BOTTOM_PAD, ctxt->grain_min, ctxt->grain_max);
 
     generate_chroma_grain_blocks(
         params,
         //                               pred_pos_luma,
-        pred_pos_chroma, luma_grain_block, cb_grain_block, cr_grain_block,
-        luma_grain_stride, chroma_block_size_y, chroma_block_size_x,
-        chroma_grain_stride, left_pad, top_pad, right_pad, bottom_pad,
-        chroma_subsamp_y, chroma_subsamp_x);
+        pred_pos_chroma, ctxt->luma_grain_block, ctxt->cb_grain_block,
+        ctxt->cr_grain_block, ctxt->luma_grain_stride, chroma_block_size_y,
+        chroma_block_size_x, ctxt->chroma_grain_stride, FGN_LEFT_PAD,
+        FGN_TOP_PAD, FGN_RIGHT_PAD, FGN_BOTTOM_PAD, chroma_subsamp_y,
+        chroma_subsamp_x, ctxt->grain_min, ctxt->grain_max);
+
+    dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma);
+
+    memset(ctxt->scaling_lut_y, 0, sizeof(ctxt->scaling_lut_y));
+    memset(ctxt->scaling_lut_cb, 0, sizeof(ctxt->scaling_lut_cb));
+    memset(ctxt->scaling_lut_cr, 0, sizeof(ctxt->scaling_lut_cr));
 
     init_scaling_function(params->scaling_points_y, params->num_y_points,
-        scaling_lut_y);
+        ctxt->scaling_lut_y);
 
     if (params->chroma_scaling_from_luma) {
-        memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+        memcpy(ctxt->scaling_lut_cb, ctxt->scaling_lut_y, sizeof(ctxt->scaling_lut_y));
+        memcpy(ctxt->scaling_lut_cr, ctxt->scaling_lut_y, sizeof(ctxt->scaling_lut_y));
     }
     else {
         init_scaling_function(params->scaling_points_cb, params->num_cb_points,
-            scaling_lut_cb);
+            ctxt->scaling_lut_cb);
         init_scaling_function(params->scaling_points_cr, params->num_cr_points,
-            scaling_lut_cr);
+            ctxt->scaling_lut_cr);
     }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
-
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
-            int32_t offset_x = (offset_y >> 4) & 15;
-            offset_y &= 15;
-
-            int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
-            int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
-
-            int32_t chroma_offset_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-                offset_y * (2 >> chroma_subsamp_y);
-            int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                offset_x * (2 >> chroma_subsamp_x);
-
-            if (overlap && x) {
-                ver_boundary_overlap(
-                    y_col_buf, 2,
-                    luma_grain_block + luma_offset_y * luma_grain_stride +
-                    luma_offset_x,
-                    luma_grain_stride, y_col_buf, 2, 2,
-                    AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                ver_boundary_overlap(
-                    cb_col_buf, 2 >> chroma_subsamp_x,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x,
-                    chroma_grain_stride, cb_col_buf, 2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                    (height - (y << 1)) >> chroma_subsamp_y));
-
-                ver_boundary_overlap(
-                    cr_col_buf, 2 >> chroma_subsamp_x,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x,
-                    chroma_grain_stride, cr_col_buf, 2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                    (height - (y << 1)) >> chroma_subsamp_y));
-
-                int32_t i = y ? 1 : 0;
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb +
-                        ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << (1 - chroma_subsamp_x)),
-                        (uint16_t *)cr +
-                        ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << (1 - chroma_subsamp_x)),
-                        luma_stride, chroma_stride, y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2, (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
-                        bit_depth, chroma_subsamp_y, chroma_subsamp_x);
-                }
-                else {
-                    add_noise_to_block(
-                        params, luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << (1 - chroma_subsamp_x)),
-                        luma_stride, chroma_stride, y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2, (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
-                        bit_depth, chroma_subsamp_y, chroma_subsamp_x);
-                }
-            }
 
-            if (overlap && y) {
-                if (x) {
-                    ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(y_line_buf + (x << 1), luma_stride, y_col_buf, 2,
-                        y_line_buf + (x << 1), luma_stride, 2, 2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                        chroma_stride, cb_col_buf, 2 >> chroma_subsamp_x,
-                        cb_line_buf + x * (2 >> chroma_subsamp_x),
-                        chroma_stride, 2 >> chroma_subsamp_x,
-                        2 >> chroma_subsamp_y);
-
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                        chroma_stride, cr_col_buf, 2 >> chroma_subsamp_x,
-                        cr_line_buf + x * (2 >> chroma_subsamp_x),
-                        chroma_stride, 2 >> chroma_subsamp_x,
-                        2 >> chroma_subsamp_y);
-                }
+    ctxt->apply_y = params->num_y_points > 0 ? 1 : 0;
+    ctxt->apply_cb = params->num_cb_points > 0 && cb ? 1 : 0;
+    ctxt->apply_cr = params->num_cr_points > 0 && cr ? 1 : 0;
 
-                hor_boundary_overlap(
-                    y_line_buf + ((x ? x + 1 : 0) << 1), luma_stride,
-                    luma_grain_block + luma_offset_y * luma_grain_stride +
-                    luma_offset_x + (x ? 2 : 0),
-                    luma_grain_stride, y_line_buf + ((x ? x + 1 : 0) << 1), luma_stride,
-                    AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
-                        width - ((x ? x + 1 : 0) << 1)),
-                    2);
-
-                hor_boundary_overlap(
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x -
-                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                        (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                hor_boundary_overlap(
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x -
-                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                        (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params, (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << ((1 - chroma_subsamp_x))),
-                        (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << ((1 - chroma_subsamp_x))),
-                        luma_stride, chroma_stride, y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)), luma_stride,
-                        chroma_stride, 1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x), bit_depth,
-                        chroma_subsamp_y, chroma_subsamp_x);
-                }
-                else {
-                    add_noise_to_block(
-                        params, luma + (y << 1) * luma_stride + (x << 1),
-                        cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << ((1 - chroma_subsamp_x))),
-                        cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                        (x << ((1 - chroma_subsamp_x))),
-                        luma_stride, chroma_stride, y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)), luma_stride,
-                        chroma_stride, 1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x), bit_depth,
-                        chroma_subsamp_y, chroma_subsamp_x);
-                }
-            }
+    // offset values and clipping range depend on the bit depth
+    int32_t bd_shift = use_high_bit_depth ? bit_depth - 8 : 0;
 
-            int32_t i = overlap && y ? 1 : 0;
-            int32_t j = overlap && x ? 1 : 0;
-
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb +
-                    ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                    ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr +
-                    ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                    ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride, chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                    luma_offset_x + (j << 1),
-                    cb_grain_block +
-                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride, chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
-                    chroma_subsamp_y, chroma_subsamp_x);
-            }
-            else {
-                add_noise_to_block(
-                    params, luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                    ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                    ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride, chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                    luma_offset_x + (j << 1),
-                    cb_grain_block +
-                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride, chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
-                    chroma_subsamp_y, chroma_subsamp_x);
-            }
+    ctxt->cb_mult = params->cb_mult - 128;            // fixed scale
+    ctxt->cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
+    ctxt->cb_offset = (params->cb_offset << bd_shift) - (256 << bd_shift);
 
-            if (overlap) {
-                if (x) {
-                    // Copy overlapped column bufer to line buffer
-                    copy_area(y_col_buf + (luma_subblock_size_y << 1), 2,
-                        y_line_buf + (x << 1), luma_stride, 2, 2);
-
-                    copy_area(
-                        cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                        2 >> chroma_subsamp_x,
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)), chroma_stride,
-                        2 >> chroma_subsamp_x, 2 >> chroma_subsamp_y);
-
-                    copy_area(
-                        cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                        2 >> chroma_subsamp_x,
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)), chroma_stride,
-                        2 >> chroma_subsamp_x, 2 >> chroma_subsamp_y);
-                }
+    ctxt->cr_mult = params->cr_mult - 128;            // fixed scale
+    ctxt->cr_luma_mult = params->cr_luma_mult - 128;  // fixed scale
+    ctxt->cr_offset = (params->cr_offset << bd_shift) - (256 << bd_shift);
 
-                // Copy grain to the line buffer for overlap with a bottom block
-                copy_area(
-                    luma_grain_block +
-                    (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
-                    luma_offset_x + ((x ? 2 : 0)),
-                    luma_grain_stride, y_line_buf + ((x ? x + 1 : 0) << 1), luma_stride,
-                    AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0), 2);
-
-                copy_area(cb_grain_block +
-                    (chroma_offset_y + chroma_subblock_size_y) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                    chroma_grain_stride,
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x,
-                    ((width - (x << 1)) >> chroma_subsamp_x)) -
-                        (x ? 2 >> chroma_subsamp_x : 0),
-                    2 >> chroma_subsamp_y);
-
-                copy_area(cr_grain_block +
-                    (chroma_offset_y + chroma_subblock_size_y) *
-                    chroma_grain_stride +
-                    chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                    chroma_grain_stride,
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x,
-                    ((width - (x << 1)) >> chroma_subsamp_x)) -
-                        (x ? 2 >> chroma_subsamp_x : 0),
-                    2 >> chroma_subsamp_y);
-
-                // Copy grain to the column buffer for overlap with the next block to
-                // the right
-
-                copy_area(luma_grain_block + luma_offset_y * luma_grain_stride +
-                    luma_offset_x + luma_subblock_size_x,
-                    luma_grain_stride, y_col_buf, 2, 2,
-                    AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x + chroma_subblock_size_x,
-                    chroma_grain_stride, cb_col_buf, 2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                    (height - (y << 1)) >> chroma_subsamp_y));
-
-                copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride +
-                    chroma_offset_x + chroma_subblock_size_x,
-                    chroma_grain_stride, cr_col_buf, 2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                    (height - (y << 1)) >> chroma_subsamp_y));
-            }
+    if (params->chroma_scaling_from_luma) {
+        ctxt->cb_mult = 0;        // fixed scale
+        ctxt->cb_luma_mult = 64;  // fixed scale
+        ctxt->cb_offset = 0;
+
+        ctxt->cr_mult = 0;        // fixed scale
+        ctxt->cr_luma_mult = 64;  // fixed scale
+        ctxt->cr_offset = 0;
+    }
+
+    ctxt->rounding_offset = (1 << (params->scaling_shift - 1));
+    ctxt->scaling_shift = params->scaling_shift;
+
+    if (params->clip_to_restricted_range) {
+        ctxt->min_luma = min_luma_legal_range << bd_shift;
+        ctxt->max_luma = max_luma_legal_range << bd_shift;
+
+        ctxt->min_chroma = min_chroma_legal_range << bd_shift;
+        ctxt->max_chroma = max_chroma_legal_range << bd_shift;
+    }
+    else {
+        ctxt->min_luma = ctxt->min_chroma = 0;
+        ctxt->max_luma = ctxt->max_chroma = (256 << bd_shift) - 1;
+    }
+}
+
+void eb_av1_film_grain_free(FilmGrainCtxt *ctxt) {
+    free(ctxt->luma_grain_block);
+    free(ctxt->cb_grain_block);
+    free(ctxt->cr_grain_block);
+    ctxt->luma_grain_block = NULL;
+    ctxt->cb_grain_block = NULL;
+    ctxt->cr_grain_block = NULL;
+}
+
+// Grain of the blocks of a band kept for the overlap with the next block to
+// the right (column buffers) and with the band below (line buffers)
+typedef struct FilmGrainBandBufs {
+    int32_t *y_line_buf;
+    int32_t *cb_line_buf;
+    int32_t *cr_line_buf;
+    int32_t luma_line_stride;
+    int32_t chroma_line_stride;
+
+    int32_t *y_col_buf;
+    int32_t *cb_col_buf;
+    int32_t *cr_col_buf;
+} FilmGrainBandBufs;
+
+static void alloc_band_bufs(const FilmGrainCtxt *ctxt, FilmGrainBandBufs *bufs) {
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+
+    bufs->luma_line_stride = ctxt->width;
+    bufs->chroma_line_stride = (ctxt->width + chroma_subsamp_x) >> chroma_subsamp_x;
+
+    bufs->y_line_buf = (int32_t *)malloc(sizeof(*bufs->y_line_buf) *
+        bufs->luma_line_stride * 2);
+    bufs->cb_line_buf = (int32_t *)malloc(sizeof(*bufs->cb_line_buf) *
+        bufs->chroma_line_stride * (2 >> chroma_subsamp_y));
+    bufs->cr_line_buf = (int32_t *)malloc(sizeof(*bufs->cr_line_buf) *
+        bufs->chroma_line_stride * (2 >> chroma_subsamp_y));
+
+    bufs->y_col_buf = (int32_t *)malloc(sizeof(*bufs->y_col_buf) *
+        (ctxt->luma_subblock_size_y + 2) * 2);
+    bufs->cb_col_buf = (int32_t *)malloc(sizeof(*bufs->cb_col_buf) *
+        (ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+        (2 >> chroma_subsamp_x));
+    bufs->cr_col_buf = (int32_t *)malloc(sizeof(*bufs->cr_col_buf) *
+        (ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+        (2 >> chroma_subsamp_x));
+}
+
+static void free_band_bufs(FilmGrainBandBufs *bufs) {
+    free(bufs->y_line_buf);
+    free(bufs->cb_line_buf);
+    free(bufs->cr_line_buf);
+    free(bufs->y_col_buf);
+    free(bufs->cb_col_buf);
+    free(bufs->cr_col_buf);
+}
+
+// Picks the grain of the next block of the band in the templates
+static void get_block_grain(const FilmGrainCtxt *ctxt, uint16_t *random_register,
+    int32_t **luma_grain, int32_t **cb_grain, int32_t **cr_grain) {
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+
+    int32_t offset_y = get_random_number(random_register, 8);
+    int32_t offset_x = (offset_y >> 4) & 15;
+    offset_y &= 15;
+
+    int32_t luma_offset_y = FGN_LEFT_PAD + 2 * FGN_AR_PADDING + (offset_y << 1);
+    int32_t luma_offset_x = FGN_TOP_PAD + 2 * FGN_AR_PADDING + (offset_x << 1);
+
+    int32_t chroma_offset_y = FGN_TOP_PAD + (2 >> chroma_subsamp_y) * FGN_AR_PADDING +
+        offset_y * (2 >> chroma_subsamp_y);
+    int32_t chroma_offset_x = FGN_LEFT_PAD + (2 >> chroma_subsamp_x) * FGN_AR_PADDING +
+        offset_x * (2 >> chroma_subsamp_x);
+
+    *luma_grain = ctxt->luma_grain_block + luma_offset_y * ctxt->luma_grain_stride +
+        luma_offset_x;
+    *cb_grain = ctxt->cb_grain_block + chroma_offset_y * ctxt->chroma_grain_stride +
+        chroma_offset_x;
+    *cr_grain = ctxt->cr_grain_block + chroma_offset_y * ctxt->chroma_grain_stride +
+        chroma_offset_x;
+}
+
+// Blends the column buffers with the left columns of the block
+static void ver_overlap_col_bufs(const FilmGrainCtxt *ctxt, FilmGrainBandBufs *bufs,
+    int32_t y, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain) {
+    int32_t height = ctxt->height;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+
+    ver_boundary_overlap(
+        bufs->y_col_buf, 2, luma_grain, ctxt->luma_grain_stride,
+        bufs->y_col_buf, 2, 2,
+        AOMMIN(ctxt->luma_subblock_size_y + 2, height - (y << 1)),
+        ctxt->grain_min, ctxt->grain_max);
+
+    ver_boundary_overlap(
+        bufs->cb_col_buf, 2 >> chroma_subsamp_x, cb_grain,
+        ctxt->chroma_grain_stride, bufs->cb_col_buf, 2 >> chroma_subsamp_x,
+        2 >> chroma_subsamp_x,
+        AOMMIN(ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+        (height - (y << 1)) >> chroma_subsamp_y),
+        ctxt->grain_min, ctxt->grain_max);
+
+    ver_boundary_overlap(
+        bufs->cr_col_buf, 2 >> chroma_subsamp_x, cr_grain,
+        ctxt->chroma_grain_stride, bufs->cr_col_buf, 2 >> chroma_subsamp_x,
+        2 >> chroma_subsamp_x,
+        AOMMIN(ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+        (height - (y << 1)) >> chroma_subsamp_y),
+        ctxt->grain_min, ctxt->grain_max);
+}
+
+// Blends the line buffers with the top rows of the block
+static void hor_overlap_line_bufs(const FilmGrainCtxt *ctxt, FilmGrainBandBufs *bufs,
+    int32_t x, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain) {
+    int32_t width = ctxt->width;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t luma_line_stride = bufs->luma_line_stride;
+    int32_t chroma_line_stride = bufs->chroma_line_stride;
+
+    if (x) {
+        hor_boundary_overlap(bufs->y_line_buf + (x << 1), luma_line_stride,
+            bufs->y_col_buf, 2, bufs->y_line_buf + (x << 1), luma_line_stride,
+            2, 2, ctxt->grain_min, ctxt->grain_max);
+
+        hor_boundary_overlap(bufs->cb_line_buf + x * (2 >> chroma_subsamp_x),
+            chroma_line_stride, bufs->cb_col_buf, 2 >> chroma_subsamp_x,
+            bufs->cb_line_buf + x * (2 >> chroma_subsamp_x),
+            chroma_line_stride, 2 >> chroma_subsamp_x,
+            2 >> chroma_subsamp_y, ctxt->grain_min, ctxt->grain_max);
+
+        hor_boundary_overlap(bufs->cr_line_buf + x * (2 >> chroma_subsamp_x),
+            chroma_line_stride, bufs->cr_col_buf, 2 >> chroma_subsamp_x,
+            bufs->cr_line_buf + x * (2 >> chroma_subsamp_x),
+            chroma_line_stride, 2 >> chroma_subsamp_x,
+            2 >> chroma_subsamp_y, ctxt->grain_min, ctxt->grain_max);
+    }
+
+    hor_boundary_overlap(
+        bufs->y_line_buf + ((x ? x + 1 : 0) << 1), luma_line_stride,
+        luma_grain + (x ? 2 : 0), ctxt->luma_grain_stride,
+        bufs->y_line_buf + ((x ? x + 1 : 0) << 1), luma_line_stride,
+        AOMMIN(ctxt->luma_subblock_size_x - ((x ? 1 : 0) << 1),
+            width - ((x ? x + 1 : 0) << 1)),
+        2, ctxt->grain_min, ctxt->grain_max);
+
+    hor_boundary_overlap(
+        bufs->cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        cb_grain + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+        ctxt->chroma_grain_stride,
+        bufs->cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        AOMMIN(ctxt->chroma_subblock_size_x -
+        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+        2 >> chroma_subsamp_y, ctxt->grain_min, ctxt->grain_max);
+
+    hor_boundary_overlap(
+        bufs->cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        cr_grain + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+        ctxt->chroma_grain_stride,
+        bufs->cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        AOMMIN(ctxt->chroma_subblock_size_x -
+        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+        2 >> chroma_subsamp_y, ctxt->grain_min, ctxt->grain_max);
+}
+
+// Keeps the grain of the block for the overlap with the block to the right
+// and with the block below
+static void save_block_grain(const FilmGrainCtxt *ctxt, FilmGrainBandBufs *bufs,
+    int32_t y, int32_t x, int32_t *luma_grain, int32_t *cb_grain,
+    int32_t *cr_grain) {
+    int32_t height = ctxt->height;
+    int32_t width = ctxt->width;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t luma_line_stride = bufs->luma_line_stride;
+    int32_t chroma_line_stride = bufs->chroma_line_stride;
+
+    if (x) {
+        // Copy overlapped column bufer to line buffer
+        copy_area(bufs->y_col_buf + (ctxt->luma_subblock_size_y << 1), 2,
+            bufs->y_line_buf + (x << 1), luma_line_stride, 2, 2);
+
+        copy_area(
+            bufs->cb_col_buf + (ctxt->chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+            2 >> chroma_subsamp_x,
+            bufs->cb_line_buf + (x << (1 - chroma_subsamp_x)), chroma_line_stride,
+            2 >> chroma_subsamp_x, 2 >> chroma_subsamp_y);
+
+        copy_area(
+            bufs->cr_col_buf + (ctxt->chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+            2 >> chroma_subsamp_x,
+            bufs->cr_line_buf + (x << (1 - chroma_subsamp_x)), chroma_line_stride,
+            2 >> chroma_subsamp_x, 2 >> chroma_subsamp_y);
+    }
+
+    // Copy grain to the line buffer for overlap with a bottom block
+    copy_area(
+        luma_grain + ctxt->luma_subblock_size_y * ctxt->luma_grain_stride +
+        (x ? 2 : 0),
+        ctxt->luma_grain_stride, bufs->y_line_buf + ((x ? x + 1 : 0) << 1),
+        luma_line_stride,
+        AOMMIN(ctxt->luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0), 2);
+
+    copy_area(cb_grain + ctxt->chroma_subblock_size_y * ctxt->chroma_grain_stride +
+        (x ? 2 >> chroma_subsamp_x : 0),
+        ctxt->chroma_grain_stride,
+        bufs->cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        AOMMIN(ctxt->chroma_subblock_size_x,
+        ((width - (x << 1)) >> chroma_subsamp_x)) -
+            (x ? 2 >> chroma_subsamp_x : 0),
+        2 >> chroma_subsamp_y);
+
+    copy_area(cr_grain + ctxt->chroma_subblock_size_y * ctxt->chroma_grain_stride +
+        (x ? 2 >> chroma_subsamp_x : 0),
+        ctxt->chroma_grain_stride,
+        bufs->cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+        chroma_line_stride,
+        AOMMIN(ctxt->chroma_subblock_size_x,
+        ((width - (x << 1)) >> chroma_subsamp_x)) -
+            (x ? 2 >> chroma_subsamp_x : 0),
+        2 >> chroma_subsamp_y);
+
+    // Copy grain to the column buffer for overlap with the next block to
+    // the right
+
+    copy_area(luma_grain + ctxt->luma_subblock_size_x,
+        ctxt->luma_grain_stride, bufs->y_col_buf, 2, 2,
+        AOMMIN(ctxt->luma_subblock_size_y + 2, height - (y << 1)));
+
+    copy_area(cb_grain + ctxt->chroma_subblock_size_x,
+        ctxt->chroma_grain_stride, bufs->cb_col_buf, 2 >> chroma_subsamp_x,
+        2 >> chroma_subsamp_x,
+        AOMMIN(ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+        (height - (y << 1)) >> chroma_subsamp_y));
+
+    copy_area(cr_grain + ctxt->chroma_subblock_size_x,
+        ctxt->chroma_grain_stride, bufs->cr_col_buf, 2 >> chroma_subsamp_x,
+        2 >> chroma_subsamp_x,
+        AOMMIN(ctxt->chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+        (height - (y << 1)) >> chroma_subsamp_y));
+}
+
+// Fills the line buffers as the band starting at row y leaves them. The
+// grain of its bottom rows only depends on the random offsets of its blocks
+static void save_band_grain(const FilmGrainCtxt *ctxt, FilmGrainBandBufs *bufs,
+    int32_t y) {
+    uint16_t random_register = init_random_generator(y * 2,
+        ctxt->params->random_seed);
+
+    for (int32_t x = 0; x < ctxt->width / 2; x += (ctxt->luma_subblock_size_x >> 1)) {
+        int32_t *luma_grain, *cb_grain, *cr_grain;
+
+        get_block_grain(ctxt, &random_register, &luma_grain, &cb_grain, &cr_grain);
+        if (x)
+            ver_overlap_col_bufs(ctxt, bufs, y, luma_grain, cb_grain, cr_grain);
+        save_block_grain(ctxt, bufs, y, x, luma_grain, cb_grain, cr_grain);
+    }
+}
+
+static INLINE const uint8_t *fgn_src_ptr(const uint8_t *plane, int32_t offset,
+    int32_t use_high_bit_depth) {
+    return plane ? plane + ((intptr_t)offset << use_high_bit_depth) : NULL;
+}
+
+static INLINE uint8_t *fgn_dst_ptr(uint8_t *plane, int32_t offset,
+    int32_t use_high_bit_depth) {
+    return plane ? plane + ((intptr_t)offset << use_high_bit_depth) : NULL;
+}
+
+// Adds the grain to the area starting at (half_y, half_x) in half luma
+// samples
+static void add_noise_to_area(const FilmGrainCtxt *ctxt, int32_t half_y,
+    int32_t half_x, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
+    int32_t luma_grain_stride, int32_t chroma_grain_stride,
+    int32_t half_luma_height, int32_t half_luma_width) {
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t hbd = ctxt->use_high_bit_depth;
+
+    int32_t src_luma_offset = (half_y << 1) * ctxt->src_luma_stride + (half_x << 1);
+    int32_t luma_offset = (half_y << 1) * ctxt->luma_stride + (half_x << 1);
+    int32_t src_chroma_offset = (half_y << (1 - chroma_subsamp_y)) *
+        ctxt->src_chroma_stride + (half_x << (1 - chroma_subsamp_x));
+    int32_t chroma_offset = (half_y << (1 - chroma_subsamp_y)) *
+        ctxt->chroma_stride + (half_x << (1 - chroma_subsamp_x));
+
+    const uint8_t *src_luma = fgn_src_ptr(ctxt->src_luma, src_luma_offset, hbd);
+    const uint8_t *src_cb = fgn_src_ptr(ctxt->src_cb, src_chroma_offset, hbd);
+    const uint8_t *src_cr = fgn_src_ptr(ctxt->src_cr, src_chroma_offset, hbd);
+    uint8_t *luma = fgn_dst_ptr(ctxt->luma, luma_offset, hbd);
+    uint8_t *cb = fgn_dst_ptr(ctxt->cb, chroma_offset, hbd);
+    uint8_t *cr = fgn_dst_ptr(ctxt->cr, chroma_offset, hbd);
+
+    if (hbd) {
+        eb_av1_add_noise_to_block_hbd(ctxt, (const uint16_t *)src_luma,
+            (const uint16_t *)src_cb, (const uint16_t *)src_cr,
+            (uint16_t *)luma, (uint16_t *)cb, (uint16_t *)cr, luma_grain,
+            cb_grain, cr_grain, luma_grain_stride, chroma_grain_stride,
+            half_luma_height, half_luma_width);
+    }
+    else {
+        eb_av1_add_noise_to_block(ctxt, src_luma, src_cb, src_cr, luma, cb, cr,
+            luma_grain, cb_grain, cr_grain, luma_grain_stride,
+            chroma_grain_stride, half_luma_height, half_luma_width);
+    }
+}
+
+// Copies the rows [row_start, row_end) of a plane, but for the area starting
+// at the top left corner that got the grain
+static void copy_plane_remainder(const uint8_t *src, int32_t src_stride,
+    uint8_t *dst, int32_t dst_stride, int32_t width, int32_t row_start,
+    int32_t row_end, int32_t noise_width, int32_t noise_height,
+    int32_t use_high_bit_depth) {
+    for (int32_t row = row_start; row < row_end; row++) {
+        int32_t col = row < noise_height ? noise_width : 0;
+        if (col < width) {
+            memcpy(dst + (((intptr_t)row * dst_stride + col) << use_high_bit_depth),
+                src + (((intptr_t)row * src_stride + col) << use_high_bit_depth),
+                (size_t)(width - col) << use_high_bit_depth);
         }
     }
+}
+
+// With dst apart from src, copies the samples of the band that get no grain:
+// the planes with no scaling points and the last column and row of the planes
+// of odd size
+static void copy_band_remainder(const FilmGrainCtxt *ctxt, int32_t band) {
+    int32_t height = ctxt->height;
+    int32_t width = ctxt->width;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t hbd = ctxt->use_high_bit_depth;
+
+    if (ctxt->src_luma == ctxt->luma)
+        return;
+
+    int32_t row_start = band * ctxt->luma_subblock_size_y;
+    int32_t row_end = (band == ctxt->num_bands - 1) ? height :
+        row_start + ctxt->luma_subblock_size_y;
+
+    copy_plane_remainder(ctxt->src_luma, ctxt->src_luma_stride, ctxt->luma,
+        ctxt->luma_stride, width, row_start, row_end,
+        ctxt->apply_y ? (width / 2) << 1 : 0,
+        ctxt->apply_y ? (height / 2) << 1 : 0, hbd);
+
+    int32_t chroma_row_end = (band == ctxt->num_bands - 1) ?
+        height >> chroma_subsamp_y : row_end >> chroma_subsamp_y;
+    int32_t noise_width = (width / 2) << (1 - chroma_subsamp_x);
+    int32_t noise_height = (height / 2) << (1 - chroma_subsamp_y);
+
+    if (ctxt->cb) {
+        copy_plane_remainder(ctxt->src_cb, ctxt->src_chroma_stride, ctxt->cb,
+            ctxt->chroma_stride, width >> chroma_subsamp_x,
+            row_start >> chroma_subsamp_y, chroma_row_end,
+            ctxt->apply_cb ? noise_width : 0,
+            ctxt->apply_cb ? noise_height : 0, hbd);
+    }
+    if (ctxt->cr) {
+        copy_plane_remainder(ctxt->src_cr, ctxt->src_chroma_stride, ctxt->cr,
+            ctxt->chroma_stride, width >> chroma_subsamp_x,
+            row_start >> chroma_subsamp_y, chroma_row_end,
+            ctxt->apply_cr ? noise_width : 0,
+            ctxt->apply_cr ? noise_height : 0, hbd);
+    }
+}
+
+// A band is a row of 32x32 luma blocks. The blocks overlap the band above by
+// 2 luma rows, the grain of the band above there is rebuilt from its random
+// offsets, so that the bands can be processed in any order
+void eb_av1_add_film_grain_band(const FilmGrainCtxt *ctxt, int32_t band) {
+    int32_t height = ctxt->height;
+    int32_t width = ctxt->width;
+    int32_t chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t luma_subblock_size_y = ctxt->luma_subblock_size_y;
+    int32_t luma_subblock_size_x = ctxt->luma_subblock_size_x;
+    int32_t luma_grain_stride = ctxt->luma_grain_stride;
+    int32_t chroma_grain_stride = ctxt->chroma_grain_stride;
+    int32_t overlap = ctxt->params->overlap_flag;
+    int32_t y = band * (luma_subblock_size_y >> 1);
+    FilmGrainBandBufs bufs;
+
+    alloc_band_bufs(ctxt, &bufs);
+
+    if (overlap && y)
+        save_band_grain(ctxt, &bufs, y - (luma_subblock_size_y >> 1));
+
+    uint16_t random_register = init_random_generator(y * 2,
+        ctxt->params->random_seed);
+
+    for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        int32_t *luma_grain, *cb_grain, *cr_grain;
+
+        get_block_grain(ctxt, &random_register, &luma_grain, &cb_grain, &cr_grain);
+
+        if (overlap && x) {
+            ver_overlap_col_bufs(ctxt, &bufs, y, luma_grain, cb_grain, cr_grain);
+
+            int32_t i = y ? 1 : 0;
+
+            add_noise_to_area(ctxt, y + i, x, bufs.y_col_buf + i * 4,
+                bufs.cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                bufs.cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                2, (2 - chroma_subsamp_x),
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1);
+        }
+
+        if (overlap && y) {
+            hor_overlap_line_bufs(ctxt, &bufs, x, luma_grain, cb_grain, cr_grain);
+
+            add_noise_to_area(ctxt, y, x, bufs.y_line_buf + (x << 1),
+                bufs.cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                bufs.cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                bufs.luma_line_stride, bufs.chroma_line_stride, 1,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x));
+        }
+
+        int32_t i = overlap && y ? 1 : 0;
+        int32_t j = overlap && x ? 1 : 0;
+
+        add_noise_to_area(ctxt, y + i, x + j,
+            luma_grain + (i << 1) * luma_grain_stride + (j << 1),
+            cb_grain + (i << (1 - chroma_subsamp_y)) * chroma_grain_stride +
+            (j << (1 - chroma_subsamp_x)),
+            cr_grain + (i << (1 - chroma_subsamp_y)) * chroma_grain_stride +
+            (j << (1 - chroma_subsamp_x)),
+            luma_grain_stride, chroma_grain_stride,
+            AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+            AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j);
+
+        if (overlap)
+            save_block_grain(ctxt, &bufs, y, x, luma_grain, cb_grain, cr_grain);
+    }
+
+    copy_band_remainder(ctxt, band);
+
+    free_band_bufs(&bufs);
+}
+
+void eb_av1_add_film_grain_run(aom_film_grain_t *params, uint8_t *luma,
+    uint8_t *cb, uint8_t *cr, int32_t height, int32_t width,
+    int32_t luma_stride, int32_t chroma_stride,
+    int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x) {
+    FilmGrainCtxt ctxt;
+
+    eb_av1_film_grain_init(&ctxt, params, luma, cb, cr, luma_stride,
+        chroma_stride, luma, cb, cr, luma_stride, chroma_stride, height, width,
+        use_high_bit_depth, chroma_subsamp_y, chroma_subsamp_x);
+
+    for (int32_t band = 0; band < ctxt.num_bands; band++)
+        eb_av1_add_film_grain_band(&ctxt, band);
 
-    dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma, &luma_grain_block,
-        &cb_grain_block, &cr_grain_block, &y_line_buf, &cb_line_buf,
-        &cr_line_buf, &y_col_buf, &cb_col_buf, &cr_col_buf);
+    eb_av1_film_grain_free(&ctxt);
 }
 
 /*
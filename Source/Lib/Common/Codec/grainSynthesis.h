@@ -21,12 +21,13 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stdint.h>
 
     /*!\brief Structure containing film grain synthesis parameters for a frame
      *
      * This structure contains input parameters for film grain synthesis
      */
-    typedef struct {
+    typedef struct aom_film_grain {
         int32_t apply_grain;
 
         int32_t update_parameters;
@@ -82,6 +83,95 @@ extern "C" {
 
     int32_t film_grain_params_equal(aom_film_grain_t *pars_a, aom_film_grain_t *pars_b);
 
+    /*!\brief Film grain synthesis state of a frame
+     *
+     * Filled by eb_av1_film_grain_init, then read only while the bands of
+     * the frame get their grain, possibly on several threads. The grain is
+     * added to the src planes and written to the dst planes, which may be
+     * the same. Strides are in samples.
+     */
+    typedef struct FilmGrainCtxt {
+        aom_film_grain_t *params;
+
+        const uint8_t *src_luma;
+        const uint8_t *src_cb;
+        const uint8_t *src_cr;
+        int32_t src_luma_stride;
+        int32_t src_chroma_stride;
+
+        uint8_t *luma;
+        uint8_t *cb;
+        uint8_t *cr;
+        int32_t luma_stride;
+        int32_t chroma_stride;
+
+        int32_t height;
+        int32_t width;
+        int32_t use_high_bit_depth;
+        int32_t chroma_subsamp_y;
+        int32_t chroma_subsamp_x;
+
+        /* Bands of 32 luma rows, the unit of eb_av1_add_film_grain_band */
+        int32_t num_bands;
+
+        int32_t luma_subblock_size_y;
+        int32_t luma_subblock_size_x;
+        int32_t chroma_subblock_size_y;
+        int32_t chroma_subblock_size_x;
+
+        int32_t scaling_lut_y[256];
+        int32_t scaling_lut_cb[256];
+        int32_t scaling_lut_cr[256];
+
+        int32_t grain_min;
+        int32_t grain_max;
+
+        /* Grain templates, the blocks of the frame are taken from them */
+        int32_t *luma_grain_block;
+        int32_t *cb_grain_block;
+        int32_t *cr_grain_block;
+        int32_t luma_grain_stride;
+        int32_t chroma_grain_stride;
+
+        /* Noise parameters, for the bit depth of the planes */
+        int32_t apply_y;
+        int32_t apply_cb;
+        int32_t apply_cr;
+        int32_t cb_mult;
+        int32_t cb_luma_mult;
+        int32_t cb_offset;
+        int32_t cr_mult;
+        int32_t cr_luma_mult;
+        int32_t cr_offset;
+        int32_t rounding_offset;
+        int32_t scaling_shift;
+        int32_t min_luma;
+        int32_t max_luma;
+        int32_t min_chroma;
+        int32_t max_chroma;
+    } FilmGrainCtxt;
+
+    /*!\brief Prepare the film grain of a frame
+     *
+     * Generates the grain templates and the scaling functions. cb and cr
+     * are NULL for a monochrome frame.
+     */
+    void eb_av1_film_grain_init(FilmGrainCtxt *ctxt,
+        aom_film_grain_t *grain_params, const uint8_t *src_luma,
+        const uint8_t *src_cb, const uint8_t *src_cr, int32_t src_luma_stride,
+        int32_t src_chroma_stride, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+        int32_t luma_stride, int32_t chroma_stride, int32_t height,
+        int32_t width, int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+        int32_t chroma_subsamp_x);
+
+    /*!\brief Add film grain to a band of the frame
+     *
+     * Writes all the dst rows of the band, the bands are independent
+     */
+    void eb_av1_add_film_grain_band(const FilmGrainCtxt *ctxt, int32_t band);
+
+    void eb_av1_film_grain_free(FilmGrainCtxt *ctxt);
+
     /*!\brief Add film grain
      *
      * Add film grain to an image
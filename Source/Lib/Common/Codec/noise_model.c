@@ -15,6 +15,7 @@
 #include "noise_model.h"
 #include "noise_util.h"
 #include "mathutils.h"
+#include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
 
@@ -508,7 +509,7 @@ void eb_aom_flat_block_finder_free(aom_flat_block_finder_t *block_finder) {
     memset(block_finder, 0, sizeof(*block_finder));
 }
 
-void eb_aom_flat_block_finder_extract_block(
+void eb_aom_flat_block_finder_extract_block_c(
     const aom_flat_block_finder_t *block_finder, const uint8_t *const data,
     int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane,
     double *block) {
@@ -803,6 +804,19 @@ void eb_aom_noise_model_free(aom_noise_model_t *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+// Adds the equations of an observation to the normal equations A x = b,
+// buffer holds the n neighbors and val the sample itself
+void eb_aom_noise_model_add_observation_c(double *A, double *b,
+    const double *buffer, double val, int32_t n, double normalization) {
+    for (int32_t i = 0; i < n; ++i) {
+        for (int32_t j = 0; j < n; ++j) {
+            A[i * n + j] +=
+                (buffer[i] * buffer[j]) / (normalization * normalization);
+        }
+        b[i] += (buffer[i] * val) / (normalization * normalization);
+    }
+}
+
 static int32_t add_block_observations(
     aom_noise_model_t *noise_model, int32_t c, const uint8_t *const data,
     const uint8_t *const denoised, int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -853,13 +867,8 @@ static int32_t add_block_observations(
                             denoised, stride, sub_log2, alt_data,
                             alt_denoised, alt_stride, x + x_o,
                             y + y_o, buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    eb_aom_noise_model_add_observation(A, b, buffer, val, n,
+                        normalization);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
@@ -127,7 +127,7 @@ extern "C" {
      * is maintained as is the inverse, inv(A'*A), so that the plane parameters
      * can be fit for each block.
      */
-    typedef struct {
+    typedef struct aom_flat_block_finder {
         double *AtA_inv;
         double *A;
         int32_t num_params;  // The number of parameters used for internal low-order model
@@ -141,11 +141,8 @@ extern "C" {
         int32_t block_size, int32_t bit_depth, int32_t use_highbd);
     void eb_aom_flat_block_finder_free(aom_flat_block_finder_t *block_finder);
 
-    /*!\brief Helper to extract a block and low order "planar" model. */
-    void eb_aom_flat_block_finder_extract_block(
-        const aom_flat_block_finder_t *block_finder, const uint8_t *const data,
-        int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane,
-        double *block);
+    /* eb_aom_flat_block_finder_extract_block, the helper to extract a block
+       and low order "planar" model, is declared in aom_dsp_rtcd.h */
 
     /*!\brief Runs the flat block finder on the input data.
      *
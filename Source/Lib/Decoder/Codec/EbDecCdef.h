@@ -23,6 +23,21 @@
 extern "C" {
 #endif
 
+/* Buffers carried across the 64x64 filter block rows of a frame */
+typedef struct DecCdefCtxt {
+    uint16_t    *linebuf[MAX_MB_PLANE];
+    uint16_t    *colbuf[MAX_MB_PLANE];
+    uint8_t     *row_cdef;
+    uint8_t     *prev_row_cdef;
+    uint8_t     *curr_row_cdef;
+} DecCdefCtxt;
+
+void svt_cdef_init_ctxt(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt);
+void svt_cdef_free_ctxt(DecCdefCtxt *cdef_ctxt);
+void svt_cdef_fb_row(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt,
+    int32_t fbr);
+void svt_cdef_fb_row_hbd(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt,
+    int32_t fbr);
 void svt_cdef_frame(EbDecHandle *dec_handle);
 void svt_cdef_frame_hbd(EbDecHandle *dec_handle);
 
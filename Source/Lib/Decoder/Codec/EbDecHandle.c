@@ -18,9 +18,12 @@
 #include "EbDecHandle.h"
 #include "EbDecMemInit.h"
 #include "EbDecPicMgr.h"
+#include "EbDecMt.h"
 #include "grainSynthesis.h"
 
-#ifndef _WIN32
+#ifdef _WIN32
+#include <windows.h>
+#else
 #include <pthread.h>
 #include <errno.h>
 #include <sys/stat.h>
@@ -31,7 +34,6 @@
 # include <intrin.h>
 #endif
 
-#define RTCD_C
 #include "aom_dsp_rtcd.h"
 
 /**************************************
@@ -53,12 +55,7 @@ uint32_t                         lib_malloc_count = 0;
 uint32_t                         lib_semaphore_count = 0;
 uint32_t                         lib_mutex_count = 0;
 
-void asmSetConvolveAsmTable(void);
-void init_intra_dc_predictors_c_internal(void);
-void asmSetConvolveHbdAsmTable(void);
-void init_intra_predictors_internal(void);
 void dec_init_intra_predictors_internal(void);
-extern void av1_init_wedge_masks(void);
 
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr,
                                 uint8_t **data, size_t data_size);
@@ -96,6 +93,36 @@ static EbAsm get_cpu_asm_type()
     return asm_type;
 }
 
+/**********************************
+* Process Wide Tables
+*   The decoder asks for the asm_type of the CPU, the
+*   RTCD tables shared with the encoder are built once
+*   for the process, then the decoder intra predictors
+*   copied from them
+**********************************/
+static void init_dec_tables(void)
+{
+    dec_init_intra_predictors_internal();
+}
+
+#ifdef _WIN32
+static INIT_ONCE dec_tables_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_dec_tables_once(
+    PINIT_ONCE InitOnce,
+    PVOID Parameter,
+    PVOID *lpContext)
+{
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    init_dec_tables();
+    return TRUE;
+}
+#else
+static pthread_once_t dec_tables_once = PTHREAD_ONCE_INIT;
+#endif
+
 /***********************************
 * Decoder Library Handle Constructor
 ************************************/
@@ -122,21 +149,93 @@ static EbErrorType eb_dec_handle_ctor(
     svt_dec_memory_map_index = &dec_handle_ptr->memory_map_index;
     svt_dec_lib_malloc_count = 0;
 
+    dec_handle_ptr->allocate_buffer = NULL;
+    dec_handle_ptr->release_buffer = NULL;
+    dec_handle_ptr->ext_fb_priv_data = NULL;
+    dec_handle_ptr->out_pic_buf = NULL;
+    dec_handle_ptr->grain_frame_buf.buffer = NULL;
+
     return return_error;
 }
 
-/* Copy from recon buffer to out buffer! */
+/* Points the output planes to the picture buffer */
+static void set_out_img_planes(EbSvtIOFormat *out_img,
+                               EbPictureBufferDesc *recon_picture_buf,
+                               uint32_t wd, uint32_t ht)
+{
+    int32_t hbd = recon_picture_buf->bit_depth != EB_8BIT;
+    int32_t sx = 0, sy = 0;
+
+    out_img->luma = recon_picture_buf->buffer_y +
+        ((recon_picture_buf->origin_y * recon_picture_buf->stride_y +
+          recon_picture_buf->origin_x) << hbd);
+    out_img->y_stride = recon_picture_buf->stride_y;
+    out_img->cb = NULL;
+    out_img->cr = NULL;
+    out_img->cb_stride = INT32_MAX;
+    out_img->cr_stride = INT32_MAX;
+
+    if (recon_picture_buf->color_format != EB_YUV400) {
+        sx = recon_picture_buf->color_format != EB_YUV444;
+        sy = recon_picture_buf->color_format == EB_YUV420;
+        out_img->cb = recon_picture_buf->buffer_cb +
+            (((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb +
+              (recon_picture_buf->origin_x >> sx)) << hbd);
+        out_img->cr = recon_picture_buf->buffer_cr +
+            (((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr +
+              (recon_picture_buf->origin_x >> sx)) << hbd);
+        out_img->cb_stride = recon_picture_buf->stride_cb;
+        out_img->cr_stride = recon_picture_buf->stride_cr;
+    }
+
+    out_img->width = wd;
+    out_img->height = ht;
+    out_img->origin_x = 0;
+    out_img->origin_y = 0;
+    out_img->color_fmt = recon_picture_buf->color_format;
+}
+
+/* Holds the picture to output with external frame buffers, as it may
+   be dropped from the references before the output call */
+static void hold_out_pic(EbDecHandle *dec_handle_ptr, EbDecPicBuf *pic_buf)
+{
+    if (dec_handle_ptr->out_pic_buf)
+        dec_pic_mgr_release_pic(dec_handle_ptr, dec_handle_ptr->out_pic_buf);
+    pic_buf->ref_count++;
+    dec_handle_ptr->out_pic_buf = pic_buf;
+}
+
+/* Drops the output picture of the previous decode call */
+static void release_out_pic(EbDecHandle *dec_handle_ptr)
+{
+    if (dec_handle_ptr->out_pic_buf) {
+        dec_pic_mgr_release_pic(dec_handle_ptr, dec_handle_ptr->out_pic_buf);
+        dec_handle_ptr->out_pic_buf = NULL;
+    }
+    if (dec_handle_ptr->grain_frame_buf.buffer) {
+        dec_handle_ptr->release_buffer(&dec_handle_ptr->grain_frame_buf,
+                                       dec_handle_ptr->ext_fb_priv_data);
+        dec_handle_ptr->grain_frame_buf.buffer = NULL;
+    }
+}
+
+/* Copy from recon buffer to out buffer! With external frame buffers, the
+   output points to the picture buffer unless film grain is applied */
 int svt_dec_out_buf(
     EbDecHandle         *dec_handle_ptr,
     EbBufferHeaderType  *p_buffer)
 {
-    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+    EbPictureBufferDesc *recon_picture_buf;
     EbSvtIOFormat       *out_img = (EbSvtIOFormat*)p_buffer->p_buffer;
 
     uint8_t *luma = NULL;
     uint8_t *cb   = NULL;
     uint8_t *cr   = NULL;
 
+    if (NULL == dec_handle_ptr->cur_pic_buf[0])
+        return 0;
+    recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+
     /* TODO: Should add logic for show_existing_frame */
     if (0 == dec_handle_ptr->show_frame) {
         assert(0 == dec_handle_ptr->show_existing_frame);
@@ -147,7 +246,23 @@ int svt_dec_out_buf(
     uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
     uint32_t i, sx = 0, sy = 0;
 
-    if (out_img->height != ht || out_img->width != wd ||
+    aom_film_grain_t *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->
+        film_grain_params;
+    int32_t apply_grain = !dec_handle_ptr->dec_config.skip_film_grain &&
+                          film_grain_ptr->apply_grain;
+
+    /* External frame buffers : the output is the picture buffer itself,
+       held by the decode call until the next one */
+    if (dec_handle_ptr->allocate_buffer && !apply_grain) {
+        assert(dec_handle_ptr->out_pic_buf == dec_handle_ptr->cur_pic_buf[0]);
+        set_out_img_planes(out_img, recon_picture_buf, wd, ht);
+        p_buffer->p_app_private = dec_handle_ptr->out_pic_buf->
+            ext_frame_buf.private_data;
+        return 1;
+    }
+
+    if (dec_handle_ptr->allocate_buffer || out_img->height != ht ||
+        out_img->width != wd ||
         out_img->color_fmt != recon_picture_buf->color_format)
     {
         int size = (dec_handle_ptr->seq_header.color_config.bit_depth ==
@@ -185,6 +300,40 @@ int svt_dec_out_buf(
             out_img->width = wd;
             out_img->height = ht;
 
+        if (dec_handle_ptr->allocate_buffer) {
+            /* Film grain is applied on a copy, allocated by the application */
+            EbExtFrameBuf *grain_frame_buf = &dec_handle_ptr->grain_frame_buf;
+            uint32_t chroma_bytes = chroma_size > 0 ? chroma_size : 0;
+            uint32_t min_size = size + 2 * chroma_bytes;
+            if (grain_frame_buf->buffer)
+                dec_handle_ptr->release_buffer(grain_frame_buf,
+                                               dec_handle_ptr->ext_fb_priv_data);
+            grain_frame_buf->buffer = NULL;
+            grain_frame_buf->buffer_size = 0;
+            grain_frame_buf->private_data = NULL;
+            if (dec_handle_ptr->allocate_buffer(grain_frame_buf, min_size,
+                dec_handle_ptr->ext_fb_priv_data))
+            {
+                grain_frame_buf->buffer = NULL;
+                return 0;
+            }
+            /* An unusable buffer still goes back to the application */
+            if (NULL == grain_frame_buf->buffer ||
+                grain_frame_buf->buffer_size < min_size)
+            {
+                dec_handle_ptr->release_buffer(grain_frame_buf,
+                                               dec_handle_ptr->ext_fb_priv_data);
+                grain_frame_buf->buffer = NULL;
+                return 0;
+            }
+            out_img->luma = grain_frame_buf->buffer;
+            out_img->cb = out_img->luma + size;
+            out_img->cr = out_img->cb + chroma_bytes;
+            out_img->origin_x = 0;
+            out_img->origin_y = 0;
+            p_buffer->p_app_private = grain_frame_buf->private_data;
+        }
+        else {
             free(out_img->luma);
             if (recon_picture_buf->color_format != EB_YUV400) {
                 free(out_img->cb);
@@ -193,8 +342,9 @@ int svt_dec_out_buf(
 
             out_img->luma = (uint8_t*)malloc(size);
             if (recon_picture_buf->color_format != EB_YUV400) {
-            out_img->cb = (uint8_t*)malloc(chroma_size);
-            out_img->cr = (uint8_t*)malloc(chroma_size);
+                out_img->cb = (uint8_t*)malloc(chroma_size);
+                out_img->cr = (uint8_t*)malloc(chroma_size);
+            }
         }
     }
 
@@ -230,8 +380,8 @@ int svt_dec_out_buf(
             + (out_img->origin_x >> sx)) << use_high_bit_depth);
     }
 
-    /* Memcpy to dst buffer */
-    {
+    /* Memcpy to dst buffer, film grain writes it from the recon itself */
+    if (!apply_grain) {
         if (recon_picture_buf->bit_depth == EB_8BIT) {
             uint8_t *src, *dst;
             dst = luma;
@@ -309,26 +459,48 @@ int svt_dec_out_buf(
         }
     }
 
-    if (!dec_handle_ptr->dec_config.skip_film_grain) {
-        /* Need to fill the dst buf with recon data before calling film_grain */
-        aom_film_grain_t *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->
-            film_grain_params;
-        if (film_grain_ptr->apply_grain) {
-
-            switch (recon_picture_buf->bit_depth) {
-            case EB_8BIT:
-                film_grain_ptr->bit_depth = 8;
-                break;
-            case EB_10BIT:
-                film_grain_ptr->bit_depth = 10;
-                break;
-            default:
-                assert(0);
-            }
+    if (apply_grain) {
+        FilmGrainCtxt fg_ctxt;
+        const uint8_t *src_cb = NULL;
+        const uint8_t *src_cr = NULL;
+        const uint8_t *src_luma = recon_picture_buf->buffer_y +
+            ((recon_picture_buf->origin_x + recon_picture_buf->origin_y *
+            recon_picture_buf->stride_y) << use_high_bit_depth);
+
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            src_cb = recon_picture_buf->buffer_cb +
+                (((recon_picture_buf->origin_x >> sx) +
+                (recon_picture_buf->origin_y >> sy) *
+                recon_picture_buf->stride_cb) << use_high_bit_depth);
+            src_cr = recon_picture_buf->buffer_cr +
+                (((recon_picture_buf->origin_x >> sx) +
+                (recon_picture_buf->origin_y >> sy) *
+                recon_picture_buf->stride_cr) << use_high_bit_depth);
+        }
+        else {
+            /* The grain templates are sized as for 4:2:0 */
+            sx = 1;
+            sy = 1;
+        }
 
-            eb_av1_add_film_grain_run(film_grain_ptr, luma, cb, cr, ht, wd, out_img->y_stride,
-                out_img->cb_stride, use_high_bit_depth, sy, sx);
+        switch (recon_picture_buf->bit_depth) {
+        case EB_8BIT:
+            film_grain_ptr->bit_depth = 8;
+            break;
+        case EB_10BIT:
+            film_grain_ptr->bit_depth = 10;
+            break;
+        default:
+            assert(0);
         }
+
+        /* The grain is added to the recon and written to the output */
+        eb_av1_film_grain_init(&fg_ctxt, film_grain_ptr, src_luma, src_cb,
+            src_cr, recon_picture_buf->stride_y, recon_picture_buf->stride_cb,
+            luma, cb, cr, out_img->y_stride, out_img->cb_stride, ht, wd,
+            use_high_bit_depth, sy, sx);
+        dec_mt_add_film_grain(dec_handle_ptr, &fg_ctxt);
+        eb_av1_film_grain_free(&fg_ctxt);
     }
 
     return 1;
@@ -487,18 +659,12 @@ EB_API EbErrorType eb_init_decoder(
     dec_handle_ptr->show_frame          = 0;
     dec_handle_ptr->showable_frame      = 0;
 
-    dec_handle_ptr->dec_config.asm_type = get_cpu_asm_type();
-    setup_rtcd_internal(dec_handle_ptr->dec_config.asm_type);
-    asmSetConvolveAsmTable();
-
-    init_intra_dc_predictors_c_internal();
-
-    asmSetConvolveHbdAsmTable();
-
-    init_intra_predictors_internal();
-    dec_init_intra_predictors_internal();
-
-    av1_init_wedge_masks();
+    dec_handle_ptr->dec_config.asm_type = init_rtcd_tables(get_cpu_asm_type());
+#ifdef _WIN32
+    InitOnceExecuteOnce(&dec_tables_once, init_dec_tables_once, NULL, NULL);
+#else
+    pthread_once(&dec_tables_once, init_dec_tables);
+#endif
 
     /************************************
     * Decoder Memory Init
@@ -526,6 +692,9 @@ EB_API EbErrorType eb_svt_decode_frame(
     uint8_t *data_start = (uint8_t *)data;
     uint8_t *data_end = (uint8_t *)data + data_size;
 
+    /* The previous output picture becomes unavailable */
+    release_out_pic(dec_handle_ptr);
+
     while (data_start < data_end)
     {
         /*TODO : Remove or move. For Test purpose only */
@@ -539,11 +708,22 @@ EB_API EbErrorType eb_svt_decode_frame(
         frame_size = data_end - data_start;
         return_error = decode_multiple_obu(dec_handle_ptr, &data_start, frame_size);
 
-        if (return_error != EB_ErrorNone)
+        /* Running out of application frame buffers is not a stream error */
+        if (return_error != EB_ErrorNone &&
+            return_error != EB_ErrorInsufficientResources)
             assert(0);
 
+        if (dec_handle_ptr->allocate_buffer && dec_handle_ptr->show_frame &&
+            EB_ErrorNone == return_error)
+            hold_out_pic(dec_handle_ptr, dec_handle_ptr->cur_pic_buf[0]);
+
         dec_pic_mgr_update_ref_pic(dec_handle_ptr, (EB_ErrorNone == return_error)
                     ? 1 : 0, dec_handle_ptr->frame_header.refresh_frame_flags);
+        /* A failed frame has nothing to output */
+        if (return_error != EB_ErrorNone) {
+            dec_handle_ptr->cur_pic_buf[0] = NULL;
+            break;
+        }
 
         // Allow extra zero bytes after the frame end
         while (data < data_end) {
@@ -579,7 +759,7 @@ EB_API EbErrorType eb_svt_dec_get_picture(
         return EB_ErrorBadParameter;
 
     EbDecHandle     *dec_handle_ptr = (EbDecHandle   *)svt_dec_component->p_component_private;
-    /* Copy from recon pointer and return! TODO: Should remove the memcpy! */
+    /* Copy from recon pointer and return, unless external frame buffers */
     if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer))
         return_error = EB_DecNoOutputPicture;
     return return_error;
@@ -597,6 +777,11 @@ EB_API EbErrorType eb_deinit_decoder(
     EbErrorType return_error    = EB_ErrorNone;
 
     if (dec_handle_ptr) {
+        /* External frame buffers go back to the application */
+        if (dec_handle_ptr->mem_init_done) {
+            release_out_pic(dec_handle_ptr);
+            dec_pic_mgr_release_ext_frame_bufs(dec_handle_ptr);
+        }
         if (svt_dec_memory_map) {
             // Loop through the ptr table and free all malloc'd pointers per channel
             EbMemoryMapEntry*    memory_entry = svt_dec_memory_map;
@@ -678,10 +863,20 @@ EB_API EbErrorType eb_dec_set_frame_buffer_callbacks(
   eb_release_frame_buffer     release_buffer,
   void                        *priv_data)
 {
-    (void)svt_dec_component;
-    (void)allocate_buffer;
-    (void)release_buffer;
-    (void)priv_data;
+    if (svt_dec_component == NULL)
+        return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->
+                                  p_component_private;
+
+    /* Both or none, set before the picture buffers get allocated */
+    if ((NULL == allocate_buffer) != (NULL == release_buffer) ||
+        dec_handle_ptr->mem_init_done)
+        return EB_ErrorBadParameter;
+
+    dec_handle_ptr->allocate_buffer = allocate_buffer;
+    dec_handle_ptr->release_buffer = release_buffer;
+    dec_handle_ptr->ext_fb_priv_data = priv_data;
 
     return EB_ErrorNone;
 }
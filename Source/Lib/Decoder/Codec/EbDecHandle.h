@@ -58,6 +58,9 @@ typedef struct EbDecPicBuf {
     uint16_t            superres_upscaled_width;
 
     EbPictureBufferDesc *ps_pic_buf;
+    /* Memory of ps_pic_buf when allocated by the application. Taken from
+       the application with the buffer and given back once it is free */
+    EbExtFrameBuf       ext_frame_buf;
 
     FRAME_CONTEXT       final_frm_ctx;
 
@@ -177,6 +180,8 @@ typedef struct EbDecHandle {
     uint8_t showable_frame;  // frame can be used as show existing frame in future
 
     // Thread Handles
+    /** Tile parallel decoding context */
+    void   *pv_dec_mt_ctxt;
 
     // Module Contexts
     void   *pv_parse_ctxt;
@@ -220,6 +225,16 @@ typedef struct EbDecHandle {
     /* TODO: Move to buffer pool. */
     EbDecPicBuf *cur_pic_buf[DEC_MAX_NUM_FRM_PRLL];
 
+    /* External frame buffers : the picture buffers are allocated by the
+       application and the output pictures point to them */
+    eb_allocate_frame_buffer    allocate_buffer;
+    eb_release_frame_buffer     release_buffer;
+    void                        *ext_fb_priv_data;
+    /* Output picture, referenced until the next decode call */
+    EbDecPicBuf                 *out_pic_buf;
+    /* Film grain applied output, allocated by the application */
+    EbExtFrameBuf               grain_frame_buf;
+
     // Callbacks
 
     //DPB + MV, ... buf
@@ -38,12 +38,12 @@ int16_t get_ac_quant(int32_t qindex, int32_t delta, AomBitDepth bit_depth)
 }
 
 // Called in read_frame_header_obu() -> av1_decode_frame_headers_and_setup() -> read_uncompressed_header()
-void setup_segmentation_dequant(EbDecHandle *dec_handle_ptr, EbColorConfig *color_config)
+void setup_segmentation_dequant(DecModCtxt *dec_mod_ctxt, EbColorConfig *color_config)
 {
     (void)color_config;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     SeqHeader *seq_header = &dec_handle_ptr->seq_header;
     FrameHeader *frame_info = &dec_handle_ptr->frame_header;
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle_ptr->pv_dec_mod_ctxt;
     int bit_depth = seq_header->color_config.bit_depth;
     /*int max_segments = frame_info->segmentation_params.segmentation_enabled ?
         MAX_SEGMENTS : 1;*/
@@ -72,10 +72,9 @@ void setup_segmentation_dequant(EbDecHandle *dec_handle_ptr, EbColorConfig *colo
     }
 }
 
-void av1_inverse_qm_init(EbDecHandle *dec_handle_ptr)
+void av1_inverse_qm_init(DecModCtxt *dec_mod_ctxt, SeqHeader *seq_header)
 {
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle_ptr->pv_dec_mod_ctxt;
-    const int num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
+    const int num_planes = av1_num_planes(&seq_header->color_config);
     int q, c;
     uint8_t t;
     int current;
@@ -113,13 +112,13 @@ void av1_init_sb(FrameHeader *frame)
 
 // Called in parse_decode_block()
 // Update de-quantization parameter based on delta qp param
-void update_dequant(EbDecHandle *dec_handle, SBInfo *sb_info)
+void update_dequant(DecModCtxt *dec_mod_ctxt, SBInfo *sb_info)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     int32_t current_qindex;
     int dc_delta_q, ac_delta_q;
     SeqHeader *seq_header = &dec_handle->seq_header;
     FrameHeader *frame = &dec_handle->frame_header;
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle->pv_dec_mod_ctxt;
 
     dec_mod_ctxt->dequants_delta_q = &dec_mod_ctxt->dequants;
     if (frame->delta_q_params.delta_q_present) {
@@ -162,13 +161,13 @@ int get_dqv(const int16_t *dequant, int coeff_idx, const QmVal *iqmatrix) {
     return dqv;
 }
 
-int32_t inverse_quantize(EbDecHandle * dec_handle, PartitionInfo_t *part, ModeInfo_t *mode,
+int32_t inverse_quantize(DecModCtxt *dec_mod_ctxt, PartitionInfo_t *part, ModeInfo_t *mode,
     int32_t *level, int32_t *qcoeffs, TxType tx_type, TxSize tx_size, int plane)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     (void)part;
     SeqHeader *seq = &dec_handle->seq_header;
     FrameHeader *frame = &dec_handle->frame_header;
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle->pv_dec_mod_ctxt;
     const ScanOrder *const scan_order = &av1_scan_orders[tx_size][tx_type]; //get_scan(tx_size, tx_type);
     const int16_t *scan = scan_order->scan;
     const int32_t max_value = (1 << (7 + seq->color_config.bit_depth)) - 1;
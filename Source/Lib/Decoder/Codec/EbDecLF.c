@@ -638,7 +638,7 @@ static void dec_update_sharpness(LoopFilterInfoN *lfi, int32_t sharpness_lvl) {
 }
 
 /*Update the loop filter for the current frame */
-static void dec_av1_loop_filter_frame_init(FrameHeader *frm_hdr,
+void dec_av1_loop_filter_frame_init(FrameHeader *frm_hdr,
     LoopFilterInfoN *lf_info, int32_t plane_start, int32_t plane_end)
 {
     int32_t filt_lvl[MAX_MB_PLANE], filt_lvl_r[MAX_MB_PLANE];
@@ -721,28 +721,59 @@ static void dec_av1_loop_filter_frame_init(FrameHeader *frm_hdr,
     }
 }
 
-/*Frame level function to trigger loop filter for each superblock*/
-void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr,
+/*SB row level function to trigger loop filter for each superblock of the row.
+  dec_av1_loop_filter_frame_init should be called once per frame before*/
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr,
     EbPictureBufferDesc *recon_picture_buf, LFCtxt *lf_ctxt,
-    int32_t plane_start, int32_t plane_end)
+    uint32_t y_lcu_index, int32_t plane_start, int32_t plane_end)
 {
     FrameHeader *frm_hdr = &dec_handle_ptr->frame_header;
     SeqHeader *seq_header = &dec_handle_ptr->seq_header;
     uint8_t     sb_size_Log2 = seq_header->sb_size_log2;
     uint32_t    x_lcu_index;
-    uint32_t    y_lcu_index;
     uint32_t    sb_origin_x;
     uint32_t    sb_origin_y;
     EbBool      endOfRowFlag;
 
     LoopFilterInfoN *lf_info = &lf_ctxt->lf_info;
-    lf_ctxt->delta_lf_stride = dec_handle_ptr->master_frame_buf.sb_cols *
-                               FRAME_LF_COUNT;
 
     int32_t sb_size_w = block_size_wide[seq_header->sb_size];
-    int32_t sb_size_h = block_size_high[seq_header->sb_size];
     uint32_t picture_width_in_sb    =
         (seq_header->max_frame_width + sb_size_w - 1) / sb_size_w;
+
+    for (x_lcu_index = 0; x_lcu_index < picture_width_in_sb; ++x_lcu_index) {
+        sb_origin_x = x_lcu_index << sb_size_Log2;
+        sb_origin_y = y_lcu_index << sb_size_Log2;
+        endOfRowFlag = (x_lcu_index == picture_width_in_sb - 1) ?
+            EB_TRUE : EB_FALSE;
+
+        MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
+        CurFrameBuf    *frame_buf = &master_frame_buf->cur_frame_bufs[0];
+
+        SBInfo  *sb_info = frame_buf->sb_info + (
+            ((y_lcu_index * master_frame_buf->sb_cols) + x_lcu_index));
+
+        /*LF function for a SB*/
+        dec_loop_filter_sb(frm_hdr, seq_header, recon_picture_buf,
+            lf_ctxt, lf_info, sb_origin_y >> 2, sb_origin_x >> 2,
+            plane_start, plane_end, endOfRowFlag, sb_info->sb_delta_lf);
+    }
+}
+
+/*Frame level function to trigger loop filter for each superblock*/
+void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr,
+    EbPictureBufferDesc *recon_picture_buf, LFCtxt *lf_ctxt,
+    int32_t plane_start, int32_t plane_end)
+{
+    FrameHeader *frm_hdr = &dec_handle_ptr->frame_header;
+    SeqHeader *seq_header = &dec_handle_ptr->seq_header;
+    uint32_t    y_lcu_index;
+
+    LoopFilterInfoN *lf_info = &lf_ctxt->lf_info;
+    lf_ctxt->delta_lf_stride = dec_handle_ptr->master_frame_buf.sb_cols *
+                               FRAME_LF_COUNT;
+
+    int32_t sb_size_h = block_size_high[seq_header->sb_size];
     uint32_t picture_height_in_sb   =
         (seq_header->max_frame_height + sb_size_h- 1) / sb_size_h;
 
@@ -750,25 +781,7 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr,
 
     /*Loop over a frame : tregger dec_loop_filter_sb for each SB*/
     for (y_lcu_index = 0; y_lcu_index < picture_height_in_sb; ++y_lcu_index) {
-        for (x_lcu_index = 0; x_lcu_index < picture_width_in_sb; ++x_lcu_index) {
-            sb_origin_x = x_lcu_index << sb_size_Log2;
-            sb_origin_y = y_lcu_index << sb_size_Log2;
-            endOfRowFlag = (x_lcu_index == picture_width_in_sb - 1) ?
-                EB_TRUE : EB_FALSE;
-
-            MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
-            CurFrameBuf    *frame_buf = &master_frame_buf->cur_frame_bufs[0];
-
-            SBInfo  *sb_info = frame_buf->sb_info + (
-                ((y_lcu_index * master_frame_buf->sb_cols) + x_lcu_index));
-
-            /*sb_info->sb_delta_lf = frame_buf->delta_lf + (FRAME_LF_COUNT *
-                ((y_lcu_index * master_frame_buf->sb_cols) + x_lcu_index));*/
-
-            /*LF function for a SB*/
-            dec_loop_filter_sb(frm_hdr, seq_header, recon_picture_buf,
-                lf_ctxt, lf_info, sb_origin_y >> 2, sb_origin_x >> 2,
-                plane_start, plane_end, endOfRowFlag, sb_info->sb_delta_lf);
-        }
+        dec_av1_loop_filter_sb_row(dec_handle_ptr, recon_picture_buf, lf_ctxt,
+            y_lcu_index, plane_start, plane_end);
     }
 }
@@ -66,4 +66,11 @@ void dec_av1_loop_filter_frame(
     EbPictureBufferDesc *recon_picture_buf, LFCtxt *lf_ctxt,
     int32_t plane_start, int32_t plane_end);
 
+void dec_av1_loop_filter_frame_init(FrameHeader *frm_hdr,
+    LoopFilterInfoN *lf_info, int32_t plane_start, int32_t plane_end);
+
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr,
+    EbPictureBufferDesc *recon_picture_buf, LFCtxt *lf_ctxt,
+    uint32_t y_lcu_index, int32_t plane_start, int32_t plane_end);
+
 #endif  // EbDecLF_h
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 
 #include "EbDefinitions.h"
+#include "EbThreads.h"
 #include "EbPictureBufferDesc.h"
 
 #include "EbSvtAv1Dec.h"
@@ -25,6 +26,7 @@
 
 #include "EbDecPicMgr.h"
 #include "EbDecLF.h"
+#include "EbDecMt.h"
 
 /*TODO: Remove and harmonize with encoder. Globals prevent harmonization now! */
 /*****************************************
@@ -269,7 +271,7 @@ static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
     frame_mi_map->sb_cols = sb_cols;
     frame_mi_map->sb_rows = sb_rows;
     frame_mi_map->mi_cols_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
-    frame_mi_map->mi_rows_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
+    frame_mi_map->mi_rows_algnsb = sb_rows * (1 << (sb_size_log2 - MI_SIZE_LOG2));
     /* SBInfo pointers for entire frame */
     EB_MALLOC_DEC(SBInfo**, frame_mi_map->pps_sb_info,
         sb_rows * sb_cols * sizeof(SBInfo *), EB_N_PTR);
@@ -315,12 +317,16 @@ static EbErrorType init_master_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
 }
 
 /*TODO: Move to module files */
-static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr) {
+static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr,
+                                       void **pv_parse_ctxt)
+{
     EbErrorType return_error = EB_ErrorNone;
 
-    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_parse_ctxt, sizeof(ParseCtxt), EB_N_PTR);
+    EB_MALLOC_DEC(void *, *pv_parse_ctxt, sizeof(ParseCtxt), EB_N_PTR);
+
+    ParseCtxt *parse_ctx = (ParseCtxt*)*pv_parse_ctxt;
 
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle_ptr->pv_parse_ctxt;
+    parse_ctx->dec_handle_ptr = (void *)dec_handle_ptr;
 
     SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
 
@@ -374,15 +380,16 @@ static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr) {
 }
 
 /*TODO: Move to module files */
-static EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr)
+static EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr,
+                                     void **pv_dec_mod_ctxt)
 {
     EbErrorType return_error = EB_ErrorNone;
     SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
     EbColorConfig *color_config = &seq_header->color_config;
 
-    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_dec_mod_ctxt, sizeof(DecModCtxt), EB_N_PTR);
+    EB_MALLOC_DEC(void *, *pv_dec_mod_ctxt, sizeof(DecModCtxt), EB_N_PTR);
 
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle_ptr->pv_dec_mod_ctxt;
+    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)*pv_dec_mod_ctxt;
 
     dec_mod_ctxt->dec_handle_ptr = (void *)dec_handle_ptr;
 
@@ -395,7 +402,7 @@ static EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr)
 
     EB_MALLOC_DEC(int32_t*, dec_mod_ctxt->sb_iquant_ptr,
         iq_size * sizeof(int32_t), EB_N_PTR);
-    av1_inverse_qm_init(dec_handle_ptr);
+    av1_inverse_qm_init(dec_mod_ctxt, seq_header);
 
     return return_error;
 }
@@ -474,8 +481,127 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     // expects width to be multiple of 16 for filtering.
     lr_ctxt->dst_stride = ALIGN_POWER_OF_TWO(frame_width, 4);
 
-    EB_MALLOC_DEC(uint8_t *, lr_ctxt->dst, lr_ctxt->dst_stride *
-        (frame_height) * sizeof(uint8_t) << use_highbd, EB_N_PTR);
+    const int sub_y = dec_handle_ptr->seq_header.color_config.subsampling_y;
+    const int plane_h[MAX_MB_PLANE] = { frame_height,
+        (frame_height + sub_y) >> sub_y, (frame_height + sub_y) >> sub_y };
+    int dst_h = 0;
+    for (int plane = 0; plane < num_planes; plane++)
+        dst_h += plane_h[plane];
+
+    uint8_t *dst;
+    EB_MALLOC_DEC(uint8_t *, dst, lr_ctxt->dst_stride *
+        dst_h * sizeof(uint8_t) << use_highbd, EB_N_PTR);
+    for (int plane = 0; plane < num_planes; plane++) {
+        lr_ctxt->dst[plane] = dst;
+        dst += (lr_ctxt->dst_stride * plane_h[plane]) << use_highbd;
+    }
+
+    return return_error;
+}
+
+/* Contexts of the tile decoding threads. Thread 0 is the calling thread
+   and works on the module contexts of the decoder handle */
+static EbErrorType init_dec_mt_ctxt(EbDecHandle  *dec_handle_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
+    EbColorConfig *color_config = &seq_header->color_config;
+    CurFrameBuf *cur_frame_buf = &dec_handle_ptr->master_frame_buf.
+                                    cur_frame_bufs[0];
+
+    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_dec_mt_ctxt, sizeof(DecMtCtxt),
+                  EB_N_PTR);
+
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    uint32_t num_threads = dec_get_num_threads(dec_handle_ptr);
+
+    dec_mt_ctxt->num_threads = num_threads;
+    dec_mt_ctxt->num_tile_jobs = 0;
+    dec_mt_ctxt->next_tile_job = 0;
+    dec_mt_ctxt->status = EB_ErrorNone;
+
+    EB_MALLOC_DEC(DecTileJob *, dec_mt_ctxt->tile_jobs,
+        MAX_TILE_ROWS * MAX_TILE_COLS * sizeof(DecTileJob), EB_N_PTR);
+    EB_MALLOC_DEC(DecThreadCtxt *, dec_mt_ctxt->thread_ctxt,
+        num_threads * sizeof(DecThreadCtxt), EB_N_PTR);
+
+    /* (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
+    int32_t num_mis_in_sb = dec_handle_ptr->master_frame_buf.num_mis_in_sb;
+    int32_t y_coeff_size = num_mis_in_sb * (16 + 1) * sizeof(int32_t);
+    int32_t uv_coeff_size = y_coeff_size >>
+        (color_config->subsampling_x + color_config->subsampling_y);
+
+    for (uint32_t i = 0; i < num_threads; i++) {
+        DecThreadCtxt *thread_ctxt = &dec_mt_ctxt->thread_ctxt[i];
+
+        thread_ctxt->dec_handle_ptr = (void *)dec_handle_ptr;
+        thread_ctxt->tile_start_semaphore = NULL;
+        if (0 == i) {
+            thread_ctxt->pv_parse_ctxt = dec_handle_ptr->pv_parse_ctxt;
+            thread_ctxt->pv_dec_mod_ctxt = dec_handle_ptr->pv_dec_mod_ctxt;
+            for (int plane = 0; plane < MAX_MB_PLANE; plane++)
+                thread_ctxt->sb_coeff[plane] = cur_frame_buf->coeff[plane];
+            continue;
+        }
+
+        return_error |= init_parse_context(dec_handle_ptr,
+                                           &thread_ctxt->pv_parse_ctxt);
+        return_error |= init_dec_mod_ctxt(dec_handle_ptr,
+                                          &thread_ctxt->pv_dec_mod_ctxt);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+
+        EB_MALLOC_DEC(int32_t*, thread_ctxt->sb_coeff[AOM_PLANE_Y],
+            y_coeff_size, EB_N_PTR);
+        EB_MALLOC_DEC(int32_t*, thread_ctxt->sb_coeff[AOM_PLANE_U],
+            uv_coeff_size, EB_N_PTR);
+        EB_MALLOC_DEC(int32_t*, thread_ctxt->sb_coeff[AOM_PLANE_V],
+            uv_coeff_size, EB_N_PTR);
+
+        EB_CREATE_SEMAPHORE_DEC(thread_ctxt->tile_start_semaphore, 0,
+                                MAX_TILE_ROWS * MAX_TILE_COLS);
+    }
+
+    /* SB row wavefront : frame sized coeff buffers and row progress */
+    dec_mt_ctxt->row_mt = EB_FALSE;
+    if (num_threads > 1) {
+        int32_t sb_rows = dec_handle_ptr->master_frame_buf.sb_rows;
+        int32_t num_sb = dec_handle_ptr->master_frame_buf.sb_cols * sb_rows;
+
+        EB_MALLOC_DEC(int32_t*, dec_mt_ctxt->frame_coeff[AOM_PLANE_Y],
+            num_sb * y_coeff_size, EB_N_PTR);
+        EB_MALLOC_DEC(int32_t*, dec_mt_ctxt->frame_coeff[AOM_PLANE_U],
+            num_sb * uv_coeff_size, EB_N_PTR);
+        EB_MALLOC_DEC(int32_t*, dec_mt_ctxt->frame_coeff[AOM_PLANE_V],
+            num_sb * uv_coeff_size, EB_N_PTR);
+
+        EB_MALLOC_DEC(EbHandle*, dec_mt_ctxt->sb_row_parse_sem,
+            sb_rows * sizeof(EbHandle), EB_N_PTR);
+        EB_MALLOC_DEC(EbHandle*, dec_mt_ctxt->sb_row_recon_sem,
+            sb_rows * sizeof(EbHandle), EB_N_PTR);
+        for (int32_t i = 0; i < sb_rows; i++) {
+            EB_CREATE_SEMAPHORE_DEC(dec_mt_ctxt->sb_row_parse_sem[i], 0,
+                dec_handle_ptr->master_frame_buf.sb_cols);
+            EB_CREATE_SEMAPHORE_DEC(dec_mt_ctxt->sb_row_recon_sem[i], 0,
+                dec_handle_ptr->master_frame_buf.sb_cols);
+        }
+    }
+
+    EB_CREATE_MUTEX_DEC(dec_mt_ctxt->tile_job_mutex);
+    EB_CREATE_SEMAPHORE_DEC(dec_mt_ctxt->tile_done_semaphore, 0, num_threads);
+
+    dec_mt_ctxt->post_filter = EB_FALSE;
+    dec_mt_ctxt->film_grain = EB_FALSE;
+    dec_mt_ctxt->fg_ctxt = NULL;
+    EB_CREATE_SEMAPHORE_DEC(dec_mt_ctxt->pf_ctxt.wait_semaphore, 0,
+                            num_threads);
+
+    /* Threads last, so that they are destroyed first on deinit */
+    for (uint32_t i = 1; i < num_threads; i++) {
+        EbHandle thread_handle;
+        EB_CREATE_THREAD_DEC(thread_handle, dec_tile_thread,
+                             &dec_mt_ctxt->thread_ctxt[i]);
+    }
 
     return return_error;
 }
@@ -489,9 +615,11 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     /* init module ctxts */
     return_error |= dec_pic_mgr_init(dec_handle_ptr);
 
-    return_error |= init_parse_context(dec_handle_ptr);
+    return_error |= init_parse_context(dec_handle_ptr,
+                                       &dec_handle_ptr->pv_parse_ctxt);
 
-    return_error |= init_dec_mod_ctxt(dec_handle_ptr);
+    return_error |= init_dec_mod_ctxt(dec_handle_ptr,
+                                      &dec_handle_ptr->pv_dec_mod_ctxt);
 
     return_error |= init_lf_ctxt(dec_handle_ptr);
 
@@ -500,6 +628,9 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     /* init frame buffers */
     return_error |= init_master_frame_ctxt(dec_handle_ptr);
 
+    /* init tile threads, uses the contexts and frame buffers above */
+    return_error |= init_dec_mt_ctxt(dec_handle_ptr);
+
     /* Initialize the references to NULL */
     for (int i = 0; i < REF_FRAMES; i++) {
         dec_handle_ptr->ref_frame_map[i] = NULL;
@@ -73,6 +73,31 @@ extern uint32_t                         svt_dec_lib_malloc_count;
         svt_dec_lib_malloc_count++; \
     }
 
+/* Registers a thread / semaphore / mutex handle in the memory map
+   so that it gets destroyed in eb_deinit_decoder */
+#define EB_ADD_HANDLE_DEC(pointer, pointer_class) \
+    if (pointer == (EbHandle)EB_NULL) \
+        return EB_ErrorInsufficientResources; \
+    else { \
+        EbMemoryMapEntry *node = malloc(sizeof(EbMemoryMapEntry)); \
+        if (node == (EbMemoryMapEntry*)EB_NULL) return EB_ErrorInsufficientResources; \
+        node->ptr_type         = pointer_class; \
+        node->ptr              = (EbPtr)pointer;\
+        node->prev_entry       = (EbPtr)svt_dec_memory_map;   \
+        svt_dec_memory_map     = node;          \
+        (*svt_dec_memory_map_index)++; \
+        *svt_dec_total_lib_memory += sizeof(EbMemoryMapEntry); \
+    }
+#define EB_CREATE_SEMAPHORE_DEC(pointer, initial_count, max_count) \
+    pointer = eb_create_semaphore(initial_count, max_count); \
+    EB_ADD_HANDLE_DEC(pointer, EB_SEMAPHORE)
+#define EB_CREATE_MUTEX_DEC(pointer) \
+    pointer = eb_create_mutex(); \
+    EB_ADD_HANDLE_DEC(pointer, EB_MUTEX)
+#define EB_CREATE_THREAD_DEC(pointer, thread_function, thread_context) \
+    pointer = eb_create_thread(thread_function, thread_context); \
+    EB_ADD_HANDLE_DEC(pointer, EB_THREAD)
+
 EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
     EbPtr  *object_dbl_ptr,
     EbPtr   object_init_data_ptr);
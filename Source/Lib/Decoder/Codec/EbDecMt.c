@@ -0,0 +1,624 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Contains the tile parallel decoding and post filter pipeline functions
+
+/**************************************
+ * Includes
+ **************************************/
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+
+#include "EbSvtAv1Dec.h"
+#include "EbDecHandle.h"
+#include "EbDecProcessFrame.h"
+#include "EbDecInverseQuantize.h"
+#include "EbDecUtils.h"
+#include "EbDecLF.h"
+#include "EbDecRestoration.h"
+#include "EbDecMt.h"
+
+/* Number of tile decoding threads, including the calling thread */
+uint32_t dec_get_num_threads(EbDecHandle *dec_handle_ptr)
+{
+    uint32_t num_threads = dec_handle_ptr->dec_config.threads;
+
+    if (0 == num_threads) {
+#ifdef _WIN32
+        SYSTEM_INFO sysinfo;
+        GetSystemInfo(&sysinfo);
+        num_threads = sysinfo.dwNumberOfProcessors;
+#else
+        num_threads = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    }
+    return AOMMAX(num_threads, 1);
+}
+
+/* Picks tile jobs of the current tile group until none is left */
+static void decode_tile_jobs(DecMtCtxt *dec_mt_ctxt,
+                             DecThreadCtxt *thread_ctxt)
+{
+    for (;;) {
+        eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+        int32_t job_idx = dec_mt_ctxt->next_tile_job++;
+        eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+        if (job_idx >= dec_mt_ctxt->num_tile_jobs)
+            break;
+
+        EbErrorType status = decode_tile(thread_ctxt,
+                                         &dec_mt_ctxt->tile_jobs[job_idx]);
+        if (status != EB_ErrorNone) {
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            if (dec_mt_ctxt->status == EB_ErrorNone)
+                dec_mt_ctxt->status = status;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+        }
+    }
+}
+
+/* Reconstructs SB rows of the row_mt tile until none is left. SB (r, c)
+   waits for its parse and for SB (r - 1, c + 1) to be reconstructed */
+static void decode_sb_rows(DecMtCtxt *dec_mt_ctxt,
+                           DecThreadCtxt *thread_ctxt)
+{
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)thread_ctxt->dec_handle_ptr;
+    DecModCtxt *dec_mod_ctxt = (DecModCtxt *)thread_ctxt->pv_dec_mod_ctxt;
+    SeqHeader *seq_header = &dec_handle_ptr->seq_header;
+    MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
+    CurFrameBuf *frame_buf = &master_frame_buf->cur_frame_bufs[0];
+    TileInfo *tile_info = &dec_mt_ctxt->row_mt_tile_info;
+
+    int32_t sb_mi_size = seq_header->sb_mi_size;
+    int32_t sb_row_start = tile_info->mi_row_start / sb_mi_size;
+    int32_t sb_row_end = (tile_info->mi_row_end + sb_mi_size - 1) / sb_mi_size;
+    int32_t sb_col_start = tile_info->mi_col_start / sb_mi_size;
+    int32_t num_sb_cols = (tile_info->mi_col_end + sb_mi_size - 1) /
+                          sb_mi_size - sb_col_start;
+
+    for (;;) {
+        eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+        int32_t sb_row = dec_mt_ctxt->next_recon_sb_row++;
+        eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+        if (sb_row >= sb_row_end)
+            break;
+
+        cfl_init(&dec_mod_ctxt->cfl_ctx, &seq_header->color_config);
+        dec_mod_ctxt->cur_tile_info = tile_info;
+
+        int32_t above_sb_done = 0;
+        for (int32_t i = 0; i < num_sb_cols; i++) {
+            eb_block_on_semaphore(dec_mt_ctxt->sb_row_parse_sem[sb_row]);
+            if (sb_row > sb_row_start) {
+                int32_t above_sb_needed = AOMMIN(i + 2, num_sb_cols);
+                for (; above_sb_done < above_sb_needed; above_sb_done++)
+                    eb_block_on_semaphore(dec_mt_ctxt->sb_row_recon_sem[sb_row]);
+            }
+
+            /* Parse failures still post, so that all rows drain */
+            if (dec_mt_ctxt->status == EB_ErrorNone) {
+                int32_t sb_col = sb_col_start + i;
+                SBInfo *sb_info = frame_buf->sb_info +
+                    (sb_row * master_frame_buf->sb_cols) + sb_col;
+
+                dec_mod_ctxt->cur_coeff[AOM_PLANE_Y] = sb_info->sb_coeff[AOM_PLANE_Y];
+                dec_mod_ctxt->cur_coeff[AOM_PLANE_U] = sb_info->sb_coeff[AOM_PLANE_U];
+                dec_mod_ctxt->cur_coeff[AOM_PLANE_V] = sb_info->sb_coeff[AOM_PLANE_V];
+
+                decode_super_block(dec_mod_ctxt, sb_row * sb_mi_size,
+                                   sb_col * sb_mi_size, sb_info);
+            }
+
+            if (sb_row + 1 < sb_row_end)
+                eb_post_semaphore(dec_mt_ctxt->sb_row_recon_sem[sb_row + 1]);
+        }
+    }
+}
+
+/* Parses the single tile job on the calling thread and reconstructs its
+   SB rows as a wavefront on all the threads */
+static EbErrorType decode_tile_rows(EbDecHandle *dec_handle_ptr,
+                                    DecMtCtxt *dec_mt_ctxt)
+{
+    FrameHeader *frame_header = &dec_handle_ptr->frame_header;
+    TilesInfo *tiles_info = &frame_header->tiles_info;
+    DecTileJob *tile_job = &dec_mt_ctxt->tile_jobs[0];
+    TileInfo *tile_info = &dec_mt_ctxt->row_mt_tile_info;
+    int32_t sb_mi_size = dec_handle_ptr->seq_header.sb_mi_size;
+
+    svt_tile_init(tile_info, frame_header,
+                  tile_job->tile_num / tiles_info->tile_cols,
+                  tile_job->tile_num % tiles_info->tile_cols);
+
+    dec_mt_ctxt->row_mt = EB_TRUE;
+    dec_mt_ctxt->next_recon_sb_row = tile_info->mi_row_start / sb_mi_size;
+
+    for (uint32_t i = 1; i < dec_mt_ctxt->num_threads; i++)
+        eb_post_semaphore(dec_mt_ctxt->thread_ctxt[i].tile_start_semaphore);
+
+    EbErrorType status = decode_tile(&dec_mt_ctxt->thread_ctxt[0], tile_job);
+    if (status != EB_ErrorNone) {
+        /* Reader init failed before any SB got parsed */
+        dec_mt_ctxt->status = status;
+        int32_t sb_row_end = (tile_info->mi_row_end + sb_mi_size - 1) /
+                             sb_mi_size;
+        int32_t num_sb_cols = (tile_info->mi_col_end + sb_mi_size - 1) /
+            sb_mi_size - tile_info->mi_col_start / sb_mi_size;
+        for (int32_t sb_row = tile_info->mi_row_start / sb_mi_size;
+             sb_row < sb_row_end; sb_row++)
+        {
+            for (int32_t i = 0; i < num_sb_cols; i++)
+                eb_post_semaphore(dec_mt_ctxt->sb_row_parse_sem[sb_row]);
+        }
+    }
+
+    /* Parsing done, join the reconstruction */
+    decode_sb_rows(dec_mt_ctxt, &dec_mt_ctxt->thread_ctxt[0]);
+
+    for (uint32_t i = 1; i < dec_mt_ctxt->num_threads; i++)
+        eb_block_on_semaphore(dec_mt_ctxt->tile_done_semaphore);
+
+    dec_mt_ctxt->row_mt = EB_FALSE;
+
+    return dec_mt_ctxt->status;
+}
+
+/* Luma rows above which the LF output is final. The top edge of an SB row
+   modifies up to 7 rows of the SB row above */
+static int32_t pf_lf_final_rows(EbDecHandle *dec_handle_ptr,
+                                DecPostFilterCtxt *pf_ctxt, int32_t lf_done)
+{
+    if (lf_done == pf_ctxt->lf_rows)
+        return INT32_MAX;
+    return lf_done * (dec_handle_ptr->seq_header.sb_mi_size << MI_SIZE_LOG2) - 8;
+}
+
+/* Rows of the plane above which the CDEF output is final and padded */
+static int32_t pf_cdef_final_rows(DecPostFilterCtxt *pf_ctxt, int32_t sy)
+{
+    if (pf_ctxt->cdef_done == pf_ctxt->cdef_rows)
+        return INT32_MAX;
+    return (pf_ctxt->cdef_done * MI_SIZE_64X64 << MI_SIZE_LOG2) >> sy;
+}
+
+static EbBool pf_cdef_ready(EbDecHandle *dec_handle_ptr,
+                            DecPostFilterCtxt *pf_ctxt)
+{
+    int32_t fbr = pf_ctxt->cdef_done;
+    int32_t lf_final = pf_lf_final_rows(dec_handle_ptr, pf_ctxt,
+                                        pf_ctxt->lf_done);
+
+    /* The filter block row reads CDEF_VBORDER rows below it, twice as many
+       luma rows for subsampled chroma. The deblocked boundary lines of the
+       stripe starting in it have to be saved before it gets filtered */
+    if (lf_final < ((fbr + 1) * MI_SIZE_64X64 << MI_SIZE_LOG2) +
+        2 * CDEF_VBORDER)
+        return EB_FALSE;
+    if (pf_ctxt->save_boundaries &&
+        pf_ctxt->stripes_saved < AOMMIN(fbr + 2, pf_ctxt->num_stripes))
+        return EB_FALSE;
+    return EB_TRUE;
+}
+
+/* Returns the first plane whose next LR unit row is ready, -1 if none */
+static int32_t pf_lr_ready_plane(EbDecHandle *dec_handle_ptr,
+                                 DecPostFilterCtxt *pf_ctxt)
+{
+    int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.
+                                        color_config);
+    RestorationTileLimits limits;
+
+    for (int32_t plane = 0; plane < num_planes; plane++) {
+        if (pf_ctxt->lr_done[plane] == pf_ctxt->lr_rows[plane])
+            continue;
+
+        int32_t sy = plane ? dec_handle_ptr->seq_header.color_config.
+                             subsampling_y : 0;
+        dec_av1_lr_unit_row_limits(dec_handle_ptr, plane,
+                                   pf_ctxt->lr_done[plane], &limits);
+        /* The unit row reads and temporarily overwrites 3 rows below it */
+        if (limits.v_end + RESTORATION_BORDER <=
+            pf_cdef_final_rows(pf_ctxt, sy))
+            return plane;
+    }
+    return -1;
+}
+
+static void pf_lf_row(EbDecHandle *dec_handle_ptr, DecPostFilterCtxt *pf_ctxt,
+                      int32_t sb_row, int32_t stripes_saved,
+                      int32_t *stripes_done)
+{
+    if (pf_ctxt->do_lf) {
+        dec_av1_loop_filter_sb_row(dec_handle_ptr,
+            dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+            dec_handle_ptr->pv_lf_ctxt, sb_row, AOM_PLANE_Y, MAX_MB_PLANE);
+    }
+
+    /* Deblocked lines around a stripe boundary, before CDEF overwrites them */
+    int32_t lf_final = pf_lf_final_rows(dec_handle_ptr, pf_ctxt, sb_row + 1);
+    if (pf_ctxt->save_boundaries) {
+        while (stripes_saved < pf_ctxt->num_stripes &&
+               (stripes_saved + 1) * RESTORATION_PROC_UNIT_SIZE -
+               RESTORATION_UNIT_OFFSET + RESTORATION_CTX_VERT <= lf_final)
+        {
+            dec_av1_loop_restoration_save_stripe_boundary_lines(
+                dec_handle_ptr, stripes_saved, 0);
+            stripes_saved++;
+        }
+    }
+    else
+        stripes_saved = pf_ctxt->num_stripes;
+    *stripes_done = stripes_saved;
+}
+
+static void pf_cdef_row(EbDecHandle *dec_handle_ptr, DecPostFilterCtxt *pf_ctxt,
+                        int32_t fbr)
+{
+    EbPictureBufferDesc *recon_picture_buf =
+        dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+
+    if (pf_ctxt->do_cdef) {
+        if (recon_picture_buf->bit_depth == EB_8BIT)
+            svt_cdef_fb_row(dec_handle_ptr, &pf_ctxt->cdef_ctxt, fbr);
+        else
+            svt_cdef_fb_row_hbd(dec_handle_ptr, &pf_ctxt->cdef_ctxt, fbr);
+    }
+
+    if (!pf_ctxt->do_lr)
+        return;
+
+    /* CDEF lines at the top and bottom of the frame */
+    if (pf_ctxt->save_boundaries) {
+        int32_t last_stripe = (fbr == pf_ctxt->cdef_rows - 1) ?
+                              pf_ctxt->num_stripes - 1 : fbr;
+        for (int32_t stripe = fbr; stripe <= last_stripe; stripe++)
+            dec_av1_loop_restoration_save_stripe_boundary_lines(
+                dec_handle_ptr, stripe, 1);
+    }
+
+    /* Padded bits are required for filtering pixel around frame boundary */
+    uint32_t frame_height = dec_handle_ptr->frame_header.frame_size.
+                            frame_height;
+    uint32_t y0 = fbr * MI_SIZE_64X64 << MI_SIZE_LOG2;
+    uint32_t y1 = AOMMIN(y0 + (MI_SIZE_64X64 << MI_SIZE_LOG2),
+                         frame_height);
+    pad_pic_rows(recon_picture_buf, &dec_handle_ptr->frame_header, y0, y1);
+}
+
+static void pf_lr_row(EbDecHandle *dec_handle_ptr, DecPostFilterCtxt *pf_ctxt,
+                      int32_t plane, int32_t unit_row)
+{
+    dec_av1_loop_restoration_filter_row(dec_handle_ptr, plane, unit_row,
+                                        !pf_ctxt->do_cdef);
+
+    /* The unit row above is no longer read unrestored */
+    if (unit_row > 0)
+        dec_av1_loop_restoration_copy_row(dec_handle_ptr, plane, unit_row - 1);
+    if (unit_row == pf_ctxt->lr_rows[plane] - 1)
+        dec_av1_loop_restoration_copy_row(dec_handle_ptr, plane, unit_row);
+}
+
+/* Rows of the plane above which the output of the last stage is final. A
+   restored unit row is copied back once the unit row below is restored */
+static int32_t pf_plane_final_rows(EbDecHandle *dec_handle_ptr,
+                                   DecPostFilterCtxt *pf_ctxt, int32_t plane)
+{
+    int32_t sy = plane ? dec_handle_ptr->seq_header.color_config.
+                         subsampling_y : 0;
+    int32_t lr_done = pf_ctxt->lr_done[plane];
+    RestorationTileLimits limits;
+
+    if (0 == pf_ctxt->lr_rows[plane])
+        return pf_cdef_final_rows(pf_ctxt, sy);
+    if (lr_done == pf_ctxt->lr_rows[plane])
+        return INT32_MAX;
+    if (lr_done < 2)
+        return 0;
+    dec_av1_lr_unit_row_limits(dec_handle_ptr, plane, lr_done - 2, &limits);
+    return limits.v_end;
+}
+
+static EbBool pf_pad_ready(EbDecHandle *dec_handle_ptr,
+                           DecPostFilterCtxt *pf_ctxt)
+{
+    int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.
+                                        color_config);
+    int32_t frame_height = dec_handle_ptr->frame_header.frame_size.
+                           frame_height;
+    int32_t y1 = AOMMIN((pf_ctxt->pad_done + 1) * MI_SIZE_64X64 <<
+                        MI_SIZE_LOG2, frame_height);
+
+    /* The last row pads below the frame, all of it has to be final */
+    for (int32_t plane = 0; plane < num_planes; plane++) {
+        int32_t sy = plane ? dec_handle_ptr->seq_header.color_config.
+                             subsampling_y : 0;
+        int32_t rows = (y1 == frame_height) ? INT32_MAX : y1 >> sy;
+        if (pf_plane_final_rows(dec_handle_ptr, pf_ctxt, plane) < rows)
+            return EB_FALSE;
+    }
+    return EB_TRUE;
+}
+
+static void pf_pad_row(EbDecHandle *dec_handle_ptr, int32_t row)
+{
+    EbDecPicBuf *cur_pic_buf = dec_handle_ptr->cur_pic_buf[0];
+    uint32_t frame_height = dec_handle_ptr->frame_header.frame_size.
+                            frame_height;
+    uint32_t y0 = row * MI_SIZE_64X64 << MI_SIZE_LOG2;
+    uint32_t y1 = AOMMIN(y0 + (MI_SIZE_64X64 << MI_SIZE_LOG2),
+                         frame_height);
+
+    pad_pic_rows(cur_pic_buf->ps_pic_buf, &dec_handle_ptr->frame_header,
+                 y0, y1);
+}
+
+/* Runs the rows of the post filter stages until all of them are done.
+   PAD rows are picked first, then LR, CDEF and LF, so that the rows of
+   the frame leave the pipeline as early as possible */
+static void post_filter_rows(EbDecHandle *dec_handle_ptr,
+                             DecMtCtxt *dec_mt_ctxt)
+{
+    DecPostFilterCtxt *pf_ctxt = &dec_mt_ctxt->pf_ctxt;
+    int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.
+                                        color_config);
+
+    eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+    for (;;) {
+        EbBool lr_pending = EB_FALSE;
+        for (int32_t plane = 0; plane < num_planes; plane++)
+            lr_pending |= pf_ctxt->lr_done[plane] < pf_ctxt->lr_rows[plane];
+        if (!lr_pending && pf_ctxt->pad_done == pf_ctxt->cdef_rows &&
+            pf_ctxt->cdef_done == pf_ctxt->cdef_rows &&
+            pf_ctxt->lf_done == pf_ctxt->lf_rows)
+            break;
+
+        int32_t lr_plane = pf_ctxt->lr_busy ? -1 :
+            pf_lr_ready_plane(dec_handle_ptr, pf_ctxt);
+
+        if (!pf_ctxt->pad_busy && pf_ctxt->pad_done < pf_ctxt->cdef_rows &&
+            pf_pad_ready(dec_handle_ptr, pf_ctxt))
+        {
+            int32_t row = pf_ctxt->pad_done;
+            pf_ctxt->pad_busy = EB_TRUE;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+            pf_pad_row(dec_handle_ptr, row);
+
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            pf_ctxt->pad_done++;
+            pf_ctxt->pad_busy = EB_FALSE;
+        }
+        else if (lr_plane >= 0) {
+            int32_t unit_row = pf_ctxt->lr_done[lr_plane];
+            pf_ctxt->lr_busy = EB_TRUE;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+            pf_lr_row(dec_handle_ptr, pf_ctxt, lr_plane, unit_row);
+
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            pf_ctxt->lr_done[lr_plane]++;
+            pf_ctxt->lr_busy = EB_FALSE;
+        }
+        else if (!pf_ctxt->cdef_busy &&
+                 pf_ctxt->cdef_done < pf_ctxt->cdef_rows &&
+                 pf_cdef_ready(dec_handle_ptr, pf_ctxt))
+        {
+            int32_t fbr = pf_ctxt->cdef_done;
+            pf_ctxt->cdef_busy = EB_TRUE;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+            pf_cdef_row(dec_handle_ptr, pf_ctxt, fbr);
+
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            pf_ctxt->cdef_done++;
+            pf_ctxt->cdef_busy = EB_FALSE;
+        }
+        else if (!pf_ctxt->lf_busy && pf_ctxt->lf_done < pf_ctxt->lf_rows) {
+            int32_t sb_row = pf_ctxt->lf_done;
+            int32_t stripes_saved = pf_ctxt->stripes_saved;
+            pf_ctxt->lf_busy = EB_TRUE;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+            pf_lf_row(dec_handle_ptr, pf_ctxt, sb_row, stripes_saved,
+                      &stripes_saved);
+
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            pf_ctxt->lf_done++;
+            pf_ctxt->stripes_saved = stripes_saved;
+            pf_ctxt->lf_busy = EB_FALSE;
+        }
+        else {
+            /* Nothing ready, wait for a row of another thread */
+            pf_ctxt->num_waiting++;
+            eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+            eb_block_on_semaphore(pf_ctxt->wait_semaphore);
+            eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+            continue;
+        }
+
+        for (; pf_ctxt->num_waiting > 0; pf_ctxt->num_waiting--)
+            eb_post_semaphore(pf_ctxt->wait_semaphore);
+    }
+    eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+}
+
+/* Picks bands of the output picture until none is left */
+static void film_grain_bands(DecMtCtxt *dec_mt_ctxt)
+{
+    const FilmGrainCtxt *fg_ctxt = dec_mt_ctxt->fg_ctxt;
+
+    for (;;) {
+        eb_block_on_mutex(dec_mt_ctxt->tile_job_mutex);
+        int32_t band = dec_mt_ctxt->next_fg_band++;
+        eb_release_mutex(dec_mt_ctxt->tile_job_mutex);
+
+        if (band >= fg_ctxt->num_bands)
+            break;
+        eb_av1_add_film_grain_band(fg_ctxt, band);
+    }
+}
+
+/* Tile decoding worker */
+void *dec_tile_thread(void *input)
+{
+    DecThreadCtxt *thread_ctxt = (DecThreadCtxt *)input;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)thread_ctxt->dec_handle_ptr;
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+
+    for (;;) {
+        eb_block_on_semaphore(thread_ctxt->tile_start_semaphore);
+
+        if (dec_mt_ctxt->film_grain)
+            film_grain_bands(dec_mt_ctxt);
+        else if (dec_mt_ctxt->post_filter)
+            post_filter_rows(dec_handle_ptr, dec_mt_ctxt);
+        else if (dec_mt_ctxt->row_mt)
+            decode_sb_rows(dec_mt_ctxt, thread_ctxt);
+        else
+            decode_tile_jobs(dec_mt_ctxt, thread_ctxt);
+
+        eb_post_semaphore(dec_mt_ctxt->tile_done_semaphore);
+    }
+    return EB_NULL;
+}
+
+/* Decodes the tile jobs of the current tile group. The calling thread
+   decodes tiles as well and returns once all the jobs are done */
+EbErrorType dec_mt_decode_tiles(EbDecHandle *dec_handle_ptr,
+                                int32_t num_tile_jobs)
+{
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    uint32_t num_workers = AOMMIN(dec_mt_ctxt->num_threads,
+                                  (uint32_t)num_tile_jobs) - 1;
+
+    dec_mt_ctxt->num_tile_jobs = num_tile_jobs;
+    dec_mt_ctxt->next_tile_job = 0;
+    dec_mt_ctxt->status = EB_ErrorNone;
+
+    /* Intra BC reads pixels ahead of the wavefront, decode it in order */
+    if (1 == num_tile_jobs && dec_mt_ctxt->num_threads > 1 &&
+        !dec_handle_ptr->frame_header.allow_intrabc)
+        return decode_tile_rows(dec_handle_ptr, dec_mt_ctxt);
+
+    for (uint32_t i = 1; i <= num_workers; i++)
+        eb_post_semaphore(dec_mt_ctxt->thread_ctxt[i].tile_start_semaphore);
+
+    decode_tile_jobs(dec_mt_ctxt, &dec_mt_ctxt->thread_ctxt[0]);
+
+    for (uint32_t i = 1; i <= num_workers; i++)
+        eb_block_on_semaphore(dec_mt_ctxt->tile_done_semaphore);
+
+    return dec_mt_ctxt->status;
+}
+
+/* Runs LF, CDEF, LR and PAD of the current frame as a row pipeline on all
+   the threads. The calling thread filters rows as well and returns once
+   the frame is filtered. Used when the frame is not superres scaled */
+void dec_mt_post_filter_frame(EbDecHandle *dec_handle_ptr, EbBool do_lf,
+                              EbBool do_cdef, EbBool do_lr)
+{
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    DecPostFilterCtxt *pf_ctxt = &dec_mt_ctxt->pf_ctxt;
+    FrameHeader *frame_header = &dec_handle_ptr->frame_header;
+    MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
+    CurFrameBuf *frame_buf = &master_frame_buf->cur_frame_bufs[0];
+    int32_t sb_mi_size = dec_handle_ptr->seq_header.sb_mi_size;
+    int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.
+                                        color_config);
+
+    pf_ctxt->do_lf = do_lf;
+    pf_ctxt->do_cdef = do_cdef;
+    pf_ctxt->do_lr = do_lr;
+    pf_ctxt->save_boundaries = do_lr && do_cdef;
+
+    pf_ctxt->lf_rows = (frame_header->mi_rows + sb_mi_size - 1) / sb_mi_size;
+    pf_ctxt->lf_done = 0;
+    pf_ctxt->num_stripes = (frame_header->frame_size.frame_height +
+        RESTORATION_UNIT_OFFSET + RESTORATION_PROC_UNIT_SIZE - 1) /
+        RESTORATION_PROC_UNIT_SIZE;
+    pf_ctxt->stripes_saved = 0;
+    pf_ctxt->cdef_rows = (frame_header->mi_rows + MI_SIZE_64X64 - 1) /
+                         MI_SIZE_64X64;
+    pf_ctxt->cdef_done = 0;
+    for (int32_t plane = 0; plane < MAX_MB_PLANE; plane++) {
+        pf_ctxt->lr_rows[plane] = 0;
+        pf_ctxt->lr_done[plane] = 0;
+        if (do_lr && plane < num_planes &&
+            frame_header->lr_params[plane].frame_restoration_type !=
+            RESTORE_NONE)
+        {
+            pf_ctxt->lr_rows[plane] = dec_av1_lr_num_unit_rows(dec_handle_ptr,
+                                                               plane);
+        }
+    }
+    pf_ctxt->pad_done = 0;
+    pf_ctxt->lf_busy = EB_FALSE;
+    pf_ctxt->cdef_busy = EB_FALSE;
+    pf_ctxt->lr_busy = EB_FALSE;
+    pf_ctxt->pad_busy = EB_FALSE;
+    pf_ctxt->num_waiting = 0;
+
+    if (do_lf) {
+        LFCtxt *lf_ctxt = (LFCtxt *)dec_handle_ptr->pv_lf_ctxt;
+        lf_ctxt->delta_lf_stride = master_frame_buf->sb_cols * FRAME_LF_COUNT;
+        dec_av1_loop_filter_frame_init(frame_header, &lf_ctxt->lf_info,
+                                       AOM_PLANE_Y, MAX_MB_PLANE);
+    }
+    if (do_cdef)
+        svt_cdef_init_ctxt(dec_handle_ptr, &pf_ctxt->cdef_ctxt);
+    if (do_lr) {
+        LRCtxt *lr_ctxt = (LRCtxt *)dec_handle_ptr->pv_lr_ctxt;
+        for (int32_t plane = 0; plane < MAX_MB_PLANE; plane++)
+            lr_ctxt->lr_unit[plane] = frame_buf->lr_unit[plane];
+    }
+
+    dec_mt_ctxt->post_filter = EB_TRUE;
+    for (uint32_t i = 1; i < dec_mt_ctxt->num_threads; i++)
+        eb_post_semaphore(dec_mt_ctxt->thread_ctxt[i].tile_start_semaphore);
+
+    post_filter_rows(dec_handle_ptr, dec_mt_ctxt);
+
+    for (uint32_t i = 1; i < dec_mt_ctxt->num_threads; i++)
+        eb_block_on_semaphore(dec_mt_ctxt->tile_done_semaphore);
+    dec_mt_ctxt->post_filter = EB_FALSE;
+
+    if (do_cdef)
+        svt_cdef_free_ctxt(&pf_ctxt->cdef_ctxt);
+}
+
+/* Adds the film grain prepared in fg_ctxt on all the threads. The
+   calling thread adds grain to bands as well and returns once the
+   picture is done */
+void dec_mt_add_film_grain(EbDecHandle *dec_handle_ptr,
+                           const FilmGrainCtxt *fg_ctxt)
+{
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    uint32_t num_workers = AOMMIN(dec_mt_ctxt->num_threads,
+                                  (uint32_t)fg_ctxt->num_bands) - 1;
+
+    dec_mt_ctxt->fg_ctxt = fg_ctxt;
+    dec_mt_ctxt->next_fg_band = 0;
+    dec_mt_ctxt->film_grain = EB_TRUE;
+
+    for (uint32_t i = 1; i <= num_workers; i++)
+        eb_post_semaphore(dec_mt_ctxt->thread_ctxt[i].tile_start_semaphore);
+
+    film_grain_bands(dec_mt_ctxt);
+
+    for (uint32_t i = 1; i <= num_workers; i++)
+        eb_block_on_semaphore(dec_mt_ctxt->tile_done_semaphore);
+
+    dec_mt_ctxt->film_grain = EB_FALSE;
+    dec_mt_ctxt->fg_ctxt = NULL;
+}
@@ -0,0 +1,144 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecMt_h
+#define EbDecMt_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "EbDecHandle.h"
+#include "EbDecCdef.h"
+#include "grainSynthesis.h"
+
+/* Tile decode job. Filled for every tile of the current tile group */
+typedef struct DecTileJob {
+    int32_t         tile_num;
+    /* Start of the tile data and end of the tile group data */
+    const uint8_t   *data;
+    const uint8_t   *data_end;
+    size_t          tile_size;
+} DecTileJob;
+
+/* Context of one tile decoding thread. Context 0 is the calling thread */
+typedef struct DecThreadCtxt {
+    /** Decoder Handle */
+    void        *dec_handle_ptr;
+
+    /* Parse and decode contexts owned by this thread */
+    void        *pv_parse_ctxt;
+    void        *pv_dec_mod_ctxt;
+
+    /* SB level coeff buffers owned by this thread */
+    int32_t     *sb_coeff[MAX_MB_PLANE];
+
+    /* Posted when tile jobs are available for the thread */
+    EbHandle    tile_start_semaphore;
+} DecThreadCtxt;
+
+/* Post filter pipeline state of the current frame. LF runs on SB rows,
+   CDEF on 64x64 filter block rows and LR on restoration unit rows. Each
+   stage is serial, a row of a stage starts as soon as the rows it reads
+   are final in the previous stage. PAD pads the 64 luma rows of a CDEF
+   row once all the planes are final there. Protected by tile_job_mutex */
+typedef struct DecPostFilterCtxt {
+    EbBool          do_lf;
+    EbBool          do_cdef;
+    EbBool          do_lr;
+    /* Stripe boundary lines are needed by LR when CDEF is on */
+    EbBool          save_boundaries;
+
+    int32_t         lf_rows;
+    int32_t         lf_done;
+    /* Stripes whose deblocked boundary lines are saved */
+    int32_t         num_stripes;
+    int32_t         stripes_saved;
+    int32_t         cdef_rows;
+    int32_t         cdef_done;
+    int32_t         lr_rows[MAX_MB_PLANE];
+    int32_t         lr_done[MAX_MB_PLANE];
+    int32_t         pad_done;
+
+    EbBool          lf_busy;
+    EbBool          cdef_busy;
+    EbBool          lr_busy;
+    EbBool          pad_busy;
+
+    DecCdefCtxt     cdef_ctxt;
+
+    /* Threads waiting for a row to get ready, woken up on every row done */
+    int32_t         num_waiting;
+    EbHandle        wait_semaphore;
+} DecPostFilterCtxt;
+
+/* Tile parallel decoding context */
+typedef struct DecMtCtxt {
+    /* Number of threads including the calling thread */
+    uint32_t        num_threads;
+
+    DecThreadCtxt   *thread_ctxt;
+
+    /* Tile jobs of the current tile group */
+    DecTileJob      *tile_jobs;
+    int32_t         num_tile_jobs;
+    /* Index of the next tile job to pick. Protected by tile_job_mutex */
+    int32_t         next_tile_job;
+    EbHandle        tile_job_mutex;
+
+    /* Posted by every worker once the tile job list is exhausted */
+    EbHandle        tile_done_semaphore;
+
+    /* First error returned by a tile job */
+    EbErrorType     status;
+
+    /* SB row wavefront mode : used for a tile group with a single tile.
+       The calling thread parses the tile while the workers reconstruct
+       its SB rows, each row lagging the row above by 2 SBs */
+    EbBool          row_mt;
+    TileInfo        row_mt_tile_info;
+    /* Index of the next SB row to reconstruct. Protected by tile_job_mutex */
+    int32_t         next_recon_sb_row;
+    /* Frame sized coeff buffers, filled by parse and read by recon */
+    int32_t         *frame_coeff[MAX_MB_PLANE];
+    /* Per SB row, posted once for every parsed SB of the row */
+    EbHandle        *sb_row_parse_sem;
+    /* Per SB row, posted once for every reconstructed SB of the row above */
+    EbHandle        *sb_row_recon_sem;
+
+    /* Post filter mode : the threads run the LF, CDEF and LR pipeline */
+    EbBool              post_filter;
+    DecPostFilterCtxt   pf_ctxt;
+
+    /* Film grain mode : the threads add the film grain of the output
+       picture, a band of 32 luma rows at a time */
+    EbBool              film_grain;
+    const FilmGrainCtxt *fg_ctxt;
+    /* Index of the next band to pick. Protected by tile_job_mutex */
+    int32_t             next_fg_band;
+} DecMtCtxt;
+
+uint32_t dec_get_num_threads(EbDecHandle *dec_handle_ptr);
+
+void *dec_tile_thread(void *input);
+
+EbErrorType dec_mt_decode_tiles(EbDecHandle *dec_handle_ptr,
+                                int32_t num_tile_jobs);
+
+void dec_mt_post_filter_frame(EbDecHandle *dec_handle_ptr, EbBool do_lf,
+                              EbBool do_cdef, EbBool do_lr);
+
+void dec_mt_add_film_grain(EbDecHandle *dec_handle_ptr,
+                           const FilmGrainCtxt *fg_ctxt);
+
+/* Defined in EbDecParseObu.c */
+EbErrorType decode_tile(DecThreadCtxt *thread_ctxt, DecTileJob *tile_job);
+void svt_tile_init(TileInfo *cur_tile_info, FrameHeader *frame_header,
+                   int32_t tile_row, int32_t tile_col);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDecMt_h
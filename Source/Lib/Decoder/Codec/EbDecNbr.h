@@ -5,6 +5,9 @@
 
 #ifndef EbDecNbr_h
 #define EbDecNbr_h
+
+#include "EbObuParse.h"
+
 #if !FRAME_MI_MAP
 void update_nbrs_before_sb(FrameMiMap *frame_mi_map, int32_t sb_col);
 
@@ -13,7 +16,7 @@ void update_nbrs_after_sb(FrameMiMap *frame_mi_map, int32_t sb_col);
 ModeInfo_t* get_cur_mode_info(void *pv_dec_handle,
     int mi_row, int mi_col, SBInfo *sb_info);
 
-void update_block_nbrs(EbDecHandle *dec_handle,
+void update_block_nbrs(ParseCtxt *parse_ctx,
     int mi_row, int mi_col,
     BlockSize subsize);
 
@@ -230,12 +230,13 @@ static INLINE void build_obmc_inter_pred_left(EbDecHandle *dec_handle,
 
 }
 
-static INLINE void dec_build_prediction_by_above_pred(EbDecHandle *dec_handle,
+static INLINE void dec_build_prediction_by_above_pred(DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *backup_pi, BlockSize bsize, int bw4, int mi_row, int mi_col,
     int rel_mi_col, uint8_t above_mi_width, ModeInfo_t *above_mbmi,
     uint8_t *tmp_buf[MAX_MB_PLANE], int tmp_stride[MAX_MB_PLANE],
     const int num_planes)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     EbPictureBufferDesc *recon_picture_buf = dec_handle->cur_pic_buf[0]->
         ps_pic_buf;
     const int above_mi_col = mi_col + rel_mi_col;
@@ -272,7 +273,7 @@ static INLINE void dec_build_prediction_by_above_pred(EbDecHandle *dec_handle,
         }
 
         if (av1_skip_u4x4_pred_in_obmc(bsize, sub_x, sub_y, 0)) continue;
-        svtav1_predict_inter_block_plane(dec_handle, backup_pi, plane,
+        svtav1_predict_inter_block_plane(dec_mod_ctxt, backup_pi, plane,
             1/*obmc*/, mi_x, mi_y, (void *)tmp_recon_buf, tmp_recon_stride,
             0/*some_use_intra*/, recon_picture_buf->bit_depth);
 
@@ -280,11 +281,12 @@ static INLINE void dec_build_prediction_by_above_pred(EbDecHandle *dec_handle,
     }
 }
 
-static void dec_build_prediction_by_above_preds(EbDecHandle *dec_handle,
+static void dec_build_prediction_by_above_preds(DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *pi, int mi_row, int mi_col,
     uint8_t *above_dst_buf[MAX_MB_PLANE],
     int above_dst_stride[MAX_MB_PLANE])
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     if (!pi->up_available) return;
     PartitionInfo_t backup_pi = *pi;
 
@@ -348,7 +350,7 @@ static void dec_build_prediction_by_above_preds(EbDecHandle *dec_handle,
         if (dec_is_neighbor_overlappable(above_mi)) {
             ++nb_count;
             /*OBMC above prediction*/
-            dec_build_prediction_by_above_pred(dec_handle, &backup_pi, bsize,
+            dec_build_prediction_by_above_pred(dec_mod_ctxt, &backup_pi, bsize,
                 bw4, mi_row, mi_col, above_mi_col - mi_col,
                 AOMMIN((uint8_t)bw4, mi_step), above_mi, above_dst_buf,
                 above_dst_stride, num_planes);
@@ -363,12 +365,13 @@ static void dec_build_prediction_by_above_preds(EbDecHandle *dec_handle,
 }
 
 
-static INLINE void dec_build_prediction_by_left_pred(EbDecHandle *dec_handle,
+static INLINE void dec_build_prediction_by_left_pred(DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *backup_pi, BlockSize bsize, int bh4, int mi_row, int mi_col,
     int rel_mi_row, uint8_t left_mi_height, ModeInfo_t *left_mbmi,
     uint8_t *tmp_buf[MAX_MB_PLANE], int tmp_stride[MAX_MB_PLANE],
     const int num_planes)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     EbPictureBufferDesc *recon_picture_buf = dec_handle->cur_pic_buf[0]->
         ps_pic_buf;
     const int left_mi_row = mi_row + rel_mi_row;
@@ -408,18 +411,19 @@ static INLINE void dec_build_prediction_by_left_pred(EbDecHandle *dec_handle,
         if (av1_skip_u4x4_pred_in_obmc(bsize, sub_x, sub_y, 1)) continue;
        // dec_build_inter_predictors(ctxt->cm, pi, j, &backup_mbmi, 1, bw, bh, mi_x,
        //                            mi_y);
-        svtav1_predict_inter_block_plane(dec_handle, backup_pi, plane,
+        svtav1_predict_inter_block_plane(dec_mod_ctxt, backup_pi, plane,
             1/*obmc*/, mi_x, mi_y, (void *)tmp_recon_buf, tmp_recon_stride,
             0/*some_use_intra*/, recon_picture_buf->bit_depth);
 
     }
 }
 
-static void dec_build_prediction_by_left_preds(EbDecHandle *dec_handle,
+static void dec_build_prediction_by_left_preds(DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *pi, int mi_row, int mi_col,
     uint8_t *left_dst_buf[MAX_MB_PLANE],
     int left_dst_stride[MAX_MB_PLANE])
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
     if (!pi->left_available) return;
     PartitionInfo_t backup_pi = *pi;
 
@@ -476,7 +480,7 @@ static void dec_build_prediction_by_left_preds(EbDecHandle *dec_handle,
         if (dec_is_neighbor_overlappable(left_mi)) {
             ++nb_count;
             /*OBMC left prediction*/
-            dec_build_prediction_by_left_pred(dec_handle, &backup_pi, bsize,
+            dec_build_prediction_by_left_pred(dec_mod_ctxt, &backup_pi, bsize,
                 bh4, mi_row, mi_col, left_mi_row - mi_row,
                 AOMMIN((uint8_t)bh4, mi_step), left_mi, left_dst_buf,
                 left_dst_stride, num_planes);
@@ -490,10 +494,9 @@ static void dec_build_prediction_by_left_preds(EbDecHandle *dec_handle,
 }
 
 
-void dec_build_obmc_inter_predictors_sb( EbDecHandle *dec_handle,
+void dec_build_obmc_inter_predictors_sb( DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *pi, int mi_row, int mi_col)
 {
-    DecModCtxt *dec_mod_ctxt = (DecModCtxt *)dec_handle->pv_dec_mod_ctxt;
     uint8_t *dst_buf[MAX_MB_PLANE];
     dec_mod_ctxt->obmc_ctx.dst_stride[AOM_PLANE_Y] = MAX_SB_SIZE;
     dec_mod_ctxt->obmc_ctx.dst_stride[AOM_PLANE_U] = MAX_SB_SIZE;
@@ -502,11 +505,11 @@ void dec_build_obmc_inter_predictors_sb( EbDecHandle *dec_handle,
     dst_buf[1] = dec_mod_ctxt->obmc_ctx.tmp_obmc_bufs[AOM_PLANE_U];
     dst_buf[2] = dec_mod_ctxt->obmc_ctx.tmp_obmc_bufs[AOM_PLANE_V];
     /*OBMC above prediction followed by Blending happen in below fun call*/
-    dec_build_prediction_by_above_preds(dec_handle, pi, mi_row, mi_col,
+    dec_build_prediction_by_above_preds(dec_mod_ctxt, pi, mi_row, mi_col,
         dst_buf, dec_mod_ctxt->obmc_ctx.dst_stride);
 
     /*OBMC left prediction followed by Blending happen in below fun call*/
-    dec_build_prediction_by_left_preds(dec_handle, pi, mi_row, mi_col,
+    dec_build_prediction_by_left_preds(dec_mod_ctxt, pi, mi_row, mi_col,
         dst_buf, dec_mod_ctxt->obmc_ctx.dst_stride);
 }
 
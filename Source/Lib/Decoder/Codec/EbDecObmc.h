@@ -27,7 +27,9 @@ typedef struct ObmcCtx {
 
 static const int max_neighbor_obmc[6] = { 0, 1, 2, 3, 4, 4 };
 
-void dec_build_obmc_inter_predictors_sb(EbDecHandle *dec_handle,
+struct DecModCtxt;
+
+void dec_build_obmc_inter_predictors_sb(struct DecModCtxt *dec_mod_ctxt,
     PartitionInfo_t *pi, int mi_row, int mi_col);
 
 
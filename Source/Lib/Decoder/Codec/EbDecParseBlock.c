@@ -356,10 +356,10 @@ static void read_palette_colors_uv(ParseCtxt *parse_ctx, PartitionInfo_t *pi,
     }
 }
 
-void palette_mode_info(EbDecHandle *dec_handle, PartitionInfo_t *pi,
+void palette_mode_info(ParseCtxt *parse_ctxt, PartitionInfo_t *pi,
     int mi_row, int mi_col, SvtReader *r)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     FRAME_CONTEXT *frm_ctx = &parse_ctxt->cur_tile_ctx;
     EbColorConfig *color_info = &dec_handle->seq_header.color_config;
     const int num_planes = color_info->mono_chrome ? 1 : MAX_MB_PLANE;
@@ -414,13 +414,13 @@ static INLINE int filter_intra_allowed(EbDecHandle *dec_handle, const ModeInfo_t
         filter_intra_allowed_bsize(dec_handle, mbmi->sb_type);
 }
 
-void filter_intra_mode_info(EbDecHandle *dec_handle,
+void filter_intra_mode_info(ParseCtxt *parse_ctxt,
     PartitionInfo_t *xd, SvtReader *r)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ModeInfo_t *const mbmi = xd->mi;
     FilterIntraModeInfo_t *filter_intra_mode_info =
         &mbmi->filter_intra_mode_info;
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     FRAME_CONTEXT *frm_ctx = &parse_ctxt->cur_tile_ctx;
 
     if (filter_intra_allowed(dec_handle, mbmi)) {
@@ -487,15 +487,15 @@ void read_cdef(EbDecHandle *dec_handle, SvtReader *r, PartitionInfo_t *xd,
     }
 }
 
-void read_delta_qindex(EbDecHandle *dec_handle, SvtReader *r,
+void read_delta_qindex(ParseCtxt *parse_ctxt, SvtReader *r,
     ModeInfo_t *const mbmi, int32_t *cur_qind, int32_t *sb_delta_q)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     int sign, abs, reduced_delta_qindex = 0;
     BlockSize bsize = mbmi->sb_type;
     DeltaQParams    *delta_q_params = &dec_handle->frame_header.delta_q_params;
 
     if ((bsize != dec_handle->seq_header.sb_size || mbmi->skip == 0)) {
-        ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
         abs = svt_read_symbol(r, parse_ctxt->cur_tile_ctx.delta_q_cdf,
             DELTA_Q_PROBS + 1, ACCT_STR);
 
@@ -546,10 +546,10 @@ int read_delta_lflevel(EbDecHandle *dec_handle, SvtReader *r,
     return tmp_lvl;
 }
 
-int read_skip(EbDecHandle *dec_handle, PartitionInfo_t *xd,
+int read_skip(ParseCtxt *parse_ctxt, PartitionInfo_t *xd,
     int segment_id, SvtReader *r)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     //uint8_t segIdPreSkip = dec_handle->frame_header.segmentation_params.seg_id_pre_skip;
     if (seg_feature_active(&dec_handle->frame_header.segmentation_params,
         segment_id, SEG_LVL_SKIP))
@@ -564,9 +564,10 @@ int read_skip(EbDecHandle *dec_handle, PartitionInfo_t *xd,
     }
 }
 
-int read_skip_mode(EbDecHandle *dec_handle, PartitionInfo_t *xd, int segment_id,
+int read_skip_mode(ParseCtxt *parse_ctxt, PartitionInfo_t *xd, int segment_id,
     SvtReader *r)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     SegmentationParams *seg = &dec_handle->frame_header.segmentation_params;
     if (seg_feature_active(seg, segment_id, SEG_LVL_SKIP) ||
         seg_feature_active(seg, segment_id, SEG_LVL_REF_FRAME) ||
@@ -577,7 +578,6 @@ int read_skip_mode(EbDecHandle *dec_handle, PartitionInfo_t *xd, int segment_id,
     {
         return 0;
     }
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     int above_skip_mode = xd->above_mbmi ? xd->above_mbmi->skip_mode : 0;
     int left_skip_mode = xd->left_mbmi ? xd->left_mbmi->skip_mode : 0;
     int ctx = above_skip_mode + left_skip_mode;
@@ -586,10 +586,10 @@ int read_skip_mode(EbDecHandle *dec_handle, PartitionInfo_t *xd, int segment_id,
 
 // If delta q is present, reads delta_q index.
 // Also reads delta_q loop filter levels, if present.
-static void read_delta_params(EbDecHandle *dec_handle, SvtReader *r,
+static void read_delta_params(ParseCtxt *parse_ctxt, SvtReader *r,
     PartitionInfo_t *xd)
 {
-    ParseCtxt       *parse_ctxt     = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     DeltaQParams    *delta_q_params = &dec_handle->frame_header.delta_q_params;
     DeltaLFParams   *delta_lf_params = &dec_handle->frame_header.delta_lf_params;
     SBInfo          *sb_info = xd->sb_info;
@@ -599,7 +599,7 @@ static void read_delta_params(EbDecHandle *dec_handle, SvtReader *r,
         return;
 
     if (delta_q_params->delta_q_present) {
-        read_delta_qindex(dec_handle, r, mbmi,
+        read_delta_qindex(parse_ctxt, r, mbmi,
             &parse_ctxt->parse_nbr4x4_ctxt.cur_q_ind, &sb_info->sb_delta_q[0]);
     }
 
@@ -658,11 +658,11 @@ int get_segment_id(FrameHeader *frm_info, uint8_t *segment_ids,
     return segment_id;
 }
 
-static int read_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd, uint32_t mi_row,
+static int read_segment_id(ParseCtxt *parse_ctxt, PartitionInfo_t *xd, uint32_t mi_row,
     uint32_t mi_col, SvtReader *r, int skip)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     int cdf_num = 0;
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
 
     int prev_ul = -1;  // top left segment_id
     int prev_l = -1;   // left segment_id
@@ -712,9 +712,10 @@ static int read_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd, uint32_
     return neg_deinterleave(coded_id, pred, seg->last_active_seg_id + 1);
 }
 
-int intra_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd, int mi_row, int mi_col,
+int intra_segment_id(ParseCtxt *parse_ctx, PartitionInfo_t *xd, int mi_row, int mi_col,
     int bsize, SvtReader *r, int skip)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     SegmentationParams *seg = &dec_handle->frame_header.segmentation_params;
     int segment_id = 0;
 
@@ -724,7 +725,7 @@ int intra_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd, int mi_row, i
         const int bh = mi_size_high[bsize];
         const int x_mis = AOMMIN((int32_t)(dec_handle->frame_header.mi_cols - mi_col), bw);
         const int y_mis = AOMMIN((int32_t)(dec_handle->frame_header.mi_rows - mi_row), bh);
-        segment_id = read_segment_id(dec_handle, xd, mi_row, mi_col, r, skip);
+        segment_id = read_segment_id(parse_ctx, xd, mi_row, mi_col, r, skip);
         set_segment_id(dec_handle, mi_offset, x_mis, y_mis, segment_id);
     }
     return segment_id;
@@ -755,11 +756,10 @@ PredictionMode getMode(PredictionMode yMode, int refList) {
     return compMode;
 }
 
-static INLINE void update_palette_context(EbDecHandle *dec_handle,
+static INLINE void update_palette_context(ParseCtxt *parse_ctx,
     int mi_row, int mi_col, ModeInfo_t *mi)
 {
     BlockSize bsize = mi->sb_type;
-    ParseCtxt *parse_ctx = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     ParseNbr4x4Ctxt *ngr_ctx = &parse_ctx->parse_nbr4x4_ctxt;
     const int bw = mi_size_wide[bsize];
     const int bh = mi_size_high[bsize];
@@ -840,10 +840,10 @@ static INLINE TxType intra_mode_to_tx_type(const ModeInfo_t *mbmi, PlaneType pla
     return _intra_mode_to_tx_type[mode];
 }
 
-void intra_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t *xd,
+void intra_frame_mode_info(ParseCtxt *parse_ctxt, PartitionInfo_t *xd,
     int mi_row, int mi_col, SvtReader *r, int8_t *cdef_strength)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ModeInfo_t *const mbmi = xd->mi;
     const ModeInfo_t *above_mi = xd->above_mbmi;
     const ModeInfo_t *left_mi = xd->left_mbmi;
@@ -857,19 +857,19 @@ void intra_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t *xd,
 
     if (seg->seg_id_pre_skip) {
         mbmi->segment_id =
-            intra_segment_id(dec_handle, xd, mi_row, mi_col, bsize, r, 0);
+            intra_segment_id(parse_ctxt, xd, mi_row, mi_col, bsize, r, 0);
     }
 
-    mbmi->skip = read_skip(dec_handle, xd, mbmi->segment_id, r);
+    mbmi->skip = read_skip(parse_ctxt, xd, mbmi->segment_id, r);
 
     if (!seg->seg_id_pre_skip) {
         mbmi->segment_id =
-            intra_segment_id(dec_handle, xd, mi_row, mi_col, bsize, r, mbmi->skip);
+            intra_segment_id(parse_ctxt, xd, mi_row, mi_col, bsize, r, mbmi->skip);
     }
 
     read_cdef(dec_handle, r, xd, mi_col, mi_row, cdef_strength);
 
-    read_delta_params(dec_handle, r, xd);
+    read_delta_params(parse_ctxt, r, xd);
     parse_ctxt->read_deltas = 0;
 
     mbmi->ref_frame[0] = INTRA_FRAME;
@@ -892,11 +892,11 @@ void intra_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t *xd,
         mbmi->compound_mode = COMPOUND_AVERAGE;
         mbmi->interp_filters = av1_broadcast_interp_filter(BILINEAR);
         IntMvDec global_mvs[2];
-        av1_find_mv_refs(dec_handle, xd, INTRA_FRAME, xd->ref_mv_stack,
+        av1_find_mv_refs(parse_ctxt, xd, INTRA_FRAME, xd->ref_mv_stack,
             ref_mvs, global_mvs, mi_row, mi_col,
             inter_mode_ctx, mv_cnt);
 
-        assign_intrabc_mv(dec_handle, ref_mvs, xd, mi_row, mi_col, r);
+        assign_intrabc_mv(parse_ctxt, ref_mvs, xd, mi_row, mi_col, r);
     }
     else {
         AomCdfProb *y_mode_cdf = get_y_mode_cdf(&parse_ctxt->cur_tile_ctx,
@@ -923,10 +923,10 @@ void intra_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t *xd,
             mbmi->uv_mode = UV_DC_PRED;
 
         if (allow_palette(dec_handle->frame_header.allow_screen_content_tools, bsize)) {
-            palette_mode_info(dec_handle, xd, mi_row, mi_col, r);
-            update_palette_context(dec_handle, mi_row, mi_col, mbmi);
+            palette_mode_info(parse_ctxt, xd, mi_row, mi_col, r);
+            update_palette_context(parse_ctxt, mi_row, mi_col, mbmi);
         }
-        filter_intra_mode_info(dec_handle, xd, r);
+        filter_intra_mode_info(parse_ctxt, xd, r);
     }
     free(mv_cnt);
 }
@@ -964,13 +964,13 @@ static void copy_segment_id(EbDecHandle *dec_handle,
         }
 }
 
-int read_inter_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd,
+int read_inter_segment_id(ParseCtxt *parse_ctxt, PartitionInfo_t *xd,
                         uint32_t mi_row, uint32_t mi_col, int preskip, SvtReader *r)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     SegmentationParams *seg = &dec_handle->frame_header.segmentation_params;
     ModeInfo_t *const mbmi = xd->mi;
     FrameHeader *frame_header = &dec_handle->frame_header;
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     const int mi_offset = mi_row * frame_header->mi_cols + mi_col;
     const uint32_t bw = mi_size_wide[mbmi->sb_type];
     const uint32_t bh = mi_size_high[mbmi->sb_type];
@@ -1004,7 +1004,7 @@ int read_inter_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd,
             mbmi->seg_id_predicted = 0;
             update_seg_ctx(&parse_ctxt->parse_nbr4x4_ctxt,
                 mi_col, bw, bh, mbmi->seg_id_predicted);
-            segment_id = read_segment_id(dec_handle, xd, mi_row, mi_col, r, 1);
+            segment_id = read_segment_id(parse_ctxt, xd, mi_row, mi_col, r, 1);
             set_segment_id(dec_handle, mi_offset, x_mis, y_mis, segment_id);
             return segment_id;
         }
@@ -1012,7 +1012,6 @@ int read_inter_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd,
 
     if (seg->segmentation_temporal_update) {
         const int ctx = get_pred_context_seg_id(xd);
-        ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
         struct segmentation_probs *const segp = &parse_ctxt->cur_tile_ctx.seg;
         mbmi->seg_id_predicted = svt_read_symbol(r, segp->pred_cdf[ctx], 2, ACCT_STR);
         if (mbmi->seg_id_predicted) {
@@ -1020,12 +1019,12 @@ int read_inter_segment_id(EbDecHandle *dec_handle, PartitionInfo_t *xd,
                 prev_buf->segment_maps, mbmi->sb_type, mi_row, mi_col) : 0;
         }
         else
-            segment_id = read_segment_id(dec_handle, xd, mi_row, mi_col, r, 0);
+            segment_id = read_segment_id(parse_ctxt, xd, mi_row, mi_col, r, 0);
         update_seg_ctx(&parse_ctxt->parse_nbr4x4_ctxt,
             mi_col, bw, bh, mbmi->seg_id_predicted);
     }
     else
-        segment_id = read_segment_id(dec_handle, xd, mi_row, mi_col, r, 0);
+        segment_id = read_segment_id(parse_ctxt, xd, mi_row, mi_col, r, 0);
     set_segment_id(dec_handle, mi_offset, x_mis, y_mis, segment_id);
 
     return segment_id;
@@ -1236,10 +1235,10 @@ void svt_setup_motion_field(EbDecHandle *dec_handle) {
     if (ref_stamp >= 0) motion_field_projection(dec_handle, LAST2_FRAME, 2);
 }
 
-void intra_block_mode_info(EbDecHandle *dec_handle, int mi_row,
+void intra_block_mode_info(ParseCtxt *parse_ctxt, int mi_row,
     int mi_col, PartitionInfo_t* xd, SvtReader *r)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ModeInfo_t *mbmi = xd->mi;
     const BlockSize bsize = mbmi->sb_type;
     mbmi->ref_frame[0] = INTRA_FRAME;
@@ -1274,17 +1273,17 @@ void intra_block_mode_info(EbDecHandle *dec_handle, int mi_row,
     mbmi->palette_size[1] = 0;
 
     if (allow_palette(dec_handle->frame_header.allow_screen_content_tools, bsize)) {
-        palette_mode_info(dec_handle, xd, mi_row, mi_col, r);
-        update_palette_context(dec_handle, mi_row, mi_col, mbmi);
+        palette_mode_info(parse_ctxt, xd, mi_row, mi_col, r);
+        update_palette_context(parse_ctxt, mi_row, mi_col, mbmi);
     }
 
-    filter_intra_mode_info(dec_handle, xd, r);
+    filter_intra_mode_info(parse_ctxt, xd, r);
 }
 
-int read_is_inter(EbDecHandle* dec_handle, PartitionInfo_t * xd,
+int read_is_inter(ParseCtxt *parse_ctxt, PartitionInfo_t * xd,
     int segment_id, SvtReader *r)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     int is_inter = 0;
     SegmentationParams *seg_params = &dec_handle->frame_header.segmentation_params;
     if (seg_feature_active(seg_params, segment_id, SEG_LVL_REF_FRAME))
@@ -1299,9 +1298,10 @@ int read_is_inter(EbDecHandle* dec_handle, PartitionInfo_t * xd,
     return is_inter;
 }
 
-void inter_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t * pi,
+void inter_frame_mode_info(ParseCtxt *parse_ctxt, PartitionInfo_t * pi,
     uint32_t mi_row, uint32_t mi_col, SvtReader *r, int8_t *cdef_strength)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ModeInfo_t *mbmi = pi->mi;
     mbmi->use_intrabc = 0;
     int inter_block = 1;
@@ -1311,33 +1311,32 @@ void inter_frame_mode_info(EbDecHandle *dec_handle, PartitionInfo_t * pi,
 
     mbmi->inter_inter_compound.type = COMPOUND_AVERAGE;
 
-    mbmi->segment_id = read_inter_segment_id(dec_handle, pi, mi_row, mi_col, 1, r);
+    mbmi->segment_id = read_inter_segment_id(parse_ctxt, pi, mi_row, mi_col, 1, r);
 
-    mbmi->skip_mode = read_skip_mode(dec_handle, pi, mbmi->segment_id, r);
+    mbmi->skip_mode = read_skip_mode(parse_ctxt, pi, mbmi->segment_id, r);
 
     if (mbmi->skip_mode)
         mbmi->skip = 1;
     else
-        mbmi->skip = read_skip(dec_handle, pi, mbmi->segment_id, r);
+        mbmi->skip = read_skip(parse_ctxt, pi, mbmi->segment_id, r);
 
     if (!dec_handle->frame_header.segmentation_params.seg_id_pre_skip)
-        mbmi->segment_id = read_inter_segment_id(dec_handle, pi, mi_row, mi_col, 0, r);
+        mbmi->segment_id = read_inter_segment_id(parse_ctxt, pi, mi_row, mi_col, 0, r);
 
     dec_handle->frame_header.coded_lossless = dec_handle->frame_header.
         lossless_array[mbmi->segment_id];
     read_cdef(dec_handle, r, pi, mi_col, mi_row, cdef_strength);
 
-    read_delta_params(dec_handle, r, pi);
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    read_delta_params(parse_ctxt, r, pi);
     parse_ctxt->read_deltas = 0;
 
     if (!mbmi->skip_mode)
-        inter_block = read_is_inter(dec_handle, pi, mbmi->segment_id, r);
+        inter_block = read_is_inter(parse_ctxt, pi, mbmi->segment_id, r);
 
     if (inter_block)
-        inter_block_mode_info(dec_handle, pi, mi_row, mi_col, r);
+        inter_block_mode_info(parse_ctxt, pi, mi_row, mi_col, r);
     else
-        intra_block_mode_info(dec_handle, mi_row, mi_col, pi, r);
+        intra_block_mode_info(parse_ctxt, mi_row, mi_col, pi, r);
 }
 
 static void intra_copy_frame_mvs(EbDecHandle *dec_handle, int mi_row, int mi_col,
@@ -1396,9 +1395,10 @@ void inter_copy_frame_mvs(EbDecHandle *dec_handle, ModeInfo_t *mi,
     }
 }
 
-void mode_info(EbDecHandle *dec_handle, PartitionInfo_t *part_info, uint32_t mi_row,
+void mode_info(ParseCtxt *parse_ctx, PartitionInfo_t *part_info, uint32_t mi_row,
     uint32_t mi_col, SvtReader *r, int8_t *cdef_strength)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     ModeInfo_t *mi = part_info->mi;
     FrameHeader *frame_info = &dec_handle->frame_header;
     //BlockSize bsize = mi->sb_type
@@ -1413,27 +1413,28 @@ void mode_info(EbDecHandle *dec_handle, PartitionInfo_t *part_info, uint32_t mi_
     if (frame_info->frame_type == KEY_FRAME ||
         frame_info->frame_type == INTRA_ONLY_FRAME)
     {
-        intra_frame_mode_info(dec_handle, part_info, mi_row, mi_col, r,
+        intra_frame_mode_info(parse_ctx, part_info, mi_row, mi_col, r,
             cdef_strength);
         intra_copy_frame_mvs(dec_handle, mi_row, mi_col, x_mis, y_mis);
     }
     else {
-        inter_frame_mode_info(dec_handle, part_info, mi_row, mi_col, r,
+        inter_frame_mode_info(parse_ctx, part_info, mi_row, mi_col, r,
             cdef_strength);
         inter_copy_frame_mvs(dec_handle, mi, mi_row, mi_col, x_mis, y_mis);
     }
 }
 
-TxSize read_tx_size(EbDecHandle *dec_handle, PartitionInfo_t *xd,
+TxSize read_tx_size(ParseCtxt *parse_ctx, PartitionInfo_t *xd,
                     int allow_select, SvtReader *r)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     ModeInfo_t *mbmi = xd->mi;
     const TxMode tx_mode = dec_handle->frame_header.tx_mode;
     const BlockSize bsize = xd->mi->sb_type;
     if (dec_handle->frame_header.lossless_array[mbmi->segment_id]) return TX_4X4;
 
     if (bsize > BLOCK_4X4 && allow_select && tx_mode == TX_MODE_SELECT) {
-        const TxSize coded_tx_size = read_selected_tx_size(xd, r, dec_handle);
+        const TxSize coded_tx_size = read_selected_tx_size(xd, r, parse_ctx);
         return coded_tx_size;
     }
     assert(IMPLIES(tx_mode == ONLY_4X4, bsize == BLOCK_4X4));
@@ -1452,10 +1453,10 @@ static INLINE TxSize av1_get_max_uv_txsize(BlockSize bsize, int subsampling_x,
 }
 
 /* Update Chroma Transform Info for Inter Case! */
-void update_chroma_trans_info(EbDecHandle *dec_handle,
+void update_chroma_trans_info(ParseCtxt *parse_ctx,
     PartitionInfo_t *part_info, BlockSize bsize)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     ModeInfo_t *mbmi = part_info->mi;
     SBInfo     *sb_info = part_info->sb_info;
     EbColorConfig color_config = dec_handle->seq_header.color_config;
@@ -1554,11 +1555,10 @@ int get_txfm_split_ctx(PartitionInfo_t *pi, ParseCtxt *parse_ctx,
              (TX_SIZES - 1 - max_tx_size) * 6 + above + left);
 }
 
-void read_var_tx_size(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r,
+void read_var_tx_size(ParseCtxt *parse_ctx, PartitionInfo_t *pi, SvtReader *r,
     TxSize tx_size, int blk_row, int blk_col, int depth, int *num_luma_tus) {
 
     ModeInfo_t *mbmi = pi->mi;
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
     const BlockSize bsize = mbmi->sb_type;
     const int max_blocks_high = max_block_high(pi, bsize, 0);
     const int max_blocks_wide = max_block_wide(pi, bsize, 0);
@@ -1587,7 +1587,7 @@ void read_var_tx_size(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r
 
         for (i = 0; i < h4; i += step_h)
             for (j = 0; j < w4; j += step_w)
-                read_var_tx_size(dec_handle, pi, r, sub_tx_sz, blk_row + i,
+                read_var_tx_size(parse_ctx, pi, r, sub_tx_sz, blk_row + i,
                                  blk_col + j, depth + 1, num_luma_tus);
     }
     else {
@@ -1602,10 +1602,10 @@ void read_var_tx_size(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r
 }
 
 /* Update Flat Transform Info for Intra Case! */
-void update_flat_trans_info(EbDecHandle *dec_handle, PartitionInfo_t *part_info,
+void update_flat_trans_info(ParseCtxt *parse_ctx, PartitionInfo_t *part_info,
                             BlockSize bsize, TxSize tx_size)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     ModeInfo_t *mbmi = part_info->mi;
     SBInfo     *sb_info = part_info->sb_info;
     EbColorConfig color_config = dec_handle->seq_header.color_config;
@@ -1723,11 +1723,11 @@ static INLINE void set_txfm_ctxs(ParseCtxt *parse_ctx, TxSize tx_size,
     memset(left_ctx, tx_high, n4_h);
 }
 
-void read_block_tx_size(EbDecHandle *dec_handle, SvtReader *r,
+void read_block_tx_size(ParseCtxt *parse_ctx, SvtReader *r,
     PartitionInfo_t *part_info, BlockSize bsize)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     ModeInfo_t *mbmi = part_info->mi;
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
     SBInfo     *sb_info = part_info->sb_info;
     int inter_block_tx = dec_is_inter_block(mbmi);
 
@@ -1752,19 +1752,19 @@ void read_block_tx_size(EbDecHandle *dec_handle, SvtReader *r,
             for (int idx = 0; idx < width; idx += bw)
             {
                 num_luma_tus = 0;
-                read_var_tx_size(dec_handle, part_info, r, max_tx_size, idy, idx, 0, &num_luma_tus);
+                read_var_tx_size(parse_ctx, part_info, r, max_tx_size, idy, idx, 0, &num_luma_tus);
                 parse_ctx->num_tus[AOM_PLANE_Y][force_split_cnt] = num_luma_tus;
                 force_split_cnt++;
             }
 
         // Chroma trans_info update
-        update_chroma_trans_info(dec_handle, part_info, bsize);
+        update_chroma_trans_info(parse_ctx, part_info, bsize);
 
         mbmi->num_luma_tus = parse_ctx->cur_blk_luma_count;
         parse_ctx->first_luma_tu_offset += parse_ctx->cur_blk_luma_count;
     }
     else {
-        TxSize tx_size = read_tx_size(dec_handle, part_info,
+        TxSize tx_size = read_tx_size(parse_ctx, part_info,
             !mbmi->skip || !inter_block_tx, r);
 
         int b4_w = mi_size_wide[mbmi->sb_type];
@@ -1774,7 +1774,7 @@ void read_block_tx_size(EbDecHandle *dec_handle, SvtReader *r,
             mbmi->skip && dec_is_inter_block(mbmi), part_info);
 
         /* Update Flat Transform Info */
-        update_flat_trans_info(dec_handle, part_info, bsize, tx_size);
+        update_flat_trans_info(parse_ctx, part_info, bsize, tx_size);
     }
 }
 
@@ -1789,15 +1789,15 @@ TxSetType get_tx_set(TxSize tx_size, int is_inter, int use_reduced_set) {
     return get_ext_tx_set_type(tx_size, is_inter, use_reduced_set);
 }
 
-void parse_transform_type(EbDecHandle *dec_handle, PartitionInfo_t *xd,
+void parse_transform_type(ParseCtxt *parse_ctxt, PartitionInfo_t *xd,
      TxSize tx_size, SvtReader *r, TransformInfo_t *trans_info)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ModeInfo_t *mbmi = xd->mi;
 
     TxType *tx_type = &trans_info->txk_type;
     *tx_type = DCT_DCT;
 
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     FRAME_CONTEXT *frm_ctx = &parse_ctxt->cur_tile_ctx;
 
     // No need to read transform type if block is skipped.
@@ -1883,11 +1883,11 @@ static AOM_FORCE_INLINE int get_br_ctx_eob(const int c,  // raster order
     return 14;
 }
 
-void update_coeff_ctx(EbDecHandle *dec_handle, int plane, PartitionInfo_t *pi,
+void update_coeff_ctx(ParseCtxt *parse_ctxt, int plane, PartitionInfo_t *pi,
     TxSize tx_size, uint32_t blk_row, uint32_t blk_col, int above_off,
     int left_off, int cul_level, int dc_val)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     ParseNbr4x4Ctxt *ngr_ctx = &parse_ctxt->parse_nbr4x4_ctxt;
 
     uint8_t suby = plane ? dec_handle->seq_header.color_config.subsampling_y : 0;
@@ -2093,15 +2093,15 @@ static INLINE int get_lower_levels_ctx_eob(int bwl, int height, int scan_idx) {
     return 3;
 }
 
-uint16_t parse_coeffs(EbDecHandle *dec_handle, PartitionInfo_t *xd, SvtReader *r,
+uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo_t *xd, SvtReader *r,
     uint32_t blk_row, uint32_t blk_col, int above_off, int left_off, int plane,
     int txb_skip_ctx, int dc_sign_ctx, TxSize tx_size, int32_t *coeff_buf,
     TransformInfo_t *trans_info)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     const int width = get_txb_wide(tx_size);
     const int height = get_txb_high(tx_size);
 
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     FRAME_CONTEXT *frm_ctx = &parse_ctxt->cur_tile_ctx;
 
     TxSize txs_ctx = (TxSize)((txsize_sqr_map[tx_size] +
@@ -2125,14 +2125,14 @@ uint16_t parse_coeffs(EbDecHandle *dec_handle, PartitionInfo_t *xd, SvtReader *r
             trans_info->cbf      = 0;
         }
 
-        update_coeff_ctx(dec_handle, plane, xd, tx_size, blk_row, blk_col,
+        update_coeff_ctx(parse_ctxt, plane, xd, tx_size, blk_row, blk_col,
             above_off, left_off, cul_level, dc_val);
 
         return 0;
     }
 
     if (plane == AOM_PLANE_Y)
-        parse_transform_type(dec_handle, xd, tx_size, r, trans_info);
+        parse_transform_type(parse_ctxt, xd, tx_size, r, trans_info);
 
     uint8_t     *lossless_array = &dec_handle->frame_header.lossless_array[0];
     TransformInfo_t *trans_buf = (dec_is_inter_block(xd->mi) && plane) ?
@@ -2276,7 +2276,7 @@ uint16_t parse_coeffs(EbDecHandle *dec_handle, PartitionInfo_t *xd, SvtReader *r
 
     cul_level = AOMMIN(COEFF_CONTEXT_MASK, cul_level);
 
-    update_coeff_ctx(dec_handle, plane, xd, tx_size, blk_row, blk_col,
+    update_coeff_ctx(parse_ctxt, plane, xd, tx_size, blk_row, blk_col,
         above_off, left_off, cul_level, dc_val);
 
     trans_info->cbf = 1; assert(eob);
@@ -2334,9 +2334,8 @@ void partition_gather_vert_alike(AomCdfProb *out, AomCdfProb *in, BlockSize bsiz
 }
 
 PartitionType parse_partition_type(uint32_t blk_row, uint32_t blk_col, SvtReader *reader,
-    BlockSize bsize, int has_rows, int has_cols, EbDecHandle *dec_handle)
+    BlockSize bsize, int has_rows, int has_cols, ParseCtxt *parse_ctxt)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
 
     int partition_cdf_length = bsize <= BLOCK_8X8 ? PARTITION_TYPES :
         (bsize == BLOCK_128X128 ? EXT_PARTITION_TYPES - 2 : EXT_PARTITION_TYPES);
@@ -2371,13 +2370,13 @@ PartitionType parse_partition_type(uint32_t blk_row, uint32_t blk_col, SvtReader
     return  PARTITION_SPLIT;
 }
 
-static INLINE void dec_get_txb_ctx(EbDecHandle *dec_handle,
+static INLINE void dec_get_txb_ctx(ParseCtxt *parse_ctx,
     const TxSize tx_size, const int plane, int plane_bsize, int txb_h_unit,
     int txb_w_unit, int blk_row, int blk_col, TXB_CTX *const txb_ctx)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
 #define MAX_TX_SIZE_UNIT 16
 
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
     ParseNbr4x4Ctxt *nbr_ctx = &parse_ctx->parse_nbr4x4_ctxt;
     EbColorConfig *clr_cfg = &dec_handle->seq_header.color_config;
 
@@ -2467,12 +2466,13 @@ static INLINE void dec_get_txb_ctx(EbDecHandle *dec_handle,
 #undef MAX_TX_SIZE_UNIT
 }
 
-uint16_t parse_transform_block(EbDecHandle *dec_handle,
+uint16_t parse_transform_block(ParseCtxt *parse_ctx,
     PartitionInfo_t *pi, SvtReader *r, int32_t *coeff,
     TransformInfo_t *trans_info, int plane, int blk_col,
     int blk_row, int mi_row, int mi_col,
     TxSize tx_size, int skip)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     uint16_t eob = 0 , sub_x, sub_y;
 
     sub_x = (plane > 0) ? dec_handle->seq_header.color_config.subsampling_x : 0;
@@ -2510,24 +2510,24 @@ uint16_t parse_transform_block(EbDecHandle *dec_handle,
         }
 
 
-        dec_get_txb_ctx(dec_handle, tx_size, plane, plane_bsize, txb_h_unit,
+        dec_get_txb_ctx(parse_ctx, tx_size, plane, plane_bsize, txb_h_unit,
             txb_w_unit, start_y, start_x, &txb_ctx);
 
-        eob = parse_coeffs(dec_handle, pi, r, start_y, start_x, blk_col,
+        eob = parse_coeffs(parse_ctx, pi, r, start_y, start_x, blk_col,
             blk_row, plane, txb_ctx.txb_skip_ctx, txb_ctx.dc_sign_ctx,
             tx_size, coeff, trans_info);
     }
     else{
-        update_coeff_ctx(dec_handle, plane, pi, tx_size,
+        update_coeff_ctx(parse_ctx, plane, pi, tx_size,
             start_y, start_x, blk_col, blk_row, 0, 0);
     }
     return eob;
 }
 
-void parse_residual(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r,
+void parse_residual(ParseCtxt *parse_ctx, PartitionInfo_t *pi, SvtReader *r,
                     int mi_row, int mi_col, BlockSize mi_size)
 {
-    ParseCtxt   *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     EbColorConfig *color_info = &dec_handle->seq_header.color_config;
     SBInfo *sb_info = pi->sb_info;
     int num_planes = color_info->mono_chrome ? 1 : MAX_MB_PLANE;
@@ -2609,7 +2609,7 @@ void parse_residual(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r,
                     cur_coeff[1] = cur_loc;
                     }
 #endif
-                    int32_t eob = parse_transform_block(dec_handle, pi, r, coeff,
+                    int32_t eob = parse_transform_block(parse_ctx, pi, r, coeff,
                         trans_info[plane], plane,
                         trans_info[plane]->tu_x_offset, trans_info[plane]->tu_y_offset,
                         mi_row, mi_col, trans_info[plane]->tx_size, skip);
@@ -2630,11 +2630,11 @@ void parse_residual(EbDecHandle *dec_handle, PartitionInfo_t *pi, SvtReader *r,
     }
 }
 
-void parse_block(EbDecHandle *dec_handle, uint32_t mi_row, uint32_t mi_col,
+void parse_block(ParseCtxt *parse_ctx, uint32_t mi_row, uint32_t mi_col,
     SvtReader *r, BlockSize subsize, TileInfo *tile, SBInfo *sb_info,
     PartitionType partition)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
 
     int8_t      *cdef_strength = sb_info->sb_cdef_strength;
 
@@ -2717,7 +2717,7 @@ void parse_block(EbDecHandle *dec_handle, uint32_t mi_row, uint32_t mi_col,
     else
         part_info.left_mbmi = NULL;
     mode->sb_type = subsize;
-    mode_info(dec_handle, &part_info, mi_row, mi_col, r, cdef_strength);
+    mode_info(parse_ctx, &part_info, mi_row, mi_col, r, cdef_strength);
 
     /* Replicating same chroma mode for block pairs or 4x4 blks
        when chroma is present in last block*/
@@ -2757,14 +2757,14 @@ void parse_block(EbDecHandle *dec_handle, uint32_t mi_row, uint32_t mi_col,
     ZERO_ARRAY(parse_ctx->num_tus[AOM_PLANE_V], 4);
 
     if (!dec_is_inter_block(mode))
-        palette_tokens(dec_handle, &part_info, mi_row, mi_col, r);
+        palette_tokens(parse_ctx, &part_info, mi_row, mi_col, r);
 
-    read_block_tx_size(dec_handle, r, &part_info, subsize);
+    read_block_tx_size(parse_ctx, r, &part_info, subsize);
 
-    parse_residual(dec_handle, &part_info, r, mi_row, mi_col, subsize);
+    parse_residual(parse_ctx, &part_info, r, mi_row, mi_col, subsize);
 
     /* Update block level MI map */
-    update_block_nbrs(dec_handle, mi_row, mi_col, subsize);
+    update_block_nbrs(parse_ctx, mi_row, mi_col, subsize);
     parse_ctx->cur_mode_info_cnt++;
     parse_ctx->cur_mode_info++;
 }
@@ -2822,10 +2822,10 @@ static INLINE void update_ext_partition_context(ParseCtxt *parse_ctx, int mi_row
     }
 }
 
-void parse_partition(EbDecHandle *dec_handle, uint32_t blk_row, uint32_t blk_col,
+void parse_partition(ParseCtxt *parse_ctx, uint32_t blk_row, uint32_t blk_col,
     SvtReader *reader, BlockSize bsize, SBInfo *sb_info)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
 
     if (blk_row >= dec_handle->frame_header.mi_rows ||
         blk_col >= dec_handle->frame_header.mi_cols)
@@ -2842,16 +2842,16 @@ void parse_partition(EbDecHandle *dec_handle, uint32_t blk_row, uint32_t blk_col
 
     partition = (bsize < BLOCK_8X8) ? PARTITION_NONE
         : parse_partition_type(blk_row, blk_col, reader, bsize,
-            has_rows, has_cols, dec_handle);
+            has_rows, has_cols, parse_ctx);
     int subSize = Partition_Subsize[(int)partition][bsize];
     int splitSize = Partition_Subsize[PARTITION_SPLIT][bsize];
 
 #define PARSE_BLOCK(db_r, db_c, db_subsize)                 \
-parse_block(dec_handle, db_r, db_c, reader, db_subsize,     \
+parse_block(parse_ctx, db_r, db_c, reader, db_subsize,     \
     &parse_ctx->cur_tile_info, sb_info, partition);
 
 #define PARSE_PARTITION(db_r, db_c, db_subsize)                 \
-  parse_partition(dec_handle, (db_r), (db_c), reader,           \
+  parse_partition(parse_ctx, (db_r), (db_c), reader,           \
                    (db_subsize), sb_info)
 
     switch ((int)partition) {
@@ -3035,15 +3035,15 @@ void read_sgrproj_filter(SgrprojInfo *sgrproj_info,
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
 
-void read_lr_unit(EbDecHandle *dec_handle, int32_t row, int32_t col,
+void read_lr_unit(ParseCtxt *parse_ctxt, int32_t row, int32_t col,
     int32_t plane, SvtReader *reader, RestorationUnitInfo *lr_unit)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     UNUSED(row);
     UNUSED(col);
 
     FrameHeader *frame_info = &dec_handle->frame_header;
     const LRParams *lrp = &frame_info->lr_params[plane];
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     if (lrp->frame_restoration_type == RESTORE_NONE) return;
 
     lr_unit->restoration_type = RESTORE_NONE;
@@ -3083,9 +3083,10 @@ void read_lr_unit(EbDecHandle *dec_handle, int32_t row, int32_t col,
     }
 }
 
-void read_lr(EbDecHandle *dec_handle, int32_t row, int32_t col,
+void read_lr(ParseCtxt *parse_ctx, int32_t row, int32_t col,
              SvtReader *reader)
 {
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     FrameHeader *frame_info = &dec_handle->frame_header;
     SeqHeader *seq_header = &dec_handle->seq_header;
     EbColorConfig *color_config = &dec_handle->seq_header.color_config;
@@ -3128,7 +3129,7 @@ void read_lr(EbDecHandle *dec_handle, int32_t row, int32_t col,
                 for (int unit_col = unit_col_start; unit_col < unit_col_end; unit_col++) {
                     RestorationUnitInfo *cur_lr = lr_ctxt->lr_unit[plane] +
                         (unit_row * lr_ctxt->lr_stride[plane]) + unit_col;
-                    read_lr_unit(dec_handle, unit_row, unit_col, plane,
+                    read_lr_unit(parse_ctx, unit_row, unit_col, plane,
                                  reader, cur_lr);
                 }
             }
@@ -3136,17 +3137,17 @@ void read_lr(EbDecHandle *dec_handle, int32_t row, int32_t col,
     }
 }
 
-void parse_super_block(EbDecHandle *dec_handle, uint32_t blk_row,
+void parse_super_block(ParseCtxt *parse_ctx, uint32_t blk_row,
                        uint32_t blk_col, SBInfo *sbInfo)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
+    EbDecHandle *dec_handle = (EbDecHandle *)parse_ctx->dec_handle_ptr;
     SvtReader *reader = &parse_ctx->r;
 
     parse_ctx->read_deltas = dec_handle->frame_header.
                             delta_q_params.delta_q_present;
 
-    read_lr(dec_handle, blk_row, blk_col, reader);
+    read_lr(parse_ctx, blk_row, blk_col, reader);
 
-    parse_partition(dec_handle, blk_row, blk_col, reader,
+    parse_partition(parse_ctx, blk_row, blk_col, reader,
                     dec_handle->seq_header.sb_size, sbInfo);
 }
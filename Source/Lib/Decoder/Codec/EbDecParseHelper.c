@@ -148,9 +148,8 @@ void update_tx_context(ParseCtxt *parse_ctxt, PartitionInfo_t *pi,
 }
 
 TxSize read_selected_tx_size(PartitionInfo_t *xd, SvtReader *r,
-    EbDecHandle *dec_handle)
+    ParseCtxt *parse_ctxt)
 {
-    ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle->pv_parse_ctxt;
     const BlockSize bsize = xd->mi->sb_type;
     const int32_t tx_size_cat = bsize_to_tx_size_cat(bsize);
     const int maxTxDepth = bsize_to_max_depth(bsize);
@@ -43,6 +43,7 @@
 #include "EbDecLF.h"
 
 #include "EbDecCdef.h"
+#include "EbDecMt.h"
 
 
 #define CONFIG_MAX_DECODE_PROFILE 2
@@ -1615,8 +1616,8 @@ void setup_past_independence(EbDecHandle *dec_handle_ptr,
     frame_info->loop_filter_params.mode_deltas[1] = 0;
 }
 
-void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
-                              ObuHeader *obu_header, int num_planes)
+EbErrorType read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
+                                     ObuHeader *obu_header, int num_planes)
 {
     SeqHeader *seq_header = &dec_handle_ptr->seq_header;
     FrameHeader *frame_info = &dec_handle_ptr->frame_header;
@@ -1658,7 +1659,7 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
                 PRINT_FRAME("display_frame_id", display_frame_id);
                 if (display_frame_id != frame_info->ref_frame_idx[frame_to_show_map_idx]
                     && frame_info->ref_valid[frame_to_show_map_idx] == 1)
-                    return; // EB_Corrupt_Frame;
+                    return EB_ErrorNone; // EB_Corrupt_Frame;
             }
 
             //frame_type = RefFrameType[ frame_to_show_map_idx ]
@@ -1672,7 +1673,7 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
             dec_handle_ptr->cur_pic_buf[0] = dec_handle_ptr->
                 ref_frame_map[frame_to_show_map_idx];
             generate_next_ref_frame_map(dec_handle_ptr);
-            return;
+            return EB_ErrorNone;
         }
 
         frame_info->frame_type = dec_get_bits(bs, 2);
@@ -1748,7 +1749,7 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
         // Bitstream conformance
         if (frame_info->current_frame_id == prev_frame_id || diff_frame_id >=
             1 << (id_len - 1))
-            return; // EB_Corrupt_Frame;
+            return EB_ErrorNone; // EB_Corrupt_Frame;
         }
 
         //mark_ref_frames( id_len )
@@ -1890,7 +1891,7 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
                 expected_frame_id = ((frame_info->current_frame_id + (1 << id_len) -
                     (delta_frame_id_length_minus_1 + 1)) % (1 << id_len));
                 if (expected_frame_id != frame_info->ref_frame_idx[i])
-                    return; // EB_Corrupt_Frame;
+                    return EB_ErrorNone; // EB_Corrupt_Frame;
             }
         }
         if (frame_size_override_flag && !frame_info->error_resilient_mode)
@@ -1948,6 +1949,9 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
         &dec_handle_ptr->seq_header, &dec_handle_ptr->frame_header,
         dec_handle_ptr->seq_header.color_config.mono_chrome ? EB_YUV400 :
         dec_handle_ptr->dec_config.max_color_format);
+    /* No free picture buffer or the application could not provide one */
+    if (NULL == dec_handle_ptr->cur_pic_buf[0])
+        return EB_ErrorInsufficientResources;
 
     svt_setup_frame_buf_refs(dec_handle_ptr);
     /*Temporal MVs allocation */
@@ -1975,7 +1979,11 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     read_segmentation_params(bs, dec_handle_ptr, frame_info);
     read_frame_delta_q_params(bs, frame_info);
     read_frame_delta_lf_params(bs, frame_info);
-    setup_segmentation_dequant(dec_handle_ptr, &seq_header->color_config);
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    for (uint32_t i = 0; i < dec_mt_ctxt->num_threads; i++) {
+        setup_segmentation_dequant((DecModCtxt *)dec_mt_ctxt->thread_ctxt[i].
+            pv_dec_mod_ctxt, &seq_header->color_config);
+    }
 
     ParseCtxt *parse_ctxt = (ParseCtxt *)dec_handle_ptr->pv_parse_ctxt;
     if (frame_info->primary_ref_frame == PRIMARY_REF_NONE)
@@ -2051,6 +2059,8 @@ void read_uncompressed_header(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     /* TODO: Should be moved to caller */
     if(!frame_info->show_existing_frame)
         svt_setup_motion_field(dec_handle_ptr);
+
+    return EB_ErrorNone;
 }
 
 EbErrorType read_frame_header_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
@@ -2062,7 +2072,9 @@ EbErrorType read_frame_header_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     uint32_t start_position, end_position, header_bytes;
 
     start_position = get_position(bs);
-    read_uncompressed_header(bs, dec_handle_ptr, obu_header, num_planes);
+    status = read_uncompressed_header(bs, dec_handle_ptr, obu_header,
+                                      num_planes);
+    if (status != EB_ErrorNone) return status;
 
     if (allow_intrabc(dec_handle_ptr)) {
         av1_setup_scale_factors_for_frame(
@@ -2087,12 +2099,12 @@ EbErrorType read_frame_header_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     return status;
 }
 
-void clear_above_context(EbDecHandle *dec_handle_ptr, int mi_col_start,
+void clear_above_context(ParseCtxt *parse_ctxt, int mi_col_start,
                          int mi_col_end, const int tile_row)
 {
     assert(0 == tile_row);
 
-    ParseCtxt   *parse_ctxt = (ParseCtxt *)dec_handle_ptr->pv_parse_ctxt;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     SeqHeader   *seq_params = &dec_handle_ptr->seq_header;
 
     int num_planes  = av1_num_planes(&seq_params->color_config);
@@ -2141,9 +2153,9 @@ void clear_above_context(EbDecHandle *dec_handle_ptr, int mi_col_start,
         tx_size_wide[TX_SIZES_LARGEST], width_y * sizeof(uint8_t));
 }
 
-void clear_left_context(EbDecHandle *dec_handle_ptr)
+void clear_left_context(ParseCtxt *parse_ctxt)
 {
-    ParseCtxt   *parse_ctxt = (ParseCtxt *)dec_handle_ptr->pv_parse_ctxt;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)parse_ctxt->dec_handle_ptr;
     SeqHeader   *seq_params = &dec_handle_ptr->seq_header;
 
     /* Maintained only for 1 left SB! */
@@ -2177,9 +2189,8 @@ void clear_cdef(int8_t *sb_cdef_strength, int32_t cdef_factor)
     memset(sb_cdef_strength, -1, cdef_factor * sizeof(*sb_cdef_strength));
 }
 
-void clear_loop_filter_delta(EbDecHandle *dec_handle)
+void clear_loop_filter_delta(ParseCtxt *parse_ctx)
 {
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle->pv_parse_ctxt;
     for (int lf_id = 0; lf_id < FRAME_LF_COUNT; ++lf_id)
         parse_ctx->parse_nbr4x4_ctxt.delta_lf[lf_id] = 0;
 }
@@ -2192,21 +2203,27 @@ void clear_loop_restoration(int num_planes, PartitionInfo_t *part_info)
     }
 }
 
-EbErrorType parse_tile(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
-                       TilesInfo *tile_info, int32_t tile_row, int32_t tile_col)
+EbErrorType parse_tile(DecThreadCtxt *thread_ctxt, TilesInfo *tile_info,
+                       int32_t tile_row, int32_t tile_col)
 {
-    (void)bs;
     EbErrorType status = EB_ErrorNone;
 
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)thread_ctxt->dec_handle_ptr;
     EbColorConfig *color_config = &dec_handle_ptr->seq_header.color_config;
     int num_planes = av1_num_planes(color_config);
 
-    clear_above_context(dec_handle_ptr, tile_info->tile_col_start_sb[tile_col],
-                        tile_info->tile_col_start_sb[tile_col + 1], 0 /*TODO: For MultiThread*/);
-    clear_loop_filter_delta(dec_handle_ptr);
-
     /* Init ParseCtxt */
-    ParseCtxt *parse_ctx = (ParseCtxt*)dec_handle_ptr->pv_parse_ctxt;
+    ParseCtxt *parse_ctx = (ParseCtxt*)thread_ctxt->pv_parse_ctxt;
+    /* Init DecModCtxt */
+    DecModCtxt *dec_mod_ctxt = (DecModCtxt*)thread_ctxt->pv_dec_mod_ctxt;
+
+    /* In SB row mode only the parse happens here */
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+
+    clear_above_context(parse_ctx, tile_info->tile_col_start_sb[tile_col],
+                        tile_info->tile_col_start_sb[tile_col + 1], 0);
+    clear_loop_filter_delta(parse_ctx);
+
     RestorationUnitInfo *lr_unit[MAX_MB_PLANE];
 
     // Default initialization of Wiener and SGR Filter
@@ -2226,11 +2243,10 @@ EbErrorType parse_tile(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     {
         int32_t sb_row = (mi_row << 2) >> dec_handle_ptr->seq_header.sb_size_log2;
 
-        clear_left_context(dec_handle_ptr);
+        clear_left_context(parse_ctx);
 
-        /*TODO: Move CFL to thread ctxt! We need to access DecModCtxt from parse_tile function */
         /*add tile level cfl init */
-        cfl_init(&((DecModCtxt*)dec_handle_ptr->pv_dec_mod_ctxt)->cfl_ctx, color_config);
+        cfl_init(&dec_mod_ctxt->cfl_ctx, color_config);
 
         for (uint32_t mi_col = tile_info->tile_col_start_sb[tile_col];
             mi_col < tile_info->tile_col_start_sb[tile_col + 1];
@@ -2274,10 +2290,23 @@ EbErrorType parse_tile(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
                 (sb_row * num_mis_in_sb * master_frame_buf->sb_cols >> sy) +
                 (sb_col * num_mis_in_sb >> sx);
 #if SINGLE_THRD_COEFF_BUF_OPT
-            /*TODO : Change to macro */
-            sb_info->sb_coeff[AOM_PLANE_Y] = frame_buf->coeff[AOM_PLANE_Y];
-            sb_info->sb_coeff[AOM_PLANE_U] = frame_buf->coeff[AOM_PLANE_U];
-            sb_info->sb_coeff[AOM_PLANE_V] = frame_buf->coeff[AOM_PLANE_V];
+            if (dec_mt_ctxt->row_mt) {
+                /* Coeffs are held till the SB gets reconstructed */
+                int32_t sb_offset = ((sb_row * master_frame_buf->sb_cols) +
+                                      sb_col) * num_mis_in_sb * (16 + 1);
+                sb_info->sb_coeff[AOM_PLANE_Y] = dec_mt_ctxt->
+                    frame_coeff[AOM_PLANE_Y] + sb_offset;
+                sb_info->sb_coeff[AOM_PLANE_U] = dec_mt_ctxt->
+                    frame_coeff[AOM_PLANE_U] + (sb_offset >> (sy + sx));
+                sb_info->sb_coeff[AOM_PLANE_V] = dec_mt_ctxt->
+                    frame_coeff[AOM_PLANE_V] + (sb_offset >> (sy + sx));
+            }
+            else {
+                /* SB coeff buffers are owned by the tile thread */
+                sb_info->sb_coeff[AOM_PLANE_Y] = thread_ctxt->sb_coeff[AOM_PLANE_Y];
+                sb_info->sb_coeff[AOM_PLANE_U] = thread_ctxt->sb_coeff[AOM_PLANE_U];
+                sb_info->sb_coeff[AOM_PLANE_V] = thread_ctxt->sb_coeff[AOM_PLANE_V];
+            }
 #else
             /*TODO : Change to macro */
             sb_info->sb_coeff[AOM_PLANE_Y] = frame_buf->coeff[AOM_PLANE_Y] +
@@ -2321,8 +2350,6 @@ EbErrorType parse_tile(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
 #endif
             parse_ctx->prev_blk_has_chroma = 1; //default at start of frame / tile
 
-            /* Init DecModCtxt */
-            DecModCtxt *dec_mod_ctxt = (DecModCtxt*)dec_handle_ptr->pv_dec_mod_ctxt;
 #if !FRAME_MI_MAP
             dec_mod_ctxt->sb_row_mi = mi_row;
             dec_mod_ctxt->sb_col_mi = mi_col;
@@ -2340,11 +2367,14 @@ EbErrorType parse_tile(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
             update_nbrs_before_sb(&master_frame_buf->frame_mi_map, sb_col);
 #endif
             // Bit-stream parsing of the superblock
-            parse_super_block(dec_handle_ptr, mi_row, mi_col, sb_info);
+            parse_super_block(parse_ctx, mi_row, mi_col, sb_info);
 
             /* TO DO : Will move later */
             // decoding of the superblock
-            decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
+            if (dec_mt_ctxt->row_mt)
+                eb_post_semaphore(dec_mt_ctxt->sb_row_parse_sem[sb_row]);
+            else
+                decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
 #if !FRAME_MI_MAP
             /* nbr updates at SB level */
             update_nbrs_after_sb(&master_frame_buf->frame_mi_map, sb_col);
@@ -2403,6 +2433,48 @@ void svt_tile_init(TileInfo *cur_tile_info, FrameHeader *frame_header,
     assert(cur_tile_info->mi_col_end > cur_tile_info->mi_col_start);
 }
 
+/* Parses and decodes one tile using the contexts of the given thread */
+EbErrorType decode_tile(DecThreadCtxt *thread_ctxt, DecTileJob *tile_job)
+{
+    EbErrorType status = EB_ErrorNone;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)thread_ctxt->dec_handle_ptr;
+    ParseCtxt   *parse_ctxt = (ParseCtxt *)thread_ctxt->pv_parse_ctxt;
+    ParseCtxt   *master_parse_ctxt = (ParseCtxt *)dec_handle_ptr->pv_parse_ctxt;
+    FrameHeader *frame_header = &dec_handle_ptr->frame_header;
+    TilesInfo   *tiles_info = &frame_header->tiles_info;
+
+    int32_t tile_row = tile_job->tile_num / tiles_info->tile_cols;
+    int32_t tile_col = tile_job->tile_num % tiles_info->tile_cols;
+
+    svt_tile_init(&parse_ctxt->cur_tile_info, frame_header,
+                  tile_row, tile_col);
+
+    parse_ctxt->parse_nbr4x4_ctxt.cur_q_ind =
+        frame_header->quantization_params.base_q_idx;
+
+    status = init_svt_reader(&parse_ctxt->r, tile_job->data,
+        tile_job->data_end, tile_job->tile_size,
+        !(frame_header->disable_cdf_update));
+    if (status != EB_ErrorNone)
+        return status;
+
+    parse_ctxt->cur_tile_ctx = master_parse_ctxt->init_frm_ctx;
+
+    status = parse_tile(thread_ctxt, tiles_info, tile_row, tile_col);
+
+    /* Save CDF */
+    if (!frame_header->disable_frame_end_update_cdf &&
+        (tile_job->tile_num == tiles_info->context_update_tile_id))
+    {
+        dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx =
+                                    parse_ctxt->cur_tile_ctx;
+        eb_av1_reset_cdf_symbol_counters(&dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx);
+    }
+
+    return status;
+}
+
 // Read Tile group information
 EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     TilesInfo *tiles_info, ObuHeader *obu_header, int *is_last_tg)
@@ -2414,7 +2486,6 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     FrameHeader *frame_header = &dec_handle_ptr->frame_header;
 
     int num_tiles, tg_start, tg_end, tile_bits, tile_start_and_end_present_flag = 0;
-    int tile_row, tile_col;
     size_t tile_size;
     uint32_t start_position, end_position, header_bytes;
     num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
@@ -2447,10 +2518,10 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
     header_bytes = (end_position - start_position) / 8;
     obu_header->payload_size -= header_bytes;
 
+    /* Collect the tiles of the tile group, tiles are decoded in parallel */
+    DecMtCtxt *dec_mt_ctxt = (DecMtCtxt *)dec_handle_ptr->pv_dec_mt_ctxt;
+    int32_t num_tile_jobs = 0;
     for (int tile_num = tg_start; tile_num <= tg_end; tile_num++) {
-        tile_row = tile_num / tiles_info->tile_cols;
-        tile_col = tile_num % tiles_info->tile_cols;
-
         if (tile_num == tg_end)
             tile_size = obu_header->payload_size;
         else {
@@ -2458,56 +2529,32 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
             obu_header->payload_size -= (tiles_info->tile_size_bytes + tile_size);
         }
         PRINT_FRAME("tile_size", (tile_size));
-        svt_tile_init(&parse_ctxt->cur_tile_info, frame_header,
-                        tile_row, tile_col);
-
-        parse_ctxt->parse_nbr4x4_ctxt.cur_q_ind =
-            frame_header->quantization_params.base_q_idx;
 
-        //init_symbol(tileSize)
+        DecTileJob *tile_job = &dec_mt_ctxt->tile_jobs[num_tile_jobs++];
+        tile_job->tile_num = tile_num;
+        tile_job->data = (const uint8_t *)get_bitsteam_buf(bs);
+        tile_job->data_end = bs->buf_max;
+        tile_job->tile_size = tile_size;
 
-        status = init_svt_reader(&parse_ctxt->r,
-            (const uint8_t *)get_bitsteam_buf(bs), bs->buf_max, tile_size,
-            !(frame_header->disable_cdf_update));
-        if (status != EB_ErrorNone)
-            return status;
-#if 0
-        reset_parse_ctx(&parse_ctxt->frm_ctx[0],
-            frame_header->quantization_params.base_q_idx);
-#else
-        parse_ctxt->cur_tile_ctx = parse_ctxt->init_frm_ctx;
-#endif
-        /* TO DO decode_tile() */
-        status = parse_tile(bs, dec_handle_ptr, tiles_info, tile_row, tile_col);
-
-        /* Save CDF */
-        if (!frame_header->disable_frame_end_update_cdf &&
-            (tile_num == tiles_info->context_update_tile_id))
-        {
-            dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx =
-                                        parse_ctxt->cur_tile_ctx;
-            eb_av1_reset_cdf_symbol_counters(&dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx);
+        if (tile_num != tg_end) {
+            if (!read_is_valid(tile_job->data, tile_size, bs->buf_max))
+                return EB_Corrupt_Frame;
+            dec_bits_init(bs, (uint8_t *)tile_job->data + tile_size,
+                          obu_header->payload_size);
         }
-
-        dec_bits_init(bs, (uint8_t *)parse_ctxt->r.ec.bptr, obu_header->payload_size);
-
-        if (status != EB_ErrorNone)
-            return status;
     }
 
+    status = dec_mt_decode_tiles(dec_handle_ptr, num_tile_jobs);
+    if (status != EB_ErrorNone)
+        return status;
+
     if ((tg_end + 1) != num_tiles)
         return 0;
 
     if (!dec_handle_ptr->frame_header.allow_intrabc) {
-        if (dec_handle_ptr->frame_header.loop_filter_params.filter_level[0] ||
-            dec_handle_ptr->frame_header.loop_filter_params.filter_level[1])
-        {
-            /*LF Trigger function for each frame*/
-            dec_av1_loop_filter_frame(dec_handle_ptr,
-                dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                dec_handle_ptr->pv_lf_ctxt,
-                AOM_PLANE_Y, MAX_MB_PLANE);
-        }
+        const int32_t do_lf =
+            dec_handle_ptr->frame_header.loop_filter_params.filter_level[0] ||
+            dec_handle_ptr->frame_header.loop_filter_params.filter_level[1];
 
         const int32_t do_cdef =
             !frame_header->coded_lossless &&
@@ -2526,7 +2573,21 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
             lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
             lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE;
 
-        if (!opt_lr) {
+        if (!do_upscale) {
+            /* LF, CDEF and LR pipelined on the rows of the frame */
+            dec_mt_post_filter_frame(dec_handle_ptr, (EbBool)do_lf,
+                                     (EbBool)do_cdef,
+                                     (EbBool)do_loop_restoration);
+        }
+        else {
+            if (do_lf) {
+                /*LF Trigger function for each frame*/
+                dec_av1_loop_filter_frame(dec_handle_ptr,
+                    dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                    dec_handle_ptr->pv_lf_ctxt,
+                    AOM_PLANE_Y, MAX_MB_PLANE);
+            }
+
             if (do_loop_restoration)
                 dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0);
 
@@ -2538,11 +2599,9 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
                     svt_cdef_frame_hbd(dec_handle_ptr);
             }
 
-            if (do_upscale) {
-                av1_superres_upscale(&dec_handle_ptr->frame_header,
-                    &dec_handle_ptr->seq_header,
-                    dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf);
-            }
+            av1_superres_upscale(&dec_handle_ptr->frame_header,
+                &dec_handle_ptr->seq_header,
+                dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf);
 
             if (do_loop_restoration) {
                 dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
@@ -2552,24 +2611,20 @@ EbErrorType read_tile_group_obu(bitstrm_t *bs, EbDecHandle *dec_handle_ptr,
                         &dec_handle_ptr->frame_header);
                 dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr);
             }
-        }
-        else {
-            if (do_loop_restoration) {
-                /* Padded bits are required for filtering pixel around frame boundary */
-                pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                        &dec_handle_ptr->frame_header);
-                dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr);
-            }
+
+            pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                    &dec_handle_ptr->frame_header);
         }
     }
+    else {
+        pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                &dec_handle_ptr->frame_header);
+    }
 
     /* Save CDF */
     if (frame_header->disable_frame_end_update_cdf)
         dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = parse_ctxt->init_frm_ctx;
 
-    pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-            &dec_handle_ptr->frame_header);
-
     return status;
 }
 
@@ -2662,6 +2717,10 @@ EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, siz
                 dec_handle_ptr->seen_frame_header = 1;
                 status = read_frame_header_obu(&bs, dec_handle_ptr, &obu_header,
                                                obu_header.obu_type != OBU_FRAME);
+                if (status != EB_ErrorNone) {
+                    dec_handle_ptr->seen_frame_header = 0;
+                    return status;
+                }
             }
             /*else {
                  For OBU_REDUNDANT_FRAME_HEADER, previous frame_header is taken from dec_handle_ptr->frame_header
@@ -2743,3 +2802,80 @@ EB_API EbErrorType eb_get_sequence_info(
     } while (status == EB_ErrorNone && frame_sz > 0);
     return EB_ErrorUndefined;
 }
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_dec_get_tu_info(
+    const uint8_t *data,
+    size_t         data_size,
+    EbAV1TuInfo   *tu_info)
+{
+    uint8_t reduced_still_picture_header = 0;
+    uint8_t seen_frame_header = 0;
+    size_t pos = 0;
+
+    if (data == NULL || tu_info == NULL)
+        return EB_ErrorBadParameter;
+    memset(tu_info, 0, sizeof(*tu_info));
+
+    /* The headers are read byte by byte, the bit reader would read past
+       the end of the data */
+    while (pos < data_size) {
+        const size_t obu_start = pos;
+        const uint8_t header = data[pos++];
+        const obuType obu_type = (obuType)((header >> 3) & 0xF);
+        uint64_t payload_size = 0;
+        int i;
+
+        /* obu_forbidden_bit, obu_has_size_field */
+        if ((header & 0x80) || !(header & 0x2))
+            return EB_Corrupt_Frame;
+        if (header & 0x4)
+            pos++;
+        for (i = 0; ; i++) {
+            if (pos >= data_size || i == 8)
+                return EB_Corrupt_Frame;
+            payload_size |= (uint64_t)(data[pos] & 0x7f) << (7 * i);
+            if (!(data[pos++] & 0x80))
+                break;
+        }
+        if (payload_size > data_size - pos)
+            return EB_Corrupt_Frame;
+
+        switch (obu_type) {
+        case OBU_SEQUENCE_HEADER:
+            tu_info->seq_header_offset = (uint32_t)obu_start;
+            tu_info->seq_header_size = (uint32_t)(pos + payload_size - obu_start);
+            /* seq_profile f(3), still_picture f(1), reduced_still_picture_header f(1) */
+            if (payload_size)
+                reduced_still_picture_header = (data[pos] >> 3) & 1;
+            break;
+        case OBU_FRAME_HEADER:
+        case OBU_FRAME:
+            /* The first frame of the TU is the one of the base layer */
+            if (!seen_frame_header && payload_size) {
+                seen_frame_header = 1;
+                if (reduced_still_picture_header) {
+                    tu_info->frame_type = KEY_FRAME;
+                    tu_info->show_frame = EB_TRUE;
+                }
+                else {
+                    /* show_existing_frame f(1), frame_type f(2), show_frame f(1) */
+                    tu_info->show_existing_frame = (EbBool)(data[pos] >> 7);
+                    if (!tu_info->show_existing_frame) {
+                        tu_info->frame_type = (data[pos] >> 5) & 3;
+                        tu_info->show_frame = (EbBool)((data[pos] >> 4) & 1);
+                    }
+                }
+                tu_info->random_access_point = !tu_info->show_existing_frame &&
+                    tu_info->frame_type == KEY_FRAME && tu_info->show_frame;
+            }
+            break;
+        default:
+            break;
+        }
+        pos += (size_t)payload_size;
+    }
+    return EB_ErrorNone;
+}
@@ -82,6 +82,10 @@ EbErrorType dec_pic_mgr_init(EbDecHandle  *dec_handle_ptr) {
 
     ps_pic_mgr->num_pic_bufs = 0;
 
+    ps_pic_mgr->allocate_buffer = dec_handle_ptr->allocate_buffer;
+    ps_pic_mgr->release_buffer = dec_handle_ptr->release_buffer;
+    ps_pic_mgr->ext_fb_priv_data = dec_handle_ptr->ext_fb_priv_data;
+
     return return_error;
 }
 
@@ -97,6 +101,44 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs,
     return EB_ErrorNone;
 }
 
+/* Takes the memory of the picture buffer from the application. The Y, Cb
+   and Cr planes follow each other, ALVALUE aligned as the SIMD kernels
+   expect. The intra edge fetch of the bottom blocks reads below the bottom
+   padding, hence the guard rows after the last plane */
+static EbErrorType alloc_ext_frame_buf(EbDecPicMgr *ps_pic_mgr,
+                                       EbDecPicBuf *ps_pic_buf)
+{
+    EbPictureBufferDesc *pic = ps_pic_buf->ps_pic_buf;
+    EbExtFrameBuf *ext_frame_buf = &ps_pic_buf->ext_frame_buf;
+    uint32_t bytes_per_pixel = (pic->bit_depth == EB_8BIT) ? 1 : 2;
+    uint32_t luma_bytes = ALIGN_POWER_OF_TWO(pic->luma_size *
+                                             bytes_per_pixel, 6);
+    uint32_t chroma_bytes = (pic->color_format == EB_YUV400) ? 0 :
+        ALIGN_POWER_OF_TWO(pic->chroma_size * bytes_per_pixel, 6);
+    uint32_t guard_bytes = pic->stride_y * bytes_per_pixel * MAX_SB_SIZE;
+    uint32_t min_size = luma_bytes + 2 * chroma_bytes + guard_bytes +
+                        ALVALUE - 1;
+
+    ext_frame_buf->buffer = NULL;
+    ext_frame_buf->buffer_size = 0;
+    ext_frame_buf->private_data = NULL;
+    if (ps_pic_mgr->allocate_buffer(ext_frame_buf, min_size,
+                                    ps_pic_mgr->ext_fb_priv_data))
+        return EB_ErrorInsufficientResources;
+    /* An unusable buffer still goes back to the application */
+    if (NULL == ext_frame_buf->buffer || ext_frame_buf->buffer_size < min_size) {
+        ps_pic_mgr->release_buffer(ext_frame_buf, ps_pic_mgr->ext_fb_priv_data);
+        return EB_ErrorInsufficientResources;
+    }
+
+    pic->buffer_y = (EbByte)(((uintptr_t)ext_frame_buf->buffer + ALVALUE - 1) &
+                             ~(uintptr_t)(ALVALUE - 1));
+    pic->buffer_cb = chroma_bytes ? pic->buffer_y + luma_bytes : NULL;
+    pic->buffer_cr = chroma_bytes ? pic->buffer_cb + chroma_bytes : NULL;
+
+    return EB_ErrorNone;
+}
+
 /**
 *******************************************************************************
 *
@@ -154,6 +196,9 @@ EbDecPicBuf * dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr,
                                                         EB_YUV400 : color_format;
         input_picture_buffer_desc_init_data.buffer_enable_mask = cc->mono_chrome ?
             PICTURE_BUFFER_DESC_LUMA_MASK : PICTURE_BUFFER_DESC_FULL_MASK;
+        /* The planes come from the application with every new frame */
+        if (ps_pic_mgr->allocate_buffer)
+            input_picture_buffer_desc_init_data.buffer_enable_mask = 0;
 
         input_picture_buffer_desc_init_data.left_padding  = PAD_VALUE;
         input_picture_buffer_desc_init_data.right_padding = PAD_VALUE;
@@ -179,6 +224,11 @@ EbDecPicBuf * dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr,
     else
         assert(ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL);
 
+    if (ps_pic_mgr->allocate_buffer &&
+        alloc_ext_frame_buf(ps_pic_mgr, &ps_pic_mgr->as_dec_pic[i]) !=
+        EB_ErrorNone)
+        return NULL;
+
     ps_pic_mgr->as_dec_pic[i].is_free = 0;
     ps_pic_mgr->as_dec_pic[i].ref_count = 1;
 
@@ -187,15 +237,54 @@ EbDecPicBuf * dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr,
     return pic_buf;
 }
 
-static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
+/* Gives the memory of an external picture buffer back to the application */
+static INLINE void release_ext_frame_buf(EbDecPicMgr *ps_pic_mgr,
+                                         EbDecPicBuf *ps_pic_buf)
+{
+    EbPictureBufferDesc *pic = ps_pic_buf->ps_pic_buf;
+
+    ps_pic_mgr->release_buffer(&ps_pic_buf->ext_frame_buf,
+                               ps_pic_mgr->ext_fb_priv_data);
+    pic->buffer_y = NULL;
+    pic->buffer_cb = NULL;
+    pic->buffer_cr = NULL;
+}
+
+static INLINE void dec_ref_count_and_rel(EbDecPicMgr *ps_pic_mgr,
+                                         EbDecPicBuf *ps_pic_buf) {
 
     if (ps_pic_buf != NULL) {
 
         ps_pic_buf->ref_count--;
         assert(ps_pic_buf->ref_count >= 0);
 
-        if (ps_pic_buf->ref_count == 0)
+        if (ps_pic_buf->ref_count == 0) {
             ps_pic_buf->is_free = 1;
+            if (ps_pic_mgr->release_buffer)
+                release_ext_frame_buf(ps_pic_mgr, ps_pic_buf);
+        }
+    }
+}
+
+/* Drops a reference taken on the picture buffer */
+void dec_pic_mgr_release_pic(EbDecHandle *dec_handle_ptr,
+                             EbDecPicBuf *ps_pic_buf) {
+    dec_ref_count_and_rel((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr,
+                          ps_pic_buf);
+}
+
+/* Gives all the external picture buffers still in use back to the
+   application. Called on decoder deinit */
+void dec_pic_mgr_release_ext_frame_bufs(EbDecHandle *dec_handle_ptr) {
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    if (NULL == ps_pic_mgr->release_buffer)
+        return;
+    for (int32_t i = 0; i < MAX_PIC_BUFS; i++) {
+        if (0 == ps_pic_mgr->as_dec_pic[i].is_free) {
+            release_ext_frame_buf(ps_pic_mgr, &ps_pic_mgr->as_dec_pic[i]);
+            ps_pic_mgr->as_dec_pic[i].is_free = 1;
+        }
     }
 }
 
@@ -221,12 +310,14 @@ static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags)
 {
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
     int32_t ref_index = 0, mask;
 
     /* TODO: Add lock and unlock for MT */
     if (frame_decoded) {
         for (mask = refresh_frame_flags; mask; mask >>= 1) {
-            dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+            dec_ref_count_and_rel(ps_pic_mgr,
+                                  dec_handle_ptr->ref_frame_map[ref_index]);
             dec_handle_ptr->ref_frame_map[ref_index] = dec_handle_ptr->
                                                 next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
@@ -234,7 +325,8 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
         }
 
         for (; ref_index < REF_FRAMES; ++ref_index) {
-            dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+            dec_ref_count_and_rel(ps_pic_mgr,
+                                  dec_handle_ptr->ref_frame_map[ref_index]);
             dec_handle_ptr->ref_frame_map[ref_index] = dec_handle_ptr->
                                                 next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
@@ -246,11 +338,11 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
             //assert(0);
         }
         else
-            dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+            dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->cur_pic_buf[0]);
     }
     else {
         // Nothing was decoded, so just drop this frame buffer
-        dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+        dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->cur_pic_buf[0]);
     }
 
     /* Invalidate these references until the next frame starts. */
@@ -19,6 +19,11 @@ typedef struct EbDecPicMgr {
     /* number of picture buffers */
     uint8_t     num_pic_bufs;
 
+    /* External frame buffer callbacks, NULL for internal buffers */
+    eb_allocate_frame_buffer    allocate_buffer;
+    eb_release_frame_buffer     release_buffer;
+    void                        *ext_fb_priv_data;
+
 } EbDecPicMgr;
 
 typedef struct RefFrameInfo {
@@ -35,6 +40,11 @@ EbDecPicBuf * dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr,
                                       FrameHeader *frame_info,
                                       EbColorFormat color_format);
 
+void dec_pic_mgr_release_pic(EbDecHandle *dec_handle_ptr,
+                             EbDecPicBuf *ps_pic_buf);
+
+void dec_pic_mgr_release_ext_frame_bufs(EbDecHandle *dec_handle_ptr);
+
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags);
 
@@ -256,7 +256,7 @@ void decode_block(DecModCtxt *dec_mod_ctxt, int32_t mi_row, int32_t mi_col,
             int32_t nsamples = 0;
             int32_t apply_wm = 0;
 
-            nsamples = find_warp_samples(dec_handle, &part_info, mi_row, mi_col, pts, pts_inref);
+            nsamples = find_warp_samples(dec_handle, tile, &part_info, mi_row, mi_col, pts, pts_inref);
             assert(nsamples > 0);
 
             MV mv = mode_info->mv[REF_LIST_0].as_mv;
@@ -292,7 +292,7 @@ void decode_block(DecModCtxt *dec_mod_ctxt, int32_t mi_row, int32_t mi_col,
     }
 
     if (inter_block)
-        svtav1_predict_inter_block(dec_handle, &part_info, mi_row, mi_col,
+        svtav1_predict_inter_block(dec_mod_ctxt, &part_info, mi_row, mi_col,
             num_planes);
 
     TxType tx_type;
@@ -392,7 +392,7 @@ void decode_block(DecModCtxt *dec_mod_ctxt, int32_t mi_row, int32_t mi_col,
 #endif
                 tx_type = trans_info->txk_type;
 
-                n_coeffs = inverse_quantize(dec_handle, &part_info,
+                n_coeffs = inverse_quantize(dec_mod_ctxt, &part_info,
                     mode_info, coeffs, qcoeffs, tx_type, tx_size, plane);
                 if (n_coeffs != 0) {
                     dec_mod_ctxt->cur_coeff[plane] += (n_coeffs + 1);
@@ -75,8 +75,9 @@ typedef struct LRCtxt {
     /* Used to store CDEF line buffer around stripe boundary */
     RestorationLineBuffers *rlbs;
 
-    /* Scratch buffer to hold LR output */
-    uint8_t *dst;
+    /* Scratch buffers to hold LR output, one per plane so that the
+       planes can be restored as their rows get ready */
+    uint8_t *dst[MAX_MB_PLANE];
     uint16_t dst_stride;
 
     /* Pointer to a scratch buffer used by self-guided restoration */
@@ -44,6 +44,132 @@ int av1_superres_scaled(FrameSize *frame_size) {
     return !(frame_size->frame_width == frame_size->superres_upscaled_width);
 }
 
+/* Number of restoration unit rows of the plane, the last one absorbing
+   any remainder smaller than half a unit */
+int dec_av1_lr_num_unit_rows(EbDecHandle *dec_handle, int plane)
+{
+    LRParams *lr_params = &dec_handle->frame_header.lr_params[plane];
+    AV1PixelRect tile_rect = av1_whole_frame_rect(dec_handle, plane > 0);
+    int tile_h = tile_rect.bottom - tile_rect.top;
+    int unit_size = lr_params->loop_restoration_size;
+
+    return AOMMAX((tile_h + (unit_size >> 1)) / unit_size, 1);
+}
+
+/* Rows of the plane read by the restoration of unit row unit_row,
+   including the rows above and below the filtering needs */
+void dec_av1_lr_unit_row_limits(EbDecHandle *dec_handle, int plane,
+                                int unit_row, RestorationTileLimits *limits)
+{
+    LRParams *lr_params = &dec_handle->frame_header.lr_params[plane];
+    int sy = plane ? dec_handle->seq_header.color_config.subsampling_y : 0;
+    AV1PixelRect tile_rect = av1_whole_frame_rect(dec_handle, plane > 0);
+    int unit_size = lr_params->loop_restoration_size;
+    int num_unit_rows = dec_av1_lr_num_unit_rows(dec_handle, plane);
+
+    limits->v_start = tile_rect.top + unit_row * unit_size;
+    limits->v_end = (unit_row == num_unit_rows - 1) ? tile_rect.bottom :
+        tile_rect.top + (unit_row + 1) * unit_size;
+
+    // Offset the tile upwards to align with the restoration processing stripe
+    const int voffset = RESTORATION_UNIT_OFFSET >> sy;
+    limits->v_start = AOMMAX(tile_rect.top, limits->v_start - voffset);
+    if (limits->v_end < tile_rect.bottom) limits->v_end -= voffset;
+}
+
+/* Restores the units of one unit row of the plane into lr_ctxt->dst */
+void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int plane,
+                                         int unit_row, int optimized_lr)
+{
+    LRCtxt *lr_ctxt = (LRCtxt *)dec_handle->pv_lr_ctxt;
+    LRParams *lr_params = &dec_handle->frame_header.lr_params[plane];
+    EbPictureBufferDesc *cur_pic_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    RestorationTileLimits tile_limit;
+    RestorationUnitInfo *lr_unit;
+    int use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
+    int bit_depth = dec_handle->seq_header.color_config.bit_depth;
+    int ext_size = lr_params->loop_restoration_size * 3 / 2;
+    int is_uv = plane > 0;
+    int sx = 0, sy = 0, w = 0, x, unit_col;
+    int src_stride, dst_stride, tile_stripe0 = 0;
+    uint8_t *src, *dst;
+
+    if (plane) {
+        sx = dec_handle->seq_header.color_config.subsampling_x;
+        sy = dec_handle->seq_header.color_config.subsampling_y;
+    }
+
+    // src points to frame start
+    derive_blk_pointers(cur_pic_buf, plane, 0, 0, (void *)&src,
+                        &src_stride, sx, sy);
+
+    dst = lr_ctxt->dst[plane];
+    dst_stride = lr_ctxt->dst_stride;
+
+    AV1PixelRect tile_rect = av1_whole_frame_rect(dec_handle, is_uv);
+    int tile_w = tile_rect.right - tile_rect.left;
+
+    dec_av1_lr_unit_row_limits(dec_handle, plane, unit_row, &tile_limit);
+    assert(tile_limit.v_end <= tile_rect.bottom);
+
+    for (x = 0, unit_col = 0; x < tile_w; x += w, unit_col++)
+    {
+        int remaining_w = tile_w - x;
+        w = (remaining_w < ext_size) ? remaining_w :
+                                       lr_params->loop_restoration_size;
+
+        tile_limit.h_start = tile_rect.left + x;
+        tile_limit.h_end = tile_rect.left + x + w;
+
+        lr_unit = lr_ctxt->lr_unit[plane] +
+            unit_row * lr_ctxt->lr_stride[plane] + unit_col;
+
+        if (!use_highbd)
+            eb_av1_loop_restoration_filter_unit(1, &tile_limit, lr_unit,
+                &lr_ctxt->boundaries[plane], lr_ctxt->rlbs, &tile_rect,
+                tile_stripe0, sx, sy, use_highbd, bit_depth, src,
+                src_stride, dst, dst_stride, lr_ctxt->rst_tmpbuf, optimized_lr);
+        else
+            eb_av1_loop_restoration_filter_unit(1, &tile_limit, lr_unit,
+                &lr_ctxt->boundaries[plane], lr_ctxt->rlbs, &tile_rect,
+                tile_stripe0, sx, sy, use_highbd, bit_depth,
+                CONVERT_TO_BYTEPTR(src), src_stride, CONVERT_TO_BYTEPTR(dst),
+                dst_stride, lr_ctxt->rst_tmpbuf, optimized_lr);
+    }
+}
+
+/* Copies the restored rows of one unit row back to the frame. The unit
+   row below reads these rows unrestored, so it has to be filtered first */
+void dec_av1_loop_restoration_copy_row(EbDecHandle *dec_handle, int plane,
+                                       int unit_row)
+{
+    LRCtxt *lr_ctxt = (LRCtxt *)dec_handle->pv_lr_ctxt;
+    EbPictureBufferDesc *cur_pic_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    RestorationTileLimits tile_limit;
+    int use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
+    int sx = 0, sy = 0;
+    int src_stride, dst_stride = lr_ctxt->dst_stride;
+    uint8_t *src, *dst;
+
+    if (plane) {
+        sx = dec_handle->seq_header.color_config.subsampling_x;
+        sy = dec_handle->seq_header.color_config.subsampling_y;
+    }
+
+    derive_blk_pointers(cur_pic_buf, plane, 0, 0, (void *)&src,
+                        &src_stride, sx, sy);
+
+    dec_av1_lr_unit_row_limits(dec_handle, plane, unit_row, &tile_limit);
+    src += (tile_limit.v_start * src_stride) << use_highbd;
+    dst = lr_ctxt->dst[plane] + ((tile_limit.v_start * dst_stride) << use_highbd);
+
+    for (int y = tile_limit.v_start; y < tile_limit.v_end; y++) {
+        memcpy(src, dst, dst_stride * sizeof(*dst) << use_highbd);
+        src += src_stride << use_highbd;
+        dst += dst_stride << use_highbd;
+    }
+}
+
 void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr)
 {
     assert(!dec_handle->frame_header.all_lossless);
@@ -52,92 +178,24 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
     LRCtxt *lr_ctxt = (LRCtxt *)dec_handle->pv_lr_ctxt;
     MasterFrameBuf *master_frame_buf = &dec_handle->master_frame_buf;
     CurFrameBuf    *frame_buf = &master_frame_buf->cur_frame_bufs[0];
-    RestorationTileLimits tile_limit;
-    AV1PixelRect tile_rect;
-    EbPictureBufferDesc *cur_pic_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
-    RestorationUnitInfo *lr_unit;
 
     lr_ctxt->lr_unit[AOM_PLANE_Y] = frame_buf->lr_unit[AOM_PLANE_Y];
     lr_ctxt->lr_unit[AOM_PLANE_U] = frame_buf->lr_unit[AOM_PLANE_U];
     lr_ctxt->lr_unit[AOM_PLANE_V] = frame_buf->lr_unit[AOM_PLANE_V];
 
     int num_plane = av1_num_planes(&dec_handle->seq_header.color_config);
-    int use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
-    int bit_depth = dec_handle->seq_header.color_config.bit_depth;
-    int h = 0, w = 0, x, y, unit_row, unit_col;
-    int src_stride, dst_stride, tile_stripe0 = 0;
-    uint8_t *src, *dst;
 
     for (int plane = 0; plane < num_plane; plane++)
     {
-        LRParams *lr_params = &frame_header->lr_params[plane];
-        int ext_size = lr_params->loop_restoration_size * 3 / 2;
-        int is_uv = plane > 0;
-        int sx = 0, sy = 0;
-
-        if (plane) {
-            sx = dec_handle->seq_header.color_config.subsampling_x;
-            sy = dec_handle->seq_header.color_config.subsampling_y;
-        }
-
-        // src points to frame start
-        derive_blk_pointers(cur_pic_buf, plane, 0, 0, (void *)&src,
-                            &src_stride, sx, sy);
-
-        dst = lr_ctxt->dst;
-        dst_stride = lr_ctxt->dst_stride;
-
-        tile_rect = av1_whole_frame_rect(dec_handle, is_uv);
-        int tile_h = tile_rect.bottom - tile_rect.top;
-        int tile_w = tile_rect.right - tile_rect.left;
-
-        if (lr_params->frame_restoration_type == RESTORE_NONE)
+        if (frame_header->lr_params[plane].frame_restoration_type == RESTORE_NONE)
             continue;
 
-        for (y = 0, unit_row = 0; y < tile_h; y += h, unit_row++)
-        {
-            int remaining_h = tile_h - y;
-            h = (remaining_h < ext_size) ? remaining_h :
-                                           lr_params->loop_restoration_size;
-            tile_limit.v_start = tile_rect.top + y;
-            tile_limit.v_end   = tile_rect.top + y + h;
-            assert(tile_limit.v_end <= tile_rect.bottom);
-
-            // Offset the tile upwards to align with the restoration processing stripe
-            const int voffset = RESTORATION_UNIT_OFFSET >> sy;
-            tile_limit.v_start = AOMMAX(tile_rect.top, tile_limit.v_start - voffset);
-            if (tile_limit.v_end < tile_rect.bottom) tile_limit.v_end -= voffset;
-
-            for (x = 0, unit_col = 0; x < tile_w; x += w, unit_col++)
-            {
-                int remaining_w = tile_w - x;
-                w = (remaining_w < ext_size) ? remaining_w :
-                                               lr_params->loop_restoration_size;
-
-                tile_limit.h_start = tile_rect.left + x;
-                tile_limit.h_end = tile_rect.left + x + w;
-
-                lr_unit = lr_ctxt->lr_unit[plane] +
-                    unit_row * lr_ctxt->lr_stride[plane] + unit_col;
-
-                if (!use_highbd)
-                    eb_av1_loop_restoration_filter_unit(1, &tile_limit, lr_unit,
-                        &lr_ctxt->boundaries[plane], lr_ctxt->rlbs, &tile_rect,
-                        tile_stripe0, sx, sy, use_highbd, bit_depth, src,
-                        src_stride, dst, dst_stride, lr_ctxt->rst_tmpbuf, optimized_lr);
-                else
-                    eb_av1_loop_restoration_filter_unit(1, &tile_limit, lr_unit,
-                        &lr_ctxt->boundaries[plane], lr_ctxt->rlbs, &tile_rect,
-                        tile_stripe0, sx, sy, use_highbd, bit_depth,
-                        CONVERT_TO_BYTEPTR(src), src_stride, CONVERT_TO_BYTEPTR(dst),
-                        dst_stride, lr_ctxt->rst_tmpbuf, optimized_lr);
-            }
-        }
-        for (y = 0; y < tile_h; y++) {
-            memcpy(src, dst, dst_stride * sizeof(*dst) << use_highbd);
-            src += src_stride << use_highbd;
-            dst += dst_stride << use_highbd;
-        }
+        int num_unit_rows = dec_av1_lr_num_unit_rows(dec_handle, plane);
+        for (int unit_row = 0; unit_row < num_unit_rows; unit_row++)
+            dec_av1_loop_restoration_filter_row(dec_handle, plane, unit_row,
+                                                optimized_lr);
+        for (int unit_row = 0; unit_row < num_unit_rows; unit_row++)
+            dec_av1_loop_restoration_copy_row(dec_handle, plane, unit_row);
     }
 }
 
@@ -262,8 +320,10 @@ void dec_save_cdef_boundary_lines(EbDecHandle *dec_handle,
         RESTORATION_EXTRA_HORZ, use_highbd);
 }
 
-void dec_save_tile_row_boundary_lines(EbDecHandle *dec_handle, int use_highbd,
-                                      int plane, int after_cdef)
+/* Saves the context lines of one 64 luma row processing stripe. Returns 0
+   once the stripe is past the bottom of the frame */
+static int dec_save_stripe_boundary_lines(EbDecHandle *dec_handle,
+    int use_highbd, int plane, int tile_stripe, int after_cdef)
 {
     const int is_uv = plane > 0;
     const int ss_y = is_uv && dec_handle->seq_header.color_config.subsampling_y;
@@ -282,52 +342,60 @@ void dec_save_tile_row_boundary_lines(EbDecHandle *dec_handle, int use_highbd,
 
     const int plane_height = ROUND_POWER_OF_TWO(frame_height, ss_y);
 
-    int tile_stripe;
-    for (tile_stripe = 0;; ++tile_stripe) {
-        const int rel_y0 = AOMMAX(0, tile_stripe * stripe_height - stripe_off);
-        const int y0 = tile_rect.top + rel_y0;
-        if (y0 >= tile_rect.bottom)
-            break;
+    const int rel_y0 = AOMMAX(0, tile_stripe * stripe_height - stripe_off);
+    const int y0 = tile_rect.top + rel_y0;
+    if (y0 >= tile_rect.bottom)
+        return 0;
+
+    const int rel_y1 = (tile_stripe + 1) * stripe_height - stripe_off;
+    const int y1 = AOMMIN(tile_rect.top + rel_y1, tile_rect.bottom);
+
+    const int frame_stripe = stripe0 + tile_stripe;
 
-        const int rel_y1 = (tile_stripe + 1) * stripe_height - stripe_off;
-        const int y1 = AOMMIN(tile_rect.top + rel_y1, tile_rect.bottom);
-
-        const int frame_stripe = stripe0 + tile_stripe;
-
-        // In this case, we should only use CDEF pixels at the top
-        // and bottom of the frame as a whole; internal tile boundaries
-        // can use deblocked pixels from adjacent tiles for context.
-        const int use_deblock_above = (frame_stripe > 0);
-        const int use_deblock_below = (y1 < plane_height);
-
-        if (!after_cdef) {
-            // Save deblocked context where needed.
-            if (use_deblock_above) {
-                dec_save_deblock_boundary_lines(dec_handle, plane,
-                    y0 - RESTORATION_CTX_VERT, frame_stripe, use_highbd, 1, boundaries);
-            }
-            if (use_deblock_below) {
-                dec_save_deblock_boundary_lines(dec_handle, plane, y1, frame_stripe,
-                    use_highbd, 0, boundaries);
-            }
+    // In this case, we should only use CDEF pixels at the top
+    // and bottom of the frame as a whole; internal tile boundaries
+    // can use deblocked pixels from adjacent tiles for context.
+    const int use_deblock_above = (frame_stripe > 0);
+    const int use_deblock_below = (y1 < plane_height);
+
+    if (!after_cdef) {
+        // Save deblocked context where needed.
+        if (use_deblock_above) {
+            dec_save_deblock_boundary_lines(dec_handle, plane,
+                y0 - RESTORATION_CTX_VERT, frame_stripe, use_highbd, 1, boundaries);
         }
-        else {
-            // Save CDEF context where needed. Note that we need to save the CDEF
-            // context for a particular boundary iff we *didn't* save deblocked
-            // context for that boundary.
-            //
-            // In addition, we need to save copies of the outermost line within
-            // the tile, rather than using data from outside the tile.
-            if (!use_deblock_above) {
-                dec_save_cdef_boundary_lines(dec_handle, plane, y0,
-                    frame_stripe, use_highbd, 1, boundaries);
-            }
-            if (!use_deblock_below) {
-                dec_save_cdef_boundary_lines(dec_handle, plane, y1 - 1,
-                    frame_stripe, use_highbd, 0, boundaries);
-            }
+        if (use_deblock_below) {
+            dec_save_deblock_boundary_lines(dec_handle, plane, y1, frame_stripe,
+                use_highbd, 0, boundaries);
         }
     }
+    else {
+        // Save CDEF context where needed. Note that we need to save the CDEF
+        // context for a particular boundary iff we *didn't* save deblocked
+        // context for that boundary.
+        //
+        // In addition, we need to save copies of the outermost line within
+        // the tile, rather than using data from outside the tile.
+        if (!use_deblock_above) {
+            dec_save_cdef_boundary_lines(dec_handle, plane, y0,
+                frame_stripe, use_highbd, 1, boundaries);
+        }
+        if (!use_deblock_below) {
+            dec_save_cdef_boundary_lines(dec_handle, plane, y1 - 1,
+                frame_stripe, use_highbd, 0, boundaries);
+        }
+    }
+    return 1;
+}
+
+void dec_save_tile_row_boundary_lines(EbDecHandle *dec_handle, int use_highbd,
+                                      int plane, int after_cdef)
+{
+    for (int tile_stripe = 0;; ++tile_stripe) {
+        if (!dec_save_stripe_boundary_lines(dec_handle, use_highbd, plane,
+                                            tile_stripe, after_cdef))
+            break;
+    }
 }
 
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle,
@@ -338,3 +406,14 @@ void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle,
     for (int p = 0; p < num_planes; ++p)
         dec_save_tile_row_boundary_lines(dec_handle, use_highbd, p, after_cdef);
 }
+
+/* Saves the context lines of one processing stripe for all the planes */
+void dec_av1_loop_restoration_save_stripe_boundary_lines(
+    EbDecHandle *dec_handle, int stripe, int after_cdef)
+{
+    const int num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    const int use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
+    for (int p = 0; p < num_planes; ++p)
+        dec_save_stripe_boundary_lines(dec_handle, use_highbd, p, stripe,
+                                       after_cdef);
+}
@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include "EbDecHandle.h"
+#include "EbRestoration.h"
 
 int av1_superres_scaled(FrameSize *frame_size);
 
@@ -19,6 +20,17 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle,
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle,
                                                   int after_cdef);
 
+/* Row level restoration, used by the post filter pipeline */
+int dec_av1_lr_num_unit_rows(EbDecHandle *dec_handle, int plane);
+void dec_av1_lr_unit_row_limits(EbDecHandle *dec_handle, int plane,
+                                int unit_row, RestorationTileLimits *limits);
+void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int plane,
+                                         int unit_row, int optimized_lr);
+void dec_av1_loop_restoration_copy_row(EbDecHandle *dec_handle, int plane,
+                                       int unit_row);
+void dec_av1_loop_restoration_save_stripe_boundary_lines(
+    EbDecHandle *dec_handle, int stripe, int after_cdef);
+
 #ifdef __cplusplus
 }
 #endif
@@ -179,6 +179,117 @@ void pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr) {
     }
 }
 
+/* Pads the rows [y0, y1) of one plane. The rows above the plane get padded
+   with row 0 and the rows below with the last row */
+static void pad_plane_rows(EbByte buf, uint32_t stride, uint32_t width,
+                           uint32_t height, uint32_t origin_x,
+                           uint32_t origin_y, uint32_t y0, uint32_t y1,
+                           EbBool is_16bit)
+{
+    if (y1 > y0) {
+        if (is_16bit)
+            generate_padding16_bit(buf + (origin_y + y0) * stride, stride,
+                                   width, y1 - y0, origin_x, 0);
+        else
+            generate_padding(buf + (origin_y + y0) * stride, stride,
+                             width, y1 - y0, origin_x, 0);
+    }
+
+    if (0 == y0) {
+        EbByte first_row = buf + origin_y * stride;
+        for (uint32_t i = 1; i <= origin_y; i++)
+            EB_MEMCPY(first_row - i * stride, first_row, stride);
+    }
+    if (height == y1) {
+        EbByte last_row = buf + (origin_y + height - 1) * stride;
+        for (uint32_t i = 1; i <= origin_y; i++)
+            EB_MEMCPY(last_row + i * stride, last_row, stride);
+    }
+}
+
+/* Pads the luma rows [y0, y1) of the picture and the matching chroma rows.
+   Padding all the rows of a frame gives the same result as pad_pic */
+void pad_pic_rows(EbPictureBufferDesc *recon_picture_buf,
+                  FrameHeader *frame_hdr, uint32_t y0, uint32_t y1)
+{
+    FrameSize *frame_size = &frame_hdr->frame_size;
+    uint32_t width = frame_size->superres_upscaled_width;
+    uint32_t height = frame_size->frame_height;
+    int32_t sx = 0, sy = 0;
+
+    switch (recon_picture_buf->color_format) {
+        case EB_YUV400:
+            sx = -1;
+            sy = -1;
+            break;
+        case EB_YUV420:
+            sx = 1;
+            sy = 1;
+            break;
+        case EB_YUV422:
+            sx = 1;
+            sy = 0;
+            break;
+        case EB_YUV444:
+            sx = 0;
+            sy = 0;
+            break;
+        default:
+            assert(0);
+    }
+
+    if (recon_picture_buf->bit_depth == EB_8BIT) {
+        // Y samples
+        pad_plane_rows(recon_picture_buf->buffer_y,
+            recon_picture_buf->stride_y, width, height,
+            recon_picture_buf->origin_x, recon_picture_buf->origin_y,
+            y0, y1, EB_FALSE);
+
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            uint32_t height_uv = (height + sy) >> sy;
+            uint32_t y0_uv = y0 >> sy;
+            uint32_t y1_uv = (y1 == height) ? height_uv : y1 >> sy;
+
+            // Cb samples
+            pad_plane_rows(recon_picture_buf->buffer_cb,
+                recon_picture_buf->stride_cb, (width + sx) >> sx, height_uv,
+                recon_picture_buf->origin_x >> sx,
+                recon_picture_buf->origin_y >> sy, y0_uv, y1_uv, EB_FALSE);
+
+            // Cr samples
+            pad_plane_rows(recon_picture_buf->buffer_cr,
+                recon_picture_buf->stride_cr, (width + sx) >> sx, height_uv,
+                recon_picture_buf->origin_x >> sx,
+                recon_picture_buf->origin_y >> sy, y0_uv, y1_uv, EB_FALSE);
+        }
+    }
+    else {
+        // Y samples
+        pad_plane_rows(recon_picture_buf->buffer_y,
+            recon_picture_buf->stride_y << 1, width << 1, height,
+            recon_picture_buf->origin_x << 1, recon_picture_buf->origin_y,
+            y0, y1, EB_TRUE);
+
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            uint32_t height_uv = height >> sy;
+            uint32_t y0_uv = AOMMIN(y0 >> sy, height_uv);
+            uint32_t y1_uv = AOMMIN(y1 >> sy, height_uv);
+
+            // Cb samples
+            pad_plane_rows(recon_picture_buf->buffer_cb,
+                recon_picture_buf->stride_cb << 1, width >> sx << 1,
+                height_uv, recon_picture_buf->origin_x >> sx << 1,
+                recon_picture_buf->origin_y >> sy, y0_uv, y1_uv, EB_TRUE);
+
+            // Cr samples
+            pad_plane_rows(recon_picture_buf->buffer_cr,
+                recon_picture_buf->stride_cr << 1, width >> sx << 1,
+                height_uv, recon_picture_buf->origin_x >> sx << 1,
+                recon_picture_buf->origin_y >> sy, y0_uv, y1_uv, EB_TRUE);
+        }
+    }
+}
+
 int inverse_recenter(int r, int v)
 {
     if (v > 2 * r)
@@ -32,6 +32,8 @@ void derive_blk_pointers(EbPictureBufferDesc *recon_picture_buf, int32_t plane,
                          int32_t sub_x, int32_t sub_y);
 
 void pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr);
+void pad_pic_rows(EbPictureBufferDesc *recon_picture_buf,
+                  FrameHeader *frame_hdr, uint32_t y0, uint32_t y1);
 
 int inverse_recenter(int r, int v);
 
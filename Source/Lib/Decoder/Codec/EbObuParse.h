@@ -189,7 +189,7 @@ typedef struct ParseCtxt {
 } ParseCtxt;
 
 int get_qindex(SegmentationParams *seg_params, int segment_id, int base_q_idx);
-void parse_super_block(EbDecHandle *dec_handle, uint32_t blk_row,
+void parse_super_block(ParseCtxt *parse_ctx, uint32_t blk_row,
                        uint32_t blk_col, SBInfo *sbInfo);
 
 void svt_setup_motion_field(EbDecHandle *dec_handle);
@@ -34,6 +34,7 @@
 #include "EbModeDecisionConfigurationProcess.h"
 #include "EbEncDecProcess.h"
 #include "EbEntropyCodingProcess.h"
+#include "EbEntropyCoding.h"
 #include "EbPacketizationProcess.h"
 #include "EbResourceCoordinationResults.h"
 #include "EbPictureAnalysisResults.h"
@@ -60,7 +61,6 @@
 #include <unistd.h>
 #endif
 
-#define RTCD_C
 #include "aom_dsp_rtcd.h"
 
  /**************************************
@@ -85,7 +85,7 @@
 #define EB_OUTPUTRECONBUFFERSIZE                                        (MAX_PICTURE_WIDTH_SIZE*MAX_PICTURE_HEIGHT_SIZE*2)   // Recon Slice Size
 #define EB_OUTPUTSTATISTICSBUFFERSIZE                                   0x30            // 6X8 (8 Bytes for Y, U, V, number of bits, picture number, QP)
 #define EOS_NAL_BUFFER_SIZE                                             0x0010 // Bitstream used to code EOS NAL
-#define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x1E8480 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x2DC6C0 : 0x2DC6C0  )
+#define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x10000 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x20000 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x40000 : 0x80000  ) // Initial size, packetization grows the buffers
 
 #define ENCDEC_INPUT_PORT_MDC                                0
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
@@ -141,6 +141,38 @@ uint32_t GetNumProcessors() {
 #endif
 }
 
+//Get the CPU quota of the process cgroup, in cores. 0 if there is none
+static uint32_t GetCpuQuota() {
+#if defined(__linux__)
+    long long quota = -1, period = 0;
+    FILE *fp = fopen("/sys/fs/cgroup/cpu.max", "r");
+    if (fp) {
+        // cgroup v2 : "max 100000" or "<quota> <period>"
+        if (fscanf(fp, "%lld %lld", &quota, &period) != 2)
+            quota = -1;
+        fclose(fp);
+    }
+    else {
+        // cgroup v1
+        fp = fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+        if (fp) {
+            if (fscanf(fp, "%lld", &quota) != 1)
+                quota = -1;
+            fclose(fp);
+        }
+        fp = fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+        if (fp) {
+            if (fscanf(fp, "%lld", &period) != 1)
+                period = 0;
+            fclose(fp);
+        }
+    }
+    if (quota > 0 && period > 0)
+        return (uint32_t)MAX(1, (quota + period - 1) / period);
+#endif
+    return 0;
+}
+
 EbErrorType InitThreadManagmentParams() {
 #ifdef _WIN32
     // Initialize group_affinity structure with Current thread info
@@ -282,11 +314,56 @@ void EbSetThreadManagementParameters(EbSvtAv1EncConfiguration *config_ptr)
 #endif
 }
 
-void asmSetConvolveAsmTable(void);
-void asmSetConvolveHbdAsmTable(void);
-void init_intra_dc_predictors_c_internal(void);
-void init_intra_predictors_internal(void);
 void eb_av1_init_me_luts(void);
+void init_fn_ptr(void);
+
+/**********************************
+* Process Wide Tables
+*   The luts of the encoder, the tables it copies
+*   from the RTCD function pointers and the block
+*   geometry of both super block sizes are built once
+*   for the process, after the RTCD tables shared with
+*   the decoder. None of them is rewritten afterwards.
+**********************************/
+static void init_enc_tables(void)
+{
+    eb_av1_init_me_luts();
+    init_fn_ptr();
+    build_blk_geom(0);
+    build_blk_geom(1);
+}
+
+#ifdef _WIN32
+static INIT_ONCE enc_tables_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_enc_tables_once(
+    PINIT_ONCE InitOnce,
+    PVOID Parameter,
+    PVOID *lpContext)
+{
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    init_enc_tables();
+    return TRUE;
+}
+#else
+static pthread_once_t enc_tables_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void setup_enc_tables(EbAsm asm_type)
+{
+    const EbAsm rtcd_asm_type = init_rtcd_tables(asm_type);
+
+    if (rtcd_asm_type != asm_type)
+        SVT_LOG("Warning: asm_type %d applies to the kernels dispatched per handle only, the RTCD functions of the process being built for asm_type %d\n",
+            asm_type, rtcd_asm_type);
+#ifdef _WIN32
+    InitOnceExecuteOnce(&enc_tables_once, init_enc_tables_once, NULL, NULL);
+#else
+    pthread_once(&enc_tables_once, init_enc_tables);
+#endif
+}
 
 void SwitchToRealTime(){
 #ifndef _WIN32
@@ -356,6 +433,70 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config, uint32_t core_count,
         return -1;
     }
 }
+/*****************************************
+ * Set the picture pool sizes and the process counts of a sequence
+ * sized for core_count cores
+ *****************************************/
+static EbErrorType set_buffer_counts(
+    SequenceControlSet       *sequence_control_set_ptr,
+    uint32_t                  core_count){
+    int32_t return_ppcs = set_parent_pcs(&sequence_control_set_ptr->static_config,
+                    core_count, sequence_control_set_ptr->input_resolution);
+    if (return_ppcs == -1)
+        return EB_ErrorInsufficientResources;
+    uint32_t input_pic = (uint32_t)return_ppcs;
+    sequence_control_set_ptr->input_buffer_fifo_init_count = input_pic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance;
+    sequence_control_set_ptr->output_stream_buffer_fifo_init_count =
+        sequence_control_set_ptr->input_buffer_fifo_init_count + 4;
+
+    //#====================== Data Structures and Picture Buffers ======================
+    sequence_control_set_ptr->picture_control_set_pool_init_count       = input_pic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance;
+    if (sequence_control_set_ptr->static_config.enable_overlays)
+        sequence_control_set_ptr->picture_control_set_pool_init_count = MAX(sequence_control_set_ptr->picture_control_set_pool_init_count,
+            sequence_control_set_ptr->static_config.look_ahead_distance + // frames in the LAD
+            sequence_control_set_ptr->static_config.look_ahead_distance / (1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1 +  // number of overlayes in the LAD
+            ((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + SCD_LAD) * 2 +// minigop formation in PD + SCD_LAD *(normal pictures + potential pictures )
+            (1 << sequence_control_set_ptr->static_config.hierarchical_levels)); // minigop in PM
+    sequence_control_set_ptr->picture_control_set_pool_init_count_child = MAX(MAX(MIN(3, core_count/2), core_count / 6), 1);
+    sequence_control_set_ptr->reference_picture_buffer_init_count       = MAX((uint32_t)(input_pic >> 1),
+                                                                          (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
+    sequence_control_set_ptr->pa_reference_picture_buffer_init_count    = MAX((uint32_t)(input_pic >> 1),
+                                                                          (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
+    sequence_control_set_ptr->output_recon_buffer_fifo_init_count       = sequence_control_set_ptr->reference_picture_buffer_init_count;
+    sequence_control_set_ptr->overlay_input_picture_buffer_init_count   = sequence_control_set_ptr->static_config.enable_overlays ?
+                                                                          (2 << sequence_control_set_ptr->static_config.hierarchical_levels) + SCD_LAD : 1;
+
+    //#====================== Processes number ======================
+    sequence_control_set_ptr->total_process_init_count                    = 0;
+    if (core_count > 1){
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = MAX(MIN(15, core_count >> 1), core_count / 6));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count =  MAX(MIN(20, core_count >> 1), core_count / 3));//1);//
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = MAX(MIN(3, core_count >> 1), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count >> 1), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = MAX(MIN(40, core_count >> 1), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = MAX(MIN(3, core_count >> 1), core_count / 12));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = MAX(MIN(40, core_count >> 1), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
+    }else{
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = 1);
+        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = 1);
+    }
+
+    sequence_control_set_ptr->total_process_init_count += 6; // single processes count
+
+    return EB_ErrorNone;
+}
+
 EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *sequence_control_set_ptr){
     EbErrorType           return_error = EB_ErrorNone;
@@ -397,15 +538,12 @@ EbErrorType load_default_buffer_configuration_settings(
         sequence_control_set_ptr->static_config.logical_processors > lp_count / num_groups)
         core_count = lp_count;
 #endif
-    int32_t return_ppcs = set_parent_pcs(&sequence_control_set_ptr->static_config,
-                    core_count, sequence_control_set_ptr->input_resolution);
-    if (return_ppcs == -1)
-        return EB_ErrorInsufficientResources;
-    uint32_t input_pic = (uint32_t)return_ppcs;
-    sequence_control_set_ptr->input_buffer_fifo_init_count = input_pic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance;
-    sequence_control_set_ptr->output_stream_buffer_fifo_init_count =
-        sequence_control_set_ptr->input_buffer_fifo_init_count + 4;
-
+    // Handles sharing a pool split its run slots, size the kernels for their share
+    if (sequence_control_set_ptr->static_config.thread_pool) {
+        const uint32_t pool_size = ((EbThreadPool*)sequence_control_set_ptr->static_config.thread_pool)->pool_size;
+        const uint32_t channel_count = MAX(1, sequence_control_set_ptr->static_config.active_channel_count);
+        core_count = MIN(core_count, MAX(1, pool_size / channel_count));
+    }
     // ME segments
     sequence_control_set_ptr->me_segment_row_count_array[0] = meSegH;
     sequence_control_set_ptr->me_segment_row_count_array[1] = meSegH;
@@ -449,25 +587,6 @@ EbErrorType load_default_buffer_configuration_settings(
 
     sequence_control_set_ptr->tf_segment_column_count = meSegW;//1;//
     sequence_control_set_ptr->tf_segment_row_count =  meSegH;//1;//
-    //#====================== Data Structures and Picture Buffers ======================
-    sequence_control_set_ptr->picture_control_set_pool_init_count       = input_pic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance;
-    if (sequence_control_set_ptr->static_config.enable_overlays)
-        sequence_control_set_ptr->picture_control_set_pool_init_count = MAX(sequence_control_set_ptr->picture_control_set_pool_init_count,
-            sequence_control_set_ptr->static_config.look_ahead_distance + // frames in the LAD
-            sequence_control_set_ptr->static_config.look_ahead_distance / (1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1 +  // number of overlayes in the LAD
-            ((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + SCD_LAD) * 2 +// minigop formation in PD + SCD_LAD *(normal pictures + potential pictures )
-            (1 << sequence_control_set_ptr->static_config.hierarchical_levels)); // minigop in PM
-    sequence_control_set_ptr->picture_control_set_pool_init_count_child = MAX(MAX(MIN(3, core_count/2), core_count / 6), 1);
-    sequence_control_set_ptr->reference_picture_buffer_init_count       = MAX((uint32_t)(input_pic >> 1),
-                                                                          (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
-                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
-    sequence_control_set_ptr->pa_reference_picture_buffer_init_count    = MAX((uint32_t)(input_pic >> 1),
-                                                                          (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
-                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
-    sequence_control_set_ptr->output_recon_buffer_fifo_init_count       = sequence_control_set_ptr->reference_picture_buffer_init_count;
-    sequence_control_set_ptr->overlay_input_picture_buffer_init_count   = sequence_control_set_ptr->static_config.enable_overlays ?
-                                                                          (2 << sequence_control_set_ptr->static_config.hierarchical_levels) + SCD_LAD : 1;
-
     //#====================== Inter process Fifos ======================
     sequence_control_set_ptr->resource_coordination_fifo_init_count       = 300;
     sequence_control_set_ptr->picture_analysis_fifo_init_count            = 300;
@@ -483,31 +602,11 @@ EbErrorType load_default_buffer_configuration_settings(
     sequence_control_set_ptr->dlf_fifo_init_count                         = 300;
     sequence_control_set_ptr->cdef_fifo_init_count                        = 300;
     sequence_control_set_ptr->rest_fifo_init_count                        = 300;
-    //#====================== Processes number ======================
-    sequence_control_set_ptr->total_process_init_count                    = 0;
-    if (core_count > 1){
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = MAX(MIN(15, core_count >> 1), core_count / 6));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count =  MAX(MIN(20, core_count >> 1), core_count / 3));//1);//
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = MAX(MIN(3, core_count >> 1), core_count / 12));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
-    }else{
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count            = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count           = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count     = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                     = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count              = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->dlf_process_init_count                         = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->cdef_process_init_count                        = 1);
-        sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->rest_process_init_count                        = 1);
-    }
+    sequence_control_set_ptr->core_count = core_count;
+    return_error = set_buffer_counts(sequence_control_set_ptr, core_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
-    sequence_control_set_ptr->total_process_init_count += 6; // single processes count
     printf("Number of logical cores available: %u\nNumber of PPCS %u\n", core_count, sequence_control_set_ptr->picture_control_set_pool_init_count);
 
     return return_error;
@@ -637,6 +736,8 @@ static void eb_enc_handle_dctor(EbPtr p)
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
 
     eb_enc_handle_stop_threads(enc_handle_ptr);
+    EB_DELETE(enc_handle_ptr->thread_pool_channel_ptr);
+    EB_DELETE(enc_handle_ptr->thread_pool_ptr);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->sequence_control_set_pool_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -728,6 +829,10 @@ EbErrorType EbInputBufferHeaderCreator(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
 
+EbErrorType EbZeroCopyInputBufferHeaderCreator(
+    EbPtr *objectDblPtr,
+    EbPtr  objectInitDataPtr);
+
 EbErrorType EbOutputReconBufferHeaderCreator(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
@@ -740,6 +845,13 @@ void EbInputBufferHeaderDestoryer(    EbPtr p);
 void EbOutputReconBufferHeaderDestoryer(    EbPtr p);
 void EbOutputBufferHeaderDestoryer(    EbPtr p);
 
+static void release_zero_copy_input(
+    EbPtr object_ptr,
+    EbPtr callback_data);
+static void release_zero_copy_pa_reference(
+    EbPtr object_ptr,
+    EbPtr callback_data);
+
 
 EbErrorType DlfResultsCtor(
     DlfResults *context_ptr,
@@ -810,19 +922,361 @@ EbErrorType RestResultsCreator(
     return EB_ErrorNone;
 }
 
-void init_fn_ptr(void);
-extern void av1_init_wedge_masks(void);
+/*****************************************
+ * Set the init data of a parent picture control set
+ *****************************************/
+static void set_ppcs_init_data(
+    PictureControlSetInitData *input_data,
+    SequenceControlSet        *scs_ptr){
+    memset(input_data, 0, sizeof(*input_data));
+    input_data->picture_width = scs_ptr->max_input_luma_width;
+    input_data->picture_height = scs_ptr->max_input_luma_height;
+    input_data->left_padding = scs_ptr->left_padding;
+    input_data->right_padding = scs_ptr->right_padding;
+    input_data->top_padding = scs_ptr->top_padding;
+    input_data->bot_padding = scs_ptr->bot_padding;
+    input_data->bit_depth = scs_ptr->encoder_bit_depth;
+    input_data->color_format = scs_ptr->static_config.encoder_color_format;
+    input_data->sb_sz = scs_ptr->sb_sz;
+    input_data->max_depth = scs_ptr->max_sb_depth;
+    input_data->ten_bit_format = scs_ptr->static_config.ten_bit_format;
+    input_data->compressed_ten_bit_format = scs_ptr->static_config.compressed_ten_bit_format;
+    input_data->enc_mode = scs_ptr->static_config.enc_mode;
+    input_data->speed_control = (uint8_t)scs_ptr->static_config.speed_control_flag;
+    input_data->hbd_mode_decision = scs_ptr->static_config.enable_hbd_mode_decision;
+    input_data->film_grain_noise_level = scs_ptr->static_config.film_grain_denoise_strength;
+    input_data->bit_depth = scs_ptr->static_config.encoder_bit_depth;
+
+    input_data->ext_block_flag = (uint8_t)scs_ptr->static_config.ext_block_flag;
+
+    input_data->in_loop_me_flag = (uint8_t)scs_ptr->static_config.in_loop_me_flag;
+    input_data->mrp_mode = scs_ptr->mrp_mode;
+    input_data->nsq_present = scs_ptr->nsq_present;
+}
+
+/*****************************************
+ * Set the init data of a child picture control set
+ *****************************************/
+static void set_pcs_init_data(
+    PictureControlSetInitData *input_data,
+    SequenceControlSet        *scs_ptr){
+    unsigned i;
+
+    memset(input_data, 0, sizeof(*input_data));
+    input_data->enc_dec_segment_col = 0;
+    input_data->enc_dec_segment_row = 0;
+    for (i = 0; i <= scs_ptr->static_config.hierarchical_levels; ++i) {
+        input_data->enc_dec_segment_col = scs_ptr->enc_dec_segment_col_count_array[i] > input_data->enc_dec_segment_col ?
+            (uint16_t)scs_ptr->enc_dec_segment_col_count_array[i] :
+            input_data->enc_dec_segment_col;
+        input_data->enc_dec_segment_row = scs_ptr->enc_dec_segment_row_count_array[i] > input_data->enc_dec_segment_row ?
+            (uint16_t)scs_ptr->enc_dec_segment_row_count_array[i] :
+            input_data->enc_dec_segment_row;
+    }
+
+    input_data->picture_width = scs_ptr->max_input_luma_width;
+    input_data->picture_height = scs_ptr->max_input_luma_height;
+    input_data->left_padding = scs_ptr->left_padding;
+    input_data->right_padding = scs_ptr->right_padding;
+    input_data->top_padding = scs_ptr->top_padding;
+    input_data->bot_padding = scs_ptr->bot_padding;
+    input_data->bit_depth = scs_ptr->encoder_bit_depth;
+    input_data->film_grain_noise_level = scs_ptr->film_grain_denoise_strength;
+    input_data->color_format = scs_ptr->static_config.encoder_color_format;
+    input_data->sb_sz = scs_ptr->sb_sz;
+    input_data->sb_size_pix = scs_ptr->static_config.super_block_size;
+    input_data->max_depth = scs_ptr->max_sb_depth;
+    input_data->hbd_mode_decision = scs_ptr->static_config.enable_hbd_mode_decision;
+    input_data->cdf_mode = scs_ptr->cdf_mode;
+    input_data->mfmv = scs_ptr->mfmv_enabled;
+    {
+        // The configured tiles, bounded by the SB grid. The AV1 tile width and
+        // area limits split wide pictures once more
+        const uint32_t sb_size = scs_ptr->static_config.super_block_size;
+        const uint32_t sb_cols = (scs_ptr->max_input_luma_width + sb_size - 1) / sb_size;
+        const uint32_t sb_rows = (scs_ptr->max_input_luma_height + sb_size - 1) / sb_size;
+        const uint32_t min_log2_tiles =
+            (scs_ptr->max_input_luma_width > MAX_TILE_WIDTH ||
+             scs_ptr->max_input_luma_width * scs_ptr->max_input_luma_height > MAX_TILE_AREA) ? 1 : 0;
+        input_data->tile_count = (uint16_t)(
+            MIN(sb_cols, 1u << (scs_ptr->static_config.tile_columns + min_log2_tiles)) *
+            MIN(sb_rows, 1u << (scs_ptr->static_config.tile_rows + min_log2_tiles)));
+    }
+}
+
+/*****************************************
+ * Set the init data of a reference picture
+ *****************************************/
+static void set_reference_init_data(
+    EbReferenceObjectDescInitData *init_data,
+    SequenceControlSet            *scs_ptr){
+    EbPictureBufferDescInitData *ref_desc = &init_data->reference_picture_desc_init_data;
+
+    memset(init_data, 0, sizeof(*init_data));
+    ref_desc->max_width = scs_ptr->max_input_luma_width;
+    ref_desc->max_height = scs_ptr->max_input_luma_height;
+    ref_desc->bit_depth = scs_ptr->encoder_bit_depth;
+    ref_desc->color_format = scs_ptr->static_config.encoder_color_format;
+    ref_desc->buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+
+    ref_desc->left_padding = PAD_VALUE;
+    ref_desc->right_padding = PAD_VALUE;
+    ref_desc->top_padding = PAD_VALUE;
+    ref_desc->bot_padding = PAD_VALUE;
+    ref_desc->mfmv = scs_ptr->mfmv_enabled;
+    // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
+
+    if (scs_ptr->static_config.encoder_bit_depth > EB_8BIT)
+        ref_desc->bit_depth = EB_10BIT;
+}
+
+/*****************************************
+ * Set the init data of a PA reference picture
+ *****************************************/
+static void set_pa_reference_init_data(
+    EbPaReferenceObjectDescInitData *init_data,
+    SequenceControlSet              *scs_ptr){
+    EbPictureBufferDescInitData *ref_desc = &init_data->reference_picture_desc_init_data;
+    EbPictureBufferDescInitData *quarter_desc = &init_data->quarter_picture_desc_init_data;
+    EbPictureBufferDescInitData *sixteenth_desc = &init_data->sixteenth_picture_desc_init_data;
+
+    memset(init_data, 0, sizeof(*init_data));
+    ref_desc->mfmv = scs_ptr->mfmv_enabled;
+    // Currently, only Luma samples are needed in the PA
+    ref_desc->max_width = scs_ptr->max_input_luma_width;
+    ref_desc->max_height = scs_ptr->max_input_luma_height;
+    ref_desc->bit_depth = scs_ptr->encoder_bit_depth;
+    ref_desc->color_format = EB_YUV420; //use 420 for picture analysis
+    ref_desc->buffer_enable_mask = 0;
+    ref_desc->left_padding = scs_ptr->sb_sz + ME_FILTER_TAP;
+    ref_desc->right_padding = scs_ptr->sb_sz + ME_FILTER_TAP;
+    ref_desc->top_padding = scs_ptr->sb_sz + ME_FILTER_TAP;
+    ref_desc->bot_padding = scs_ptr->sb_sz + ME_FILTER_TAP;
+    ref_desc->split_mode = EB_FALSE;
+    quarter_desc->max_width = scs_ptr->max_input_luma_width >> 1;
+    quarter_desc->max_height = scs_ptr->max_input_luma_height >> 1;
+    quarter_desc->bit_depth = scs_ptr->encoder_bit_depth;
+    quarter_desc->color_format = EB_YUV420;
+    quarter_desc->buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    quarter_desc->left_padding = scs_ptr->sb_sz >> 1;
+    quarter_desc->right_padding = scs_ptr->sb_sz >> 1;
+    quarter_desc->top_padding = scs_ptr->sb_sz >> 1;
+    quarter_desc->bot_padding = scs_ptr->sb_sz >> 1;
+    quarter_desc->split_mode = EB_FALSE;
+    quarter_desc->down_sampled_filtered = (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) ? EB_TRUE : EB_FALSE;
+
+    sixteenth_desc->max_width = scs_ptr->max_input_luma_width >> 2;
+    sixteenth_desc->max_height = scs_ptr->max_input_luma_height >> 2;
+    sixteenth_desc->bit_depth = scs_ptr->encoder_bit_depth;
+    sixteenth_desc->color_format = EB_YUV420;
+    sixteenth_desc->buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    sixteenth_desc->left_padding = scs_ptr->sb_sz >> 2;
+    sixteenth_desc->right_padding = scs_ptr->sb_sz >> 2;
+    sixteenth_desc->top_padding = scs_ptr->sb_sz >> 2;
+    sixteenth_desc->bot_padding = scs_ptr->sb_sz >> 2;
+    sixteenth_desc->split_mode = EB_FALSE;
+    sixteenth_desc->down_sampled_filtered = (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) ? EB_TRUE : EB_FALSE;
+}
+
+/*****************************************
+ * Set the init data of the picture buffer of a picture analysis context
+ *****************************************/
+static void set_picture_analysis_init_data(
+    EbPictureBufferDescInitData *init_data,
+    SequenceControlSet          *scs_ptr){
+    memset(init_data, 0, sizeof(*init_data));
+    init_data->color_format = scs_ptr->static_config.encoder_color_format;
+    init_data->max_width = scs_ptr->max_input_luma_width;
+    init_data->max_height = scs_ptr->max_input_luma_height;
+    init_data->bit_depth = EB_8BIT;
+    init_data->buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
+    init_data->left_padding = 0;
+    init_data->right_padding = 0;
+    init_data->top_padding = 0;
+    init_data->bot_padding = 0;
+    init_data->split_mode = EB_FALSE;
+}
+
+// Memory taken by one object of each pool and one context of each process
+typedef struct EncMemoryCost {
+    uint64_t ppcs;
+    uint64_t pcs;
+    uint64_t reference;
+    uint64_t pa_reference;
+    uint64_t input_buffer;
+    uint64_t output_stream_buffer;
+    uint64_t output_recon_buffer;
+    uint64_t picture_analysis;
+    uint64_t motion_estimation;
+    uint64_t source_based_operations;
+    uint64_t mode_decision_configuration;
+    uint64_t enc_dec;
+    uint64_t dlf;
+    uint64_t cdef;
+    uint64_t rest;
+    uint64_t entropy_coding;
+} EncMemoryCost;
+
+// Measures the memory of a context built without fifos
+#define PROBE_CONTEXT_COST(cost, context_type, ctor, ...) \
+    do { \
+        context_type *probe_ptr; \
+        uint64_t start_mem = eb_get_thread_mem(); \
+        EB_NEW(probe_ptr, ctor, __VA_ARGS__); \
+        cost = eb_get_thread_mem() - start_mem; \
+        EB_DELETE(probe_ptr); \
+    } while (0)
+
+/*****************************************
+ * Measure the memory costs of a sequence by building and deleting
+ * one object of every kind
+ *****************************************/
+static EbErrorType probe_memory_cost(
+    EncMemoryCost      *cost,
+    SequenceControlSet *scs_ptr){
+    EbErrorType                     return_error;
+    PictureControlSetInitData       pcs_init_data;
+    EbReferenceObjectDescInitData   reference_init_data;
+    EbPaReferenceObjectDescInitData pa_reference_init_data;
+    EbPictureBufferDescInitData     pa_init_data;
+    EbBool is16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbColorFormat color_format = scs_ptr->static_config.encoder_color_format;
+
+    memset(cost, 0, sizeof(*cost));
+
+    set_ppcs_init_data(&pcs_init_data, scs_ptr);
+    return_error = eb_object_memory_cost(&cost->ppcs, picture_parent_control_set_creator, &pcs_init_data, NULL);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    set_pcs_init_data(&pcs_init_data, scs_ptr);
+    return_error = eb_object_memory_cost(&cost->pcs, picture_control_set_creator, &pcs_init_data, NULL);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    set_reference_init_data(&reference_init_data, scs_ptr);
+    return_error = eb_object_memory_cost(&cost->reference, eb_reference_object_creator, &reference_init_data, NULL);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    set_pa_reference_init_data(&pa_reference_init_data, scs_ptr);
+    return_error = eb_object_memory_cost(&cost->pa_reference, eb_pa_reference_object_creator, &pa_reference_init_data, NULL);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    return_error = eb_object_memory_cost(&cost->input_buffer, EbInputBufferHeaderCreator, scs_ptr, EbInputBufferHeaderDestoryer);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    return_error = eb_object_memory_cost(&cost->output_stream_buffer, EbOutputBufferHeaderCreator, &scs_ptr->static_config, EbOutputBufferHeaderDestoryer);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    if (scs_ptr->static_config.recon_enabled) {
+        return_error = eb_object_memory_cost(&cost->output_recon_buffer, EbOutputReconBufferHeaderCreator, scs_ptr, EbOutputReconBufferHeaderDestoryer);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
+    set_picture_analysis_init_data(&pa_init_data, scs_ptr);
+    PROBE_CONTEXT_COST(cost->picture_analysis, PictureAnalysisContext, picture_analysis_context_ctor,
+        &pa_init_data, EB_TRUE, NULL, NULL);
+    PROBE_CONTEXT_COST(cost->motion_estimation, MotionEstimationContext_t, motion_estimation_context_ctor,
+        NULL, NULL, scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height,
+        scs_ptr->nsq_present, scs_ptr->mrp_mode);
+    PROBE_CONTEXT_COST(cost->source_based_operations, SourceBasedOperationsContext, source_based_operations_context_ctor,
+        NULL, NULL, scs_ptr);
+    PROBE_CONTEXT_COST(cost->mode_decision_configuration, ModeDecisionConfigurationContext, mode_decision_configuration_context_ctor,
+        NULL, NULL,
+        ((scs_ptr->max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+        ((scs_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64));
+    PROBE_CONTEXT_COST(cost->enc_dec, EncDecContext, enc_dec_context_ctor,
+        NULL, NULL, NULL, NULL, is16bit, color_format, scs_ptr->static_config.enable_hbd_mode_decision,
+        scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height);
+    PROBE_CONTEXT_COST(cost->dlf, DlfContext, dlf_context_ctor,
+        NULL, NULL, NULL, is16bit, color_format, scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height);
+    PROBE_CONTEXT_COST(cost->cdef, CdefContext_t, cdef_context_ctor,
+        NULL, NULL, NULL, is16bit, scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height);
+    PROBE_CONTEXT_COST(cost->rest, RestContext, rest_context_ctor,
+        NULL, NULL, NULL, NULL, is16bit, color_format, scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height);
+    PROBE_CONTEXT_COST(cost->entropy_coding, EntropyCodingContext, entropy_coding_context_ctor,
+        NULL, NULL, NULL, NULL, is16bit);
+
+    return EB_ErrorNone;
+}
+
+/*****************************************
+ * Memory taken by the pools and the contexts of a sequence
+ * with its current buffer and process counts
+ *****************************************/
+static uint64_t get_memory_footprint(
+    SequenceControlSet  *scs_ptr,
+    const EncMemoryCost *cost){
+    uint64_t footprint =
+        scs_ptr->picture_control_set_pool_init_count * cost->ppcs +
+        scs_ptr->picture_control_set_pool_init_count_child * cost->pcs +
+        scs_ptr->reference_picture_buffer_init_count * cost->reference +
+        scs_ptr->pa_reference_picture_buffer_init_count * cost->pa_reference +
+        scs_ptr->input_buffer_fifo_init_count * (scs_ptr->static_config.zero_copy_input ? 0 : cost->input_buffer) +
+        scs_ptr->output_stream_buffer_fifo_init_count * cost->output_stream_buffer +
+        scs_ptr->picture_analysis_process_init_count * cost->picture_analysis +
+        scs_ptr->motion_estimation_process_init_count * cost->motion_estimation +
+        scs_ptr->source_based_operations_process_init_count * cost->source_based_operations +
+        scs_ptr->mode_decision_configuration_process_init_count * cost->mode_decision_configuration +
+        scs_ptr->enc_dec_process_init_count * cost->enc_dec +
+        scs_ptr->dlf_process_init_count * cost->dlf +
+        scs_ptr->cdef_process_init_count * cost->cdef +
+        scs_ptr->rest_process_init_count * cost->rest +
+        scs_ptr->entropy_coding_process_init_count * cost->entropy_coding;
+
+    // Overlay input pictures are input buffers
+    if (scs_ptr->static_config.enable_overlays)
+        footprint += scs_ptr->overlay_input_picture_buffer_init_count * cost->input_buffer;
+    if (scs_ptr->static_config.recon_enabled)
+        footprint += scs_ptr->output_recon_buffer_fifo_init_count * cost->output_recon_buffer;
+    return footprint;
+}
+
+/*****************************************
+ * Size the pools and the processes of a sequence for the largest
+ * core count whose memory footprint fits in memory_budget_mb
+ *****************************************/
+static EbErrorType fit_memory_budget(
+    SequenceControlSet *scs_ptr){
+    EbErrorType   return_error;
+    EncMemoryCost cost;
+    uint64_t      budget = (uint64_t)scs_ptr->static_config.memory_budget_mb << 20;
+    uint64_t      footprint = 0;
+    uint32_t      core_count;
+
+    return_error = probe_memory_cost(&cost, scs_ptr);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+
+    for (core_count = scs_ptr->core_count; core_count >= 1; --core_count) {
+        return_error = set_buffer_counts(scs_ptr, core_count);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        footprint = get_memory_footprint(scs_ptr, &cost);
+        if (footprint <= budget)
+            break;
+    }
+    if (footprint > budget) {
+        SVT_LOG("SVT [Error]: the encoder needs at least %u MB, above the memory budget of %u MB. Lower the look ahead distance or the resolution\n",
+            (uint32_t)((footprint + (1 << 20) - 1) >> 20), scs_ptr->static_config.memory_budget_mb);
+        return EB_ErrorInsufficientResources;
+    }
+    if (core_count < scs_ptr->core_count)
+        SVT_LOG("SVT [Warning]: buffers and processes sized for %u cores instead of %u to fit the memory budget\n",
+            core_count, scs_ptr->core_count);
+    scs_ptr->core_count = core_count;
+    SVT_LOG("SVT [config]: memory footprint %u MB, budget %u MB (PPCS %u / child PCS %u / references %u / PA references %u)\n",
+        (uint32_t)((footprint + (1 << 20) - 1) >> 20), scs_ptr->static_config.memory_budget_mb,
+        scs_ptr->picture_control_set_pool_init_count, scs_ptr->picture_control_set_pool_init_count_child,
+        scs_ptr->reference_picture_buffer_init_count, scs_ptr->pa_reference_picture_buffer_init_count);
+    return EB_ErrorNone;
+}
+
 /**********************************
-* Initialize Encoder Library
+* Allocate the pools, the contexts and the
+* threads of the encoder
 **********************************/
-#ifdef __GNUC__
-__attribute__((visibility("default")))
-#endif
-EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+static EbErrorType init_encoder(EbEncHandle *enc_handle_ptr)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instance_index;
     uint32_t processIndex;
@@ -838,22 +1292,23 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type = GetCpuAsmType();
     else
         enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.asm_type;
-    setup_rtcd_internal(enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type);
-    asmSetConvolveAsmTable();
-
-    init_intra_dc_predictors_c_internal();
-
-    asmSetConvolveHbdAsmTable();
-
-    init_intra_predictors_internal();
     EbSequenceControlSetInitData scs_init;
     scs_init.sb_size = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.super_block_size;
 
-    build_blk_geom(scs_init.sb_size == 128);
+    setup_enc_tables(enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->asm_type);
 
-    eb_av1_init_me_luts();
-    init_fn_ptr();
-    av1_init_wedge_masks();
+    if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.memory_budget_mb) {
+        // The objects built to measure the costs are not accounted
+        EbMemAccount *mem_account = eb_set_mem_account(NULL);
+        for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+            return_error = fit_memory_budget(enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
+            if (return_error != EB_ErrorNone)
+                break;
+        }
+        eb_set_mem_account(mem_account);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
     /************************************
     * Sequence Control Set
     ************************************/
@@ -872,6 +1327,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Control Set: Parent
     ************************************/
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_PCS);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     EB_MALLOC_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_producer_fifo_ptr_dbl_array, enc_handle_ptr->encode_instance_total_count);
@@ -880,29 +1336,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         // The segment Width & Height Arrays are in units of LCUs, not samples
         PictureControlSetInitData inputData;
 
-        inputData.picture_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width;
-        inputData.picture_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height;
-        inputData.left_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->left_padding;
-        inputData.right_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->right_padding;
-        inputData.top_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->top_padding;
-        inputData.bot_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->bot_padding;
-        inputData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        inputData.color_format = color_format;
-        inputData.sb_sz = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz;
-        inputData.max_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_sb_depth;
-        inputData.ten_bit_format = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.ten_bit_format;
-        inputData.compressed_ten_bit_format = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.compressed_ten_bit_format;
-        inputData.enc_mode = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.enc_mode;
-        inputData.speed_control = (uint8_t)enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.speed_control_flag;
-        inputData.hbd_mode_decision = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.enable_hbd_mode_decision;
-        inputData.film_grain_noise_level = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.film_grain_denoise_strength;
-        inputData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.encoder_bit_depth;
-
-        inputData.ext_block_flag = (uint8_t)enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.ext_block_flag;
-
-        inputData.in_loop_me_flag = (uint8_t)enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.in_loop_me_flag;
-        inputData.mrp_mode = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->mrp_mode;
-        inputData.nsq_present = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->nsq_present;
+        set_ppcs_init_data(&inputData, enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
             eb_system_resource_ctor,
@@ -927,34 +1361,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         // The segment Width & Height Arrays are in units of LCUs, not samples
         PictureControlSetInitData inputData;
-        unsigned i;
 
-        inputData.enc_dec_segment_col = 0;
-        inputData.enc_dec_segment_row = 0;
-        for (i = 0; i <= enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.hierarchical_levels; ++i) {
-            inputData.enc_dec_segment_col = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->enc_dec_segment_col_count_array[i] > inputData.enc_dec_segment_col ?
-                (uint16_t)enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->enc_dec_segment_col_count_array[i] :
-                inputData.enc_dec_segment_col;
-            inputData.enc_dec_segment_row = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->enc_dec_segment_row_count_array[i] > inputData.enc_dec_segment_row ?
-                (uint16_t)enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->enc_dec_segment_row_count_array[i] :
-                inputData.enc_dec_segment_row;
-        }
-
-        inputData.picture_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width;
-        inputData.picture_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height;
-        inputData.left_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->left_padding;
-        inputData.right_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->right_padding;
-        inputData.top_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->top_padding;
-        inputData.bot_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->bot_padding;
-        inputData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        inputData.film_grain_noise_level = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->film_grain_denoise_strength;
-        inputData.color_format = color_format;
-        inputData.sb_sz = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz;
-        inputData.sb_size_pix = scs_init.sb_size;
-        inputData.max_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_sb_depth;
-        inputData.hbd_mode_decision = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.enable_hbd_mode_decision;
-        inputData.cdf_mode = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->cdf_mode;
-        inputData.mfmv = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->mfmv_enabled;
+        set_pcs_init_data(&inputData, enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
         EB_NEW(
             enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
             eb_system_resource_ctor,
@@ -972,6 +1380,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Buffers
     ************************************/
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_REFERENCE);
 
     // Allocate Resource Arrays
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -995,27 +1404,10 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         EbReferenceObjectDescInitData     EbReferenceObjectDescInitDataStructure;
         EbPaReferenceObjectDescInitData   EbPaReferenceObjectDescInitDataStructure;
-        EbPictureBufferDescInitData       referencePictureBufferDescInitData;
-        EbPictureBufferDescInitData       quarterPictureBufferDescInitData;
-        EbPictureBufferDescInitData       sixteenthPictureBufferDescInitData;
-        // Initialize the various Picture types
-        referencePictureBufferDescInitData.max_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width;
-        referencePictureBufferDescInitData.max_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height;
-        referencePictureBufferDescInitData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        referencePictureBufferDescInitData.color_format = color_format;
-        referencePictureBufferDescInitData.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
 
-        referencePictureBufferDescInitData.left_padding = PAD_VALUE;
-        referencePictureBufferDescInitData.right_padding = PAD_VALUE;
-        referencePictureBufferDescInitData.top_padding = PAD_VALUE;
-        referencePictureBufferDescInitData.bot_padding = PAD_VALUE;
-        referencePictureBufferDescInitData.mfmv = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->mfmv_enabled;
-        // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
-
-        if (is16bit)
-            referencePictureBufferDescInitData.bit_depth = EB_10BIT;
-
-        EbReferenceObjectDescInitDataStructure.reference_picture_desc_init_data = referencePictureBufferDescInitData;
+        eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_REFERENCE);
+        set_reference_init_data(&EbReferenceObjectDescInitDataStructure, enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
+        set_pa_reference_init_data(&EbPaReferenceObjectDescInitDataStructure, enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
 
         // Reference Picture Buffers
         EB_NEW(
@@ -1031,45 +1423,6 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &(EbReferenceObjectDescInitDataStructure),
             NULL);
 
-        // PA Reference Picture Buffers
-        // Currently, only Luma samples are needed in the PA
-        referencePictureBufferDescInitData.max_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width;
-        referencePictureBufferDescInitData.max_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height;
-        referencePictureBufferDescInitData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        referencePictureBufferDescInitData.color_format = EB_YUV420; //use 420 for picture analysis
-        referencePictureBufferDescInitData.buffer_enable_mask = 0;
-        referencePictureBufferDescInitData.left_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz + ME_FILTER_TAP;
-        referencePictureBufferDescInitData.right_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz + ME_FILTER_TAP;
-        referencePictureBufferDescInitData.top_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz + ME_FILTER_TAP;
-        referencePictureBufferDescInitData.bot_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz + ME_FILTER_TAP;
-        referencePictureBufferDescInitData.split_mode = EB_FALSE;
-        quarterPictureBufferDescInitData.max_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width >> 1;
-        quarterPictureBufferDescInitData.max_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height >> 1;
-        quarterPictureBufferDescInitData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        quarterPictureBufferDescInitData.color_format = EB_YUV420;
-        quarterPictureBufferDescInitData.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        quarterPictureBufferDescInitData.left_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 1;
-        quarterPictureBufferDescInitData.right_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 1;
-        quarterPictureBufferDescInitData.top_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 1;
-        quarterPictureBufferDescInitData.bot_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 1;
-        quarterPictureBufferDescInitData.split_mode = EB_FALSE;
-        quarterPictureBufferDescInitData.down_sampled_filtered = (enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) ? EB_TRUE : EB_FALSE;
-
-        sixteenthPictureBufferDescInitData.max_width = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_width >> 2;
-        sixteenthPictureBufferDescInitData.max_height = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->max_input_luma_height >> 2;
-        sixteenthPictureBufferDescInitData.bit_depth = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->encoder_bit_depth;
-        sixteenthPictureBufferDescInitData.color_format = EB_YUV420;
-        sixteenthPictureBufferDescInitData.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        sixteenthPictureBufferDescInitData.left_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 2;
-        sixteenthPictureBufferDescInitData.right_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 2;
-        sixteenthPictureBufferDescInitData.top_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 2;
-        sixteenthPictureBufferDescInitData.bot_padding = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->sb_sz >> 2;
-        sixteenthPictureBufferDescInitData.split_mode = EB_FALSE;
-        sixteenthPictureBufferDescInitData.down_sampled_filtered = (enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) ? EB_TRUE : EB_FALSE;
-
-        EbPaReferenceObjectDescInitDataStructure.reference_picture_desc_init_data = referencePictureBufferDescInitData;
-        EbPaReferenceObjectDescInitDataStructure.quarter_picture_desc_init_data = quarterPictureBufferDescInitData;
-        EbPaReferenceObjectDescInitDataStructure.sixteenth_picture_desc_init_data = sixteenthPictureBufferDescInitData;
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
             eb_system_resource_ctor,
@@ -1088,6 +1441,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
         if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.enable_overlays) {
             // Overlay Input Picture Buffers
+            eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_IO_BUFFER);
             EB_NEW(
                 enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index],
                 eb_system_resource_ctor,
@@ -1109,6 +1463,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     * System Resource Managers & Fifos
     ************************************/
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_IO_BUFFER);
     // EbBufferHeaderType Input
     EB_NEW(
         enc_handle_ptr->input_buffer_resource_ptr,
@@ -1119,10 +1474,20 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         &enc_handle_ptr->input_buffer_producer_fifo_ptr_array,
         &enc_handle_ptr->input_buffer_consumer_fifo_ptr_array,
         EB_TRUE,
-        EbInputBufferHeaderCreator,
+        enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.zero_copy_input ?
+            EbZeroCopyInputBufferHeaderCreator : EbInputBufferHeaderCreator,
         enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr,
         EbInputBufferHeaderDestoryer);
 
+    // Zero copy inputs are handed back to the application once released by the
+    // pipeline and by their PA reference
+    if (enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.zero_copy_input) {
+        enc_handle_ptr->input_buffer_resource_ptr->release_callback = release_zero_copy_input;
+        enc_handle_ptr->input_buffer_resource_ptr->release_callback_data = enc_handle_ptr;
+        for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index)
+            enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index]->release_callback = release_zero_copy_pa_reference;
+    }
+
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_MALLOC_ARRAY(enc_handle_ptr->output_stream_buffer_producer_fifo_ptr_dbl_array, enc_handle_ptr->encode_instance_total_count);
@@ -1164,6 +1529,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         }
     }
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
     // Resource Coordination Results
     {
         ResourceCoordinationResultInitData resourceCoordinationResultInitData;
@@ -1342,7 +1708,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->enc_dec_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count +
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count, // EncDec and DLF feedback
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count,
             &enc_handle_ptr->enc_dec_results_producer_fifo_ptr_array,
             &enc_handle_ptr->enc_dec_results_consumer_fifo_ptr_array,
@@ -1360,7 +1727,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->dlf_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count +
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count, // DLF and CDEF feedback
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count,
             &enc_handle_ptr->dlf_results_producer_fifo_ptr_array,
             &enc_handle_ptr->dlf_results_consumer_fifo_ptr_array,
@@ -1377,7 +1745,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->cdef_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count +
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count, // CDEF and Rest feedback
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count,
             &enc_handle_ptr->cdef_results_producer_fifo_ptr_array,
             &enc_handle_ptr->cdef_results_consumer_fifo_ptr_array,
@@ -1394,7 +1763,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->rest_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_fifo_init_count,
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count,
+            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count +
+                enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->entropy_coding_process_init_count, // Rest and EC feedback
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->entropy_coding_process_init_count,
             &enc_handle_ptr->rest_results_producer_fifo_ptr_array,
             &enc_handle_ptr->rest_results_consumer_fifo_ptr_array,
@@ -1438,6 +1808,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     * Contexts
     ************************************/
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
     // Resource Coordination Context
     EB_NEW(
         enc_handle_ptr->resource_coordination_context_ptr,
@@ -1451,21 +1822,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->compute_segments_total_count_array,
         enc_handle_ptr->encode_instance_total_count);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ANALYSIS);
     // Picture Analysis Context
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count);
 
     for (processIndex = 0; processIndex < enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->picture_analysis_process_init_count; ++processIndex) {
         EbPictureBufferDescInitData  pictureBufferDescConf;
-        pictureBufferDescConf.color_format = color_format;
-        pictureBufferDescConf.max_width = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width;
-        pictureBufferDescConf.max_height = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height;
-        pictureBufferDescConf.bit_depth = EB_8BIT;
-        pictureBufferDescConf.buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
-        pictureBufferDescConf.left_padding = 0;
-        pictureBufferDescConf.right_padding = 0;
-        pictureBufferDescConf.top_padding = 0;
-        pictureBufferDescConf.bot_padding = 0;
-        pictureBufferDescConf.split_mode = EB_FALSE;
+
+        set_picture_analysis_init_data(&pictureBufferDescConf, enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr);
 
         EB_NEW(
             enc_handle_ptr->picture_analysis_context_ptr_array[processIndex],
@@ -1521,6 +1885,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr);
     }
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
     // Picture Manager Context
     EB_NEW(
         enc_handle_ptr->picture_manager_context_ptr,
@@ -1528,6 +1893,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->picture_demux_results_consumer_fifo_ptr_array[0],
         enc_handle_ptr->rate_control_tasks_producer_fifo_ptr_array[RateControlPortLookup(RATE_CONTROL_INPUT_PORT_PICTURE_MANAGER, 0)],
         enc_handle_ptr->picture_control_set_pool_producer_fifo_ptr_dbl_array[0]);//The Child PCS Pool here
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ENTROPY);
     // Rate Control Context
     EB_NEW(
         enc_handle_ptr->rate_control_context_ptr,
@@ -1535,6 +1901,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->rate_control_tasks_consumer_fifo_ptr_array[0],
         enc_handle_ptr->rate_control_results_producer_fifo_ptr_array[0],
         enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->intra_period_length);
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_MODE_DECISION);
     // Mode Decision Configuration Contexts
     {
         // Mode Decision Configuration Contexts
@@ -1579,6 +1946,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         );
     }
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_LOOP_FILTER);
     // Dlf Contexts
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count);
 
@@ -1588,6 +1956,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             dlf_context_ctor,
             enc_handle_ptr->enc_dec_results_consumer_fifo_ptr_array[processIndex],
             enc_handle_ptr->dlf_results_producer_fifo_ptr_array[processIndex],             //output to EC
+            enc_handle_ptr->enc_dec_results_producer_fifo_ptr_array[enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count + processIndex],
             is16bit,
             color_format,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
@@ -1604,6 +1973,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             cdef_context_ctor,
             enc_handle_ptr->dlf_results_consumer_fifo_ptr_array[processIndex],
             enc_handle_ptr->cdef_results_producer_fifo_ptr_array[processIndex],
+            enc_handle_ptr->dlf_results_producer_fifo_ptr_array[enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count + processIndex],
             is16bit,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_height
@@ -1620,6 +1990,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->rest_results_producer_fifo_ptr_array[processIndex],
             enc_handle_ptr->picture_demux_results_producer_fifo_ptr_array[
                 /*enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->source_based_operations_process_init_count*/ 1+ processIndex],
+            enc_handle_ptr->cdef_results_producer_fifo_ptr_array[enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count + processIndex],
             is16bit,
             color_format,
             enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->max_input_luma_width,
@@ -1627,6 +1998,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         );
     }
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ENTROPY);
     // Entropy Coding Contexts
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->entropy_coding_process_init_count);
 
@@ -1635,6 +2007,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->entropy_coding_context_ptr_array[processIndex],
             entropy_coding_context_ctor,
             enc_handle_ptr->rest_results_consumer_fifo_ptr_array[processIndex],
+            enc_handle_ptr->rest_results_producer_fifo_ptr_array[enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count + processIndex],
             enc_handle_ptr->entropy_coding_results_producer_fifo_ptr_array[processIndex],
             enc_handle_ptr->rate_control_tasks_producer_fifo_ptr_array[RateControlPortLookup(RATE_CONTROL_INPUT_PORT_ENTROPY_CODING, processIndex)],
             is16bit);
@@ -1659,9 +2032,62 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
+    // Pipeline Trace
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs_ptr = enc_handle_ptr->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr;
+        if (scs_ptr->static_config.trace_event_count) {
+            EB_NEW(
+                enc_handle_ptr->sequence_control_set_instance_array[instance_index]->encode_context_ptr->trace_ptr,
+                eb_trace_ctor,
+                scs_ptr->static_config.trace_event_count);
+        }
+    }
+
+    // Thread Pool
+    if (config_ptr->thread_pool || config_ptr->thread_pool_size != 0) {
+        EbThreadPool *thread_pool_ptr = (EbThreadPool*)config_ptr->thread_pool;
+        uint32_t pooled_thread_count =
+            control_set_ptr->picture_analysis_process_init_count +
+            control_set_ptr->motion_estimation_process_init_count +
+            control_set_ptr->source_based_operations_process_init_count +
+            control_set_ptr->mode_decision_configuration_process_init_count +
+            control_set_ptr->enc_dec_process_init_count +
+            control_set_ptr->dlf_process_init_count +
+            control_set_ptr->cdef_process_init_count +
+            control_set_ptr->rest_process_init_count +
+            control_set_ptr->entropy_coding_process_init_count;
+
+        if (!thread_pool_ptr) {
+            uint32_t pool_size = (uint32_t)config_ptr->thread_pool_size;
+            if (config_ptr->thread_pool_size == -1) {
+                pool_size = GetCpuQuota();
+                if (pool_size == 0) {
+                    pool_size = GetNumProcessors();
+                    if (config_ptr->logical_processors != 0 && config_ptr->logical_processors < pool_size)
+                        pool_size = config_ptr->logical_processors;
+                }
+            }
+            pool_size = CLIP3(1, pooled_thread_count, pool_size);
+
+            EB_NEW(
+                enc_handle_ptr->thread_pool_ptr,
+                eb_thread_pool_ctor,
+                pool_size);
+            thread_pool_ptr = enc_handle_ptr->thread_pool_ptr;
+        }
+
+        EB_NEW(
+            enc_handle_ptr->thread_pool_channel_ptr,
+            eb_thread_pool_channel_ctor,
+            thread_pool_ptr,
+            pooled_thread_count);
+    }
+
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ANALYSIS);
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array, control_set_ptr->picture_analysis_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         picture_analysis_kernel,
         enc_handle_ptr->picture_analysis_context_ptr_array);
 
@@ -1669,7 +2095,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
     // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         motion_estimation_kernel,
         enc_handle_ptr->motion_estimation_context_ptr_array);
 
@@ -1677,44 +2103,49 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
     // Source Based Oprations
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         source_based_operations_kernel,
         enc_handle_ptr->source_based_operations_context_ptr_array);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
     // Picture Manager
     EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ENTROPY);
     // Rate Control
     EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_MODE_DECISION);
     // Mode Decision Configuration Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         mode_decision_configuration_kernel,
         enc_handle_ptr->mode_decision_configuration_context_ptr_array);
 
 
     // EncDec Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         enc_dec_kernel,
         enc_handle_ptr->enc_dec_context_ptr_array);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_LOOP_FILTER);
     // Dlf Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         dlf_kernel,
         enc_handle_ptr->dlf_context_ptr_array);
 
     // Cdef Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         cdef_kernel,
         enc_handle_ptr->cdef_context_ptr_array);
 
     // Rest Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         rest_kernel,
         enc_handle_ptr->rest_context_ptr_array);
 
+    eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_ENTROPY);
     // Entropy Coding Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+    EB_CREATE_POOL_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count, enc_handle_ptr->thread_pool_channel_ptr,
         entropy_coding_kernel,
         enc_handle_ptr->entropy_coding_context_ptr_array);
 
@@ -1729,6 +2160,113 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     return return_error;
 }
 
+/**********************************
+* Initialize Encoder Library
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EbMemAccount *prev_account = eb_set_mem_account(enc_handle_ptr->mem_account);
+    EbMemorySubsystem prev_subsystem = eb_set_mem_subsystem(EB_MEM_SUBSYSTEM_OTHER);
+    EbErrorType return_error = init_encoder(enc_handle_ptr);
+
+    eb_set_mem_subsystem(prev_subsystem);
+    eb_set_mem_account(prev_account);
+    return return_error;
+}
+
+/**********************************
+* Memory Usage of the Encoder
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_memory_usage(
+    EbComponentType *svt_enc_component,
+    EbMemoryUsage   *usage)
+{
+    if (svt_enc_component == NULL || usage == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr == NULL)
+        return EB_ErrorBadParameter;
+    eb_get_mem_account_usage(enc_handle_ptr->mem_account, usage);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Pipeline Trace of the Encoder
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_trace(
+    EbComponentType     *svt_enc_component,
+    const EbTraceEvent **events,
+    uint32_t            *event_count)
+{
+    if (svt_enc_component == NULL || events == NULL || event_count == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr == NULL)
+        return EB_ErrorBadParameter;
+    EbTrace *trace_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->encode_context_ptr->trace_ptr;
+    *events = NULL;
+    *event_count = 0;
+    if (trace_ptr)
+        *event_count = eb_trace_get_events(trace_ptr, events);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Thread Pool shared by Encoder Handles
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_create_thread_pool(
+    EbSvtThreadPool **thread_pool,
+    int32_t           pool_size)
+{
+    EbThreadPool *thread_pool_ptr;
+
+    if (thread_pool == NULL)
+        return EB_ErrorBadParameter;
+    *thread_pool = NULL;
+    if (pool_size == 0 || pool_size < -1)
+        return EB_ErrorBadParameter;
+
+    if (pool_size == -1) {
+        pool_size = (int32_t)GetCpuQuota();
+        if (pool_size == 0)
+            pool_size = (int32_t)GetNumProcessors();
+    }
+    EB_NEW(
+        thread_pool_ptr,
+        eb_thread_pool_ctor,
+        (uint32_t)pool_size);
+    *thread_pool = thread_pool_ptr;
+
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_destroy_thread_pool(
+    EbSvtThreadPool *thread_pool)
+{
+    if (thread_pool == NULL)
+        return EB_ErrorBadParameter;
+    EB_DELETE(thread_pool);
+    return EB_ErrorNone;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -1800,7 +2338,9 @@ EbErrorType eb_av1_enc_component_de_init(EbComponentType  *svt_enc_component)
 
     if (svt_enc_component->p_component_private) {
         EbEncHandle* handle = (EbEncHandle*)svt_enc_component->p_component_private;
+        EbMemAccount *mem_account = handle->mem_account;
         EB_DELETE(handle);
+        eb_release_mem_account(mem_account);
         svt_enc_component->p_component_private = NULL;
     }
     else
@@ -2161,6 +2701,12 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->active_channel_count;
     sequence_control_set_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->logical_processors;
     sequence_control_set_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->target_socket;
+    sequence_control_set_ptr->static_config.thread_pool_size = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->thread_pool_size;
+    sequence_control_set_ptr->static_config.thread_pool = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->thread_pool;
+    sequence_control_set_ptr->static_config.memory_budget_mb = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->memory_budget_mb;
+    sequence_control_set_ptr->static_config.trace_event_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->trace_event_count;
+    sequence_control_set_ptr->static_config.zero_copy_input = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->zero_copy_input;
+    sequence_control_set_ptr->static_config.input_release_callback = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->input_release_callback;
     sequence_control_set_ptr->qp = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->qp;
     sequence_control_set_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_enabled;
 
@@ -2497,6 +3043,11 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->zero_copy_input && config->input_release_callback == NULL) {
+        SVT_LOG("Error instance %u: Zero copy input requires an input release callback\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->speed_control_flag > 1) {
         SVT_LOG("Error Instance %u: Invalid Speed Control flag [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2513,6 +3064,11 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->thread_pool_size < -1) {
+        SVT_LOG("Error instance %u: Invalid thread_pool_size. thread_pool_size must be -1 or larger \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // alt-ref frames related
     if (config->altref_strength > ALTREF_MAX_STRENGTH ) {
         SVT_LOG("Error instance %u: invalid altref-strength, should be in the range [0 - %d] \n", channelNumber + 1, ALTREF_MAX_STRENGTH);
@@ -2626,6 +3182,12 @@ EbErrorType eb_svt_enc_init_parameter(
     // Channel info
     config_ptr->logical_processors = 0;
     config_ptr->target_socket = -1;
+    config_ptr->thread_pool_size = 0;
+    config_ptr->thread_pool = NULL;
+    config_ptr->memory_budget_mb = 0;
+    config_ptr->trace_event_count = 0;
+    config_ptr->zero_copy_input = EB_FALSE;
+    config_ptr->input_release_callback = NULL;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
@@ -2764,11 +3326,13 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr);
 
     // Initialize the Prediction Structure Group
+    EbMemAccount *prev_account = eb_set_mem_account(pEncCompData->mem_account);
     EB_NO_THROW_NEW(
         pEncCompData->sequence_control_set_instance_array[instance_index]->encode_context_ptr->prediction_structure_group_ptr,
         prediction_structure_group_ctor,
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.enc_mode,
         pEncCompData->sequence_control_set_instance_array[instance_index]->sequence_control_set_ptr->static_config.base_layer_switch_mode);
+    eb_set_mem_account(prev_account);
     if (!pEncCompData->sequence_control_set_instance_array[instance_index]->encode_context_ptr->prediction_structure_group_ptr) {
         eb_release_mutex(pEncCompData->sequence_control_set_instance_array[instance_index]->config_mutex);
         return EB_ErrorInsufficientResources;
@@ -2814,19 +3378,20 @@ EB_API EbErrorType eb_svt_enc_stream_header(
         return EB_ErrorInsufficientResources;
     }
 
-    outputStreamBuffer->p_buffer = (uint8_t *)malloc(sizeof(uint8_t) * PACKETIZATION_PROCESS_BUFFER_SIZE);
+    outputStreamBuffer->p_buffer = (uint8_t *)malloc(sizeof(uint8_t) * PACKETIZATION_PROCESS_SPS_BUFFER_SIZE);
     if (!outputStreamBuffer->p_buffer) {
         free(outputStreamBuffer);
         return EB_ErrorInsufficientResources;
     }
 
     outputStreamBuffer->size = sizeof(EbBufferHeaderType);
-    outputStreamBuffer->n_alloc_len = PACKETIZATION_PROCESS_BUFFER_SIZE;
+    outputStreamBuffer->n_alloc_len = PACKETIZATION_PROCESS_SPS_BUFFER_SIZE;
     outputStreamBuffer->p_app_private = NULL;
     outputStreamBuffer->pic_type = EB_AV1_INVALID_PICTURE;
     outputStreamBuffer->n_filled_len = 0;
 
     ((OutputBitstreamUnit *)bitstream.output_bitstream_ptr)->buffer_begin_av1 = outputStreamBuffer->p_buffer;
+    ((OutputBitstreamUnit *)bitstream.output_bitstream_ptr)->size = outputStreamBuffer->n_alloc_len;
 
     output_bitstream_reset(bitstream.output_bitstream_ptr);
 
@@ -3051,6 +3616,91 @@ static void CopyInputBuffer(
         CopyFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
 }
 
+/***********************************************
+**** Point the library buffer to the planes of
+**** a zero copy input of the application
+************************************************/
+static EbErrorType WrapInputBuffer(
+    SequenceControlSet    *sequence_control_set_ptr,
+    EbBufferHeaderType    *dst,
+    EbBufferHeaderType    *src)
+{
+    EbPictureBufferDesc   *input_picture_ptr = (EbPictureBufferDesc*)dst->p_buffer;
+    EbSvtIOFormat         *inputPtr = (EbSvtIOFormat*)src->p_buffer;
+    EbBool                 is16BitInput = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    const uint32_t         lumaOffset = input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y;
+    const uint32_t         chromaOffset = (input_picture_ptr->origin_x >> sequence_control_set_ptr->subsampling_x) +
+        (input_picture_ptr->origin_y >> sequence_control_set_ptr->subsampling_y) * input_picture_ptr->stride_cb;
+
+    input_picture_ptr->buffer_y = input_picture_ptr->buffer_cb = input_picture_ptr->buffer_cr = NULL;
+    input_picture_ptr->buffer_bit_inc_y = input_picture_ptr->buffer_bit_inc_cb = input_picture_ptr->buffer_bit_inc_cr = NULL;
+
+    // The end of stream input is not encoded
+    if (inputPtr != NULL && !(src->flags & EB_BUFFERFLAG_EOS)) {
+        if (inputPtr->y_stride != input_picture_ptr->stride_y ||
+            inputPtr->cb_stride != input_picture_ptr->stride_cb ||
+            inputPtr->cr_stride != input_picture_ptr->stride_cr ||
+            (is16BitInput && (!inputPtr->luma_ext || !inputPtr->cb_ext || !inputPtr->cr_ext)))
+            return EB_ErrorBadParameter;
+
+        input_picture_ptr->buffer_y = inputPtr->luma - lumaOffset;
+        input_picture_ptr->buffer_cb = inputPtr->cb - chromaOffset;
+        input_picture_ptr->buffer_cr = inputPtr->cr - chromaOffset;
+        if (is16BitInput) {
+            input_picture_ptr->buffer_bit_inc_y = inputPtr->luma_ext - lumaOffset;
+            input_picture_ptr->buffer_bit_inc_cb = inputPtr->cb_ext - chromaOffset;
+            input_picture_ptr->buffer_bit_inc_cr = inputPtr->cr_ext - chromaOffset;
+        }
+    }
+
+    // Copy the higher level structure
+    dst->n_alloc_len = src->n_alloc_len;
+    dst->n_filled_len = src->n_filled_len;
+    dst->flags = src->flags;
+    dst->pts = src->pts;
+    dst->n_tick_count = src->n_tick_count;
+    dst->size = src->size;
+    dst->qp = src->qp;
+    dst->pic_type = src->pic_type;
+    dst->p_app_private = src->p_app_private;
+
+    return EB_ErrorNone;
+}
+
+/***********************************************
+**** Release callbacks of the zero copy inputs
+************************************************/
+static void release_zero_copy_input(
+    EbPtr object_ptr,
+    EbPtr callback_data)
+{
+    EbEncHandle           *enc_handle_ptr = (EbEncHandle*)callback_data;
+    EbBufferHeaderType    *input_ptr = (EbBufferHeaderType*)object_ptr;
+    EbPictureBufferDesc   *input_picture_ptr = (EbPictureBufferDesc*)input_ptr->p_buffer;
+    EbComponentType       *svt_enc_component = (EbComponentType*)enc_handle_ptr->app_callback_ptr_array[0]->handle;
+
+    if (input_picture_ptr->buffer_y == NULL)
+        return;
+    enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.input_release_callback(
+        svt_enc_component->p_application_private,
+        input_ptr->p_app_private);
+    input_picture_ptr->buffer_y = NULL;
+}
+
+static void release_zero_copy_pa_reference(
+    EbPtr object_ptr,
+    EbPtr callback_data)
+{
+    EbPaReferenceObject   *pa_reference_object = (EbPaReferenceObject*)object_ptr;
+    EbObjectWrapper       *input_picture_wrapper_ptr = pa_reference_object->input_picture_wrapper_ptr;
+    (void)callback_data;
+
+    if (input_picture_wrapper_ptr == NULL)
+        return;
+    pa_reference_object->input_picture_wrapper_ptr = NULL;
+    eb_release_object(input_picture_wrapper_ptr);
+}
+
 /**********************************
 * Empty This Buffer
 **********************************/
@@ -3070,16 +3720,67 @@ EB_API EbErrorType eb_svt_enc_send_picture(
         &ebWrapperPtr);
 
     if (p_buffer != NULL) {
-        CopyInputBuffer(
-            enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr,
-            (EbBufferHeaderType*)ebWrapperPtr->object_ptr,
-            p_buffer);
+        SequenceControlSet *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+        if (sequence_control_set_ptr->static_config.zero_copy_input) {
+            EbErrorType return_error = WrapInputBuffer(
+                sequence_control_set_ptr,
+                (EbBufferHeaderType*)ebWrapperPtr->object_ptr,
+                p_buffer);
+            if (return_error != EB_ErrorNone) {
+                // Post the object back empty
+                eb_release_object(ebWrapperPtr);
+                return return_error;
+            }
+            // The end of stream input is not encoded, its picture is free right away
+            if ((p_buffer->flags & EB_BUFFERFLAG_EOS) && p_buffer->p_buffer != NULL)
+                sequence_control_set_ptr->static_config.input_release_callback(
+                    svt_enc_component->p_application_private,
+                    p_buffer->p_app_private);
+        }
+        else {
+            CopyInputBuffer(
+                sequence_control_set_ptr,
+                (EbBufferHeaderType*)ebWrapperPtr->object_ptr,
+                p_buffer);
+        }
     }
 
     eb_post_full_object(ebWrapperPtr);
 
     return EB_ErrorNone;
 }
+
+/**********************************
+* Zero Copy Input Layout
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_input_layout(
+    EbComponentType      *svt_enc_component,
+    EbInputLayout        *layout)
+{
+    if (svt_enc_component == NULL || layout == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle_ptr == NULL)
+        return EB_ErrorBadParameter;
+    SequenceControlSet *sequence_control_set_ptr = enc_handle_ptr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+    const uint16_t subsampling_x = sequence_control_set_ptr->subsampling_x;
+
+    // Same layout as the input pictures allocated by the library
+    layout->width = sequence_control_set_ptr->max_input_luma_width;
+    layout->height = sequence_control_set_ptr->max_input_luma_height;
+    layout->origin_x = sequence_control_set_ptr->left_padding;
+    layout->origin_y = sequence_control_set_ptr->top_padding;
+    layout->y_stride = layout->width + sequence_control_set_ptr->left_padding + sequence_control_set_ptr->right_padding;
+    layout->cb_stride = layout->cr_stride = layout->y_stride >> subsampling_x;
+    layout->luma_size = layout->y_stride *
+        (layout->height + sequence_control_set_ptr->top_padding + sequence_control_set_ptr->bot_padding);
+    layout->chroma_size = layout->luma_size >> (3 - sequence_control_set_ptr->static_config.encoder_color_format);
+
+    return EB_ErrorNone;
+}
 static void CopyOutputReconBuffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -3245,14 +3946,26 @@ EbErrorType init_svt_av1_encoder_handle(
     // Set Component Size & Version
     svt_enc_component->size = sizeof(EbComponentType);
 
-    EB_NEW(handle, eb_enc_handle_ctor, svt_enc_component);
+    // Everything the handle allocates is charged to its memory account
+    EbMemAccount *mem_account = eb_create_mem_account();
+    if (!mem_account)
+        return EB_ErrorInsufficientResources;
+    EbMemAccount *prev_account = eb_set_mem_account(mem_account);
+    EB_NO_THROW_NEW(handle, eb_enc_handle_ctor, svt_enc_component);
+    eb_set_mem_account(prev_account);
+    if (!handle) {
+        eb_release_mem_account(mem_account);
+        return EB_ErrorInsufficientResources;
+    }
+    handle->mem_account = mem_account;
     svt_enc_component->p_component_private = handle;
 
     return return_error;
 }
 static EbErrorType allocate_frame_buffer(
     SequenceControlSet       *sequence_control_set_ptr,
-    EbBufferHeaderType        *inputBuffer)
+    EbBufferHeaderType        *inputBuffer,
+    EbBool                     zero_copy)
 {
     EbErrorType   return_error = EB_ErrorNone;
     EbPictureBufferDescInitData input_picture_buffer_desc_init_data;
@@ -3277,6 +3990,10 @@ static EbErrorType allocate_frame_buffer(
 
     input_picture_buffer_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
 
+    // The planes of a zero copy input belong to the application
+    if (zero_copy)
+        input_picture_buffer_desc_init_data.buffer_enable_mask = 0;
+
     if (is16bit && config->compressed_ten_bit_format == 1)
         input_picture_buffer_desc_init_data.split_mode = EB_FALSE;  //do special allocation for 2bit data down below.
     // Enhanced Picture Buffer
@@ -3315,7 +4032,35 @@ EbErrorType EbInputBufferHeaderCreator(
 
     allocate_frame_buffer(
         sequence_control_set_ptr,
-        inputBuffer);
+        inputBuffer,
+        EB_FALSE);
+
+    inputBuffer->p_app_private = NULL;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+* EbBufferHeaderType Constructor of the
+* zero copy inputs, without planes
+**************************************/
+EbErrorType EbZeroCopyInputBufferHeaderCreator(
+    EbPtr *objectDblPtr,
+    EbPtr  objectInitDataPtr)
+{
+    EbBufferHeaderType* inputBuffer;
+    SequenceControlSet        *sequence_control_set_ptr = (SequenceControlSet*)objectInitDataPtr;
+
+    *objectDblPtr = NULL;
+    EB_CALLOC(inputBuffer, 1, sizeof(EbBufferHeaderType));
+    *objectDblPtr = (EbPtr)inputBuffer;
+    // Initialize Header
+    inputBuffer->size = sizeof(EbBufferHeaderType);
+
+    allocate_frame_buffer(
+        sequence_control_set_ptr,
+        inputBuffer,
+        EB_TRUE);
 
     inputBuffer->p_app_private = NULL;
 
@@ -3326,9 +4071,11 @@ void EbInputBufferHeaderDestoryer(    EbPtr p)
 {
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_y);
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cb);
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cr);
+    if (buf->buffer_enable_mask) {
+        EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_y);
+        EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cb);
+        EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cr);
+    }
 
     EB_DELETE(buf);
     EB_FREE(obj);
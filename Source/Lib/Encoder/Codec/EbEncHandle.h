@@ -92,6 +92,15 @@ typedef struct EbEncHandle
 
     EbHandle                               packetization_thread_handle;
 
+    // Run slots shared by the kernel thread arrays, NULL if not pooled or
+    // if the pool is shared with other handles
+    EbThreadPool                          *thread_pool_ptr;
+    // Attachment of the kernel thread arrays to their pool
+    EbThreadPoolChannel                   *thread_pool_channel_ptr;
+
+    // Charged with every allocation of the handle and its threads
+    EbMemAccount                          *mem_account;
+
     // Contexts
     ResourceCoordinationContext            *resource_coordination_context_ptr;
     PictureAnalysisContext                 **picture_analysis_context_ptr_array;
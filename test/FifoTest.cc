@@ -0,0 +1,218 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file FifoTest.cc
+ *
+ * @brief Unit test for the system resource fifos:
+ * - eb_get_empty_object
+ * - eb_post_full_object
+ * - eb_get_full_object
+ * - eb_release_object
+ *
+ * Producer and consumer threads pass a small pool of objects around, with
+ * the lock-free ring when built with LOCKFREE_FIFO and with the mutex based
+ * fifos otherwise.
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "gtest/gtest.h"
+#include "EbSystemResourceManager.h"
+
+namespace {
+
+static const uint32_t end_of_stream = ~0u;
+
+typedef struct FifoTestObject {
+    uint32_t producer;
+    uint32_t value;
+} FifoTestObject;
+
+static EbErrorType fifo_test_object_creator(EbPtr *object_dbl_ptr,
+                                            EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(FifoTestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void fifo_test_object_destroyer(EbPtr p) {
+    free(p);
+}
+
+struct FifoTestProducer {
+    EbFifo *empty_fifo_ptr;
+    uint32_t producer;
+    uint32_t object_count;
+    EbHandle done_semaphore;
+};
+
+struct FifoTestConsumer {
+    EbFifo *full_fifo_ptr;
+    // Last value and number of objects received from each producer
+    std::vector<uint32_t> last_value;
+    std::vector<uint32_t> received_count;
+    uint64_t value_sum;
+    bool in_order;
+    EbHandle done_semaphore;
+};
+
+static void *fifo_test_producer_kernel(void *input_ptr) {
+    FifoTestProducer *producer_ptr = (FifoTestProducer *)input_ptr;
+    EbObjectWrapper *wrapper_ptr;
+
+    for (uint32_t i = 0; i < producer_ptr->object_count; i++) {
+        eb_get_empty_object(producer_ptr->empty_fifo_ptr, &wrapper_ptr);
+        FifoTestObject *object_ptr = (FifoTestObject *)wrapper_ptr->object_ptr;
+        object_ptr->producer = producer_ptr->producer;
+        object_ptr->value = i;
+        eb_post_full_object(wrapper_ptr);
+    }
+    eb_post_semaphore(producer_ptr->done_semaphore);
+    return NULL;
+}
+
+static void *fifo_test_consumer_kernel(void *input_ptr) {
+    FifoTestConsumer *consumer_ptr = (FifoTestConsumer *)input_ptr;
+    EbObjectWrapper *wrapper_ptr;
+
+    for (;;) {
+        eb_get_full_object(consumer_ptr->full_fifo_ptr, &wrapper_ptr);
+        FifoTestObject *object_ptr = (FifoTestObject *)wrapper_ptr->object_ptr;
+        const uint32_t producer = object_ptr->producer;
+        const uint32_t value = object_ptr->value;
+        eb_release_object(wrapper_ptr);
+        if (value == end_of_stream)
+            break;
+
+        // A single producer queues in order, a consumer pops in order
+        if (consumer_ptr->received_count[producer] &&
+            value <= consumer_ptr->last_value[producer])
+            consumer_ptr->in_order = false;
+        consumer_ptr->last_value[producer] = value;
+        consumer_ptr->received_count[producer]++;
+        consumer_ptr->value_sum += value;
+    }
+    eb_post_semaphore(consumer_ptr->done_semaphore);
+    return NULL;
+}
+
+/**
+ * @brief Runs producer_count producers sending object_count objects each
+ * to consumer_count consumers, through a resource of pool_count objects.
+ *
+ * Expected result: <br>
+ * Every object is received exactly once, in the order of its producer.
+ */
+static void run_fifo_test(uint32_t producer_count, uint32_t consumer_count,
+                          uint32_t pool_count, uint32_t object_count) {
+    EbSystemResource *resource_ptr =
+        (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+    EbFifo **producer_fifo_ptr_array;
+    EbFifo **consumer_fifo_ptr_array;
+    std::vector<FifoTestProducer> producers(producer_count);
+    std::vector<FifoTestConsumer> consumers(consumer_count);
+    std::vector<EbHandle> threads;
+    EbHandle done_semaphore;
+    EbObjectWrapper *wrapper_ptr;
+
+    ASSERT_NE(resource_ptr, nullptr);
+    ASSERT_EQ(EB_ErrorNone,
+              eb_system_resource_ctor(resource_ptr,
+                                      pool_count,
+                                      producer_count,
+                                      consumer_count,
+                                      &producer_fifo_ptr_array,
+                                      &consumer_fifo_ptr_array,
+                                      EB_TRUE,
+                                      fifo_test_object_creator,
+                                      NULL,
+                                      fifo_test_object_destroyer));
+    done_semaphore = eb_create_semaphore(0, producer_count + consumer_count);
+    ASSERT_NE(done_semaphore, nullptr);
+
+    for (uint32_t i = 0; i < consumer_count; i++) {
+        FifoTestConsumer *consumer_ptr = &consumers[i];
+        consumer_ptr->full_fifo_ptr = consumer_fifo_ptr_array[i];
+        consumer_ptr->last_value.assign(producer_count, 0);
+        consumer_ptr->received_count.assign(producer_count, 0);
+        consumer_ptr->value_sum = 0;
+        consumer_ptr->in_order = true;
+        consumer_ptr->done_semaphore = done_semaphore;
+        threads.push_back(
+            eb_create_thread(fifo_test_consumer_kernel, consumer_ptr));
+    }
+    for (uint32_t i = 0; i < producer_count; i++) {
+        FifoTestProducer *producer_ptr = &producers[i];
+        producer_ptr->empty_fifo_ptr = producer_fifo_ptr_array[i];
+        producer_ptr->producer = i;
+        producer_ptr->object_count = object_count;
+        producer_ptr->done_semaphore = done_semaphore;
+        threads.push_back(
+            eb_create_thread(fifo_test_producer_kernel, producer_ptr));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        ASSERT_NE(threads[i], nullptr);
+
+    // Once the producers are done, stop every consumer
+    for (uint32_t i = 0; i < producer_count; i++)
+        eb_block_on_semaphore(done_semaphore);
+    for (uint32_t i = 0; i < consumer_count; i++) {
+        eb_get_empty_object(producer_fifo_ptr_array[0], &wrapper_ptr);
+        ((FifoTestObject *)wrapper_ptr->object_ptr)->value = end_of_stream;
+        eb_post_full_object(wrapper_ptr);
+    }
+    for (uint32_t i = 0; i < consumer_count; i++)
+        eb_block_on_semaphore(done_semaphore);
+
+    for (size_t i = 0; i < threads.size(); i++)
+        eb_destroy_thread(threads[i]);
+    eb_destroy_semaphore(done_semaphore);
+    resource_ptr->dctor(resource_ptr);
+    free(resource_ptr);
+
+    const uint64_t expected_sum =
+        (uint64_t)object_count * (object_count - 1) / 2 * producer_count;
+    uint64_t value_sum = 0;
+    for (uint32_t i = 0; i < consumer_count; i++) {
+        EXPECT_TRUE(consumers[i].in_order) << "consumer " << i;
+        value_sum += consumers[i].value_sum;
+    }
+    for (uint32_t p = 0; p < producer_count; p++) {
+        uint32_t received_count = 0;
+        for (uint32_t i = 0; i < consumer_count; i++)
+            received_count += consumers[i].received_count[p];
+        EXPECT_EQ(object_count, received_count) << "producer " << p;
+    }
+    EXPECT_EQ(expected_sum, value_sum);
+}
+
+TEST(FifoTest, SingleProducerSingleConsumer) {
+    run_fifo_test(1, 1, 4, 200000);
+}
+
+TEST(FifoTest, SingleProducerSingleConsumerOneObject) {
+    run_fifo_test(1, 1, 1, 20000);
+}
+
+TEST(FifoTest, MultiProducerMultiConsumer) {
+    run_fifo_test(4, 4, 8, 50000);
+}
+
+TEST(FifoTest, MultiProducerMultiConsumerContended) {
+    run_fifo_test(8, 8, 3, 20000);
+}
+
+}  // namespace
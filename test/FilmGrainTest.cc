@@ -212,6 +212,11 @@ class AddFilmGrainTest : public ::testing::Test {
         luma_ = (uint8_t *)eb_aom_malloc(luma_size);
         cb_ = (uint8_t *)eb_aom_malloc(chroma_size);
         cr_ = (uint8_t *)eb_aom_malloc(chroma_size);
+        // eb_av1_add_film_grain_run adds the noise through these pointers
+        eb_av1_add_noise_to_block = eb_av1_add_noise_to_block_c;
+        eb_av1_add_noise_to_block_hbd = eb_av1_add_noise_to_block_hbd_c;
+        eb_av1_luma_grain_ar_filter = eb_av1_luma_grain_ar_filter_c;
+        eb_av1_chroma_grain_ar_filter = eb_av1_chroma_grain_ar_filter_c;
     }
 
     void TearDown() override {
@@ -271,6 +276,216 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+typedef void (*AddNoiseToBlockFunc)(
+    const FilmGrainCtxt *ctxt, const uint8_t *src_luma, const uint8_t *src_cb,
+    const uint8_t *src_cr, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+    int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
+    int32_t luma_grain_stride, int32_t chroma_grain_stride,
+    int32_t half_luma_height, int32_t half_luma_width);
+typedef void (*AddNoiseToBlockHbdFunc)(
+    const FilmGrainCtxt *ctxt, const uint16_t *src_luma,
+    const uint16_t *src_cb, const uint16_t *src_cr, uint16_t *luma,
+    uint16_t *cb, uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain,
+    int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride,
+    int32_t half_luma_height, int32_t half_luma_width);
+typedef void (*LumaGrainArFilterFunc)(
+    const aom_film_grain_t *params, int32_t **pred_pos_luma,
+    int32_t *luma_grain_block, int32_t luma_block_size_y,
+    int32_t luma_block_size_x, int32_t luma_grain_stride, int32_t left_pad,
+    int32_t top_pad, int32_t right_pad, int32_t bottom_pad, int32_t grain_min,
+    int32_t grain_max);
+typedef void (*ChromaGrainArFilterFunc)(
+    const aom_film_grain_t *params, int32_t **pred_pos_chroma,
+    const int32_t *luma_grain_block, int32_t *cb_grain_block,
+    int32_t *cr_grain_block, int32_t luma_grain_stride,
+    int32_t chroma_block_size_y, int32_t chroma_block_size_x,
+    int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
+    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max);
+
+typedef struct {
+    AddNoiseToBlockFunc add_noise;
+    AddNoiseToBlockHbdFunc add_noise_hbd;
+    LumaGrainArFilterFunc luma_ar_filter;
+    ChromaGrainArFilterFunc chroma_ar_filter;
+} FilmGrainKernels;
+
+static const FilmGrainKernels film_grain_kernels_c = {
+    eb_av1_add_noise_to_block_c,
+    eb_av1_add_noise_to_block_hbd_c,
+    eb_av1_luma_grain_ar_filter_c,
+    eb_av1_chroma_grain_ar_filter_c};
+
+static const FilmGrainKernels film_grain_kernels_simd[] = {
+    {eb_av1_add_noise_to_block_sse4_1,
+     eb_av1_add_noise_to_block_hbd_sse4_1,
+     eb_av1_luma_grain_ar_filter_sse4_1,
+     eb_av1_chroma_grain_ar_filter_sse4_1},
+    {eb_av1_add_noise_to_block_avx2,
+     eb_av1_add_noise_to_block_hbd_avx2,
+     eb_av1_luma_grain_ar_filter_avx2,
+     eb_av1_chroma_grain_ar_filter_avx2}};
+
+/**
+ * @brief Unit test for the SIMD film grain kernels
+ *
+ * Test strategy:
+ * Synthesize the film grain of random frames with random parameters,
+ * once with the C kernels and once with the SIMD ones, and compare the
+ * outputs.
+ *
+ * Expected result:
+ * The outputs are identical.
+ *
+ * Test coverage:
+ * 8, 10 and 12 bit, 4:0:0, 4:2:0, 4:2:2 and 4:4:4, with and without
+ * overlap, all the auto-regressive filter lags.
+ */
+class FilmGrainSimdTest : public ::testing::TestWithParam<FilmGrainKernels> {
+  public:
+    FilmGrainSimdTest() : random_(0x1a2b) {
+    }
+
+  protected:
+    void set_kernels(const FilmGrainKernels &kernels) {
+        eb_av1_add_noise_to_block = kernels.add_noise;
+        eb_av1_add_noise_to_block_hbd = kernels.add_noise_hbd;
+        eb_av1_luma_grain_ar_filter = kernels.luma_ar_filter;
+        eb_av1_chroma_grain_ar_filter = kernels.chroma_ar_filter;
+    }
+
+    void rand_points(int32_t (*points)[2], int32_t num_points) {
+        int32_t x = random_.PseudoUniform(21);
+        for (int32_t i = 0; i < num_points; i++) {
+            points[i][0] = x;
+            points[i][1] = random_.Rand8();
+            x += 1 + random_.PseudoUniform((255 - x) / (num_points - i + 1) + 1);
+            if (x > 255)
+                x = 255;
+        }
+    }
+
+    void rand_params(aom_film_grain_t *params, int32_t mono,
+                     int32_t bit_depth) {
+        memset(params, 0, sizeof(*params));
+        params->apply_grain = 1;
+        params->bit_depth = bit_depth;
+        params->num_y_points = random_.PseudoUniform(15);
+        rand_points(params->scaling_points_y, params->num_y_points);
+        if (!mono) {
+            params->chroma_scaling_from_luma = random_.PseudoUniform(4) == 0;
+            if (!params->chroma_scaling_from_luma) {
+                params->num_cb_points = random_.PseudoUniform(11);
+                rand_points(params->scaling_points_cb, params->num_cb_points);
+                params->num_cr_points = random_.PseudoUniform(11);
+                rand_points(params->scaling_points_cr, params->num_cr_points);
+            }
+        }
+        params->scaling_shift = 8 + random_.PseudoUniform(4);
+        params->ar_coeff_lag = random_.PseudoUniform(4);
+        for (int32_t i = 0; i < 24; i++)
+            params->ar_coeffs_y[i] = random_.PseudoUniform(81) - 40;
+        for (int32_t i = 0; i < 25; i++) {
+            params->ar_coeffs_cb[i] = random_.PseudoUniform(81) - 40;
+            params->ar_coeffs_cr[i] = random_.PseudoUniform(81) - 40;
+        }
+        params->ar_coeff_shift = 6 + random_.PseudoUniform(4);
+        params->cb_mult = random_.Rand8();
+        params->cb_luma_mult = random_.Rand8();
+        params->cb_offset = random_.PseudoUniform(512);
+        params->cr_mult = random_.Rand8();
+        params->cr_luma_mult = random_.Rand8();
+        params->cr_offset = random_.PseudoUniform(512);
+        params->overlap_flag = random_.PseudoUniform(2);
+        params->clip_to_restricted_range = random_.PseudoUniform(2);
+        params->grain_scale_shift = random_.PseudoUniform(4);
+        params->random_seed = random_.Rand16();
+    }
+
+    void add_grain(aom_film_grain_t *params, const uint8_t *const *src,
+                   uint8_t *const *dst, int32_t mono, int32_t width,
+                   int32_t height, int32_t stride, int32_t chroma_stride,
+                   int32_t hbd, int32_t sy, int32_t sx) {
+        FilmGrainCtxt ctxt;
+        eb_av1_film_grain_init(&ctxt, params, src[0], mono ? NULL : src[1],
+                               mono ? NULL : src[2], stride, chroma_stride,
+                               dst[0], mono ? NULL : dst[1],
+                               mono ? NULL : dst[2], stride, chroma_stride,
+                               height, width, hbd, sy, sx);
+        for (int32_t band = 0; band < ctxt.num_bands; band++)
+            eb_av1_add_film_grain_band(&ctxt, band);
+        eb_av1_film_grain_free(&ctxt);
+    }
+
+    void run_test(const FilmGrainKernels &kernels, int32_t bit_depth,
+                  int32_t format) {
+        const int32_t hbd = bit_depth > 8;
+        const int32_t mono = format == 0;
+        const int32_t sx = format == 3 ? 0 : 1;
+        const int32_t sy = format <= 1 ? 1 : 0;
+        const int32_t width = 2 + random_.PseudoUniform(199);
+        const int32_t height = 2 + random_.PseudoUniform(99);
+        const int32_t stride = width + random_.PseudoUniform(16);
+        const int32_t chroma_width = (width + sx) >> sx;
+        const int32_t chroma_height = (height + sy) >> sy;
+        const int32_t chroma_stride = chroma_width + random_.PseudoUniform(16);
+        const size_t size[3] = {(size_t)(stride * height) << hbd,
+                                (size_t)(chroma_stride * chroma_height) << hbd,
+                                (size_t)(chroma_stride * chroma_height) << hbd};
+        aom_film_grain_t params;
+        uint8_t *src[3], *ref[3], *tst[3];
+
+        rand_params(&params, mono, bit_depth);
+        for (int32_t c = 0; c < 3; c++) {
+            src[c] = (uint8_t *)malloc(size[c]);
+            ref[c] = (uint8_t *)malloc(size[c]);
+            tst[c] = (uint8_t *)malloc(size[c]);
+            for (size_t i = 0; i < (size[c] >> hbd); i++) {
+                const uint16_t v = random_.Rand16() >> (16 - bit_depth);
+                if (hbd)
+                    ((uint16_t *)src[c])[i] = v;
+                else
+                    src[c][i] = (uint8_t)v;
+            }
+            memset(ref[c], 0, size[c]);
+            memset(tst[c], 0, size[c]);
+        }
+
+        set_kernels(film_grain_kernels_c);
+        add_grain(&params, src, ref, mono, width, height, stride,
+                  chroma_stride, hbd, sy, sx);
+        set_kernels(kernels);
+        add_grain(&params, src, tst, mono, width, height, stride,
+                  chroma_stride, hbd, sy, sx);
+
+        for (int32_t c = 0; c < (mono ? 1 : 3); c++)
+            EXPECT_EQ(memcmp(ref[c], tst[c], size[c]), 0)
+                << "plane " << c << " bit depth " << bit_depth << " format "
+                << format << " size " << width << "x" << height;
+
+        for (int32_t c = 0; c < 3; c++) {
+            free(src[c]);
+            free(ref[c]);
+            free(tst[c]);
+        }
+    }
+
+    libaom_test::ACMRandom random_;
+};
+
+TEST_P(FilmGrainSimdTest, MatchTest) {
+    const int32_t bit_depths[] = {8, 10, 12};
+    for (int32_t i = 0; i < 3; i++)
+        for (int32_t format = 0; format < 4; format++)
+            for (int32_t iter = 0; iter < 8; iter++)
+                run_test(GetParam(), bit_depths[i], format);
+    // Keep the other tests on the C kernels
+    set_kernels(film_grain_kernels_c);
+}
+
+INSTANTIATE_TEST_CASE_P(FilmGrain, FilmGrainSimdTest,
+                        ::testing::ValuesIn(film_grain_kernels_simd));
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -426,6 +641,11 @@ class DenoiseModelRunTest : public ::testing::Test {
             eb_aom_ifft8x8_float = eb_aom_ifft8x8_float_avx2;
             eb_aom_ifft2x2_float = eb_aom_ifft2x2_float_c;
             eb_aom_ifft4x4_float = eb_aom_ifft4x4_float_sse2;
+
+            eb_aom_flat_block_finder_extract_block =
+                eb_aom_flat_block_finder_extract_block_c;
+            eb_aom_noise_model_add_observation =
+                eb_aom_noise_model_add_observation_c;
         }
     }
 
@@ -473,3 +693,108 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+/**
+ * @brief Unit test for the AVX2 noise model kernels
+ *
+ * Test strategy:
+ * Extract random blocks, at the borders of the plane too, and add random
+ * observations to random normal equations with the C and the AVX2 kernels.
+ *
+ * Expected result:
+ * The results are identical, bit for bit.
+ */
+class NoiseModelSimdTest : public ::testing::Test {
+  public:
+    NoiseModelSimdTest() : random_(0x3c4d) {
+    }
+
+  protected:
+    libaom_test::ACMRandom random_;
+};
+
+TEST_F(NoiseModelSimdTest, ExtractBlockMatchTest) {
+    const int32_t block_sizes[] = {32, 8, 13};
+    for (int32_t i = 0; i < 3; i++) {
+        for (int32_t use_highbd = 0; use_highbd < 2; use_highbd++) {
+            const int32_t block_size = block_sizes[i];
+            const int32_t n = block_size * block_size;
+            const int32_t bit_depth = use_highbd ? 10 : 8;
+            const int32_t w = 67, h = 45, stride = 80;
+            aom_flat_block_finder_t block_finder;
+            uint16_t data[80 * 45];
+            double *plane_ref = (double *)malloc(n * sizeof(double));
+            double *block_ref = (double *)malloc(n * sizeof(double));
+            double *plane_tst = (double *)malloc(n * sizeof(double));
+            double *block_tst = (double *)malloc(n * sizeof(double));
+
+            ASSERT_EQ(eb_aom_flat_block_finder_init(
+                          &block_finder, block_size, bit_depth, use_highbd),
+                      1);
+            for (int32_t k = 0; k < stride * h; k++) {
+                if (use_highbd)
+                    data[k] = random_.Rand16() >> 6;
+                else
+                    ((uint8_t *)data)[k] = random_.Rand8();
+            }
+            for (int32_t iter = 0; iter < 50; iter++) {
+                const int32_t offsx =
+                    random_.PseudoUniform(w + block_size) - block_size;
+                const int32_t offsy =
+                    random_.PseudoUniform(h + block_size) - block_size;
+                eb_aom_flat_block_finder_extract_block_c(&block_finder,
+                                                         (uint8_t *)data,
+                                                         w,
+                                                         h,
+                                                         stride,
+                                                         offsx,
+                                                         offsy,
+                                                         plane_ref,
+                                                         block_ref);
+                eb_aom_flat_block_finder_extract_block_avx2(&block_finder,
+                                                            (uint8_t *)data,
+                                                            w,
+                                                            h,
+                                                            stride,
+                                                            offsx,
+                                                            offsy,
+                                                            plane_tst,
+                                                            block_tst);
+                EXPECT_EQ(memcmp(plane_ref, plane_tst, n * sizeof(double)), 0);
+                EXPECT_EQ(memcmp(block_ref, block_tst, n * sizeof(double)), 0);
+            }
+            eb_aom_flat_block_finder_free(&block_finder);
+            free(plane_ref);
+            free(block_ref);
+            free(plane_tst);
+            free(block_tst);
+        }
+    }
+}
+
+TEST_F(NoiseModelSimdTest, AddObservationMatchTest) {
+    // Number of coefficients of the models of lag 1 to 3, with and without
+    // the luma coefficient
+    const int32_t sizes[] = {4, 5, 12, 13, 24, 25};
+    for (int32_t i = 0; i < 6; i++) {
+        const int32_t n = sizes[i];
+        double A_ref[25 * 25], A_tst[25 * 25];
+        double b_ref[25], b_tst[25], buffer[25];
+
+        for (int32_t k = 0; k < n * n; k++)
+            A_ref[k] = A_tst[k] = random_.Rand31() / 1024.0;
+        for (int32_t k = 0; k < n; k++) {
+            b_ref[k] = b_tst[k] = random_.Rand31() / 1024.0;
+            buffer[k] = random_.PseudoUniform(1024);
+        }
+        for (int32_t iter = 0; iter < 10; iter++) {
+            const double val = random_.PseudoUniform(1024);
+            eb_aom_noise_model_add_observation_c(
+                A_ref, b_ref, buffer, val, n, 1023.0);
+            eb_aom_noise_model_add_observation_avx2(
+                A_tst, b_tst, buffer, val, n, 1023.0);
+        }
+        EXPECT_EQ(memcmp(A_ref, A_tst, n * n * sizeof(double)), 0);
+        EXPECT_EQ(memcmp(b_ref, b_tst, n * sizeof(double)), 0);
+    }
+}
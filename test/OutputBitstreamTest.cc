@@ -0,0 +1,130 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file OutputBitstreamTest.cc
+ *
+ * @brief Unit test for the growth of the output bitstream buffers:
+ * - output_bitstream_reserve
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "EbBitstreamUnit.h"
+#include "gtest/gtest.h"
+#include "random.h"
+
+using svt_av1_test_tool::SVTRandom;
+namespace {
+
+/**
+ * @brief Unit test for output_bitstream_reserve
+ *
+ * Test strategy:
+ * Write bytes to an OutputBitstreamUnit, reserving room before each
+ * write the way the entropy coder and the packetization do.
+ *
+ * Expected result:
+ * The buffer grows to take every reserved byte, the bytes written before
+ * are kept. A request that can not be satisfied fails and leaves the
+ * buffer unchanged.
+ */
+class OutputBitstreamTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        memset(&bitstream_, 0, sizeof(bitstream_));
+    }
+
+    void TearDown() override {
+        if (bitstream_.dctor)
+            bitstream_.dctor(&bitstream_);
+    }
+
+    void write_bytes(const uint8_t *bytes, uint32_t count) {
+        ASSERT_EQ(EB_ErrorNone, output_bitstream_reserve(&bitstream_, count));
+        memcpy(bitstream_.buffer_av1, bytes, count);
+        bitstream_.buffer_av1 += count;
+    }
+
+    uint32_t written_bytes() const {
+        return (uint32_t)(bitstream_.buffer_av1 - bitstream_.buffer_begin_av1);
+    }
+
+    OutputBitstreamUnit bitstream_;
+};
+
+TEST_F(OutputBitstreamTest, ReserveEmpty) {
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_unit_ctor(&bitstream_, 0));
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_reserve(&bitstream_, 100));
+    ASSERT_NE(nullptr, bitstream_.buffer_begin_av1);
+    EXPECT_EQ(bitstream_.buffer_begin_av1, bitstream_.buffer_av1);
+    EXPECT_GE(bitstream_.size, 100u);
+}
+
+TEST_F(OutputBitstreamTest, ReserveWithinSize) {
+    const uint8_t bytes[10] = {0};
+
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_unit_ctor(&bitstream_, 64));
+    uint8_t *const buffer = bitstream_.buffer_begin_av1;
+    write_bytes(bytes, sizeof(bytes));
+
+    // Room is left for exactly 54 bytes
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_reserve(&bitstream_, 54));
+    EXPECT_EQ(buffer, bitstream_.buffer_begin_av1);
+    EXPECT_EQ(64u, bitstream_.size);
+    EXPECT_EQ(10u, written_bytes());
+}
+
+TEST_F(OutputBitstreamTest, ReserveGrowth) {
+    SVTRandom rnd(0, 255);
+    std::vector<uint8_t> ref;
+
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_unit_ctor(&bitstream_, 16));
+    for (int i = 0; i < 100000; i++) {
+        uint8_t bytes[37];
+        const uint32_t count = (uint32_t)(i % sizeof(bytes)) + 1;
+        for (uint32_t j = 0; j < count; j++)
+            bytes[j] = (uint8_t)rnd.random();
+        write_bytes(bytes, count);
+        ref.insert(ref.end(), bytes, bytes + count);
+
+        // The size at least doubles on growth
+        ASSERT_LT(bitstream_.size, 2 * written_bytes() + 16);
+    }
+    ASSERT_EQ(ref.size(), written_bytes());
+    EXPECT_EQ(0, memcmp(ref.data(), bitstream_.buffer_begin_av1, ref.size()));
+
+    // A reset keeps the grown buffer
+    const uint32_t size = bitstream_.size;
+    output_bitstream_reset(&bitstream_);
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_reserve(&bitstream_, size));
+    EXPECT_EQ(size, bitstream_.size);
+}
+
+TEST_F(OutputBitstreamTest, ReserveFailure) {
+    const uint8_t bytes[16] = {1, 2, 3, 4, 5, 6, 7, 8,
+                               9, 10, 11, 12, 13, 14, 15, 16};
+
+    ASSERT_EQ(EB_ErrorNone, output_bitstream_unit_ctor(&bitstream_, 64));
+    write_bytes(bytes, sizeof(bytes));
+    uint8_t *const buffer = bitstream_.buffer_begin_av1;
+
+    // The written and the reserved bytes do not fit in 32 bits
+    EXPECT_EQ(EB_ErrorInsufficientResources,
+              output_bitstream_reserve(&bitstream_, UINT32_MAX - 8));
+    EXPECT_EQ(EB_ErrorInsufficientResources,
+              output_bitstream_reserve(&bitstream_, UINT32_MAX));
+    EXPECT_EQ(buffer, bitstream_.buffer_begin_av1);
+    EXPECT_EQ(64u, bitstream_.size);
+    ASSERT_EQ(sizeof(bytes), written_bytes());
+    EXPECT_EQ(0, memcmp(bytes, bitstream_.buffer_begin_av1, sizeof(bytes)));
+
+    // The buffer is still usable
+    write_bytes(bytes, sizeof(bytes));
+    EXPECT_EQ(2 * sizeof(bytes), written_bytes());
+}
+
+}  // namespace
@@ -0,0 +1,152 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecApiTest.cc
+ *
+ * @brief SVT-AV1 decoder api test, check the random access properties
+ * eb_svt_dec_get_tu_info reads from the temporal units of an IVF stream
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+/* IVF header and the first 3 temporal units of a 64x64 stream:
+ * 0: temporal delimiter, sequence header and shown key frame
+ * 1: temporal delimiter and 4 frames, the first one hidden inter
+ * 2: temporal delimiter and a show existing frame header */
+static const uint8_t ivf_stream[] = {
+    0x44, 0x4b, 0x49, 0x46, 0x00, 0x00, 0x20, 0x00, 0x41, 0x56, 0x30, 0x31,
+    0x40, 0x00, 0x40, 0x00, 0x30, 0x75, 0x00, 0x00, 0xe8, 0x03, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x0a, 0x0d,
+    0x00, 0x00, 0x00, 0x07, 0xf8, 0x01, 0xf8, 0x01, 0xf8, 0x95, 0xf2, 0x00,
+    0x80, 0x32, 0x3f, 0x10, 0x01, 0xdc, 0x02, 0x1c, 0x70, 0xe3, 0x82, 0x00,
+    0xfc, 0x49, 0x7b, 0x5c, 0x13, 0x37, 0x85, 0x6a, 0x00, 0xc7, 0xa6, 0x34,
+    0xf9, 0x29, 0xdd, 0x94, 0xb0, 0x19, 0x30, 0xca, 0x5f, 0x66, 0x6e, 0x19,
+    0x05, 0x3b, 0xdc, 0x08, 0xef, 0xa1, 0x97, 0x4f, 0xe9, 0xbf, 0x3c, 0x48,
+    0x1e, 0xf9, 0x51, 0x0c, 0x1c, 0x1c, 0xf0, 0xf8, 0xeb, 0x51, 0x8b, 0x1f,
+    0x28, 0xa4, 0xc3, 0xed, 0xb3, 0xc0, 0x7c, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x32, 0x16, 0x28, 0x08,
+    0xe0, 0x24, 0x92, 0x49, 0x13, 0xd1, 0x01, 0x24, 0x89, 0x24, 0x30, 0x00,
+    0x10, 0x28, 0x00, 0x00, 0x7d, 0x04, 0x82, 0x40, 0x32, 0x25, 0x28, 0x04,
+    0xe1, 0x05, 0x0a, 0x00, 0x13, 0xee, 0x01, 0xf7, 0xcf, 0x3c, 0x30, 0x01,
+    0x98, 0x14, 0x00, 0x46, 0xc6, 0x8f, 0x7b, 0x6f, 0x84, 0x28, 0x1f, 0x62,
+    0xd3, 0x57, 0x7a, 0x33, 0x27, 0x96, 0x9d, 0x8b, 0xec, 0xd4, 0x54, 0x32,
+    0x16, 0x28, 0x02, 0xe4, 0x05, 0xa1, 0x61, 0x93, 0xf8, 0x02, 0x59, 0x52,
+    0x48, 0x30, 0x60, 0x18, 0x14, 0x00, 0xcf, 0xb9, 0xa0, 0x70, 0x04, 0x32,
+    0x21, 0x30, 0x03, 0xe0, 0x0b, 0x4f, 0x58, 0x27, 0xfe, 0x00, 0x00, 0x06,
+    0x00, 0x23, 0x02, 0x80, 0x00, 0x01, 0x08, 0x26, 0x68, 0x12, 0x15, 0x79,
+    0xe7, 0xac, 0x1c, 0x88, 0xef, 0x96, 0xf1, 0x82, 0x96, 0x40, 0x05, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00,
+    0x1a, 0x01, 0xd8
+};
+
+static const size_t ivf_file_header_size = 32;
+static const size_t ivf_frame_header_size = 12;
+
+/* Finds the temporal unit tu_index of ivf_stream */
+static const uint8_t *get_ivf_tu(int tu_index, size_t *tu_size) {
+    size_t pos = ivf_file_header_size;
+    for (;;) {
+        const size_t size = ivf_stream[pos] | ivf_stream[pos + 1] << 8 |
+                            ivf_stream[pos + 2] << 16 |
+                            (size_t)ivf_stream[pos + 3] << 24;
+        pos += ivf_frame_header_size;
+        if (!tu_index--) {
+            *tu_size = size;
+            return ivf_stream + pos;
+        }
+        pos += size;
+    }
+}
+
+/** @brief get_tu_info_null_pointer is a api test case
+ * DecApiTest.get_tu_info_null_pointer checks eb_svt_dec_get_tu_info with null
+ * pointers
+ *
+ * Expected result: <br>
+ * EB_ErrorBadParameter without crash.
+ */
+TEST(DecApiTest, get_tu_info_null_pointer) {
+    EbAV1TuInfo tu_info;
+    size_t tu_size;
+    const uint8_t *tu = get_ivf_tu(0, &tu_size);
+
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_get_tu_info(nullptr, tu_size, &tu_info));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_get_tu_info(tu, tu_size, nullptr));
+}
+
+/** @brief get_tu_info_ivf is a api test case
+ * DecApiTest.get_tu_info_ivf feeds the temporal units of a known IVF stream
+ * to eb_svt_dec_get_tu_info
+ *
+ * Expected result: <br>
+ * The frame type, show frame and show existing frame flags of the first
+ * frame of each temporal unit, only the key frame is a random access point.
+ */
+TEST(DecApiTest, get_tu_info_ivf) {
+    EbAV1TuInfo tu_info;
+    size_t tu_size;
+    const uint8_t *tu;
+
+    // Key frame, after the temporal delimiter and the sequence header
+    tu = get_ivf_tu(0, &tu_size);
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_get_tu_info(tu, tu_size, &tu_info));
+    EXPECT_EQ(0, tu_info.frame_type);
+    EXPECT_EQ(EB_FALSE, tu_info.show_existing_frame);
+    EXPECT_EQ(EB_TRUE, tu_info.show_frame);
+    EXPECT_EQ(EB_TRUE, tu_info.random_access_point);
+    EXPECT_EQ(2u, tu_info.seq_header_offset);
+    EXPECT_EQ(15u, tu_info.seq_header_size);
+
+    // Hidden inter frame
+    tu = get_ivf_tu(1, &tu_size);
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_get_tu_info(tu, tu_size, &tu_info));
+    EXPECT_EQ(1, tu_info.frame_type);
+    EXPECT_EQ(EB_FALSE, tu_info.show_existing_frame);
+    EXPECT_EQ(EB_FALSE, tu_info.show_frame);
+    EXPECT_EQ(EB_FALSE, tu_info.random_access_point);
+    EXPECT_EQ(0u, tu_info.seq_header_size);
+
+    // Show existing frame
+    tu = get_ivf_tu(2, &tu_size);
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_get_tu_info(tu, tu_size, &tu_info));
+    EXPECT_EQ(EB_TRUE, tu_info.show_existing_frame);
+    EXPECT_EQ(EB_FALSE, tu_info.random_access_point);
+    EXPECT_EQ(0u, tu_info.seq_header_size);
+}
+
+/** @brief get_tu_info_corrupt is a api test case
+ * DecApiTest.get_tu_info_corrupt feeds a truncated temporal unit and an OBU
+ * without obu_size field to eb_svt_dec_get_tu_info
+ *
+ * Expected result: <br>
+ * EB_Corrupt_Frame, the length fields of Annex B are not parsed.
+ */
+TEST(DecApiTest, get_tu_info_corrupt) {
+    EbAV1TuInfo tu_info;
+    size_t tu_size;
+    const uint8_t *tu = get_ivf_tu(0, &tu_size);
+    uint8_t no_size_field[16];
+
+    EXPECT_EQ(EB_Corrupt_Frame,
+              eb_svt_dec_get_tu_info(tu, tu_size - 1, &tu_info));
+
+    // Temporal delimiter with obu_has_size_field cleared
+    memcpy(no_size_field, tu, sizeof(no_size_field));
+    no_size_field[0] &= ~0x2;
+    EXPECT_EQ(EB_Corrupt_Frame,
+              eb_svt_dec_get_tu_info(
+                  no_size_field, sizeof(no_size_field), &tu_info));
+}
+
+}  // namespace
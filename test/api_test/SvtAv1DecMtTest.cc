@@ -0,0 +1,199 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecMtTest.cc
+ *
+ * @brief SVT-AV1 decoder multi-thread test, check that the tile parallel
+ * decoding, the SB row wavefront and the row pipelined post filters give the
+ * output of the single thread decoder, with and without external frame
+ * buffers
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Dec.h"
+#include "SvtAv1TestStream.h"
+#include "gtest/gtest.h"
+
+using svt_av1_test::TemporalUnits;
+using svt_av1_test::TestStreamParams;
+
+namespace {
+
+/** Samples of every output picture, plane after plane */
+typedef std::vector<std::vector<uint8_t> > DecodedPictures;
+
+/* Frame buffers handed to the decoder, filled with garbage so that a read
+ * of a sample the decoder has not written changes the output */
+static int test_allocate_frame_buffer(EbExtFrameBuf *frame_buf,
+                                      uint32_t min_size, void *private_data) {
+    int *outstanding_count = (int *)private_data;
+    frame_buf->buffer = (uint8_t *)malloc(min_size);
+    if (frame_buf->buffer == nullptr)
+        return -1;
+    memset(frame_buf->buffer, 0xa5, min_size);
+    frame_buf->buffer_size = min_size;
+    frame_buf->private_data = nullptr;
+    (*outstanding_count)++;
+    return 0;
+}
+
+static int test_release_frame_buffer(EbExtFrameBuf *frame_buf,
+                                     void *private_data) {
+    int *outstanding_count = (int *)private_data;
+    free(frame_buf->buffer);
+    frame_buf->buffer = nullptr;
+    (*outstanding_count)--;
+    return 0;
+}
+
+/* Appends the size and the visible samples of a plane */
+static void append_plane(std::vector<uint8_t> *picture, const uint8_t *plane,
+                         uint32_t stride, uint32_t width, uint32_t height,
+                         uint32_t bytes_per_sample) {
+    picture->push_back((uint8_t)width);
+    picture->push_back((uint8_t)(width >> 8));
+    picture->push_back((uint8_t)height);
+    picture->push_back((uint8_t)(height >> 8));
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *row = plane + y * stride * bytes_per_sample;
+        picture->insert(picture->end(), row, row + width * bytes_per_sample);
+    }
+}
+
+/** Decodes tus with the given decoder threads, into frame buffers of the
+ * application when ext_frame_buf is set */
+static void decode_stream(const TemporalUnits &tus, uint32_t bit_depth,
+                          uint32_t threads, bool ext_frame_buf,
+                          DecodedPictures *pictures) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1DecConfiguration config;
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+    EbSvtIOFormat img;
+    EbBufferHeaderType out_buf;
+    int outstanding_count = 0;
+    const uint32_t bytes_per_sample = bit_depth > 8 ? 2 : 1;
+
+    ASSERT_EQ(EB_ErrorNone, eb_dec_init_handle(&handle, nullptr, &config));
+    config.threads = threads;
+    config.max_bit_depth = bit_depth > 8 ? EB_TEN_BIT : EB_EIGHT_BIT;
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_set_parameter(handle, &config));
+    ASSERT_EQ(EB_ErrorNone, eb_init_decoder(handle));
+    if (ext_frame_buf) {
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_dec_set_frame_buffer_callbacks(handle,
+                                                    test_allocate_frame_buffer,
+                                                    test_release_frame_buffer,
+                                                    &outstanding_count));
+    }
+
+    // Without external frame buffers the decoder allocates the planes
+    memset(&img, 0, sizeof(img));
+    memset(&out_buf, 0, sizeof(out_buf));
+    out_buf.size = sizeof(out_buf);
+    out_buf.p_buffer = (uint8_t *)&img;
+
+    for (size_t i = 0; i < tus.size(); i++) {
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_decode_frame(handle, tus[i].data(), tus[i].size()))
+            << "temporal unit " << i;
+        if (eb_svt_dec_get_picture(
+                handle, &out_buf, &stream_info, &frame_info) != EB_ErrorNone)
+            continue;
+        std::vector<uint8_t> picture;
+        append_plane(&picture, img.luma, img.y_stride, img.width, img.height,
+                     bytes_per_sample);
+        append_plane(&picture, img.cb, img.cb_stride, img.width >> 1,
+                     img.height >> 1, bytes_per_sample);
+        append_plane(&picture, img.cr, img.cr_stride, img.width >> 1,
+                     img.height >> 1, bytes_per_sample);
+        pictures->push_back(picture);
+    }
+
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_decoder(handle));
+    EXPECT_EQ(EB_ErrorNone, eb_dec_deinit_handle(handle));
+    if (ext_frame_buf)
+        EXPECT_EQ(0, outstanding_count) << "frame buffers not released";
+    else {
+        free(img.luma);
+        free(img.cb);
+        free(img.cr);
+    }
+}
+
+/** @brief DecMtTest decodes a stream with 1 thread, then with several
+ * threads and external frame buffers
+ *
+ * Expected result: <br>
+ * Every decoding outputs the same pictures as the single thread decoding,
+ * one per frame of the stream.
+ */
+class DecMtTest : public ::testing::TestWithParam<TestStreamParams> {
+  protected:
+    void run_test() {
+        const TestStreamParams &params = GetParam();
+        TemporalUnits tus;
+        DecodedPictures ref;
+
+        ASSERT_EQ(EB_ErrorNone, svt_av1_test::encode_test_stream(params, &tus));
+        decode_stream(tus, params.bit_depth, 1, false, &ref);
+        ASSERT_EQ(params.frame_count, ref.size());
+
+        static const uint32_t thread_counts[] = {1, 2, 4, 7};
+        for (int ext_frame_buf = 0; ext_frame_buf < 2; ext_frame_buf++) {
+            for (size_t i = 0;
+                 i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+                const uint32_t threads = thread_counts[i];
+                DecodedPictures pictures;
+                if (!ext_frame_buf && threads == 1)
+                    continue;
+                decode_stream(tus, params.bit_depth, threads,
+                              ext_frame_buf != 0, &pictures);
+                ASSERT_EQ(ref.size(), pictures.size())
+                    << threads << " threads, ext_frame_buf " << ext_frame_buf;
+                for (size_t j = 0; j < ref.size(); j++) {
+                    ASSERT_TRUE(ref[j] == pictures[j])
+                        << "picture " << j << " differs with " << threads
+                        << " threads, ext_frame_buf " << ext_frame_buf;
+                }
+            }
+        }
+    }
+};
+
+TEST_P(DecMtTest, MatchSingleThread) {
+    run_test();
+}
+
+static TestStreamParams single_tile_params() {
+    return svt_av1_test::default_test_stream_params();
+}
+
+static TestStreamParams multi_tile_params() {
+    TestStreamParams params = svt_av1_test::default_test_stream_params();
+    // 4 tile columns and 2 tile rows, with segment ids coded in every tile
+    params.tile_columns = 2;
+    params.tile_rows = 1;
+    params.adaptive_quantization = EB_TRUE;
+    return params;
+}
+
+static TestStreamParams ten_bit_params() {
+    TestStreamParams params = svt_av1_test::default_test_stream_params();
+    params.bit_depth = 10;
+    params.tile_columns = 1;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(DecMt, DecMtTest,
+                        ::testing::Values(single_tile_params(),
+                                          multi_tile_params(),
+                                          ten_bit_params()));
+
+}  // namespace
@@ -86,6 +86,17 @@ TEST(EncApiTest, check_null_pointer) {
     EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_stream_header(nullptr, nullptr));
     // get end of sequence NAL with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_eos_nal(nullptr, nullptr));
+    // get memory usage with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_get_memory_usage(nullptr, nullptr));
+    // get pipeline trace with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_get_trace(nullptr, nullptr, nullptr));
+    // get zero copy input layout with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_enc_get_input_layout(nullptr, nullptr));
+    // create and destroy a shared thread pool with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_create_thread_pool(nullptr, 1));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_destroy_thread_pool(nullptr));
     // EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_send_picture(nullptr,
     // nullptr)); EXPECT_EQ(EB_ErrorBadParameter, eb_svt_get_packet(nullptr,
     // nullptr, 0)); EXPECT_EQ(EB_ErrorBadParameter, eb_svt_get_recon(nullptr,
@@ -194,4 +205,170 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+/** @brief check_memory_usage is a api test case
+ * EncApiTest.check_memory_usage is a api test case of reading the memory
+ * accounted to an encoder handle
+ *
+ * Test strategy: <br>
+ * Create an encoder handle with a default setup and read its memory usage.
+ *
+ * Expected result: <br>
+ * The handle reports the memory it allocated, the peak being at least the
+ * current total and the categories adding up to the total.
+ *
+ * Test coverage:
+ * eb_svt_get_memory_usage.
+ */
+TEST(EncApiTest, check_memory_usage) {
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    EbMemoryUsage usage;
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = 320;
+    context.enc_params.source_height = 240;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_get_memory_usage(context.enc_handle, nullptr));
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_get_memory_usage(context.enc_handle, &usage))
+        << "eb_svt_get_memory_usage failed";
+    EXPECT_GT(usage.total_bytes, 0u);
+    EXPECT_GE(usage.peak_bytes, usage.total_bytes);
+    EXPECT_EQ(usage.total_bytes,
+              usage.malloc_bytes + usage.calloc_bytes + usage.aligned_bytes);
+    uint64_t subsystem_total = 0;
+    for (int i = 0; i < EB_MEM_SUBSYSTEM_COUNT; i++)
+        subsystem_total += usage.subsystem_bytes[i];
+    EXPECT_EQ(usage.total_bytes, subsystem_total);
+    EXPECT_GT(usage.subsystem_bytes[EB_MEM_SUBSYSTEM_OTHER], 0u);
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+}
+
+/** @brief check_input_layout is a api test case
+ * EncApiTest.check_input_layout checks the layout of the zero copy input
+ * planes and that zero copy input requires a release callback.
+ *
+ * Test strategy: <br>
+ * Setup an encoder with zero copy input without release callback, then
+ * another one with a release callback, and read the layout of its input
+ * planes.
+ *
+ * Expected result: <br>
+ * The setup without callback fails. The layout covers the source size with
+ * the padding on both sides, the chroma planes being a quarter of the luma
+ * plane for 4:2:0.
+ *
+ * Test coverage:
+ * eb_svt_enc_get_input_layout.
+ */
+static void release_input(void *p_app_data, void *p_app_private) {
+    (void)p_app_data;
+    (void)p_app_private;
+}
+
+TEST(EncApiTest, check_input_layout) {
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    EbInputLayout layout;
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = 320;
+    context.enc_params.source_height = 240;
+    context.enc_params.zero_copy_input = EB_TRUE;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "zero copy input without release callback is accepted";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+
+    // A handle is not set up again after a rejected setup, take a new one
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = 320;
+    context.enc_params.source_height = 240;
+    context.enc_params.zero_copy_input = EB_TRUE;
+    context.enc_params.input_release_callback = release_input;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_enc_get_input_layout(context.enc_handle, nullptr));
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_enc_get_input_layout(context.enc_handle, &layout))
+        << "eb_svt_enc_get_input_layout failed";
+    EXPECT_EQ(layout.width, 320u);
+    EXPECT_EQ(layout.height, 240u);
+    EXPECT_EQ(layout.y_stride, 2 * layout.origin_x + layout.width);
+    EXPECT_EQ(layout.cb_stride, layout.y_stride / 2);
+    EXPECT_EQ(layout.cr_stride, layout.y_stride / 2);
+    EXPECT_GE(layout.luma_size,
+              layout.y_stride * (layout.origin_y + layout.height));
+    EXPECT_EQ(layout.chroma_size, layout.luma_size / 4);
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+}
+
+/** @brief check_shared_thread_pool is a api test case
+ * EncApiTest.check_shared_thread_pool checks that several encoder handles
+ * can be set up with the same thread pool.
+ *
+ * Test strategy: <br>
+ * Create thread pools of invalid and valid sizes, set up two encoders
+ * attached to the valid one, then destroy the handles and the pool.
+ *
+ * Expected result: <br>
+ * The invalid sizes are rejected, the handles accept the shared pool.
+ *
+ * Test coverage:
+ * eb_svt_create_thread_pool, eb_svt_destroy_thread_pool.
+ */
+TEST(EncApiTest, check_shared_thread_pool) {
+    SvtAv1Context contexts[2];
+    memset(contexts, 0, sizeof(contexts));
+    EbSvtThreadPool *thread_pool = nullptr;
+
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_create_thread_pool(&thread_pool, 0));
+    EXPECT_EQ(nullptr, thread_pool);
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_create_thread_pool(&thread_pool, -2));
+    EXPECT_EQ(nullptr, thread_pool);
+    ASSERT_EQ(EB_ErrorNone, eb_svt_create_thread_pool(&thread_pool, 2))
+        << "eb_svt_create_thread_pool failed";
+    ASSERT_NE(nullptr, thread_pool);
+
+    for (int i = 0; i < 2; i++) {
+        SvtAv1Context &context = contexts[i];
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_init_handle(
+                      &context.enc_handle, &context, &context.enc_params))
+            << "eb_init_handle failed";
+        context.enc_params.source_width = 320;
+        context.enc_params.source_height = 240;
+        context.enc_params.channel_id = i;
+        context.enc_params.active_channel_count = 2;
+        context.enc_params.thread_pool = thread_pool;
+        EXPECT_EQ(
+            EB_ErrorNone,
+            eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+            << "eb_svt_enc_set_parameter failed";
+    }
+    for (int i = 0; i < 2; i++) {
+        EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(contexts[i].enc_handle))
+            << "eb_deinit_handle failed";
+    }
+    EXPECT_EQ(EB_ErrorNone, eb_svt_destroy_thread_pool(thread_pool));
+}
+
 }  // namespace
@@ -0,0 +1,92 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncMtTest.cc
+ *
+ * @brief SVT-AV1 encoder multi-thread test, check that the SB row parallel
+ * deblocking, CDEF and loop restoration and the tile parallel entropy coding
+ * give the stream of the single thread encoder
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include "EbSvtAv1Enc.h"
+#include "SvtAv1TestStream.h"
+#include "gtest/gtest.h"
+
+using svt_av1_test::TemporalUnits;
+using svt_av1_test::TestStreamParams;
+
+namespace {
+
+/** @brief EncMtTest encodes a stream on one logical processor, then on 2 and
+ * on every logical processor, which sizes the DLF, CDEF, restoration and
+ * entropy coding thread pools from the processor count
+ *
+ * Expected result: <br>
+ * Every encoding outputs the same temporal units as the single processor
+ * encoding. On a single processor machine the encodings are the same.
+ */
+class EncMtTest : public ::testing::TestWithParam<TestStreamParams> {
+  protected:
+    void run_test() {
+        TestStreamParams params = GetParam();
+        TemporalUnits ref;
+
+        params.logical_processors = 1;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_test::encode_test_stream(params, &ref));
+        ASSERT_EQ(params.frame_count, ref.size());
+
+        // 0 takes every logical processor
+        static const uint32_t logical_processors[] = {2, 0};
+        for (size_t i = 0;
+             i < sizeof(logical_processors) / sizeof(logical_processors[0]);
+             i++) {
+            TemporalUnits tus;
+            params.logical_processors = logical_processors[i];
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_test::encode_test_stream(params, &tus));
+            ASSERT_EQ(ref.size(), tus.size())
+                << params.logical_processors << " logical processors";
+            for (size_t j = 0; j < ref.size(); j++) {
+                ASSERT_TRUE(ref[j] == tus[j])
+                    << "temporal unit " << j << " differs with "
+                    << params.logical_processors << " logical processors";
+            }
+        }
+    }
+};
+
+TEST_P(EncMtTest, MatchSingleThread) {
+    run_test();
+}
+
+static TestStreamParams filter_params() {
+    TestStreamParams params = svt_av1_test::default_test_stream_params();
+    // The fastest preset that deblocks the reference pictures in the DLF
+    // process rather than in the encode pass
+    params.enc_mode = 5;
+    return params;
+}
+
+static TestStreamParams multi_tile_params() {
+    TestStreamParams params = filter_params();
+    // 4 tile columns and 2 tile rows for the entropy coding threads
+    params.tile_columns = 2;
+    params.tile_rows = 1;
+    return params;
+}
+
+static TestStreamParams ten_bit_params() {
+    TestStreamParams params = filter_params();
+    params.bit_depth = 10;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(EncMt, EncMtTest,
+                        ::testing::Values(filter_params(), multi_tile_params(),
+                                          ten_bit_params()));
+
+}  // namespace
@@ -394,10 +394,22 @@ PARAM_TEST(EncParamLogicalProcessorsTest);
 DEFINE_PARAM_TEST_CLASS(EncParamTargetSocketTest, target_socket);
 PARAM_TEST(EncParamTargetSocketTest);
 
+/** Test case for thread_pool_size*/
+DEFINE_PARAM_TEST_CLASS(EncParamThreadPoolSizeTest, thread_pool_size);
+PARAM_TEST(EncParamThreadPoolSizeTest);
+
+/** Test case for memory_budget_mb*/
+DEFINE_PARAM_TEST_CLASS(EncParamMemoryBudgetTest, memory_budget_mb);
+PARAM_TEST(EncParamMemoryBudgetTest);
+
 /** Test case for recon_enabled*/
 DEFINE_PARAM_TEST_CLASS(EncParamReconEnabledTest, recon_enabled);
 PARAM_TEST(EncParamReconEnabledTest);
 
+/** Test case for trace_event_count*/
+DEFINE_PARAM_TEST_CLASS(EncParamTraceEventCountTest, trace_event_count);
+PARAM_TEST(EncParamTraceEventCountTest);
+
 #if TILES
 /** Test case for tile_columns*/
 DEFINE_PARAM_TEST_CLASS(EncParamTileColsTest, tile_columns);
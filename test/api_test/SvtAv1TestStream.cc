@@ -0,0 +1,212 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1TestStream.cc
+ *
+ * @brief Encodes short synthetic streams for the api tests.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "SvtAv1TestStream.h"
+
+namespace svt_av1_test {
+
+static const uint8_t obu_temporal_delimiter = 2;
+
+/* Texture sample at (x, y): a checkerboard with gradients for the edges and
+ * the flat areas the loop filters work on, and hashed noise */
+static uint32_t texture(uint32_t x, uint32_t y, uint32_t bit_depth) {
+    uint32_t hash = x * 0x9e3779b1u ^ y * 0x85ebca77u;
+    hash ^= hash >> 15;
+    hash *= 0x2c1b3c6du;
+    hash ^= hash >> 12;
+    const uint32_t value = (((x >> 4) ^ (y >> 4)) & 1) * 96 +
+                           ((x + 2 * y) & 127) + (hash & 15);
+    return bit_depth > 8 ? (value << 2) + ((hash >> 8) & 3) : value;
+}
+
+/* Fills a plane with the texture moved by (dx, dy) */
+static void fill_plane(uint8_t *plane, uint32_t width, uint32_t height,
+                       uint32_t dx, uint32_t dy, uint32_t seed,
+                       uint32_t bit_depth) {
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            const uint32_t value =
+                texture((x + dx) ^ seed, y + dy, bit_depth);
+            if (bit_depth > 8)
+                ((uint16_t *)plane)[y * width + x] = (uint16_t)value;
+            else
+                plane[y * width + x] = (uint8_t)value;
+        }
+    }
+}
+
+/* Reads the leb128 value at data[*pos] */
+static bool read_leb128(const uint8_t *data, size_t size, size_t *pos,
+                        uint64_t *value) {
+    *value = 0;
+    for (int i = 0; i < 8 && *pos < size; i++) {
+        const uint8_t byte = data[(*pos)++];
+        *value |= (uint64_t)(byte & 0x7f) << (7 * i);
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/* Splits an OBU stream into temporal units at its temporal delimiters */
+static bool split_temporal_units(const std::vector<uint8_t> &stream,
+                                 TemporalUnits *tus) {
+    const uint8_t *data = stream.data();
+    const size_t size = stream.size();
+    size_t pos = 0;
+
+    while (pos < size) {
+        const uint8_t header = data[pos];
+        const uint8_t obu_type = (header >> 3) & 0xf;
+        const bool has_extension = (header >> 2) & 1;
+        const bool has_size_field = (header >> 1) & 1;
+        size_t payload_pos = pos + 1 + (has_extension ? 1 : 0);
+        uint64_t payload_size;
+
+        if (!has_size_field ||
+            !read_leb128(data, size, &payload_pos, &payload_size) ||
+            payload_size > size - payload_pos)
+            return false;
+        if (obu_type == obu_temporal_delimiter)
+            tus->push_back(std::vector<uint8_t>());
+        if (tus->empty())
+            return false;
+        const size_t obu_end = payload_pos + (size_t)payload_size;
+        tus->back().insert(tus->back().end(), data + pos, data + obu_end);
+        pos = obu_end;
+    }
+    return true;
+}
+
+/* Appends the packets the encoder has ready to stream, until the end of
+ * stream once pic_send_done is set */
+static EbErrorType receive_packets(EbComponentType *handle,
+                                   uint8_t pic_send_done, bool *eos,
+                                   std::vector<uint8_t> *stream) {
+    while (!*eos) {
+        EbBufferHeaderType *packet = nullptr;
+        const EbErrorType return_error =
+            eb_svt_get_packet(handle, &packet, pic_send_done);
+        if (return_error == EB_ErrorMax)
+            return return_error;
+        if (return_error == EB_NoErrorEmptyQueue)
+            break;
+        stream->insert(stream->end(),
+                       packet->p_buffer,
+                       packet->p_buffer + packet->n_filled_len);
+        *eos = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+        eb_svt_release_out_buffer(&packet);
+    }
+    return EB_ErrorNone;
+}
+
+TestStreamParams default_test_stream_params() {
+    TestStreamParams params;
+    params.width = 320;
+    params.height = 256;
+    params.bit_depth = 8;
+    params.frame_count = 10;
+    // The fastest preset that keeps loop restoration
+    params.enc_mode = 7;
+    params.tile_columns = 0;
+    params.tile_rows = 0;
+    params.adaptive_quantization = EB_FALSE;
+    params.logical_processors = 0;
+    return params;
+}
+
+EbErrorType encode_test_stream(const TestStreamParams &params,
+                               TemporalUnits *tus) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    EbErrorType return_error;
+    std::vector<uint8_t> stream;
+    bool eos = false;
+
+    return_error = eb_init_handle(&handle, nullptr, &config);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    config.source_width = params.width;
+    config.source_height = params.height;
+    config.encoder_bit_depth = params.bit_depth;
+    config.encoder_color_format = EB_YUV420;
+    config.enc_mode = params.enc_mode;
+    config.tile_columns = params.tile_columns;
+    config.tile_rows = params.tile_rows;
+    config.enable_adaptive_quantization = params.adaptive_quantization;
+    config.logical_processors = params.logical_processors;
+    return_error = eb_svt_enc_set_parameter(handle, &config);
+    if (return_error == EB_ErrorNone)
+        return_error = eb_init_encoder(handle);
+    if (return_error != EB_ErrorNone) {
+        eb_deinit_handle(handle);
+        return return_error;
+    }
+
+    const uint32_t bytes_per_sample = params.bit_depth > 8 ? 2 : 1;
+    const uint32_t luma_size = params.width * params.height;
+    const uint32_t chroma_size = luma_size >> 2;
+    std::vector<uint8_t> frame((luma_size + 2 * chroma_size) *
+                               bytes_per_sample);
+    EbSvtIOFormat input;
+    memset(&input, 0, sizeof(input));
+    input.luma = frame.data();
+    input.cb = input.luma + luma_size * bytes_per_sample;
+    input.cr = input.cb + chroma_size * bytes_per_sample;
+    input.y_stride = params.width;
+    input.cb_stride = params.width >> 1;
+    input.cr_stride = params.width >> 1;
+    input.width = params.width;
+    input.height = params.height;
+    input.color_fmt = EB_YUV420;
+
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.size = sizeof(header);
+    header.p_buffer = (uint8_t *)&input;
+    header.n_filled_len = (uint32_t)frame.size();
+    header.pic_type = EB_AV1_INVALID_PICTURE;
+
+    for (uint32_t i = 0; i < params.frame_count &&
+                         return_error == EB_ErrorNone; i++) {
+        // Pan the texture so that the inter frames have motion
+        fill_plane(input.luma, params.width, params.height, 2 * i, i, 0,
+                   params.bit_depth);
+        fill_plane(input.cb, params.width >> 1, params.height >> 1, i, i >> 1,
+                   0x55, params.bit_depth);
+        fill_plane(input.cr, params.width >> 1, params.height >> 1, i, i >> 1,
+                   0xaa, params.bit_depth);
+        header.pts = i;
+        return_error = eb_svt_enc_send_picture(handle, &header);
+        if (return_error == EB_ErrorNone)
+            return_error = receive_packets(handle, 0, &eos, &stream);
+    }
+
+    if (return_error == EB_ErrorNone) {
+        EbBufferHeaderType eos_header;
+        memset(&eos_header, 0, sizeof(eos_header));
+        eos_header.flags = EB_BUFFERFLAG_EOS;
+        eos_header.pic_type = EB_AV1_INVALID_PICTURE;
+        return_error = eb_svt_enc_send_picture(handle, &eos_header);
+    }
+    if (return_error == EB_ErrorNone)
+        return_error = receive_packets(handle, 1, &eos, &stream);
+
+    eb_deinit_encoder(handle);
+    eb_deinit_handle(handle);
+
+    if (return_error == EB_ErrorNone && !split_temporal_units(stream, tus))
+        return_error = EB_ErrorUndefined;
+    return return_error;
+}
+
+}  // namespace svt_av1_test
@@ -0,0 +1,51 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1TestStream.h
+ *
+ * @brief Encodes short synthetic streams for the api tests, so that the
+ * tests can set the coding tools and the threading of the stream they check.
+ *
+ ******************************************************************************/
+#ifndef _SVT_AV1_TEST_STREAM_H_
+#define _SVT_AV1_TEST_STREAM_H_
+
+#include <stdint.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+
+namespace svt_av1_test {
+
+/** Temporal units of a stream, each one starts with a temporal delimiter */
+typedef std::vector<std::vector<uint8_t> > TemporalUnits;
+
+/** TestStreamParams holds the settings of a synthetic test stream, the
+ * other encoder settings keep their defaults */
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t bit_depth;            /**< 8 or 10 */
+    uint32_t frame_count;
+    uint8_t enc_mode;
+    int32_t tile_columns;          /**< log2 of the tile column count */
+    int32_t tile_rows;             /**< log2 of the tile row count */
+    EbBool adaptive_quantization;  /**< segment based quantization */
+    uint32_t logical_processors;   /**< 0 for every processor */
+} TestStreamParams;
+
+/** Returns the default TestStreamParams: 8-bit 320x256, 10 frames, one tile
+ */
+TestStreamParams default_test_stream_params();
+
+/** Encodes params.frame_count frames of moving texture and splits the
+ * output packets into temporal units.
+ * @return EB_ErrorNone, or the first error returned by the encoder */
+EbErrorType encode_test_stream(const TestStreamParams &params,
+                               TemporalUnits *tus);
+
+}  // namespace svt_av1_test
+
+#endif  // _SVT_AV1_TEST_STREAM_H_
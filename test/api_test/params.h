@@ -937,6 +937,43 @@ static const vector<int32_t> invalid_target_socket = {
     2,
 };
 
+/* Number of kernel threads allowed to run at the same time.
+ *
+ * -1 = Sized to the CPU quota of the process cgroup.
+ *  0 = Off.
+ *
+ * Default is 0. */
+static const vector<int32_t> default_thread_pool_size = {
+    0,
+};
+static const vector<int32_t> valid_thread_pool_size = {
+    -1,
+    0,
+    1,
+    4,
+    64,
+};
+static const vector<int32_t> invalid_thread_pool_size = {
+    -2,
+};
+
+/* Memory budget of the encoder in MB.
+ *
+ * 0 = No budget.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_memory_budget_mb = {
+    0,
+};
+static const vector<uint32_t> valid_memory_budget_mb = {
+    0,
+    4096,
+    65536,
+};
+static const vector<uint32_t> invalid_memory_budget_mb = {
+    // ...
+};
+
 // Debug tools
 
 /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -947,6 +984,23 @@ static const vector<uint32_t> default_recon_enabled = {EB_FALSE};
 static const vector<uint32_t> valid_recon_enabled = {EB_FALSE, EB_TRUE};
 static const vector<uint32_t> invalid_recon_enabled = {/** none */};
 
+/* Number of pipeline trace events recorded.
+ *
+ * 0 = Tracing off.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_trace_event_count = {
+    0,
+};
+static const vector<uint32_t> valid_trace_event_count = {
+    0,
+    1,
+    1 << 18,
+};
+static const vector<uint32_t> invalid_trace_event_count = {
+    // ...
+};
+
 #if TILES
 /* Log 2 Tile Rows and colums . 0 means no tiling,1 means that we split the
  * dimension into 2 Default is 0. */